@@ -0,0 +1,1211 @@
+#include "GvArchive.h"
+#include "GvAsyncSave.h"
+#include "GvAutoExposure.h"
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvColoredPointMap.h"
+#include "GvDeviceWorker.h"
+#include "GvImageIO.h"
+#include "GvPointCloudIO.h"
+#include "GvPointMapFilter.h"
+#include "GvRealtimeDispatch.h"
+#include "GvReconstruction.h"
+#include "GvSequence.h"
+#include "GvSession.h"
+#include "GvSharedRing.h"
+#include "GvThreadPool.h"
+#include "GvUndistort.h"
+#include "GvVirtualCamera.h"
+#include "GvWhiteBalance.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef GVSDK_BENCH_WITH_SDK
+#define GVSDK_BENCH_WITH_SDK 1
+#endif
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// 최소 벤치마크 하네스 (Google Benchmark 방식)
+// - 각 케이스는 `while (state.KeepRunning())` 루프 안에서 측정 대상만 실행합니다.
+// - 반복 횟수는 누적 측정 시간이 --min_time 이상이 될 때까지 늘려 갑니다.
+// -----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+
+class BenchState {
+public:
+    explicit BenchState(uint64_t iterations) : m_iterations(iterations), m_remaining(iterations) {}
+
+    // 첫 호출에서 측정을 시작하고, 반복 횟수를 모두 소진하면 측정을 끝냅니다.
+    bool KeepRunning() {
+        if (!m_started) {
+            m_started = true;
+            ResumeTiming();
+        }
+        if (m_remaining == 0) {
+            StopTiming();
+            return false;
+        }
+        --m_remaining;
+        return true;
+    }
+
+    // 반복마다 필요한 입력 복원 등은 Pause/Resume 사이에서 수행합니다.
+    void PauseTiming() { StopTiming(); }
+    void ResumeTiming() {
+        m_running = true;
+        m_start = Clock::now();
+    }
+
+    void SetBytesProcessed(uint64_t bytes) { m_bytes = bytes; }
+    void SetItemsProcessed(uint64_t items) { m_items = items; }
+    void SkipWithError(const std::string& message) { m_error = message; }
+
+    uint64_t Iterations() const { return m_iterations; }
+    double ElapsedSeconds() const { return m_elapsed; }
+    uint64_t BytesProcessed() const { return m_bytes; }
+    uint64_t ItemsProcessed() const { return m_items; }
+    const std::string& Error() const { return m_error; }
+
+private:
+    void StopTiming() {
+        if (m_running) {
+            m_elapsed += std::chrono::duration<double>(Clock::now() - m_start).count();
+            m_running = false;
+        }
+    }
+
+    uint64_t m_iterations;
+    uint64_t m_remaining;
+    bool m_started = false;
+    Clock::time_point m_start{};
+    double m_elapsed = 0.0;
+    bool m_running = false;
+    uint64_t m_bytes = 0;
+    uint64_t m_items = 0;
+    std::string m_error;
+};
+
+struct BenchCase {
+    std::string name;
+    std::function<void(BenchState&)> run;
+};
+
+std::vector<BenchCase>& registry() {
+    static std::vector<BenchCase> cases;
+    return cases;
+}
+
+void registerBench(const std::string& name, std::function<void(BenchState&)> run) {
+    registry().push_back(BenchCase{name, std::move(run)});
+}
+
+void runBench(const BenchCase& bench, double minTime) {
+    uint64_t iterations = 1;
+    for (;;) {
+        BenchState state(iterations);
+        bench.run(state);
+        if (!state.Error().empty()) {
+            std::printf("%-64s ERROR: %s\n", bench.name.c_str(), state.Error().c_str());
+            return;
+        }
+        const double elapsed = state.ElapsedSeconds();
+        if (elapsed >= minTime || iterations >= (1ull << 30)) {
+            const double perIter = elapsed / static_cast<double>(iterations);
+            std::printf("%-64s %10llu %12.3f ms", bench.name.c_str(), static_cast<unsigned long long>(iterations),
+                        perIter * 1.0e3);
+            if (state.BytesProcessed() > 0) {
+                std::printf(" %10.1f MB/s", static_cast<double>(state.BytesProcessed()) / elapsed / 1.0e6);
+            }
+            if (state.ItemsProcessed() > 0) {
+                // 캡처 단위 항목(다중 장치 등)은 Mitems/s로 보면 0이 되므로 items/s로 출력합니다.
+                const double itemsPerSec = static_cast<double>(state.ItemsProcessed()) / elapsed;
+                if (itemsPerSec >= 1.0e5) {
+                    std::printf(" %10.1f Mitems/s", itemsPerSec / 1.0e6);
+                } else {
+                    std::printf(" %10.2f items/s", itemsPerSec);
+                }
+            }
+            std::printf("\n");
+            return;
+        }
+        // 측정 시간이 min_time에 도달하도록 반복 횟수를 추정해 늘립니다.
+        const double scale = elapsed > 0.0 ? (minTime * 1.4) / elapsed : 10.0;
+        const double next = static_cast<double>(iterations) * std::min(std::max(scale, 2.0), 100.0);
+        iterations = static_cast<uint64_t>(next);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// 합성 데이터
+// - 기울어진 평면 + 구 형태의 물체를 핀홀 카메라로 본 정렬 포인트맵(meter)
+// - nan_ratio 비율만큼 무효(NaN) 포인트, 약 1%의 튀는 점(outlier)
+// -----------------------------------------------------------------------------
+
+struct SyntheticFrame {
+    gv::GvSize size;
+    std::vector<double> points;
+    std::vector<double> confidence;
+    std::vector<double> depth;
+    std::vector<unsigned char> texture_rgb;
+    std::vector<unsigned char> texture_mono;
+};
+
+uint32_t nextRandom(uint32_t& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed;
+}
+
+double unitRandom(uint32_t& seed) {
+    return static_cast<double>(nextRandom(seed) >> 8) / static_cast<double>(1u << 24);
+}
+
+SyntheticFrame makeSyntheticFrame(int width, int height, double nanRatio) {
+    SyntheticFrame frame;
+    frame.size = gv::GvSize(width, height);
+    const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+    frame.points.resize(count * 3);
+    frame.confidence.resize(count);
+    frame.depth.resize(count);
+    frame.texture_rgb.resize(count * 3);
+    frame.texture_mono.resize(count);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double f = width * 1.2;
+    const double cx = width * 0.5;
+    const double cy = height * 0.5;
+    const double sphereR = height * 0.25;
+    uint32_t seed = 0x9e3779b9u ^ static_cast<uint32_t>(width * 31 + height);
+
+    for (int v = 0; v < height; ++v) {
+        for (int u = 0; u < width; ++u) {
+            const size_t i = static_cast<size_t>(v) * static_cast<size_t>(width) + static_cast<size_t>(u);
+            double z = 0.9 + 0.0001 * (u - cx) * 0.2 + 0.00005 * (v - cy);
+            const double du = u - cx;
+            const double dv = v - cy;
+            const double d2 = du * du + dv * dv;
+            if (d2 < sphereR * sphereR) {
+                z -= 0.08 * std::sqrt(1.0 - d2 / (sphereR * sphereR));
+            }
+            if (unitRandom(seed) < 0.01) {
+                z += 0.05 + 0.1 * unitRandom(seed);
+            }
+            const bool invalid = unitRandom(seed) < nanRatio;
+            double* p = &frame.points[i * 3];
+            p[0] = invalid ? nan : du * z / f;
+            p[1] = invalid ? nan : dv * z / f;
+            p[2] = invalid ? nan : z;
+            frame.depth[i] = invalid ? nan : z;
+            frame.confidence[i] = invalid ? nan : unitRandom(seed);
+
+            const unsigned char shade = static_cast<unsigned char>((u ^ v) & 0xFF);
+            frame.texture_rgb[i * 3] = shade;
+            frame.texture_rgb[i * 3 + 1] = static_cast<unsigned char>(shade / 2);
+            frame.texture_rgb[i * 3 + 2] = static_cast<unsigned char>(255 - shade);
+            frame.texture_mono[i] = shade;
+        }
+    }
+    return frame;
+}
+
+struct Resolution {
+    const char* label;
+    int width;
+    int height;
+};
+
+constexpr Resolution kResolutions[] = {
+    {"640x480", 640, 480},
+    {"1280x1024", 1280, 1024},
+    {"2448x2048", 2448, 2048},
+};
+
+constexpr double kNanRatios[] = {0.0, 0.3};
+
+std::vector<int> threadCounts() {
+    std::vector<int> counts = {1, 2, 4};
+    const int hw = static_cast<int>(std::thread::hardware_concurrency());
+    if (hw > 0) {
+        counts.push_back(hw);
+    }
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+    return counts;
+}
+
+std::string caseName(const char* group, const Resolution& res, double nanRatio, int threads) {
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "%s/%s/nan:%.2f/threads:%d", group, res.label, nanRatio, threads);
+    return buf;
+}
+
+// 가장 최근 조합 하나만 보관합니다(5MP 프레임은 수백 MB).
+// 케이스가 해상도/NaN 비율 순서로 등록되므로 재생성은 조합이 바뀔 때만 일어납니다.
+const SyntheticFrame& cachedFrame(const Resolution& res, double nanRatio) {
+    static std::unique_ptr<SyntheticFrame> frame;
+    static double frameNanRatio = -1.0;
+    if (!frame || frame->size != gv::GvSize(res.width, res.height) || frameNanRatio != nanRatio) {
+        frame.reset();
+        frame.reset(new SyntheticFrame(makeSyntheticFrame(res.width, res.height, nanRatio)));
+        frameNanRatio = nanRatio;
+    }
+    return *frame;
+}
+
+// -----------------------------------------------------------------------------
+// 후처리 필터 (GvPointMapFilter.h)
+// -----------------------------------------------------------------------------
+
+template <typename Filter>
+void benchFilter(BenchState& state, const Resolution& res, double nanRatio, Filter&& filter) {
+    const SyntheticFrame& frame = cachedFrame(res, nanRatio);
+    std::vector<double> work(frame.points.size());
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        std::memcpy(work.data(), frame.points.data(), work.size() * sizeof(double));
+        state.ResumeTiming();
+        filter(work.data(), frame);
+    }
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(frame.size.width) * frame.size.height);
+    state.SetBytesProcessed(state.Iterations() * work.size() * sizeof(double));
+}
+
+void registerFilterBenchmarks() {
+    for (const Resolution& res : kResolutions) {
+        for (double nanRatio : kNanRatios) {
+            for (int threads : threadCounts()) {
+                registerBench(caseName("filter/TruncateZ", res, nanRatio, threads), [=](BenchState& state) {
+                    benchFilter(state, res, nanRatio, [&](double* pts, const SyntheticFrame& f) {
+                        gv::GvTruncateZ(pts, f.size, 0.85, 0.95, threads);
+                    });
+                });
+                registerBench(caseName("filter/Confidence", res, nanRatio, threads), [=](BenchState& state) {
+                    benchFilter(state, res, nanRatio, [&](double* pts, const SyntheticFrame& f) {
+                        gv::GvConfidenceFilter(pts, f.confidence.data(), f.size, 0.2, threads);
+                    });
+                });
+                registerBench(caseName("filter/RadiusOutlier", res, nanRatio, threads), [=](BenchState& state) {
+                    benchFilter(state, res, nanRatio, [&](double* pts, const SyntheticFrame& f) {
+                        gv::GvRadiusOutlierFilter(pts, f.size, 0.003, 8, 3, threads);
+                    });
+                });
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Processing 라이브러리 (GvReconstruction.h, GvPointCloudIO.h)
+// -----------------------------------------------------------------------------
+
+constexpr const char* kBenchProcessingSavePath = "gvsdk_bench_processing_tmp.ply";
+constexpr const char* kBenchImageSavePath = "gvsdk_bench_image_tmp";
+constexpr int kBenchImageStack = 8;
+constexpr const char* kBenchArchivePath = "gvsdk_bench_tmp.gvar";
+constexpr const char* kBenchSequencePath = "gvsdk_bench_tmp.gvsq";
+constexpr int kBenchSequenceFrames = 8;
+constexpr const char* kBenchSessionPath = "gvsdk_bench_session_tmp.gvsq";
+constexpr int kBenchSessionCaptures = 4;
+constexpr const char* kBenchSharedRingName = "gvsdk_bench";
+
+gv::GvStructuredLightModel benchModel(const Resolution& res) {
+    gv::GvStructuredLightModel model;
+    model.camera_resolution = gv::GvSize(res.width, res.height);
+    model.camera_fx = model.camera_fy = res.width * 1.2;
+    model.camera_cx = (res.width - 1) * 0.5;
+    model.camera_cy = (res.height - 1) * 0.5;
+    model.projector_width = 1280;
+    model.projector_fx = 1280 * 1.2;
+    model.projector_cx = 639.5;
+    model.baseline = 0.12;
+    model.phase_period = 32;
+    model.phase_steps = 4;
+    model.gray_bits = gv::GvStructuredLightGrayBits(model.projector_width, model.phase_period);
+    return model;
+}
+
+// 광축 0.9m 거리의 정면 평면을 본 패턴 스택(Normal 모드)을 만듭니다.
+std::vector<gv::GvImageBuffer> makePatternStack(const gv::GvStructuredLightModel& model) {
+    const int count = gv::GvStructuredLightPatternCount(model);
+    const gv::GvSize size = model.camera_resolution;
+    std::vector<gv::GvImageBuffer> stack(static_cast<size_t>(count));
+    for (gv::GvImageBuffer& img : stack) {
+        img = gv::GvImageBuffer::Create(gv::GvImageType::Mono8, size);
+    }
+    std::vector<double> pattern(static_cast<size_t>(count));
+    const double z = 0.9;
+    for (int v = 0; v < size.height; ++v) {
+        for (int u = 0; u < size.width; ++u) {
+            const double x = (u - model.camera_cx) / model.camera_fx * z;
+            const double column = model.projector_fx * (x - model.baseline) / z + model.projector_cx;
+            gv::GvStructuredLightEncodeColumn(model, column, pattern.data());
+            const size_t i = static_cast<size_t>(v) * static_cast<size_t>(size.width) + static_cast<size_t>(u);
+            for (int p = 0; p < count; ++p) {
+                stack[static_cast<size_t>(p)].GetDataPtr()[i] =
+                    static_cast<unsigned char>(20.0 + 200.0 * pattern[static_cast<size_t>(p)]);
+            }
+        }
+    }
+    return stack;
+}
+
+void benchSavePointCloud(BenchState& state, const Resolution& res, double nanRatio,
+                         gv::GvPointCloudFormat::Enum format, int threads) {
+    const SyntheticFrame& frame = cachedFrame(res, nanRatio);
+    gv::GvPointCloudWriteOptions opts;
+    opts.format = format;
+    opts.unit = gv::GvPointMapUnit::Millimeter;
+    opts.threads = threads;
+    uint64_t fileBytes = 0;
+    while (state.KeepRunning()) {
+        if (!gv::GvSavePointCloud(kBenchProcessingSavePath, frame.points.data(), frame.size, frame.texture_rgb.data(),
+                                  gv::GvImageType::RGB8, opts)) {
+            state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+            break;
+        }
+        state.PauseTiming();
+        if (fileBytes == 0) {
+            FILE* fp = std::fopen(kBenchProcessingSavePath, "rb");
+            if (fp != nullptr) {
+                std::fseek(fp, 0, SEEK_END);
+                fileBytes = static_cast<uint64_t>(std::ftell(fp));
+                std::fclose(fp);
+            }
+        }
+        state.ResumeTiming();
+    }
+    std::remove(kBenchProcessingSavePath);
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(res.width) * res.height);
+    state.SetBytesProcessed(state.Iterations() * fileBytes);
+}
+
+// 텍스처 1장을 이미지 파일로 저장합니다. 처리량은 원본 픽셀 bytes 기준입니다.
+void benchSaveImage(BenchState& state, const Resolution& res, gv::GvImageType::Enum type,
+                    const gv::GvImageWriteOptions& opts) {
+    const SyntheticFrame& frame = cachedFrame(res, 0.0);
+    const std::vector<unsigned char>& pixels = type == gv::GvImageType::Mono8 ? frame.texture_mono : frame.texture_rgb;
+    while (state.KeepRunning()) {
+        if (!gv::GvSaveImageFile(kBenchImageSavePath, pixels.data(), type, frame.size, opts)) {
+            state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+            break;
+        }
+    }
+    std::remove(kBenchImageSavePath);
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(res.width) * res.height);
+    state.SetBytesProcessed(state.Iterations() * pixels.size());
+}
+
+std::string benchImageStackPath(int index, const char* ext) {
+    return "gvsdk_bench_stack_tmp" + std::to_string(index) + ext;
+}
+
+// Mono8 패턴 묶음(8장)을 읽습니다. mapped: 비압축 PGM을 매핑하고 페이지마다 1 byte 접근,
+// 그 외: `GvImageBatchLoader`로 버퍼에 디코딩(버퍼는 반복 간 재사용).
+void benchImageLoad(BenchState& state, const Resolution& res, const char* ext, bool mapped, int threads) {
+    const SyntheticFrame& frame = cachedFrame(res, 0.0);
+    gv::GvImageWriteOptions writeOpts;
+    writeOpts.png_profile = gv::GvPngProfile::Fast;
+    std::vector<std::string> files;
+    bool ok = true;
+    for (int i = 0; ok && i < kBenchImageStack; ++i) {
+        files.push_back(benchImageStackPath(i, ext));
+        ok = gv::GvSaveImageFile(files.back().c_str(), frame.texture_mono.data(), gv::GvImageType::Mono8, frame.size,
+                                 writeOpts);
+    }
+    gv::GvImageBatchLoader loader;
+    gv::GvImageBatchLoadOptions loadOpts;
+    loadOpts.threads = threads;
+    // 페이지 읽기가 최적화로 사라지지 않도록 volatile에 누적합니다.
+    volatile uint64_t checksum = 0;
+    while (ok && state.KeepRunning()) {
+        if (mapped) {
+            for (const std::string& file : files) {
+                gv::GvMappedImage image;
+                ok = image.Open(file.c_str()) && ok;
+                const unsigned char* pixels = image.GetDataConstPtr();
+                for (size_t i = 0; ok && i < image.GetBytes(); i += 4096) {
+                    checksum = checksum + pixels[i];
+                }
+            }
+        } else {
+            ok = loader.Load(files, loadOpts);
+        }
+    }
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    }
+    for (const std::string& file : files) {
+        std::remove(file.c_str());
+    }
+    state.SetItemsProcessed(state.Iterations() * kBenchImageStack * static_cast<uint64_t>(res.width) * res.height);
+    state.SetBytesProcessed(state.Iterations() * kBenchImageStack * frame.texture_mono.size());
+}
+
+// 포인트맵 + RGB 텍스처 1프레임을 압축 보관 파일로 쓰고(write) 다시 읽습니다(read).
+void benchArchive(BenchState& state, const Resolution& res, double nanRatio, int threads, bool read) {
+    const SyntheticFrame& frame = cachedFrame(res, nanRatio);
+    gv::GvArchiveOptions opts;
+    opts.threads = threads;
+    const auto writeArchive = [&]() {
+        gv::GvArchiveWriter writer;
+        return writer.Open(kBenchArchivePath, opts) && writer.AddPointMap("points", frame.points.data(), frame.size) &&
+               writer.AddImage("texture", frame.texture_rgb.data(), gv::GvImageType::RGB8, frame.size) &&
+               writer.Close();
+    };
+    if (read && !writeArchive()) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+        return;
+    }
+    gv::GvPointMapBuffer points;
+    gv::GvImageBuffer texture;
+    while (state.KeepRunning()) {
+        bool ok = false;
+        if (read) {
+            gv::GvArchiveReader reader;
+            ok = reader.Open(kBenchArchivePath, threads) && reader.ReadPointMap(0, points) &&
+                 reader.ReadImage(1, texture);
+        } else {
+            ok = writeArchive();
+        }
+        if (!ok) {
+            state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+            break;
+        }
+    }
+    std::remove(kBenchArchivePath);
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(res.width) * res.height);
+    state.SetBytesProcessed(state.Iterations() * (frame.points.size() * sizeof(double) + frame.texture_rgb.size()));
+}
+
+// 포인트맵 + RGB 텍스처 프레임을 시퀀스 파일에 추가하고(write), 매핑된 파일에서 임의 프레임을 찾아
+// 데이터 전체를 읽습니다(read, 페이지마다 1 byte).
+void benchSequence(BenchState& state, const Resolution& res, bool read) {
+    const SyntheticFrame& frame = cachedFrame(res, 0.0);
+    const gv::GvSequencePayload payloads[2] = {
+        gv::GvSequencePayload::FromPointMap(frame.points.data(), frame.size),
+        gv::GvSequencePayload::FromImage(frame.texture_rgb.data(), gv::GvImageType::RGB8, frame.size)};
+    gv::GvSequenceWriter writer;
+    bool ok = writer.Open(kBenchSequencePath);
+    for (int f = 0; ok && read && f < kBenchSequenceFrames; ++f) {
+        gv::GvSequenceFrameInfo info;
+        info.frame_id = static_cast<uint64_t>(f);
+        ok = writer.AppendFrame(info, payloads, 2);
+    }
+    gv::GvSequenceReader reader;
+    if (read) {
+        ok = writer.Close() && reader.Open(kBenchSequencePath) && ok;
+    }
+    uint64_t frameIndex = 0;
+    // 페이지 읽기가 최적화로 사라지지 않도록 volatile에 누적합니다.
+    volatile uint64_t checksum = 0;
+    while (ok && state.KeepRunning()) {
+        if (read) {
+            const int f = static_cast<int>((frameIndex++ * 5) % kBenchSequenceFrames);
+            gv::GvSequencePayload points;
+            gv::GvSequencePayload texture;
+            ok = reader.FindPayload(f, gv::GvSequencePayloadType::PointMap, points) &&
+                 reader.FindPayload(f, gv::GvSequencePayloadType::Image, texture);
+            for (const gv::GvSequencePayload* p : {&points, &texture}) {
+                const unsigned char* bytes = static_cast<const unsigned char*>(p->data);
+                for (uint64_t i = 0; ok && i < p->bytes; i += 4096) {
+                    checksum = checksum + bytes[i];
+                }
+            }
+        } else {
+            gv::GvSequenceFrameInfo info;
+            info.frame_id = frameIndex++;
+            ok = writer.AppendFrame(info, payloads, 2);
+        }
+    }
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    }
+    reader.Close();
+    writer.Close();
+    std::remove(kBenchSequencePath);
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(res.width) * res.height);
+    state.SetBytesProcessed(state.Iterations() * (frame.points.size() * sizeof(double) + frame.texture_rgb.size()));
+}
+
+// benchModel()과 같은 설정의 가상 장치(Normal 모드).
+gv::GvVirtualDeviceConfig benchVirtualConfig(const Resolution& res, int threads) {
+    gv::GvVirtualDeviceConfig config;
+    config.resolution = gv::GvSize(res.width, res.height);
+    config.worker_threads = threads;
+    return config;
+}
+
+// record: 캡처 루프 쪽 비용(패턴 묶음 복사 + 기록 큐 등록, 큐가 차면 기록 스레드 속도로 제한됨).
+// replay: 기록된 3D 캡처 하나를 최대 속도로 가상 장치에 재생(패턴 복사 + 디코딩 + 필터).
+void benchSession(BenchState& state, const Resolution& res, int threads, bool replay) {
+    const gv::GvStructuredLightModel model = benchModel(res);
+    const std::vector<gv::GvImageBuffer> stack = makePatternStack(model);
+    uint64_t stackBytes = 0;
+    for (const gv::GvImageBuffer& img : stack) {
+        stackBytes += img.GetBytes();
+    }
+    gv::GvVirtualSingle camera(benchVirtualConfig(res, threads));
+    gv::GvSingle::GvCaptureOptions opts;
+    opts.capture_mode = gv::CaptureMode_Normal;
+    gv::GvSessionRecordOptions recordOpts;
+    recordOpts.max_inflight_bytes = 4 * stackBytes;
+    gv::GvSessionRecorder recorder;
+    bool ok = camera.Open() && recorder.Open(kBenchSessionPath, gv::GvSessionInfoFromVirtual(camera), recordOpts);
+    for (int i = 0; ok && replay && i < kBenchSessionCaptures; ++i) {
+        ok = recorder.RecordCapture3D(opts, stack, gv::GvImageBuffer());
+    }
+    gv::GvSessionPlayer player;
+    if (replay) {
+        ok = recorder.Close() && ok && player.Open(kBenchSessionPath);
+    }
+    gv::GvSessionReplayOptions replayOpts;
+    replayOpts.speed = gv::GvSessionReplaySpeed::Maximum;
+    replayOpts.event_count = 1;
+    uint64_t eventIndex = 0;
+    while (ok && state.KeepRunning()) {
+        if (replay) {
+            replayOpts.first_event = static_cast<int>(eventIndex++ % kBenchSessionCaptures);
+            ok = gv::GvReplaySession(player, camera, replayOpts);
+        } else {
+            ok = recorder.RecordCapture3D(opts, stack, gv::GvImageBuffer());
+        }
+    }
+    ok = recorder.Close() && ok;
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    }
+    player.Close();
+    std::remove(kBenchSessionPath);
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(res.width) * res.height);
+    state.SetBytesProcessed(state.Iterations() * stackBytes);
+}
+
+// publish: 포인트맵 + RGB 텍스처 프레임을 공유 메모리 슬롯에 복사하는 시간(구독자 없음).
+// latency: 발행 -> 구독 스레드가 감지해 데이터 전체를 훑고(페이지마다 1 byte) 유효성 확인 -> 응답까지 왕복 시간.
+void benchSharedRing(BenchState& state, const Resolution& res, bool latency) {
+    const SyntheticFrame& frame = cachedFrame(res, 0.0);
+    const gv::GvSequencePayload payloads[2] = {
+        gv::GvSequencePayload::FromPointMap(frame.points.data(), frame.size),
+        gv::GvSequencePayload::FromImage(frame.texture_rgb.data(), gv::GvImageType::RGB8, frame.size)};
+    gv::GvSharedRingOptions ringOpts;
+    ringOpts.slot_capacity = gv::GvSharedRingCaptureBytes(frame.size, gv::GvImageType::RGB8);
+    gv::GvSharedRingPublisher publisher;
+    gv::GvSharedRingReader reader;
+    bool ok = publisher.Create(kBenchSharedRingName, ringOpts) && reader.Open(kBenchSharedRingName);
+
+    std::atomic<uint64_t> acked{0};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> readerFailed{false};
+    std::thread subscriber;
+    if (ok && latency) {
+        subscriber = std::thread([&] {
+            uint64_t last = 0;
+            volatile uint64_t checksum = 0;
+            gv::GvSharedRingFrame received;
+            while (!stop.load(std::memory_order_acquire)) {
+                if (!reader.WaitForNext(last, received, 100)) {
+                    continue;
+                }
+                for (int i = 0; i < received.item_count; ++i) {
+                    const unsigned char* bytes = static_cast<const unsigned char*>(received.items[i].data);
+                    for (uint64_t b = 0; b < received.items[i].bytes; b += 4096) {
+                        checksum = checksum + bytes[b];
+                    }
+                }
+                if (!reader.IsValid(received)) {
+                    readerFailed.store(true, std::memory_order_relaxed);
+                }
+                last = received.sequence;
+                acked.store(last, std::memory_order_release);
+            }
+        });
+    }
+    while (ok && state.KeepRunning()) {
+        const uint64_t sequence = publisher.Publish(0, 0, payloads, 2);
+        ok = sequence != 0;
+        while (ok && latency && acked.load(std::memory_order_acquire) < sequence) {
+            std::this_thread::yield();
+        }
+    }
+    stop.store(true, std::memory_order_release);
+    if (subscriber.joinable()) {
+        subscriber.join();
+    }
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    } else if (readerFailed.load()) {
+        state.SkipWithError("subscriber saw an overwritten frame");
+    }
+    reader.Close();
+    publisher.Close();
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(res.width) * res.height);
+    state.SetBytesProcessed(state.Iterations() * (frame.points.size() * sizeof(double) + frame.texture_rgb.size()));
+}
+
+// 벤치용 렌즈 모델(benchModel()과 같은 내부 파라미터 + 배럴 왜곡).
+gv::GvCameraCalibration benchLens(const Resolution& res) {
+    const gv::GvStructuredLightModel model = benchModel(res);
+    gv::GvCameraCalibration lens;
+    const float intrinsic[9] = {static_cast<float>(model.camera_fx), 0.0f, static_cast<float>(model.camera_cx),
+                                0.0f, static_cast<float>(model.camera_fy), static_cast<float>(model.camera_cy),
+                                0.0f, 0.0f, 1.0f};
+    const float distortion[5] = {-0.12f, 0.04f, 0.0005f, -0.0005f, 0.0f};
+    std::memcpy(lens.intrinsic, intrinsic, sizeof(intrinsic));
+    std::memcpy(lens.distortion, distortion, sizeof(distortion));
+    return lens;
+}
+
+// table: 미리 만든 remap 테이블로 RGB 텍스처 보정(정수 bilinear).
+// direct: 소비자 코드처럼 픽셀마다 왜곡 다항식을 계산하고 double bilinear 보간.
+void benchUndistort(BenchState& state, const Resolution& res, int threads, bool table) {
+    const SyntheticFrame& frame = cachedFrame(res, 0.0);
+    const gv::GvCameraCalibration lens = benchLens(res);
+    gv::GvRemapTable remap;
+    bool ok = !table || gv::GvBuildUndistortTable(lens, frame.size, remap);
+    gv::GvImageBuffer dst = gv::GvImageBuffer::Create(gv::GvImageType::RGB8, frame.size);
+    const int width = frame.size.width;
+    const int height = frame.size.height;
+    const int stride = width * 3;
+    while (ok && state.KeepRunning()) {
+        if (table) {
+            ok = remap.Apply(frame.texture_rgb.data(), stride, 3, dst.GetDataPtr(), stride, threads);
+            continue;
+        }
+        const float* K = lens.intrinsic;
+        const float* d = lens.distortion;
+        gv::GvParallelFor(0, static_cast<size_t>(height), threads, [&](size_t r0, size_t r1, int) {
+            for (size_t v = r0; v < r1; ++v) {
+                unsigned char* out = dst.GetDataPtr() + v * static_cast<size_t>(stride);
+                for (int u = 0; u < width; ++u, out += 3) {
+                    const double y = (static_cast<double>(v) - K[5]) / K[4];
+                    const double x = (u - K[2]) / K[0];
+                    const double r2 = x * x + y * y;
+                    const double radial = 1.0 + r2 * (d[0] + r2 * (d[1] + r2 * d[4]));
+                    const double su = K[0] * (x * radial + 2.0 * d[2] * x * y + d[3] * (r2 + 2.0 * x * x)) + K[2];
+                    const double sv = K[4] * (y * radial + d[2] * (r2 + 2.0 * y * y) + 2.0 * d[3] * x * y) + K[5];
+                    if (!(su >= 0.0 && sv >= 0.0 && su < width - 1 && sv < height - 1)) {
+                        out[0] = out[1] = out[2] = 0;
+                        continue;
+                    }
+                    const int ix = static_cast<int>(su);
+                    const int iy = static_cast<int>(sv);
+                    const double fx = su - ix;
+                    const double fy = sv - iy;
+                    const unsigned char* p0 = frame.texture_rgb.data() + static_cast<size_t>(iy) * stride + ix * 3;
+                    const unsigned char* p1 = p0 + stride;
+                    for (int c = 0; c < 3; ++c) {
+                        const double top = p0[c] * (1.0 - fx) + p0[c + 3] * fx;
+                        const double bottom = p1[c] * (1.0 - fx) + p1[c + 3] * fx;
+                        out[c] = static_cast<unsigned char>(top * (1.0 - fy) + bottom * fy + 0.5);
+                    }
+                }
+            }
+        });
+    }
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    }
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(width) * height);
+    state.SetBytesProcessed(state.Iterations() * frame.texture_rgb.size());
+}
+
+// fused: 포인트맵 + BGR8 텍스처 -> XYZRGB(15 bytes, 형식별 행 루프). mapped면 별도 2D 카메라로 투영해 보간.
+// branching: 이전 3D 샘플처럼 픽셀마다 텍스처 형식을 분기하고 채널을 바꿔 기록.
+void benchColorFuse(BenchState& state, const Resolution& res, double nanRatio, int threads, bool fused,
+                    bool mapped) {
+    const SyntheticFrame& frame = cachedFrame(res, nanRatio);
+    const gv::GvCameraCalibration lens = benchLens(res);
+    gv::GvColorFuseOptions opts;
+    opts.threads = threads;
+    opts.texture_camera = mapped ? &lens : nullptr;
+    const gv::GvImageType::Enum textureType = gv::GvImageType::BGR8;
+    std::vector<gv::GvPointXYZRGB> out(static_cast<size_t>(res.width) * res.height);
+    const size_t width = static_cast<size_t>(res.width);
+    bool ok = true;
+    while (ok && state.KeepRunning()) {
+        if (fused) {
+            ok = gv::GvFuseColoredPoints(frame.points.data(), frame.size, frame.texture_rgb.data(), textureType,
+                                         frame.size, 0, out.data(), opts);
+            continue;
+        }
+        gv::GvParallelFor(0, static_cast<size_t>(res.height), threads, [&](size_t r0, size_t r1, int) {
+            for (size_t i = r0 * width; i < r1 * width; ++i) {
+                gv::GvPointXYZRGB& o = out[i];
+                o.x = static_cast<float>(frame.points[i * 3]);
+                o.y = static_cast<float>(frame.points[i * 3 + 1]);
+                o.z = static_cast<float>(frame.points[i * 3 + 2]);
+                const unsigned char* t = frame.texture_rgb.data();
+                if (textureType == gv::GvImageType::Mono8) {
+                    o.r = o.g = o.b = t[i];
+                } else if (textureType == gv::GvImageType::RGB8) {
+                    o.r = t[i * 3];
+                    o.g = t[i * 3 + 1];
+                    o.b = t[i * 3 + 2];
+                } else {
+                    o.r = t[i * 3 + 2];
+                    o.g = t[i * 3 + 1];
+                    o.b = t[i * 3];
+                }
+            }
+        });
+    }
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    }
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(res.width) * res.height);
+    state.SetBytesProcessed(state.Iterations() * out.size() * sizeof(gv::GvPointXYZRGB));
+}
+
+// pooled: 상주 스레드 풀(GvConfigureProcessingThreads)에서 remap 테이블 보정. 아니면 호출마다 스레드 생성.
+void benchThreadPool(BenchState& state, const Resolution& res, int threads, bool pooled) {
+    const SyntheticFrame& frame = cachedFrame(res, 0.0);
+    gv::GvRemapTable remap;
+    bool ok = gv::GvBuildUndistortTable(benchLens(res), frame.size, remap);
+    gv::GvImageBuffer dst = gv::GvImageBuffer::Create(gv::GvImageType::RGB8, frame.size);
+    const int stride = frame.size.width * 3;
+    if (ok && pooled) {
+        gv::GvSystemConfig config;
+        config.worker_threads = std::max(threads - 1, 1);
+        ok = gv::GvConfigureProcessingThreads(config);
+    }
+    while (ok && state.KeepRunning()) {
+        ok = remap.Apply(frame.texture_rgb.data(), stride, 3, dst.GetDataPtr(), stride, threads);
+    }
+    if (pooled) {
+        gv::GvReleaseProcessingThreads();
+    }
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    }
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(frame.size.width) * frame.size.height);
+    state.SetBytesProcessed(state.Iterations() * frame.texture_rgb.size());
+}
+
+// 실시간 콜백 경로에 더해지는 비용: 프레임마다 도착 시각/지터/콜백 시간 기록(원자 카운터만 갱신).
+void benchDispatchRecord(BenchState& state) {
+    gv::GvDispatchJitterCounters counters;
+    uint64_t arrival = gv::GvNowNs();
+    while (state.KeepRunning()) {
+        arrival += 33000000 + (arrival & 0xffff);
+        counters.RecordDispatch(arrival, 1000);
+    }
+    state.SetItemsProcessed(state.Iterations());
+}
+
+// 다중 장치 동시 캡처: 가상 장치마다 전용 작업자(GvDeviceWorker) 1개, 장치 내부 작업 스레드 1개.
+// 반복 1회 = 모든 장치가 한 번씩 캡처. 장치 수에 비례해 captures/s가 늘면 장치 간 공유 병목이 없다는 뜻입니다.
+void benchMultiDevice(BenchState& state, const Resolution& res, int devices, bool capture3d, uint32_t frameTimeUs) {
+    using Worker = gv::GvDeviceWorker<gv::GvVirtualSingle>;
+    gv::GvVirtualDeviceConfig config;
+    config.resolution = gv::GvSize(res.width, res.height);
+    config.worker_threads = 1;
+    config.frame_time_us = frameTimeUs;
+    std::vector<std::unique_ptr<gv::GvVirtualSingle>> cameras;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<Worker*> list;
+    bool ok = true;
+    for (int i = 0; i < devices && ok; ++i) {
+        config.sn = "VIRTUAL-BENCH-" + std::to_string(i);
+        cameras.push_back(std::make_unique<gv::GvVirtualSingle>(config));
+        workers.push_back(std::make_unique<Worker>(*cameras.back()));
+        ok = cameras.back()->Open() && workers.back()->Start();
+        list.push_back(workers.back().get());
+    }
+    gv::GvSingle::GvCaptureOptions opts;
+    opts.capture_mode = gv::CaptureMode_Fast;
+    opts.exposure_time_3d = 40;
+    const Worker::Job job = [opts, capture3d](gv::GvVirtualSingle& camera) {
+        return capture3d ? camera.Capture(opts) : camera.Capture2D(opts);
+    };
+    std::string error = ok ? "" : gv::GvGetLastHelperErrorMessage();
+    while (ok && state.KeepRunning()) {
+        for (const gv::GvDeviceCallResult& result : gv::GvRunOnDevices(list, job)) {
+            if (!result.ok) {
+                ok = false;
+                error = result.error.message;
+            }
+        }
+    }
+    // 작업자를 먼저 멈춘 뒤 장치를 닫습니다.
+    workers.clear();
+    if (!ok) {
+        state.SkipWithError(error);
+    }
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(devices));
+}
+
+// 실시간 콜백에서 프레임마다 하는 자동 노출 측정(ROI 히스토그램 + 추천 갱신). 표본 간격 2.
+void benchAutoExposure(BenchState& state, const Resolution& res, int channels) {
+    const SyntheticFrame& frame = cachedFrame(res, 0.0);
+    gv::GvRealtimeImageFrame rt;
+    rt.data = channels == 1 ? frame.texture_mono.data() : frame.texture_rgb.data();
+    rt.width = frame.size.width;
+    rt.height = frame.size.height;
+    rt.stride_bytes = frame.size.width * channels;
+    rt.channels = channels;
+    rt.is_color = channels == 3;
+    gv::GvAutoExposure autoExposure;
+    autoExposure.SetStreamSettings(50, 1.0f);
+    bool ok = true;
+    while (ok && state.KeepRunning()) {
+        ++rt.frame_id;
+        ok = autoExposure.Update(rt);
+    }
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    }
+    state.SetItemsProcessed(state.Iterations());
+    state.SetBytesProcessed(state.Iterations() * static_cast<uint64_t>(rt.stride_bytes) * rt.height);
+}
+
+// 실시간 콜백에서 하는 화이트 밸런스 측정(ROI 채널별 합 + 추정 갱신). 표본 간격 2.
+void benchWhiteBalance(BenchState& state, const Resolution& res) {
+    const SyntheticFrame& frame = cachedFrame(res, 0.0);
+    gv::GvRealtimeImageFrame rt;
+    rt.data = frame.texture_rgb.data();
+    rt.width = frame.size.width;
+    rt.height = frame.size.height;
+    rt.stride_bytes = frame.size.width * 3;
+    rt.channels = 3;
+    rt.is_color = true;
+    gv::GvWhiteBalanceOptions opts;
+    opts.frame_interval = 1;
+    opts.settle_frames = 0;
+    opts.min_valid_fraction = 0.0;
+    gv::GvWhiteBalance whiteBalance(opts);
+    bool ok = true;
+    while (ok && state.KeepRunning()) {
+        ++rt.frame_id;
+        ok = whiteBalance.Update(rt);
+    }
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    }
+    state.SetItemsProcessed(state.Iterations());
+    state.SetBytesProcessed(state.Iterations() * static_cast<uint64_t>(rt.stride_bytes) * rt.height);
+}
+
+// 캡처 루프 쪽 비용: 프레임을 복사해 저장 큐에 넣는 시간(큐가 차면 작업 스레드 처리 속도로 제한됨).
+void benchAsyncSave(BenchState& state, const Resolution& res, double nanRatio, int threads) {
+    const SyntheticFrame& frame = cachedFrame(res, nanRatio);
+    gv::GvAsyncSaveOptions queueOpts;
+    queueOpts.threads = threads;
+    queueOpts.max_inflight_bytes = 4 * frame.points.size() * sizeof(double);
+    gv::GvAsyncSaveQueue queue;
+    gv::GvPointCloudWriteOptions writeOpts;
+    writeOpts.threads = 1;
+    // 동시에 실행되는 작업이 같은 파일을 쓰지 않도록 작업마다 다른 파일 이름을 씁니다.
+    const auto fileName = [](uint64_t slot) { return "gvsdk_bench_async_tmp" + std::to_string(slot % 8) + ".ply"; };
+    uint64_t slot = 0;
+    bool ok = queue.Start(queueOpts);
+    while (ok && state.KeepRunning()) {
+        gv::GvPointMapBuffer points = gv::GvPointMapBuffer::Create(frame.size);
+        std::memcpy(points.GetPointDataPtr(), frame.points.data(), points.GetBytes());
+        ok = queue.EnqueuePointCloud(fileName(slot++).c_str(), std::move(points), gv::GvImageBuffer(), writeOpts) != 0;
+    }
+    ok = queue.Drain() && ok && queue.GetStats().failed == 0;
+    if (!ok) {
+        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+    }
+    queue.Stop();
+    for (uint64_t i = 0; i < std::min<uint64_t>(slot, 8); ++i) {
+        std::remove(fileName(i).c_str());
+    }
+    state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(res.width) * res.height);
+    state.SetBytesProcessed(state.Iterations() * frame.points.size() * sizeof(double));
+}
+
+void registerProcessingBenchmarks() {
+    // 프레임 크기와 무관하므로 한 번만 등록합니다.
+    registerBench("processing/DispatchRecord/threads:1", [](BenchState& state) { benchDispatchRecord(state); });
+    // threads: 동시에 캡처하는 가상 장치 수(장치마다 스레드 1개). 장치 수만큼 곱해지므로 가장 작은 해상도만 씁니다.
+    // Acquire: 패턴마다 취득 시간을 모사해 CPU가 적어도 장치 간 직렬화 여부가 드러나게 합니다.
+    for (int devices : threadCounts()) {
+        const Resolution& res = kResolutions[0];
+        registerBench(caseName("processing/MultiDeviceCapture3D", res, 0.0, devices), [=](BenchState& state) {
+            benchMultiDevice(state, res, devices, true, 0);
+        });
+        registerBench(caseName("processing/MultiDeviceCapture2D", res, 0.0, devices), [=](BenchState& state) {
+            benchMultiDevice(state, res, devices, false, 0);
+        });
+        registerBench(caseName("processing/MultiDeviceAcquire3D", res, 0.0, devices), [=](BenchState& state) {
+            benchMultiDevice(state, res, devices, true, 20000);
+        });
+    }
+    for (const Resolution& res : kResolutions) {
+        for (int threads : threadCounts()) {
+            registerBench(caseName("processing/Decode", res, 0.0, threads), [=](BenchState& state) {
+                const gv::GvStructuredLightModel model = benchModel(res);
+                const std::vector<gv::GvImageBuffer> stack = makePatternStack(model);
+                gv::GvStructuredLightDecodeOptions opts;
+                opts.threads = threads;
+                gv::GvPointMapBuffer points;
+                gv::GvConfidenceMapBuffer confidence;
+                while (state.KeepRunning()) {
+                    state.PauseTiming();
+                    points = gv::GvPointMapBuffer();
+                    confidence = gv::GvConfidenceMapBuffer();
+                    state.ResumeTiming();
+                    if (!gv::GvDecodeStructuredLight(stack.data(), stack.size(), model, opts, points, confidence)) {
+                        state.SkipWithError(gv::GvGetLastHelperErrorMessage());
+                        break;
+                    }
+                }
+                state.SetItemsProcessed(state.Iterations() * static_cast<uint64_t>(res.width) * res.height);
+                state.SetBytesProcessed(state.Iterations() * stack.size() * stack[0].GetBytes());
+            });
+        }
+        for (int threads : threadCounts()) {
+            struct ImageCase {
+                const char* group;
+                gv::GvImageType::Enum type;
+                gv::GvImageFileFormat::Enum format;
+                gv::GvPngProfile::Enum profile;
+                gv::GvTiffCompression::Enum compression;
+            };
+            static const ImageCase kImageCases[] = {
+                {"processing/SavePngStore/Mono8", gv::GvImageType::Mono8, gv::GvImageFileFormat::Png,
+                 gv::GvPngProfile::Store, gv::GvTiffCompression::None},
+                {"processing/SavePngFast/Mono8", gv::GvImageType::Mono8, gv::GvImageFileFormat::Png,
+                 gv::GvPngProfile::Fast, gv::GvTiffCompression::None},
+                {"processing/SavePngBest/Mono8", gv::GvImageType::Mono8, gv::GvImageFileFormat::Png,
+                 gv::GvPngProfile::Best, gv::GvTiffCompression::None},
+                {"processing/SavePngStore/RGB8", gv::GvImageType::RGB8, gv::GvImageFileFormat::Png,
+                 gv::GvPngProfile::Store, gv::GvTiffCompression::None},
+                {"processing/SavePngFast/RGB8", gv::GvImageType::RGB8, gv::GvImageFileFormat::Png,
+                 gv::GvPngProfile::Fast, gv::GvTiffCompression::None},
+                {"processing/SavePngBest/RGB8", gv::GvImageType::RGB8, gv::GvImageFileFormat::Png,
+                 gv::GvPngProfile::Best, gv::GvTiffCompression::None},
+                {"processing/SaveTiff/RGB8", gv::GvImageType::RGB8, gv::GvImageFileFormat::Tiff,
+                 gv::GvPngProfile::Fast, gv::GvTiffCompression::None},
+                {"processing/SaveTiffPackBits/RGB8", gv::GvImageType::RGB8, gv::GvImageFileFormat::Tiff,
+                 gv::GvPngProfile::Fast, gv::GvTiffCompression::PackBits},
+                {"processing/SavePnm/RGB8", gv::GvImageType::RGB8, gv::GvImageFileFormat::Pnm,
+                 gv::GvPngProfile::Fast, gv::GvTiffCompression::None},
+            };
+            for (const ImageCase& c : kImageCases) {
+                gv::GvImageWriteOptions opts;
+                opts.format = c.format;
+                opts.png_profile = c.profile;
+                opts.tiff_compression = c.compression;
+                opts.threads = threads;
+                registerBench(caseName(c.group, res, 0.0, threads),
+                              [=](BenchState& state) { benchSaveImage(state, res, c.type, opts); });
+            }
+        }
+        registerBench(caseName("processing/ImageStackMapPgm", res, 0.0, 1), [=](BenchState& state) {
+            benchImageLoad(state, res, ".pgm", true, 1);
+        });
+        for (int threads : threadCounts()) {
+            registerBench(caseName("processing/ImageStackLoadPgm", res, 0.0, threads), [=](BenchState& state) {
+                benchImageLoad(state, res, ".pgm", false, threads);
+            });
+            registerBench(caseName("processing/ImageStackLoadPng", res, 0.0, threads), [=](BenchState& state) {
+                benchImageLoad(state, res, ".png", false, threads);
+            });
+        }
+        registerBench(caseName("processing/SequenceWrite", res, 0.0, 1), [=](BenchState& state) {
+            benchSequence(state, res, false);
+        });
+        registerBench(caseName("processing/SequenceRead", res, 0.0, 1), [=](BenchState& state) {
+            benchSequence(state, res, true);
+        });
+        registerBench(caseName("processing/SessionRecord", res, 0.0, 1), [=](BenchState& state) {
+            benchSession(state, res, 1, false);
+        });
+        for (int threads : threadCounts()) {
+            registerBench(caseName("processing/SessionReplay", res, 0.0, threads), [=](BenchState& state) {
+                benchSession(state, res, threads, true);
+            });
+        }
+        registerBench(caseName("processing/SharedRingPublish", res, 0.0, 1), [=](BenchState& state) {
+            benchSharedRing(state, res, false);
+        });
+        registerBench(caseName("processing/SharedRingLatency", res, 0.0, 1), [=](BenchState& state) {
+            benchSharedRing(state, res, true);
+        });
+        for (int threads : threadCounts()) {
+            registerBench(caseName("processing/Undistort", res, 0.0, threads), [=](BenchState& state) {
+                benchUndistort(state, res, threads, true);
+            });
+            registerBench(caseName("processing/UndistortDirect", res, 0.0, threads), [=](BenchState& state) {
+                benchUndistort(state, res, threads, false);
+            });
+        }
+        for (int threads : threadCounts()) {
+            registerBench(caseName("processing/ColorFuse", res, 0.3, threads), [=](BenchState& state) {
+                benchColorFuse(state, res, 0.3, threads, true, false);
+            });
+            registerBench(caseName("processing/ColorFuseBranching", res, 0.3, threads), [=](BenchState& state) {
+                benchColorFuse(state, res, 0.3, threads, false, false);
+            });
+            registerBench(caseName("processing/ColorFuseMapped", res, 0.3, threads), [=](BenchState& state) {
+                benchColorFuse(state, res, 0.3, threads, true, true);
+            });
+        }
+        for (int threads : threadCounts()) {
+            registerBench(caseName("processing/UndistortSpawn", res, 0.0, threads), [=](BenchState& state) {
+                benchThreadPool(state, res, threads, false);
+            });
+            registerBench(caseName("processing/UndistortPooled", res, 0.0, threads), [=](BenchState& state) {
+                benchThreadPool(state, res, threads, true);
+            });
+        }
+        registerBench(caseName("processing/AutoExposure/Mono8", res, 0.0, 1), [=](BenchState& state) {
+            benchAutoExposure(state, res, 1);
+        });
+        registerBench(caseName("processing/AutoExposure/RGB8", res, 0.0, 1), [=](BenchState& state) {
+            benchAutoExposure(state, res, 3);
+        });
+        registerBench(caseName("processing/WhiteBalance/RGB8", res, 0.0, 1), [=](BenchState& state) {
+            benchWhiteBalance(state, res);
+        });
+        for (double nanRatio : kNanRatios) {
+            for (int threads : threadCounts()) {
+                registerBench(caseName("processing/SavePly", res, nanRatio, threads), [=](BenchState& state) {
+                    benchSavePointCloud(state, res, nanRatio, gv::GvPointCloudFormat::Ply, threads);
+                });
+                registerBench(caseName("processing/SavePcd", res, nanRatio, threads), [=](BenchState& state) {
+                    benchSavePointCloud(state, res, nanRatio, gv::GvPointCloudFormat::Pcd, threads);
+                });
+                registerBench(caseName("processing/AsyncSavePly", res, nanRatio, threads), [=](BenchState& state) {
+                    benchAsyncSave(state, res, nanRatio, threads);
+                });
+                registerBench(caseName("processing/ArchiveWrite", res, nanRatio, threads), [=](BenchState& state) {
+                    benchArchive(state, res, nanRatio, threads, false);
+                });
+                registerBench(caseName("processing/ArchiveRead", res, nanRatio, threads), [=](BenchState& state) {
+                    benchArchive(state, res, nanRatio, threads, true);
+                });
+            }
+        }
+    }
+}
+
+#if GVSDK_BENCH_WITH_SDK
+// -----------------------------------------------------------------------------
+// SDK 포인트맵 API (GvCameraSDK.dll)
+// - 합성 버퍼를 GvPointMap::Create(..., data, false)로 감싸 장치 없이 측정합니다.
+// - 해당 API는 스레드 수를 받지 않으므로 threads:1 로만 등록합니다.
+// -----------------------------------------------------------------------------
+
+constexpr const char* kBenchSavePath = "gvsdk_bench_tmp.ply";
+
+void registerSdkBenchmarks() {
+    for (const Resolution& res : kResolutions) {
+        for (double nanRatio : kNanRatios) {
+            registerBench(caseName("sdk/GetPointMapSeperated", res, nanRatio, 1), [=](BenchState& state) {
+                const SyntheticFrame& frame = cachedFrame(res, nanRatio);
+                std::vector<double> points = frame.points;
+                gv::GvPointMap pm = gv::GvPointMap::Create(gv::GvPointMapType::PointsOnly, frame.size, points.data());
+                const size_t count = points.size() / 3;
+                std::vector<double> x(count), y(count), z(count);
+                while (state.KeepRunning()) {
+                    if (!pm.GetPointMapSeperated(x.data(), y.data(), z.data(), 1000.0)) {
+                        state.SkipWithError(gv::GvGetLastErrorMessage());
+                        break;
+                    }
+                }
+                gv::GvPointMap::Destroy(pm, false);
+                state.SetBytesProcessed(state.Iterations() * points.size() * sizeof(double));
+            });
+            registerBench(caseName("sdk/Clone", res, nanRatio, 1), [=](BenchState& state) {
+                const SyntheticFrame& frame = cachedFrame(res, nanRatio);
+                std::vector<double> points = frame.points;
+                gv::GvPointMap pm = gv::GvPointMap::Create(gv::GvPointMapType::PointsOnly, frame.size, points.data());
+                while (state.KeepRunning()) {
+                    gv::GvPointMap copy = pm.Clone();
+                    state.PauseTiming();
+                    gv::GvPointMap::Destroy(copy);
+                    state.ResumeTiming();
+                }
+                gv::GvPointMap::Destroy(pm, false);
+                state.SetBytesProcessed(state.Iterations() * points.size() * sizeof(double));
+            });
+            registerBench(caseName("sdk/Save", res, nanRatio, 1), [=](BenchState& state) {
+                const SyntheticFrame& frame = cachedFrame(res, nanRatio);
+                std::vector<double> points = frame.points;
+                std::vector<unsigned char> rgb = frame.texture_rgb;
+                gv::GvPointMap pm = gv::GvPointMap::Create(gv::GvPointMapType::PointsOnly, frame.size, points.data());
+                gv::GvImage texture = gv::GvImage::Create(gv::GvImageType::RGB8, frame.size, rgb.data());
+                while (state.KeepRunning()) {
+                    if (!pm.Save(kBenchSavePath, gv::GvPointMapUnit::Millimeter, texture)) {
+                        state.SkipWithError(gv::GvGetLastErrorMessage());
+                        break;
+                    }
+                }
+                gv::GvImage::Destroy(texture, false);
+                gv::GvPointMap::Destroy(pm, false);
+                std::remove(kBenchSavePath);
+                state.SetItemsProcessed(state.Iterations() * points.size() / 3);
+            });
+        }
+    }
+}
+#endif
+
+void printUsage() {
+    std::printf("usage: gvsdk_bench [--filter=<substring>] [--min_time=<seconds>] [--list]\n");
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// 포인트 클라우드 후처리 처리량 벤치마크
+// - 장치 없이 합성 포인트맵(해상도 x NaN 비율 x 스레드 수)으로 측정합니다.
+// - 출력: 케이스 이름, 반복 횟수, 1회 평균 시간, 처리량
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv) {
+    std::string filter;
+    double minTime = 0.5;
+    bool listOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0) {
+            filter = arg.substr(9);
+        } else if (arg.rfind("--min_time=", 0) == 0) {
+            minTime = std::atof(arg.c_str() + 11);
+        } else if (arg == "--list") {
+            listOnly = true;
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    registerFilterBenchmarks();
+    registerProcessingBenchmarks();
+#if GVSDK_BENCH_WITH_SDK
+    registerSdkBenchmarks();
+#endif
+
+    if (!listOnly) {
+        std::printf("%-64s %10s %15s %15s\n", "Benchmark", "Iterations", "Time", "Throughput");
+    }
+    for (const BenchCase& bench : registry()) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        if (listOnly) {
+            std::printf("%s\n", bench.name.c_str());
+            continue;
+        }
+        runBench(bench, minTime);
+    }
+    return 0;
+}
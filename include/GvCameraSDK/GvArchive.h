@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * @file GvArchive.h
+ * @brief 포인트맵/depth/confidence/이미지 압축 보관 파일(GvCameraSDK::Processing).
+ * @details 실수 데이터는 설정한 정밀도(`precision`)로 양자화한 뒤 그 정밀도 안에서 무손실로 저장하고,
+ *          이미지는 그대로 무손실 저장한다.
+ *          - 유효(finite) 여부는 run-length 비트마스크로 저장하고 무효 픽셀 값은 저장하지 않는다.
+ *          - 값은 왼쪽/위/왼쪽 위 이웃으로 평면 예측한 잔차를 Rice(Golomb) 부호화한다.
+ *          - 행 묶음(tile)은 서로 독립적으로 부호화되므로 압축/해제가 tile 단위로 병렬 실행된다.
+ *          파일 구조: 파일 헤더 -> 항목들 -> 항목 위치 색인 -> footer. 항목 단위 임의 접근이 가능하다.
+ *          바이트 순서는 little-endian이다.
+ *          읽은 버퍼는 `GvCreateSdkPointMap()`/`GvCreateSdkDepthMap()`/`GvCreateSdkConfidenceMap()`/
+ *          `GvCreateSdkImage()`(GvBuffers.h)로 SDK 객체로 변환할 수 있다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace gv {
+
+struct GvArchiveEntryType {
+    enum Enum {
+        None = 0,
+        PointMap = 1,
+        DepthMap = 2,
+        ConfidenceMap = 3,
+        Image = 4,
+    };
+    static const char* ToString(GvArchiveEntryType::Enum e);
+};
+
+struct GvArchiveOptions {
+    /** @brief 포인트 좌표 양자화 단위(m). 기본 0.01 mm. */
+    double point_precision = 1e-5;
+    /** @brief depth 양자화 단위(m). 기본 0.01 mm. */
+    double depth_precision = 1e-5;
+    /** @brief confidence 양자화 단위. */
+    double confidence_precision = 1e-4;
+    /** @brief tile 하나의 행 수(독립 부호화 단위). */
+    int tile_rows = 64;
+    /** @brief 압축/해제 작업 스레드 수(0이면 하드웨어 동시 실행 수). */
+    int threads = 0;
+};
+
+struct GvArchiveEntryInfo {
+    std::string name;
+    GvArchiveEntryType::Enum type = GvArchiveEntryType::None;
+    GvSize size;
+    /** @brief `Image` 항목의 픽셀 형식. */
+    GvImageType::Enum image_type = GvImageType::None;
+    /** @brief 양자화 단위(`Image`는 1). */
+    double precision = 0.0;
+    /** @brief 원본(비압축) 데이터 크기. */
+    uint64_t raw_bytes = 0;
+    /** @brief 파일 내 항목 크기(헤더 포함). */
+    uint64_t stored_bytes = 0;
+};
+
+/**
+ * @brief 압축 보관 파일 작성기.
+ * @details `Add*()`는 호출 즉시 압축해 파일에 추가한다. 색인은 `Close()`에서 기록되므로
+ *          `Close()`를 호출하지 않은 파일은 읽을 수 없다.
+ */
+class GvArchiveWriter {
+public:
+    GvArchiveWriter() = default;
+    ~GvArchiveWriter();
+    GvArchiveWriter(const GvArchiveWriter&) = delete;
+    GvArchiveWriter& operator=(const GvArchiveWriter&) = delete;
+
+    bool Open(const char* fileName, const GvArchiveOptions& options = GvArchiveOptions());
+    bool IsOpen() const { return m_fp != nullptr; }
+
+    /** @param points `[x0,y0,z0,...]` meter 단위. `GvPointMap::GetPointDataConstPtr()`를 그대로 넘길 수 있다. */
+    bool AddPointMap(const char* name, const double* points, const GvSize& size);
+    bool AddPointMap(const char* name, const GvPointMapBuffer& points);
+    bool AddDepthMap(const char* name, const double* depth, const GvSize& size);
+    bool AddDepthMap(const char* name, const GvDepthMapBuffer& depth);
+    bool AddConfidenceMap(const char* name, const double* confidence, const GvSize& size);
+    bool AddConfidenceMap(const char* name, const GvConfidenceMapBuffer& confidence);
+    /** @param pixels 패딩 없는 Mono8/RGB8/BGR8 데이터. */
+    bool AddImage(const char* name, const unsigned char* pixels, GvImageType::Enum type, const GvSize& size);
+    bool AddImage(const char* name, const GvImageBuffer& image);
+
+    /** @brief 색인과 footer를 기록하고 파일을 닫는다. */
+    bool Close();
+
+private:
+    bool AddEntry(const char* name, GvArchiveEntryType::Enum type, const void* data, const GvSize& size,
+                  GvImageType::Enum imageType, double precision);
+
+    FILE* m_fp = nullptr;
+    GvArchiveOptions m_options;
+    std::vector<uint64_t> m_offsets;
+    uint64_t m_position = 0;
+};
+
+/** @brief 압축 보관 파일 읽기. 읽기 함수는 동시에 호출하지 않아야 한다. */
+class GvArchiveReader {
+public:
+    GvArchiveReader() = default;
+    ~GvArchiveReader();
+    GvArchiveReader(const GvArchiveReader&) = delete;
+    GvArchiveReader& operator=(const GvArchiveReader&) = delete;
+
+    /** @param threads 해제 작업 스레드 수(0이면 하드웨어 동시 실행 수). */
+    bool Open(const char* fileName, int threads = 0);
+    void Close();
+    bool IsOpen() const { return m_fp != nullptr; }
+
+    int GetEntryCount() const { return static_cast<int>(m_entries.size()); }
+    bool GetEntryInfo(int index, GvArchiveEntryInfo& info) const;
+    /** @return 이름이 같은 첫 항목의 인덱스. 없으면 -1. */
+    int FindEntry(const char* name) const;
+
+    bool ReadPointMap(int index, GvPointMapBuffer& points);
+    /** @brief `DepthMap`/`ConfidenceMap` 항목을 읽는다. */
+    bool ReadScalarMap(int index, GvScalarMapBuffer& map);
+    bool ReadImage(int index, GvImageBuffer& image);
+
+private:
+    struct Entry {
+        GvArchiveEntryInfo info;
+        uint32_t channels = 0;
+        uint32_t tile_rows = 0;
+        uint64_t tiles_offset = 0;
+        std::vector<uint64_t> tile_bytes;
+    };
+
+    bool Decode(int index, GvArchiveEntryType::Enum expected, void* out);
+
+    FILE* m_fp = nullptr;
+    int m_threads = 0;
+    std::vector<Entry> m_entries;
+};
+
+}  // namespace gv
@@ -0,0 +1,273 @@
+#pragma once
+
+/**
+ * @file GvAsyncSave.h
+ * @brief 백그라운드 저장 큐(GvCameraSDK::Processing).
+ * @details 저장 작업을 작업 스레드에서 실행해 캡처 루프가 파일 인코딩/쓰기를 기다리지 않게 한다.
+ *          - 대기 중이거나 실행 중인 작업의 데이터 크기 합(in-flight bytes)을 예산 안으로 제한한다.
+ *            예산이 차면 `Enqueue*()`가 자리가 날 때까지 대기하거나(기본) 바로 실패한다.
+ *          - 작업마다 완료 콜백(작업 스레드에서 호출)과 실패 사유를 전달한다.
+ *          - `Drain()`으로 남은 작업을 모두 끝낼 수 있으며, `GvSystemShutdown()` 전에는
+ *            `GvDrainAsyncSaveQueues()`(또는 `GvSystemShutdownAfterSaves()`)로 모든 큐를 비운다.
+ *          SDK 핸들 저장(`GvAsyncSaveImage()` 등)은 호출 시점에 데이터를 복제하므로, 캡처 버퍼가 다음
+ *          캡처에서 덮어써져도 안전하다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvImageIO.h"
+#include "GvPlatform.h"
+#include "GvPointCloudIO.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gv {
+
+struct GvAsyncSaveOptions {
+    /** @brief 작업 스레드 수. */
+    int threads = 2;
+    /**
+     * @brief 대기/실행 중 작업 데이터 크기 합의 상한(bytes). 0이면 제한 없음.
+     * @details 예산보다 큰 작업 하나는 큐가 비어 있을 때 받아들인다.
+     */
+    uint64_t max_inflight_bytes = 512ull * 1024 * 1024;
+    /** @brief true면 예산이 찰 때 `Enqueue*()`가 대기하고, false면 바로 실패한다. */
+    bool block_when_full = true;
+};
+
+struct GvAsyncSaveResult {
+    /** @brief `Enqueue*()`가 반환한 작업 ID. */
+    uint64_t id = 0;
+    std::string file_name;
+    bool ok = false;
+    /** @brief 실패 사유. 성공이면 빈 문자열. */
+    std::string error;
+    uint64_t bytes = 0;
+    /** @brief 등록/시작/완료 시각(`GvNowNs()` 기준). */
+    uint64_t queued_ns = 0;
+    uint64_t start_ns = 0;
+    uint64_t end_ns = 0;
+};
+
+struct GvAsyncSaveStats {
+    uint64_t enqueued = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    /** @brief 예산 초과로 거절된 작업 수(`block_when_full = false`). */
+    uint64_t rejected = 0;
+    uint64_t pending = 0;
+    uint64_t inflight_bytes = 0;
+    uint64_t peak_inflight_bytes = 0;
+    uint64_t written_bytes = 0;
+    /** @brief 예산 때문에 `Enqueue*()`가 대기한 총 시간. */
+    uint64_t blocked_ns = 0;
+};
+
+/**
+ * @brief 작업 완료 콜백. 작업 스레드에서 호출되므로 오래 걸리는 처리는 피한다.
+ * @details 콜백 안에서 같은 큐의 `Drain()`/`Stop()`을 호출하면 자기 작업을 기다리게 되므로 바로 실패한다
+ *          (`GvDrainAsyncSaveQueues()`도 그 큐는 false). 큐 소멸도 콜백 밖에서 한다.
+ */
+using GvAsyncSaveCallback = std::function<void(const GvAsyncSaveResult&)>;
+
+/**
+ * @brief 저장 작업 함수. 성공 시 true를 반환한다.
+ * @details 실패 사유는 `detail::GvSetLastHelperError()`로 남기면 결과의 `error`에 전달된다.
+ */
+using GvAsyncSaveJob = std::function<bool()>;
+
+class GvAsyncSaveQueue {
+public:
+    GvAsyncSaveQueue() = default;
+    /** @brief 남은 작업을 모두 끝내고 작업 스레드를 정리한다. */
+    ~GvAsyncSaveQueue();
+    GvAsyncSaveQueue(const GvAsyncSaveQueue&) = delete;
+    GvAsyncSaveQueue& operator=(const GvAsyncSaveQueue&) = delete;
+
+    bool Start(const GvAsyncSaveOptions& options = GvAsyncSaveOptions());
+    /** @brief 남은 작업을 모두 끝내고 작업 스레드를 정리한다. 완료 콜백에서 호출하면 아무것도 하지 않는다. */
+    void Stop();
+    bool IsRunning() const;
+
+    /**
+     * @brief 저장 작업을 등록한다.
+     * @param bytes 작업이 붙잡고 있는 데이터 크기(예산 계산용).
+     * @return 작업 ID. 실패 시 0(`GvGetLastHelperErrorMessage()`).
+     *         등록에 실패하면 `job`은 실행되지 않고 바로 소멸한다.
+     */
+    uint64_t Enqueue(const char* fileName, uint64_t bytes, GvAsyncSaveJob job,
+                     GvAsyncSaveCallback callback = GvAsyncSaveCallback());
+
+    /** @brief 포인트맵(+텍스처)을 `GvSavePointCloud()`로 저장한다. 버퍼는 큐로 이동된다. */
+    uint64_t EnqueuePointCloud(const char* fileName, GvPointMapBuffer points, GvImageBuffer texture,
+                               const GvPointCloudWriteOptions& options,
+                               GvAsyncSaveCallback callback = GvAsyncSaveCallback());
+
+    /** @brief 이미지를 `GvSaveImageFile()`로 저장한다. 버퍼는 큐로 이동된다. */
+    uint64_t EnqueueImage(const char* fileName, GvImageBuffer image, const GvImageWriteOptions& options,
+                          GvAsyncSaveCallback callback = GvAsyncSaveCallback());
+
+    /**
+     * @brief 등록된 작업이 모두 끝날 때까지 기다린다.
+     * @param timeout_ms 0 이하이면 무기한 대기.
+     * @return 시간 안에 모두 끝났으면 true. 완료 콜백(작업 스레드)에서 호출하면 기다리지 않고 false.
+     */
+    bool Drain(int timeout_ms = 0);
+
+    GvAsyncSaveStats GetStats() const;
+    /** @brief 최근 실패 결과(최대 64개)를 꺼낸다. */
+    std::vector<GvAsyncSaveResult> TakeFailures();
+
+private:
+    struct Task {
+        uint64_t id;
+        std::string file_name;
+        uint64_t bytes;
+        uint64_t queued_ns;
+        GvAsyncSaveJob job;
+        GvAsyncSaveCallback callback;
+    };
+
+    bool OnWorkerThread() const;
+    void WorkerLoop();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workCv;
+    std::condition_variable m_spaceCv;
+    std::condition_variable m_idleCv;
+    std::deque<Task> m_tasks;
+    std::vector<std::thread> m_workers;
+    /** @brief 작업 스레드 ID. `m_mutex`로 보호하며 `Stop()`이 스레드를 모두 기다린 뒤 지운다. */
+    std::vector<std::thread::id> m_workerIds;
+    std::vector<GvAsyncSaveResult> m_failures;
+    GvAsyncSaveOptions m_options;
+    GvAsyncSaveStats m_stats;
+    uint64_t m_nextId = 1;
+    uint64_t m_running = 0;
+    bool m_started = false;
+    bool m_stopping = false;
+};
+
+/**
+ * @brief 실행 중인 모든 저장 큐의 작업이 끝날 때까지 기다린다.
+ * @param timeout_ms 큐 하나당 대기 시간. 0 이하이면 무기한.
+ * @return 모든 큐가 시간 안에 비었으면 true.
+ */
+bool GvDrainAsyncSaveQueues(int timeout_ms = 0);
+
+namespace detail {
+
+/** @brief SDK 핸들 복제본을 작업 수명 동안 보관하고 마지막 참조가 사라질 때 `Destroy()`한다. */
+template <typename T>
+std::shared_ptr<T> GvAsyncSaveHold(const T& handle) {
+    return std::shared_ptr<T>(new T(handle), [](T* p) {
+        T::Destroy(*p);
+        delete p;
+    });
+}
+
+inline bool GvAsyncSaveSdkResult(bool ok) {
+    if (!ok) {
+        const char* message = GvGetLastErrorMessage();
+        GvSetLastHelperError(message != nullptr && message[0] != '\0' ? message : "SDK save failed");
+    }
+    return ok;
+}
+
+}  // namespace detail
+
+/**
+ * @brief `GvImage::SaveImage()`를 백그라운드에서 실행한다.
+ * @details 호출 스레드에서 이미지를 복제(`Clone()`)한 뒤 등록한다.
+ */
+inline uint64_t GvAsyncSaveImage(GvAsyncSaveQueue& queue, const GvImage& image, const char* fileName,
+                                 GvAsyncSaveCallback callback = GvAsyncSaveCallback()) {
+    if (!image.IsValid() || fileName == nullptr) {
+        detail::GvSetLastHelperError("GvAsyncSaveImage: invalid arguments");
+        return 0;
+    }
+    const std::shared_ptr<GvImage> copy = detail::GvAsyncSaveHold(image.Clone());
+    const GvSize size = copy->GetSize();
+    const uint64_t bytes = static_cast<uint64_t>(size.width) * static_cast<uint64_t>(size.height) *
+                           GvImageBufferPixelSize(copy->GetType());
+    const std::string name = fileName;
+    return queue.Enqueue(
+        fileName, bytes, [copy, name]() { return detail::GvAsyncSaveSdkResult(copy->SaveImage(name.c_str())); },
+        std::move(callback));
+}
+
+/**
+ * @brief `GvDepthMap::SaveDepthMap()`을 백그라운드에서 실행한다.
+ * @details 호출 스레드에서 depth 맵을 복사한 뒤 등록한다.
+ */
+inline uint64_t GvAsyncSaveDepthMap(GvAsyncSaveQueue& queue, GvDepthMap depth, const char* fileName, bool is_m,
+                                    GvAsyncSaveCallback callback = GvAsyncSaveCallback()) {
+    if (!depth.IsValid() || fileName == nullptr) {
+        detail::GvSetLastHelperError("GvAsyncSaveDepthMap: invalid arguments");
+        return 0;
+    }
+    const GvSize size = depth.GetSize();
+    const std::shared_ptr<GvDepthMap> copy = detail::GvAsyncSaveHold(GvDepthMap::Create(size));
+    if (!copy->IsValid()) {
+        detail::GvSetLastHelperError("GvAsyncSaveDepthMap: cannot allocate depth map");
+        return 0;
+    }
+    const uint64_t bytes = static_cast<uint64_t>(size.width) * static_cast<uint64_t>(size.height) * sizeof(double);
+    std::memcpy(copy->GetDataPtr(), depth.GetDataConstPtr(), static_cast<size_t>(bytes));
+    const std::string name = fileName;
+    return queue.Enqueue(
+        fileName, bytes,
+        [copy, name, is_m]() { return detail::GvAsyncSaveSdkResult(copy->SaveDepthMap(name.c_str(), is_m)); },
+        std::move(callback));
+}
+
+/**
+ * @brief `GvPointMap::Save()`를 백그라운드에서 실행한다.
+ * @details 호출 스레드에서 포인트맵과 텍스처를 복제(`Clone()`)한 뒤 등록한다. 텍스처가 무효면 색상 없이 저장한다.
+ */
+inline uint64_t GvAsyncSavePointMap(GvAsyncSaveQueue& queue, const GvPointMap& points, const char* fileName,
+                                    GvPointMapUnit::Enum unit, const GvImage& texture,
+                                    GvAsyncSaveCallback callback = GvAsyncSaveCallback()) {
+    if (!points.IsValid() || fileName == nullptr) {
+        detail::GvSetLastHelperError("GvAsyncSavePointMap: invalid arguments");
+        return 0;
+    }
+    const std::shared_ptr<GvPointMap> copy = detail::GvAsyncSaveHold(points.Clone());
+    const std::shared_ptr<GvImage> textureCopy =
+        texture.IsValid() ? detail::GvAsyncSaveHold(texture.Clone()) : std::make_shared<GvImage>();
+    const GvSize size = copy->GetSize();
+    uint64_t bytes = static_cast<uint64_t>(size.width) * static_cast<uint64_t>(size.height) * 3 * sizeof(double);
+    if (textureCopy->IsValid()) {
+        const GvSize textureSize = textureCopy->GetSize();
+        bytes += static_cast<uint64_t>(textureSize.width) * static_cast<uint64_t>(textureSize.height) *
+                 GvImageBufferPixelSize(textureCopy->GetType());
+    }
+    const std::string name = fileName;
+    return queue.Enqueue(
+        fileName, bytes,
+        [copy, textureCopy, name, unit]() {
+            return detail::GvAsyncSaveSdkResult(copy->Save(name.c_str(), unit, *textureCopy));
+        },
+        std::move(callback));
+}
+
+/**
+ * @brief 모든 저장 큐를 비운 뒤 `GvSystemShutdown()`을 호출한다.
+ * @details 큐가 붙잡고 있는 SDK 핸들 복제본은 SDK 종료 전에 해제되어야 하므로 `GvSystemShutdown()` 대신 사용한다.
+ */
+inline void GvSystemShutdownAfterSaves() {
+    GvDrainAsyncSaveQueues();
+    GvSystemShutdown();
+}
+
+}  // namespace gv
@@ -0,0 +1,223 @@
+#pragma once
+
+/**
+ * @file GvAutoExposure.h
+ * @brief 실시간 이미지 스트림 기반 자동 노출/게인 추정(GvCameraSDK::Processing).
+ * @details `GetAutoCaptureSetting()`/`GetAutoHdrCaptureSetting()`은 호출할 때마다 자체 캡처를 하므로 조명이 바뀔 때마다
+ *          수백 ms~수 초가 걸린다. `GvAutoExposure`는 이미 흐르고 있는 실시간 프레임(`GvRealtimeImageFrame`)으로
+ *          ROI 밝기 히스토그램을 계속 갱신하고 추천 노출/게인을 유지하므로, 조회(`GetSuggestion()`)는 복사 한 번이다.
+ *          - 히스토그램은 표본 간격(`sample_step`)만큼 건너뛰며 만들고, 부분 히스토그램 4개에 번갈아 누적해
+ *            같은 칸을 연속으로 갱신할 때의 저장-적재 의존을 줄인다(분기 없음). 1280x1024 Mono8, 간격 2 기준 수백 us 이내.
+ *          - 밝기 모델은 "픽셀 값 ∝ 노출 시간 x 게인"이다. 스트림이 실제로 쓰는 노출/게인(`SetStreamSettings()`)을 기준으로
+ *            목표 평균 밝기와 포화 비율 한도를 함께 만족하는 배율을 구하고, 로그 영역에서 지수 평활한다.
+ *          - 노출 시간을 먼저 늘리고, 최대 노출에서 부족한 만큼만 게인을 올린다.
+ *          - HDR 추천은 어두운 백분위가 목표 밝기에, 밝은 백분위가 포화 직전에 오도록 양끝 배율을 정하고
+ *            그 비율에 따라 1~3단계를 등비로 나눈다(짧은 노출부터).
+ *          - 3D 캡처는 프로젝터 조명이 더해지므로 `exposure_3d_ratio`로 2D 추천을 환산한다. 장치/작업물마다 한 번
+ *            `GetAutoCaptureSetting()` 결과와 비교해 정해 둔다.
+ *          추천값 적용은 `GvApplyExposureSuggestion()`(GvSingle/GvStereo의 `GvCaptureOptions`), 범위는
+ *          `GvLoadExposureLimits()`로 장치에서 읽는다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace gv {
+
+struct GvAutoExposureOptions {
+    /** @brief 측정 영역(프레임 좌표). 크기가 0이면 프레임 전체. 프레임을 벗어난 부분은 잘라 낸다. */
+    GvROI roi;
+    /** @brief 측정할 측면. `CameraID_Both`면 모든 측면의 프레임을 같은 추정기에 넣는다. */
+    GvCameraID camera_id = CameraID_Left;
+    /** @brief 행/열 표본 간격(1이면 모든 픽셀). */
+    int sample_step = 2;
+    /** @brief N번째 프레임마다 측정한다(1이면 매 프레임). */
+    int frame_interval = 1;
+
+    /** @brief 목표 평균 밝기(0~255)와 포화로 볼 값. */
+    double target_level = 110.0;
+    int saturation_level = 250;
+    /** @brief ROI에서 허용할 포화 픽셀 비율. 넘으면 평균 목표보다 포화 억제를 우선한다. */
+    double max_saturated_fraction = 0.01;
+    /** @brief 새 측정의 가중치(0~1, 1이면 평활 없음). 로그 영역에서 적용한다. */
+    double smoothing = 0.3;
+    /** @brief 측정 한 번에 바꿀 수 있는 최대 배율(위/아래). 포화 구간은 실제 밝기를 알 수 없어 이 값으로 줄인다. */
+    double max_step_ratio = 4.0;
+
+    /** @brief 추천 범위. `GvLoadExposureLimits()`로 장치 범위를 채울 수 있다. */
+    int min_exposure = 1;
+    int max_exposure = 1000;
+    float min_gain = 1.0f;
+    float max_gain = 16.0f;
+
+    /** @brief 3D 추천 노출 = 2D 추천 노출(노출 x 게인) x 이 값. */
+    double exposure_3d_ratio = 1.0;
+    /** @brief HDR 양끝 기준 백분위(0~1). 어두운 쪽은 목표 밝기, 밝은 쪽은 포화 직전(`saturation_level`의 90%)에 맞춘다. */
+    double hdr_dark_percentile = 0.05;
+    double hdr_bright_percentile = 0.995;
+    /** @brief 추천 HDR 단계 수 상한(1~3). */
+    int max_hdr_levels = 3;
+};
+
+/** @brief ROI 밝기 히스토그램. 컬러 프레임은 휘도 근사 (R + 2G + B) / 4, 포화는 최대 채널 기준. */
+struct GvExposureHistogram {
+    uint32_t bins[256] = {};
+    uint64_t total = 0;
+    /** @brief 어느 채널이든 `saturation_level` 이상인 표본 수. */
+    uint64_t saturated = 0;
+};
+
+/**
+ * @brief 실시간 프레임의 ROI 히스토그램을 만든다(Mono8, 3/4채널 8비트).
+ * @return 형식이 맞지 않거나 ROI가 비면 false.
+ */
+bool GvComputeExposureHistogram(const GvRealtimeImageFrame& frame, const GvROI& roi, int sample_step,
+                                int saturation_level, GvExposureHistogram& histogram);
+
+struct GvExposureSuggestion {
+    /** @brief 한 번 이상 측정했는지. false면 나머지 값은 의미가 없다. */
+    bool valid = false;
+    /** @brief 마지막 측정의 보정 배율이 10% 이내(현재 스트림 설정이 이미 목표에 가깝다). */
+    bool converged = false;
+
+    /** @brief 2D(스트림 기준) 추천 노출/게인. */
+    int exposure_time_2d = 0;
+    float gain_2d = 1.0f;
+    /** @brief 3D 추천 노출/게인(`exposure_3d_ratio` 적용). */
+    int exposure_time_3d = 0;
+    float gain_3d = 1.0f;
+
+    /** @brief HDR 추천(짧은 노출부터, `exposure_3d_ratio` 적용). */
+    int hdr_levels = 0;
+    int hdr_exposure_time[3] = {0, 0, 0};
+    float hdr_gain[3] = {1.0f, 1.0f, 1.0f};
+
+    /** @brief 마지막 측정: 평균 밝기, 포화 비율, HDR 기준 백분위 값, 보정 배율. */
+    double mean_level = 0.0;
+    double saturated_fraction = 0.0;
+    double dark_level = 0.0;
+    double bright_level = 0.0;
+    double correction = 1.0;
+
+    uint64_t frame_id = 0;
+    uint64_t measured_frames = 0;
+    /** @brief 마지막 측정 시각(`GvNowNs()`)과 측정에 걸린 시간. */
+    uint64_t updated_ns = 0;
+    uint64_t measure_ns = 0;
+};
+
+/**
+ * @brief 실시간 프레임으로 노출/게인 추천을 계속 갱신하는 추정기.
+ * @details `Update()`는 실시간 콜백 스레드에서, `GetSuggestion()`/`SetStreamSettings()`/`SetOptions()`는 어느 스레드에서나
+ *          호출할 수 있다. 히스토그램 계산은 잠금 밖(스택 버퍼)에서 하고, 잠금은 결과 반영/복사에만 쓴다.
+ */
+class GvAutoExposure {
+public:
+    explicit GvAutoExposure(const GvAutoExposureOptions& options = GvAutoExposureOptions());
+    GvAutoExposure(const GvAutoExposure&) = delete;
+    GvAutoExposure& operator=(const GvAutoExposure&) = delete;
+
+    void SetOptions(const GvAutoExposureOptions& options);
+    GvAutoExposureOptions GetOptions() const;
+
+    /**
+     * @brief 스트림이 현재 쓰는 노출/게인을 알린다. 이후 프레임은 이 설정으로 찍혔다고 보고 추천을 계산한다.
+     * @details 스트림 설정을 추천값으로 바꿨다면 바꾼 직후 호출한다. 평활 상태는 유지한다.
+     */
+    void SetStreamSettings(int exposure_time, float gain);
+
+    /**
+     * @brief 프레임 하나를 측정해 추천을 갱신한다.
+     * @return 이 프레임으로 추천을 갱신했으면 true(측면/프레임 간격으로 건너뛰면 false, 에러 아님).
+     *         형식이 맞지 않으면 false와 함께 보조 API 에러를 남긴다.
+     */
+    bool Update(const GvRealtimeImageFrame& frame);
+
+    /** @brief 현재 추천. 측정 전이면 `valid == false`. */
+    GvExposureSuggestion GetSuggestion() const;
+
+    /** @brief 평활 상태와 추천을 지운다(옵션/스트림 설정은 유지). */
+    void Reset();
+
+    /**
+     * @brief 실시간 훅의 사용자 콜백으로 등록할 수 있는 콜백. `user_data`는 `GvAutoExposure*`.
+     * @details `GvSetHookedRealtimeImageCallback()`(`GvRealtimeHook.h`)으로 등록한다. `GvSetRealtimeImageCallback()`에
+     *          직접 넘기면 공용 훅이 DLL에서 빠져 전송 통계/디스패치/추적 기록이 멈춘다.
+     *          측면마다 사용자 콜백은 하나이므로 같은 측면에서 `GvWhiteBalance` 등과 함께 쓰려면
+     *          사용자 콜백 하나에서 각 `Update()`를 호출한다.
+     */
+    static void RealtimeCallback(const GvRealtimeImageFrame* frame, UserPtr user_data);
+
+private:
+    GvAutoExposureOptions m_options;
+    int m_streamExposure = 50;
+    float m_streamGain = 1.0f;
+    /** @brief 평활한 2D 노출량(노출 x 게인)의 로그. */
+    double m_logExposure = 0.0;
+    double m_logHdrShort = 0.0;
+    double m_logHdrLong = 0.0;
+    GvExposureSuggestion m_suggestion;
+    mutable std::mutex m_mutex;
+    std::atomic<uint64_t> m_frameCounter{0};
+};
+
+/**
+ * @brief 추천값을 캡처 옵션에 적용한다(`GvSingle::GvCaptureOptions`, `GvStereo::GvCaptureOptions`).
+ * @param hdr true면 HDR 필드(`hdr_exposure_times`, `hdr_exposuretime_content`, `hdr_gain_3d`)도 채운다.
+ *            사용 단계의 `hdr_scan_times`가 0이면 1로 둔다.
+ * @return 추천이 아직 없으면 false(옵션은 그대로).
+ */
+template <typename CaptureOptions>
+bool GvApplyExposureSuggestion(const GvExposureSuggestion& suggestion, CaptureOptions& opts, bool hdr = false) {
+    if (!suggestion.valid) {
+        detail::GvSetLastHelperError("GvApplyExposureSuggestion: no measurement yet");
+        return false;
+    }
+    opts.exposure_time_2d = suggestion.exposure_time_2d;
+    opts.gain_2d = suggestion.gain_2d;
+    opts.exposure_time_3d = suggestion.exposure_time_3d;
+    opts.gain_3d = suggestion.gain_3d;
+    if (hdr) {
+        opts.hdr_exposure_times = suggestion.hdr_levels;
+        for (int i = 0; i < 3; ++i) {
+            const bool used = i < suggestion.hdr_levels;
+            opts.hdr_exposuretime_content[i] = used ? suggestion.hdr_exposure_time[i] : 0;
+            opts.hdr_gain_3d[i] = used ? suggestion.hdr_gain[i] : 0.0f;
+            if (used && opts.hdr_scan_times[i] <= 0) {
+                opts.hdr_scan_times[i] = 1;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 장치의 노출/게인 범위(`GetExposureTimeRange()`, `GetGainRange()`)를 옵션에 채운다.
+ * @details `Camera`는 `GvSingle`, `GvStereo`, `GvVirtualSingle` 등. 캐시한 범위가 있으면
+ *          `GvDeviceCalibration::exposure_min` 등을 직접 옮겨도 된다.
+ */
+template <typename Camera>
+bool GvLoadExposureLimits(Camera& camera, GvAutoExposureOptions& options) {
+    int exposureMin = 0;
+    int exposureMax = 0;
+    float gainMin = 0.0f;
+    float gainMax = 0.0f;
+    if (!camera.GetExposureTimeRange(&exposureMin, &exposureMax) || !camera.GetGainRange(&gainMin, &gainMax)) {
+        const char* message = GvGetLastErrorMessage();
+        detail::GvSetLastHelperError(std::string("GvLoadExposureLimits: ") +
+                                     (message != nullptr && message[0] != '\0' ? message : "range query failed"));
+        return false;
+    }
+    options.min_exposure = exposureMin;
+    options.max_exposure = exposureMax;
+    options.min_gain = gainMin;
+    options.max_gain = gainMax;
+    return true;
+}
+
+}  // namespace gv
@@ -0,0 +1,216 @@
+#pragma once
+
+/**
+ * @file GvBandwidth.h
+ * @brief NIC를 공유하는 GigE 장치 간 대역폭 자동 분배(GvCameraSDK::Processing).
+ * @details `SetBandwidth(percent)`를 장치마다 손으로 맞추는 대신, 장치 주소(`GvDeviceInfo::port`)와 로컬 NIC의
+ *          서브넷으로 같은 링크를 쓰는 장치를 묶고, 캡처 중인 장치의 수요(캡처당 전송량)에 비례해 링크 예산을 나눈다.
+ *          - 링크 예산 = NIC 링크 속도(모르면 `default_link_bps`) x `link_utilization`.
+ *            유휴 장치는 `min_percent`만 남기고 나머지를 캡처 중인 장치에 준다.
+ *          - `BeginCapture()`에서 장치가 유휴 -> 캡처로 바뀌면 캡처 전에 다시 분배한다.
+ *            마지막 캡처 후 `idle_timeout_ms`가 지나면 유휴로 본다.
+ *          - 분배 결과는 장치별 적용 대기 값으로만 기록하고, `SetBandwidth()`는 그 장치의 `BeginCapture()`
+ *            (또는 `ApplyPending()`)를 호출한 스레드에서만 실행한다. 다른 스레드에서 캡처 중인 장치 핸들을
+ *            건드리지 않는다(핸들 하나는 한 스레드, `docs/GvCameraSDK-Concurrency.md`). 그래서 캡처 중인 장치의
+ *            몫은 그 장치의 다음 캡처부터 바뀌며, 장치가 새로 캡처를 시작한 직후 한 캡처 동안은 링크 예산을
+ *            잠시 넘을 수 있다.
+ *          - USB 장치나 NIC를 찾지 못한 GigE 장치는 링크를 공유하지 않는 것으로 보고 `max_percent`를 준다.
+ *          - DLL은 패킷 단위 손실/재전송 수를 공개하지 않으므로 캡처 단위 지표(실패, 재시도,
+ *            할당 대역폭 기준 예상보다 느린 전송)와 측정 처리량으로 분배 결과를 확인한다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gv {
+
+struct GvNetworkInterface {
+    std::string name;
+    /** @brief IPv4 주소/넷마스크(호스트 바이트 순서). */
+    uint32_t ipv4 = 0;
+    uint32_t netmask = 0;
+    /** @brief 링크 속도(bit/s). 0이면 모름. */
+    uint64_t link_speed_bps = 0;
+};
+
+/** @brief 활성 IPv4 인터페이스(루프백 제외)를 나열한다. */
+bool GvListNetworkInterfaces(std::vector<GvNetworkInterface>& interfaces);
+
+/** @brief "a.b.c.d" 또는 "a.b.c.d:port" 형식의 IPv4 주소를 읽는다(호스트 바이트 순서). */
+bool GvParseIpv4(const char* text, uint32_t& address);
+
+/** @brief `address`가 속한 서브넷의 인터페이스 인덱스(가장 긴 넷마스크 우선). 없으면 -1. */
+int GvFindNetworkInterface(const std::vector<GvNetworkInterface>& interfaces, uint32_t address);
+
+struct GvBandwidthOptions {
+    /** @brief 링크 속도 중 카메라 스트림에 나눠 줄 비율(0~1). 나머지는 제어/재전송 여유. */
+    double link_utilization = 0.9;
+    /** @brief `SetBandwidth(100)`에 해당하는 장치 전송 속도(bit/s). */
+    double device_max_bps = 1.0e9;
+    /** @brief NIC 링크 속도를 모를 때 쓰는 값(bit/s). */
+    double default_link_bps = 1.0e9;
+    float min_percent = 5.0f;
+    float max_percent = 100.0f;
+    /** @brief 마지막 캡처 후 이 시간이 지나면 유휴로 본다. */
+    int idle_timeout_ms = 2000;
+    /** @brief 새 값과 적용된 값의 차이가 이보다 작으면 `SetBandwidth()`를 생략한다. */
+    float hysteresis_percent = 2.0f;
+    /** @brief 전송 시간이 할당 대역폭 기준 예상 시간의 이 배수를 넘으면 지연 캡처로 집계한다. */
+    double slow_capture_ratio = 1.5;
+};
+
+/** @brief 장치에 대역폭(%)을 적용한다. 예: `GvSdkBandwidthSetter(camera)`. */
+using GvBandwidthSetter = std::function<bool(float percent)>;
+
+struct GvBandwidthDeviceStats {
+    int id = -1;
+    std::string sn;
+    /** @brief 공유 링크 인덱스(`GetLinkStats()`). -1이면 전용 링크(USB, NIC 미확인). */
+    int link = -1;
+    /** @brief 마지막으로 적용한 값(%). 적용 전이면 0. */
+    float percent = 0.0f;
+    bool active = false;
+    uint64_t captures = 0;
+    uint64_t failed_captures = 0;
+    /** @brief `RecordRetry()` 횟수(실패 후 다시 캡처). */
+    uint64_t retries = 0;
+    /**
+     * @brief 할당 대역폭 기준 예상 전송 시간의 `slow_capture_ratio`배를 넘은 캡처(손실/재전송 추정).
+     * @details `EndCapture()`에 전송 시간을 넘긴 캡처만 판정한다.
+     */
+    uint64_t slow_captures = 0;
+    uint64_t bytes = 0;
+    double last_transfer_ms = 0.0;
+    /** @brief 캡처 전송 처리량 지수 이동 평균(MB/s). */
+    double throughput_mbps = 0.0;
+    /** @brief `SetBandwidth()` 실패 횟수. */
+    uint64_t set_failures = 0;
+};
+
+struct GvBandwidthLinkStats {
+    std::string interface_name;
+    uint32_t ipv4 = 0;
+    /** @brief 분배 기준 링크 속도(bit/s, NIC 값 또는 `default_link_bps`). */
+    double link_bps = 0.0;
+    int devices = 0;
+    int active_devices = 0;
+    /** @brief 캡처 중인 장치 처리량 합(MB/s)과 그 최댓값. */
+    double measured_mbps = 0.0;
+    double peak_mbps = 0.0;
+};
+
+class GvBandwidthAllocator {
+public:
+    GvBandwidthAllocator() = default;
+    GvBandwidthAllocator(const GvBandwidthAllocator&) = delete;
+    GvBandwidthAllocator& operator=(const GvBandwidthAllocator&) = delete;
+
+    /** @brief 로컬 NIC를 나열하고 옵션을 정한다. 장치 추가 전에 호출한다. */
+    bool Initialize(const GvBandwidthOptions& options = GvBandwidthOptions());
+    /** @brief 인터페이스 목록을 직접 지정한다(가상 장치, 고정 구성). */
+    bool Initialize(std::vector<GvNetworkInterface> interfaces, const GvBandwidthOptions& options);
+
+    /**
+     * @brief 장치를 등록한다. 같은 링크의 장치는 `bytes_per_capture`(0이면 1로 취급) 비율로 나눈다.
+     * @return 장치 ID. 실패 시 -1.
+     */
+    int AddDevice(const GvDeviceInfo& info, GvBandwidthSetter setter, uint64_t bytes_per_capture);
+    bool RemoveDevice(int id);
+
+    /**
+     * @brief 캡처 시작. 장치가 유휴였으면 분배를 다시 계산하고, 이 장치의 적용 대기 값을 적용한 뒤 반환한다.
+     * @details 장치 핸들을 쓰는 스레드(캡처 스레드, `GvDeviceWorker` 작업)에서 호출한다.
+     */
+    void BeginCapture(int id);
+    /**
+     * @brief 캡처 종료.
+     * @param transfer_ns 전송 시간. 0이면 `BeginCapture()`(분배 적용 후)부터 지금까지로 처리량만 기록하고
+     *        느린 캡처(`slow_captures`)는 판정하지 않는다.
+     * @param bytes 전송량. 0이면 등록한 `bytes_per_capture`.
+     */
+    void EndCapture(int id, bool ok, uint64_t transfer_ns = 0, uint64_t bytes = 0);
+    void RecordRetry(int id);
+
+    /**
+     * @brief 유휴 판정을 갱신하고 분배를 다시 계산한다. 바뀐 장치는 적용 대기로 표시만 한다(SDK 호출 없음).
+     * @return 항상 true.
+     */
+    bool Rebalance();
+    /**
+     * @brief 이 장치의 적용 대기 값을 `SetBandwidth()`로 적용한다. 장치 핸들을 쓰는 스레드에서 호출한다.
+     * @return 대기 값이 없거나 적용했으면 true. 실패하면 다음 호출에서 다시 시도한다.
+     */
+    bool ApplyPending(int id);
+
+    std::vector<GvBandwidthDeviceStats> GetDeviceStats() const;
+    std::vector<GvBandwidthLinkStats> GetLinkStats() const;
+
+private:
+    struct Device {
+        GvBandwidthDeviceStats stats;
+        GvBandwidthSetter setter;
+        uint64_t bytes_per_capture = 0;
+        bool in_capture = false;
+        uint64_t capture_start_ns = 0;
+        uint64_t last_end_ns = 0;
+        bool applied = false;
+        /** @brief `Rebalance()`가 정했지만 아직 적용하지 않은 값. */
+        bool has_pending = false;
+        float pending_percent = 0.0f;
+    };
+
+    struct Link {
+        GvBandwidthLinkStats stats;
+    };
+
+    bool IsActive(const Device& device, uint64_t now) const;
+    Device* FindDevice(int id);
+    const Device* FindDevice(int id) const;
+
+    mutable std::mutex m_mutex;
+    GvBandwidthOptions m_options;
+    std::vector<GvNetworkInterface> m_interfaces;
+    std::vector<Link> m_links;
+    std::vector<Device> m_devices;
+    int m_nextId = 0;
+};
+
+/** @brief `GvSingle::SetBandwidth()`를 호출하는 설정 함수. 카메라 객체는 할당기보다 오래 살아 있어야 한다. */
+inline GvBandwidthSetter GvSdkBandwidthSetter(GvSingle& camera) {
+    GvSingle* cam = &camera;
+    return [cam](float percent) { return cam->SetBandwidth(percent); };
+}
+
+inline GvBandwidthSetter GvSdkBandwidthSetter(GvStereo& camera) {
+    GvStereo* cam = &camera;
+    return [cam](float percent) { return cam->SetBandwidth(percent); };
+}
+
+/**
+ * @brief 분배를 맞춘 뒤 캡처하고, 실패하면 `max_retries`번까지 다시 캡처한다.
+ * @details 전송 시간은 `Capture()` 전체(노출 + 전송 + 계산)로 기록하므로 처리량은 하한값이고,
+ *          전송 시간만 따로 알 수 없어 느린 캡처(`slow_captures`)는 판정하지 않는다.
+ *          판정하려면 `BeginCapture()`/`EndCapture()`를 직접 호출하고 측정한 전송 시간을 넘긴다.
+ */
+template <typename Camera, typename Options>
+bool GvCaptureWithBandwidth(Camera& camera, GvBandwidthAllocator& allocator, int id, const Options& options,
+                            int max_retries = 1) {
+    bool ok = false;
+    for (int attempt = 0; attempt <= max_retries && !ok; ++attempt) {
+        if (attempt > 0) {
+            allocator.RecordRetry(id);
+        }
+        allocator.BeginCapture(id);
+        ok = camera.Capture(options);
+        allocator.EndCapture(id, ok);
+    }
+    return ok;
+}
+
+}  // namespace gv
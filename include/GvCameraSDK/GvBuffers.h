@@ -0,0 +1,206 @@
+#pragma once
+
+/**
+ * @file GvBuffers.h
+ * @brief 장치/DLL 핸들과 무관한 이미지/포인트맵 버퍼 컨테이너(헤더 전용 보조 API).
+ * @details 데이터 배치는 SDK 핸들과 같다.
+ *          - 이미지: 행 우선, 패딩 없음(`width * GvImageBufferPixelSize(type)` bytes/row)
+ *          - 포인트맵: `[x0,y0,z0,x1,y1,z1,...]`, 단위 `meter`, 무효 포인트는 `(NaN, NaN, NaN)`
+ *          - depth/confidence: 픽셀당 double 1개, 무효 값은 `NaN`
+ */
+
+#include "GvCameraAPI.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace gv {
+
+/**
+ * @brief 이미지 포맷의 픽셀 크기(bytes).
+ * @details `GvImageType::GetPixelSize()`와 같은 값이며 DLL 없이 사용할 수 있다.
+ */
+inline size_t GvImageBufferPixelSize(GvImageType::Enum type) {
+    switch (type) {
+        case GvImageType::Mono8: return 1;
+        case GvImageType::RGB8: return 3;
+        case GvImageType::BGR8: return 3;
+        default: return 0;
+    }
+}
+
+class GvImageBuffer {
+public:
+    GvImageBuffer() = default;
+
+    static GvImageBuffer Create(GvImageType::Enum type, const GvSize size) {
+        GvImageBuffer img;
+        if (size.width > 0 && size.height > 0 && GvImageBufferPixelSize(type) > 0) {
+            img.m_type = type;
+            img.m_size = size;
+            img.m_data.assign(static_cast<size_t>(size.width) * static_cast<size_t>(size.height) *
+                                  GvImageBufferPixelSize(type),
+                              0);
+        }
+        return img;
+    }
+
+    bool IsValid() const { return !m_data.empty(); }
+    GvSize GetSize() const { return m_size; }
+    GvImageType::Enum GetType() const { return m_type; }
+    size_t GetBytes() const { return m_data.size(); }
+    size_t GetStrideBytes() const { return static_cast<size_t>(m_size.width) * GvImageBufferPixelSize(m_type); }
+    unsigned char* GetDataPtr() { return m_data.empty() ? nullptr : m_data.data(); }
+    const unsigned char* GetDataConstPtr() const { return m_data.empty() ? nullptr : m_data.data(); }
+
+private:
+    GvImageType::Enum m_type = GvImageType::None;
+    GvSize m_size;
+    std::vector<unsigned char> m_data;
+};
+
+class GvPointMapBuffer {
+public:
+    GvPointMapBuffer() = default;
+
+    /** @brief 모든 포인트가 무효(NaN)인 버퍼를 만든다. */
+    static GvPointMapBuffer Create(const GvSize size) {
+        GvPointMapBuffer pm;
+        if (size.width > 0 && size.height > 0) {
+            pm.m_size = size;
+            pm.m_points.assign(static_cast<size_t>(size.width) * static_cast<size_t>(size.height) * 3,
+                               std::numeric_limits<double>::quiet_NaN());
+        }
+        return pm;
+    }
+
+    bool IsValid() const { return !m_points.empty(); }
+    GvSize GetSize() const { return m_size; }
+    size_t GetPointCount() const { return m_points.size() / 3; }
+    size_t GetBytes() const { return m_points.size() * sizeof(double); }
+    double* GetPointDataPtr() { return m_points.empty() ? nullptr : m_points.data(); }
+    const double* GetPointDataConstPtr() const { return m_points.empty() ? nullptr : m_points.data(); }
+
+private:
+    GvSize m_size;
+    std::vector<double> m_points;
+};
+
+/** @brief 픽셀당 double 1개를 갖는 맵(depth, confidence) 버퍼. */
+class GvScalarMapBuffer {
+public:
+    GvScalarMapBuffer() = default;
+
+    /** @brief 모든 값이 NaN인 버퍼를 만든다. */
+    static GvScalarMapBuffer Create(const GvSize size) {
+        GvScalarMapBuffer map;
+        if (size.width > 0 && size.height > 0) {
+            map.m_size = size;
+            map.m_data.assign(static_cast<size_t>(size.width) * static_cast<size_t>(size.height),
+                              std::numeric_limits<double>::quiet_NaN());
+        }
+        return map;
+    }
+
+    bool IsValid() const { return !m_data.empty(); }
+    GvSize GetSize() const { return m_size; }
+    size_t GetBytes() const { return m_data.size() * sizeof(double); }
+    double* GetDataPtr() { return m_data.empty() ? nullptr : m_data.data(); }
+    const double* GetDataConstPtr() const { return m_data.empty() ? nullptr : m_data.data(); }
+
+private:
+    GvSize m_size;
+    std::vector<double> m_data;
+};
+
+using GvDepthMapBuffer = GvScalarMapBuffer;
+using GvConfidenceMapBuffer = GvScalarMapBuffer;
+
+inline uint64_t GvGetDataBytes(const GvImageBuffer& img) {
+    return img.GetBytes();
+}
+
+inline uint64_t GvGetDataBytes(const GvPointMapBuffer& pm) {
+    return pm.GetBytes();
+}
+
+inline uint64_t GvGetDataBytes(const GvScalarMapBuffer& map) {
+    return map.GetBytes();
+}
+
+/**
+ * @brief 버퍼 내용을 복사한 SDK 이미지 핸들을 만든다.
+ * @details 반환 핸들은 호출자가 `GvImage::Destroy()`로 해제해야 한다.
+ */
+inline GvImage GvCreateSdkImage(const GvImageBuffer& src) {
+    GvImage img = GvImage::Create(src.GetType(), src.GetSize());
+    if (img.IsValid() && src.IsValid()) {
+        std::memcpy(img.GetDataPtr(), src.GetDataConstPtr(), src.GetBytes());
+    }
+    return img;
+}
+
+/**
+ * @brief 버퍼 내용을 복사한 SDK 포인트맵 핸들을 만든다.
+ * @details 반환 핸들은 호출자가 `GvPointMap::Destroy()`로 해제해야 한다.
+ */
+inline GvPointMap GvCreateSdkPointMap(const GvPointMapBuffer& src) {
+    GvPointMap pm = GvPointMap::Create(GvPointMapType::PointsOnly, src.GetSize());
+    if (pm.IsValid() && src.IsValid()) {
+        std::memcpy(pm.GetPointDataPtr(), src.GetPointDataConstPtr(), src.GetBytes());
+    }
+    return pm;
+}
+
+/**
+ * @brief 버퍼 내용을 복사한 SDK depth 맵 핸들을 만든다.
+ * @details 반환 핸들은 호출자가 `GvDepthMap::Destroy()`로 해제해야 한다.
+ */
+inline GvDepthMap GvCreateSdkDepthMap(const GvDepthMapBuffer& src) {
+    GvDepthMap map = GvDepthMap::Create(src.GetSize());
+    if (map.IsValid() && src.IsValid()) {
+        std::memcpy(map.GetDataPtr(), src.GetDataConstPtr(), src.GetBytes());
+    }
+    return map;
+}
+
+/**
+ * @brief 버퍼 내용을 복사한 SDK confidence 맵 핸들을 만든다.
+ * @details 반환 핸들은 호출자가 `GvConfidenceMap::Destroy()`로 해제해야 한다.
+ */
+inline GvConfidenceMap GvCreateSdkConfidenceMap(const GvConfidenceMapBuffer& src) {
+    GvConfidenceMap map = GvConfidenceMap::Create(src.GetSize());
+    if (map.IsValid() && src.IsValid()) {
+        std::memcpy(map.GetDataPtr(), src.GetDataConstPtr(), src.GetBytes());
+    }
+    return map;
+}
+
+/** @brief SDK 이미지 핸들 내용을 버퍼로 복사한다. */
+inline GvImageBuffer GvCopyToImageBuffer(const GvImage& src) {
+    if (!src.IsValid()) {
+        return GvImageBuffer();
+    }
+    GvImageBuffer img = GvImageBuffer::Create(src.GetType(), src.GetSize());
+    if (img.IsValid()) {
+        std::memcpy(img.GetDataPtr(), src.GetDataConstPtr(), img.GetBytes());
+    }
+    return img;
+}
+
+/** @brief SDK 포인트맵 핸들 내용을 버퍼로 복사한다. */
+inline GvPointMapBuffer GvCopyToPointMapBuffer(const GvPointMap& src) {
+    if (!src.IsValid()) {
+        return GvPointMapBuffer();
+    }
+    GvPointMapBuffer pm = GvPointMapBuffer::Create(src.GetSize());
+    if (pm.IsValid()) {
+        std::memcpy(pm.GetPointDataPtr(), src.GetPointDataConstPtr(), pm.GetBytes());
+    }
+    return pm;
+}
+
+}  // namespace gv
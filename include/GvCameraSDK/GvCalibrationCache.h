@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+ * @file GvCalibrationCache.h
+ * @brief 장치 캘리브레이션/파라미터 디스크 캐시(GvCameraSDK::Processing).
+ * @details `Open()` 뒤 장치에서 읽는 내부/외부 파라미터, 해상도, 노출/게인/감마 범위, ROI 범위,
+ *          장치에 저장된 캡처 옵션(`LoadCaptureOptionParameters()`)을 serial number + 펌웨어 버전별 파일에 저장해,
+ *          같은 장치를 다시 열 때(프로세스 재시작, 전원 재인가 등) 장치에서 다시 읽지 않는다.
+ *          - 파일은 헤더 + 본문(CRC32)으로 구성되며, 키/구조체 크기/CRC가 맞지 않으면 캐시 미스로 처리한다.
+ *          - 저장은 임시 파일에 쓴 뒤 이름을 바꾸므로 쓰는 도중 종료되어도 이전 파일이 깨지지 않는다.
+ *          - `GvOpenWithCalibrationCache()`는 캐시가 맞으면 해상도만 장치와 대조하고,
+ *            `verify_with_device`면 내부 파라미터까지 읽어 캐시의 값과 비교한다.
+ *          캐시 디렉터리는 미리 만들어 두어야 한다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace gv {
+
+struct GvCameraCalibration {
+    /** @brief 3x3 행 우선 내부 파라미터, 왜곡 계수(k1, k2, p1, p2, k3), 4x4 외부 파라미터. */
+    float intrinsic[9] = {};
+    float distortion[5] = {};
+    float extrinsic[16] = {};
+    bool has_extrinsic = false;
+};
+
+struct GvDeviceCalibration {
+    GvSize resolution;
+    /** @brief `GvSingle`은 1, `GvStereo`는 2(0 = Left, 1 = Right). */
+    int camera_count = 0;
+    GvCameraCalibration cameras[2];
+
+    bool has_ranges = false;
+    int exposure_min = 0;
+    int exposure_max = 0;
+    float gain_min = 0.0f;
+    float gain_max = 0.0f;
+    float gamma_min = 0.0f;
+    float gamma_max = 0.0f;
+    bool has_roi_range = false;
+    GvROIRange roi_range;
+
+    /** @brief 장치에 저장된 캡처 옵션(`GvSingle`만). */
+    bool has_capture_options = false;
+    GvSingle::GvCaptureOptions capture_options;
+};
+
+static_assert(std::is_trivially_copyable<GvDeviceCalibration>::value, "calibration cache stores raw bytes");
+
+/** @brief 해상도와 카메라별 내부/외부 파라미터의 CRC32(캘리브레이션 변경 확인용). */
+uint32_t GvDeviceCalibrationHash(const GvDeviceCalibration& calibration);
+
+struct GvCalibrationCacheStatus {
+    enum Enum {
+        /** @brief 캐시에서 읽었다. */
+        Hit = 0,
+        /** @brief 캐시가 없거나 키/CRC가 맞지 않아 장치에서 읽고 저장했다. */
+        Miss = 1,
+        /** @brief 캐시가 장치 값과 달라 장치에서 다시 읽고 저장했다. */
+        Stale = 2,
+    };
+    static const char* ToString(GvCalibrationCacheStatus::Enum e);
+};
+
+class GvCalibrationCache {
+public:
+    GvCalibrationCache() = default;
+    /** @param directory 캐시 파일을 둘 기존 디렉터리. */
+    explicit GvCalibrationCache(std::string directory) : m_directory(std::move(directory)) {}
+
+    const std::string& GetDirectory() const { return m_directory; }
+
+    /** @brief 캐시 파일 경로(`<directory>/<sn>_<firmware>.gvcal`, 파일 이름에 쓸 수 없는 문자는 `_`). */
+    std::string GetPath(const GvDeviceInfo& info) const;
+
+    /** @return 파일이 없거나, 키(sn/펌웨어)나 CRC가 맞지 않으면 false. */
+    bool Load(const GvDeviceInfo& info, GvDeviceCalibration& calibration) const;
+    bool Store(const GvDeviceInfo& info, const GvDeviceCalibration& calibration) const;
+    bool Remove(const GvDeviceInfo& info) const;
+
+private:
+    std::string m_directory;
+};
+
+namespace detail {
+
+inline const char* GvCalibrationCacheSdkError(const char* fallback) {
+    const char* message = GvGetLastErrorMessage();
+    return message != nullptr && message[0] != '\0' ? message : fallback;
+}
+
+inline bool GvReadCameraCalibration(bool intrinsicOk, bool extrinsicOk, GvCameraCalibration& camera) {
+    if (!intrinsicOk) {
+        GvSetLastHelperError(GvCalibrationCacheSdkError("GetIntrinsicParameters failed"));
+        return false;
+    }
+    camera.has_extrinsic = extrinsicOk;
+    if (!extrinsicOk) {
+        std::memset(camera.extrinsic, 0, sizeof(camera.extrinsic));
+    }
+    return true;
+}
+
+template <typename Camera>
+void GvReadDeviceRanges(Camera& camera, GvDeviceCalibration& calibration) {
+    calibration.has_ranges = camera.GetExposureTimeRange(&calibration.exposure_min, &calibration.exposure_max) &&
+                             camera.GetGainRange(&calibration.gain_min, &calibration.gain_max) &&
+                             camera.GetGammaRange(&calibration.gamma_min, &calibration.gamma_max);
+    calibration.has_roi_range = camera.GetRoiRange(calibration.roi_range);
+}
+
+}  // namespace detail
+
+/** @brief 열린 `GvSingle`에서 캘리브레이션/파라미터를 읽는다(캐시 사용 안 함). */
+inline bool GvReadDeviceCalibration(GvSingle& camera, GvDeviceCalibration& calibration) {
+    calibration = GvDeviceCalibration();
+    if (!camera.GetCameraResolution(calibration.resolution)) {
+        detail::GvSetLastHelperError(detail::GvCalibrationCacheSdkError("GetCameraResolution failed"));
+        return false;
+    }
+    GvCameraCalibration& cam = calibration.cameras[0];
+    const bool intrinsicOk = camera.GetIntrinsicParameters(cam.intrinsic, cam.distortion);
+    if (!detail::GvReadCameraCalibration(intrinsicOk, intrinsicOk && camera.GetExtrinsicMatrix(cam.extrinsic), cam)) {
+        return false;
+    }
+    calibration.camera_count = 1;
+    detail::GvReadDeviceRanges(camera, calibration);
+    calibration.has_capture_options = camera.LoadCaptureOptionParameters(calibration.capture_options);
+    return true;
+}
+
+/** @brief 열린 `GvStereo`에서 좌/우 캘리브레이션과 파라미터 범위를 읽는다(캐시 사용 안 함). */
+inline bool GvReadDeviceCalibration(GvStereo& camera, GvDeviceCalibration& calibration) {
+    calibration = GvDeviceCalibration();
+    if (!camera.GetCameraResolution(calibration.resolution)) {
+        detail::GvSetLastHelperError(detail::GvCalibrationCacheSdkError("GetCameraResolution failed"));
+        return false;
+    }
+    const GvCameraID ids[2] = {CameraID_Left, CameraID_Right};
+    for (int i = 0; i < 2; ++i) {
+        GvCameraCalibration& cam = calibration.cameras[i];
+        const bool intrinsicOk = camera.GetIntrinsicParameters(ids[i], cam.intrinsic, cam.distortion);
+        if (!detail::GvReadCameraCalibration(intrinsicOk,
+                                             intrinsicOk && camera.GetExtrinsicMatrix(ids[i], cam.extrinsic), cam)) {
+            return false;
+        }
+    }
+    calibration.camera_count = 2;
+    detail::GvReadDeviceRanges(camera, calibration);
+    return true;
+}
+
+struct GvCalibrationCacheOptions {
+    /** @brief true면 캐시가 맞아도 내부 파라미터를 장치에서 읽어 비교한다(느림, 주기 점검용). */
+    bool verify_with_device = false;
+    /** @brief false면 캐시를 읽기만 하고 미스일 때 저장하지 않는다. */
+    bool store_on_miss = true;
+};
+
+namespace detail {
+
+inline bool GvVerifyCachedIntrinsics(GvSingle& camera, const GvDeviceCalibration& cached) {
+    GvCameraCalibration cam;
+    return camera.GetIntrinsicParameters(cam.intrinsic, cam.distortion) &&
+           std::memcmp(cam.intrinsic, cached.cameras[0].intrinsic, sizeof(cam.intrinsic)) == 0 &&
+           std::memcmp(cam.distortion, cached.cameras[0].distortion, sizeof(cam.distortion)) == 0;
+}
+
+inline bool GvVerifyCachedIntrinsics(GvStereo& camera, const GvDeviceCalibration& cached) {
+    const GvCameraID ids[2] = {CameraID_Left, CameraID_Right};
+    for (int i = 0; i < 2; ++i) {
+        GvCameraCalibration cam;
+        if (!camera.GetIntrinsicParameters(ids[i], cam.intrinsic, cam.distortion) ||
+            std::memcmp(cam.intrinsic, cached.cameras[i].intrinsic, sizeof(cam.intrinsic)) != 0 ||
+            std::memcmp(cam.distortion, cached.cameras[i].distortion, sizeof(cam.distortion)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Camera>
+bool GvOpenWithCalibrationCacheImpl(Camera& camera, const GvDeviceInfo& info, const GvCalibrationCache& cache,
+                                    GvDeviceCalibration& calibration, const GvCalibrationCacheOptions& options,
+                                    GvCalibrationCacheStatus::Enum* status, int cameraCount) {
+    // [1] 장치 열기(SDK 내부 초기화는 캐시로 대신할 수 없다)
+    if (!camera.IsOpen() && !camera.Open()) {
+        GvSetLastHelperError(GvCalibrationCacheSdkError("Open failed"));
+        return false;
+    }
+
+    // [2] 캐시 확인: 키/CRC 일치 + 해상도(빠른 조회) 대조, 필요하면 내부 파라미터 비교
+    GvCalibrationCacheStatus::Enum result = GvCalibrationCacheStatus::Miss;
+    if (cache.Load(info, calibration) && calibration.camera_count == cameraCount) {
+        GvSize resolution;
+        const bool same = camera.GetCameraResolution(resolution) && resolution == calibration.resolution &&
+                          (!options.verify_with_device || GvVerifyCachedIntrinsics(camera, calibration));
+        if (same) {
+            if (status != nullptr) {
+                *status = GvCalibrationCacheStatus::Hit;
+            }
+            return true;
+        }
+        result = GvCalibrationCacheStatus::Stale;
+    }
+
+    // [3] 장치에서 읽고 저장(저장 실패는 열기 실패로 보지 않는다)
+    if (!GvReadDeviceCalibration(camera, calibration)) {
+        return false;
+    }
+    if (options.store_on_miss) {
+        cache.Store(info, calibration);
+    }
+    if (status != nullptr) {
+        *status = result;
+    }
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * @brief 장치를 열고 캘리브레이션/파라미터를 캐시에서 읽는다. 캐시가 없거나 맞지 않으면 장치에서 읽어 저장한다.
+ * @param info `GvSystemGetDeviceInfo()` 또는 `GvDeviceDiscovery`의 장치 정보(sn, firmware_version을 키로 사용).
+ * @param status 결과(Hit/Miss/Stale). nullptr 가능.
+ */
+inline bool GvOpenWithCalibrationCache(GvSingle& camera, const GvDeviceInfo& info, const GvCalibrationCache& cache,
+                                       GvDeviceCalibration& calibration,
+                                       const GvCalibrationCacheOptions& options = GvCalibrationCacheOptions(),
+                                       GvCalibrationCacheStatus::Enum* status = nullptr) {
+    return detail::GvOpenWithCalibrationCacheImpl(camera, info, cache, calibration, options, status, 1);
+}
+
+inline bool GvOpenWithCalibrationCache(GvStereo& camera, const GvDeviceInfo& info, const GvCalibrationCache& cache,
+                                       GvDeviceCalibration& calibration,
+                                       const GvCalibrationCacheOptions& options = GvCalibrationCacheOptions(),
+                                       GvCalibrationCacheStatus::Enum* status = nullptr) {
+    return detail::GvOpenWithCalibrationCacheImpl(camera, info, cache, calibration, options, status, 2);
+}
+
+}  // namespace gv
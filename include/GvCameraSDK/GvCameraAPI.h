@@ -10,7 +10,10 @@
 #include <string>
 #include <vector>
 
-#ifdef GVCAMERA_EXPORTS
+#if !defined(_WIN32)
+// 비 Windows: DLL 함수는 사용할 수 없고 헤더의 형식 정의만 GvCameraSDK::Processing에서 사용한다.
+#define GV_PUBLIC_API
+#elif defined(GVCAMERA_EXPORTS)
 #define GV_PUBLIC_API __declspec(dllexport)
 #else
 #define GV_PUBLIC_API __declspec(dllimport)
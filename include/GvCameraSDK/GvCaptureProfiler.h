@@ -0,0 +1,402 @@
+#pragma once
+
+/**
+ * @file GvCaptureProfiler.h
+ * @brief 3D 캡처 단계별 타이밍 프로파일러(헤더 전용 보조 API).
+ * @details `GvSingle`/`GvStereo`의 수집/계산 콜백 경계를 이용해 캡처 1회를
+ *          단계별(start/end, 스레드 ID, 전송 바이트)로 기록한다.
+ *          비활성 상태에서는 콜백 전달 시 원자 변수 1회 조회만 추가된다.
+ *          `GvTraceStart()`로 추적이 켜져 있으면 단계 구간이 `capture` 분류로 함께 기록된다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvMemoryStats.h"
+#include "GvPlatform.h"
+#include "GvTrace.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace gv {
+
+/**
+ * @brief 캡처 단계 구분.
+ * @details 공개 API 경계에서 관측 가능한 단위로 나눈다.
+ *          노출과 GigE/USB 전송은 `Acquisition`, 디코딩/HDR 합성/노이즈 제거는
+ *          `Processing`에 합산된다.
+ */
+enum GvCaptureStage {
+    /** @brief `Capture()` 호출 ~ 마지막 수집 콜백 진입(노출 + 전송). */
+    CaptureStage_Acquisition = 0,
+    /** @brief 마지막 수집 콜백 종료 ~ 계산 콜백 진입(디코딩, HDR 합성, 필터). */
+    CaptureStage_Processing = 1,
+    /** @brief 사용자 수집 콜백 실행 시간. */
+    CaptureStage_CollectionCallback = 2,
+    /** @brief 사용자 계산 콜백 실행 시간. */
+    CaptureStage_CalculationCallback = 3,
+    /** @brief `GetPointMap()`/`GetImage()` 등 결과 조회. */
+    CaptureStage_Fetch = 4,
+    /** @brief 결과 파일 저장(`ScopeStage()`로 기록). */
+    CaptureStage_Save = 5,
+    /** @brief `Capture()` 호출 전체. */
+    CaptureStage_Total = 6,
+    CaptureStage_Count = 7,
+};
+
+inline const char* GvCaptureStageToString(GvCaptureStage stage) {
+    switch (stage) {
+        case CaptureStage_Acquisition: return "Acquisition";
+        case CaptureStage_Processing: return "Processing";
+        case CaptureStage_CollectionCallback: return "CollectionCallback";
+        case CaptureStage_CalculationCallback: return "CalculationCallback";
+        case CaptureStage_Fetch: return "Fetch";
+        case CaptureStage_Save: return "Save";
+        case CaptureStage_Total: return "Total";
+        default: return "Unknown";
+    }
+}
+
+struct GvCaptureStageRecord {
+    /** @brief 단계 시작 시각(`GvNowNs()` 기준). */
+    uint64_t start_ns = 0;
+    /** @brief 단계 종료 시각(`GvNowNs()` 기준). */
+    uint64_t end_ns = 0;
+    /** @brief 단계를 마지막으로 기록한 OS 스레드 ID. */
+    uint64_t thread_id = 0;
+    /** @brief 단계에서 이동한 데이터 크기(bytes). */
+    uint64_t bytes = 0;
+    /** @brief 단계 기록 횟수. 같은 단계가 여러 번 관측되면 구간을 합친다. */
+    uint32_t count = 0;
+
+    bool IsValid() const { return count > 0 && end_ns >= start_ns; }
+    double DurationMs() const { return IsValid() ? static_cast<double>(end_ns - start_ns) / 1.0e6 : 0.0; }
+};
+
+struct GvCaptureProfile {
+    /** @brief 프로파일러 기준 캡처 일련번호(1부터 시작, 0이면 기록 없음). */
+    uint64_t capture_id = 0;
+    /** @brief `Capture()` 반환값. */
+    bool success = false;
+    GvCaptureStageRecord stages[CaptureStage_Count];
+
+    const GvCaptureStageRecord& Stage(GvCaptureStage stage) const { return stages[stage]; }
+};
+
+inline uint64_t GvGetDataBytes(const GvSingle::GvCollectionCallBackInfo& info) {
+    return GvGetDataBytes(info.image);
+}
+
+inline uint64_t GvGetDataBytes(const GvStereo::GvCollectionCallBackInfo& info) {
+    return GvGetDataBytes(info.image_l) + GvGetDataBytes(info.image_r);
+}
+
+inline uint64_t GvGetDataBytes(const GvSingle::GvCalculationCallBackInfo& info) {
+    return GvGetDataBytes(info.image) + GvGetDataBytes(info.pointmap) +
+           GvGetDataBytes(info.depthmap) + GvGetDataBytes(info.confidencemap);
+}
+
+inline uint64_t GvGetDataBytes(const GvStereo::GvCalculationCallBackInfo& info) {
+    return GvGetDataBytes(info.image_l) + GvGetDataBytes(info.image_r) + GvGetDataBytes(info.pointmap) +
+           GvGetDataBytes(info.depthmap) + GvGetDataBytes(info.confidencemap);
+}
+
+/**
+ * @brief `GvSingle`/`GvStereo` 캡처 프로파일러.
+ * @details `Attach()`가 카메라의 수집/계산 콜백을 프로파일러 콜백으로 교체하므로,
+ *          사용자 콜백은 카메라가 아닌 프로파일러의 `Set*CallBack()`으로 등록해야 한다.
+ *          `Capture()`는 프로파일러를 통해 호출해야 단계가 기록된다.
+ * @tparam Camera `GvSingle` 또는 `GvStereo`.
+ */
+template <typename Camera>
+class GvCaptureProfiler {
+public:
+    using CaptureOptions = typename Camera::GvCaptureOptions;
+    using CollectionInfo = typename Camera::GvCollectionCallBackInfo;
+    using CalculationInfo = typename Camera::GvCalculationCallBackInfo;
+    using ProfiledCalculationCallBackPtr = void (*)(const CalculationInfo&, const CaptureOptions&,
+                                                    const GvCaptureProfile&, UserPtr);
+
+    /** @brief 단계 구간을 소멸 시점에 기록하는 RAII 객체. */
+    class StageScope {
+    public:
+        StageScope(GvCaptureProfiler& profiler, GvCaptureStage stage, uint64_t bytes)
+            : m_profiler(profiler.IsActive() ? &profiler : nullptr),
+              m_stage(stage),
+              m_bytes(bytes),
+              m_start(m_profiler ? GvNowNs() : 0) {}
+        ~StageScope() {
+            if (m_profiler) {
+                m_profiler->RecordStage(m_stage, m_start, GvNowNs(), m_bytes);
+            }
+        }
+        StageScope(const StageScope&) = delete;
+        StageScope& operator=(const StageScope&) = delete;
+
+    private:
+        GvCaptureProfiler* m_profiler;
+        GvCaptureStage m_stage;
+        uint64_t m_bytes;
+        uint64_t m_start;
+    };
+
+    explicit GvCaptureProfiler(Camera& camera) : m_camera(camera) {}
+    ~GvCaptureProfiler() { Detach(); }
+    GvCaptureProfiler(const GvCaptureProfiler&) = delete;
+    GvCaptureProfiler& operator=(const GvCaptureProfiler&) = delete;
+
+    /**
+     * @brief 카메라 콜백을 프로파일러 콜백으로 등록한다.
+     * @return 성공 시 true.
+     */
+    bool Attach() {
+        if (m_attached) {
+            return true;
+        }
+        if (!m_camera.SetCollectionCallBack(&GvCaptureProfiler::OnCollection, this)) {
+            return false;
+        }
+        if (!m_camera.SetCalculationCallBack(&GvCaptureProfiler::OnCalculation, this)) {
+            m_camera.SetCollectionCallBack(nullptr, nullptr);
+            return false;
+        }
+        m_attached = true;
+        return true;
+    }
+
+    /** @brief 카메라 콜백 등록을 해제한다. */
+    void Detach() {
+        if (!m_attached) {
+            return;
+        }
+        m_camera.SetCollectionCallBack(nullptr, nullptr);
+        m_camera.SetCalculationCallBack(nullptr, nullptr);
+        m_attached = false;
+    }
+
+    bool IsAttached() const { return m_attached; }
+
+    /** @brief 프로파일링 활성화 여부를 설정한다. 기본값은 비활성. */
+    void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    /** @brief 프로파일링 또는 구간 추적 중 하나라도 켜져 있으면 true. */
+    bool IsActive() const { return IsEnabled() || GvTraceIsEnabled(); }
+
+    bool SetCollectionCallBack(typename Camera::CollectionCallBackPtr cb, UserPtr ctx) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_collectionCb = cb;
+        m_collectionCtx = ctx;
+        return true;
+    }
+
+    bool SetCalculationCallBack(typename Camera::CalculationCallBackPtr cb, UserPtr ctx) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_calculationCb = cb;
+        m_profiledCalculationCb = nullptr;
+        m_calculationCtx = ctx;
+        return true;
+    }
+
+    /**
+     * @brief 계산 콜백을 진행 중인 캡처 프로파일과 함께 받도록 등록한다.
+     * @details 전달되는 프로파일에는 `Processing` 단계까지 기록되어 있다.
+     */
+    bool SetProfiledCalculationCallBack(ProfiledCalculationCallBackPtr cb, UserPtr ctx) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_calculationCb = nullptr;
+        m_profiledCalculationCb = cb;
+        m_calculationCtx = ctx;
+        return true;
+    }
+
+    bool Capture(const CaptureOptions& opts) {
+        return RunCapture([&]() { return m_camera.Capture(opts); });
+    }
+
+    bool Capture() {
+        return RunCapture([&]() { return m_camera.Capture(); });
+    }
+
+    decltype(auto) GetPointMap() {
+        return Fetch([&]() -> decltype(auto) { return m_camera.GetPointMap(); });
+    }
+
+    decltype(auto) GetDepthMap() {
+        return Fetch([&]() -> decltype(auto) { return m_camera.GetDepthMap(); });
+    }
+
+    decltype(auto) GetConfidenceMap() {
+        return Fetch([&]() -> decltype(auto) { return m_camera.GetConfidenceMap(); });
+    }
+
+    /**
+     * @brief `GvSingle::GetImage()` / `GvStereo::GetImage(cid)`를 전달한다.
+     * @details 반환 형식은 카메라 형식을 따른다(`GvVirtualSingle`은 const 참조).
+     */
+    template <typename... Args>
+    decltype(auto) GetImage(Args&&... args) {
+        return Fetch([&]() -> decltype(auto) { return m_camera.GetImage(std::forward<Args>(args)...); });
+    }
+
+    /**
+     * @brief 임의 단계 구간을 RAII로 기록한다.
+     * @details 예: `auto scope = profiler.ScopeStage(CaptureStage_Save, bytes);`
+     */
+    StageScope ScopeStage(GvCaptureStage stage, uint64_t bytes = 0) { return StageScope(*this, stage, bytes); }
+
+    /**
+     * @brief 단계 구간을 최근 캡처 프로파일에 기록한다.
+     * @details 같은 단계가 이미 있으면 구간을 합치고 바이트를 누적한다.
+     */
+    void RecordStage(GvCaptureStage stage, uint64_t start_ns, uint64_t end_ns, uint64_t bytes) {
+        if (stage < 0 || stage >= CaptureStage_Count) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MergeStage(stage, start_ns, end_ns, bytes);
+    }
+
+    /**
+     * @brief 최근 캡처 프로파일을 조회한다.
+     * @details 캡처 이후 `Fetch`/`Save` 단계 기록도 같은 프로파일에 누적된다.
+     *          기록이 없으면 `capture_id == 0`이다.
+     */
+    GvCaptureProfile GetLastCaptureProfile() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_profile;
+    }
+
+private:
+    void MergeStage(GvCaptureStage stage, uint64_t start_ns, uint64_t end_ns, uint64_t bytes) {
+        GvTraceRecord(GvCaptureStageToString(stage), "capture", start_ns, end_ns, bytes, m_profile.capture_id);
+        GvCaptureStageRecord& rec = m_profile.stages[stage];
+        if (rec.count == 0) {
+            rec.start_ns = start_ns;
+            rec.end_ns = end_ns;
+        } else {
+            rec.start_ns = start_ns < rec.start_ns ? start_ns : rec.start_ns;
+            rec.end_ns = end_ns > rec.end_ns ? end_ns : rec.end_ns;
+        }
+        rec.thread_id = GvCurrentThreadId();
+        rec.bytes += bytes;
+        ++rec.count;
+    }
+
+    template <typename Fn>
+    bool RunCapture(Fn&& fn) {
+        if (!IsActive()) {
+            return fn();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_profile = GvCaptureProfile();
+            m_profile.capture_id = ++m_captureCount;
+            m_captureStartNs = GvNowNs();
+            m_lastCollectionEndNs = 0;
+        }
+        const bool ok = fn();
+        const uint64_t end = GvNowNs();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MergeStage(CaptureStage_Total, m_captureStartNs, end, 0);
+        m_profile.success = ok;
+        m_captureStartNs = 0;
+        return ok;
+    }
+
+    template <typename Fn>
+    auto Fetch(Fn&& fn) -> decltype(fn()) {
+        if (!IsActive()) {
+            return fn();
+        }
+        const uint64_t start = GvNowNs();
+        decltype(fn()) result = fn();
+        RecordStage(CaptureStage_Fetch, start, GvNowNs(), GvGetDataBytes(result));
+        return result;
+    }
+
+    static void OnCollection(const CollectionInfo& info, const CaptureOptions& opts, UserPtr ctx) {
+        static_cast<GvCaptureProfiler*>(ctx)->HandleCollection(info, opts);
+    }
+
+    static void OnCalculation(const CalculationInfo& info, const CaptureOptions& opts, UserPtr ctx) {
+        static_cast<GvCaptureProfiler*>(ctx)->HandleCalculation(info, opts);
+    }
+
+    void HandleCollection(const CollectionInfo& info, const CaptureOptions& opts) {
+        typename Camera::CollectionCallBackPtr cb = nullptr;
+        UserPtr ctx = nullptr;
+        const bool enabled = IsActive();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            cb = m_collectionCb;
+            ctx = m_collectionCtx;
+            if (enabled && m_captureStartNs != 0) {
+                MergeStage(CaptureStage_Acquisition, m_captureStartNs, GvNowNs(),
+                           GvGetDataBytes(info));
+            }
+        }
+        if (cb) {
+            const uint64_t start = enabled ? GvNowNs() : 0;
+            cb(info, opts, ctx);
+            if (enabled) {
+                RecordStage(CaptureStage_CollectionCallback, start, GvNowNs(), 0);
+            }
+        }
+        if (enabled) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_lastCollectionEndNs = GvNowNs();
+        }
+    }
+
+    void HandleCalculation(const CalculationInfo& info, const CaptureOptions& opts) {
+        typename Camera::CalculationCallBackPtr cb = nullptr;
+        ProfiledCalculationCallBackPtr profiledCb = nullptr;
+        UserPtr ctx = nullptr;
+        GvCaptureProfile snapshot;
+        const bool enabled = IsActive();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            cb = m_calculationCb;
+            profiledCb = m_profiledCalculationCb;
+            ctx = m_calculationCtx;
+            if (enabled && m_captureStartNs != 0) {
+                const uint64_t start = m_lastCollectionEndNs != 0 ? m_lastCollectionEndNs : m_captureStartNs;
+                MergeStage(CaptureStage_Processing, start, GvNowNs(), GvGetDataBytes(info));
+            }
+            if (profiledCb) {
+                snapshot = m_profile;
+            }
+        }
+        if (!cb && !profiledCb) {
+            return;
+        }
+        const uint64_t start = enabled ? GvNowNs() : 0;
+        if (profiledCb) {
+            profiledCb(info, opts, snapshot, ctx);
+        } else {
+            cb(info, opts, ctx);
+        }
+        if (enabled) {
+            RecordStage(CaptureStage_CalculationCallback, start, GvNowNs(), 0);
+        }
+    }
+
+    Camera& m_camera;
+    bool m_attached = false;
+    std::atomic<bool> m_enabled{false};
+
+    mutable std::mutex m_mutex;
+    GvCaptureProfile m_profile;
+    uint64_t m_captureCount = 0;
+    uint64_t m_captureStartNs = 0;
+    uint64_t m_lastCollectionEndNs = 0;
+
+    typename Camera::CollectionCallBackPtr m_collectionCb = nullptr;
+    UserPtr m_collectionCtx = nullptr;
+    typename Camera::CalculationCallBackPtr m_calculationCb = nullptr;
+    ProfiledCalculationCallBackPtr m_profiledCalculationCb = nullptr;
+    UserPtr m_calculationCtx = nullptr;
+};
+
+}  // namespace gv
@@ -0,0 +1,132 @@
+#pragma once
+
+/**
+ * @file GvColoredPointMap.h
+ * @brief 색상 포인트맵(XYZRGB) 생성과 2D 카메라 텍스처 매핑(GvCameraSDK::Processing).
+ * @details 포인트맵(double xyz)과 2D 이미지를 합쳐 float xyz + 8bit 색상 포인트를 만든다.
+ *          - 출력은 16 bytes 정렬 `GvPointXYZRGBA`(a: 유효 포인트 255, 무효/색상 없음 0)와
+ *            15 bytes 압축 `GvPointXYZRGB`(파일/전송용) 두 가지이다.
+ *          - 텍스처 형식(Mono8/RGB8/BGR8)은 행 단위로 한 번만 판별하고, 형식별 전용 루프에서 채널을 복사/교환한다
+ *            (픽셀마다 분기하지 않으므로 컴파일러가 벡터화할 수 있다).
+ *          - 2D 카메라가 3D 카메라와 같으면 같은 해상도의 텍스처를 픽셀 단위로 대응시키고,
+ *            다르면(`GvColorFuseOptions::texture_camera`) 포인트를 2D 카메라로 투영해 텍스처를 보간한다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCalibrationCache.h"
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace gv {
+
+#pragma pack(push, 1)
+/** @brief 15 bytes 압축 포인트(float xyz + RGB). `gvsdk_capture3d_sample`의 BIN 레코드와 같다. */
+struct GvPointXYZRGB {
+    float x;
+    float y;
+    float z;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+};
+#pragma pack(pop)
+
+/** @brief 16 bytes 정렬 포인트(float xyz + RGBA). */
+struct GvPointXYZRGBA {
+    float x;
+    float y;
+    float z;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+static_assert(sizeof(GvPointXYZRGB) == 15, "GvPointXYZRGB must be packed");
+static_assert(sizeof(GvPointXYZRGBA) == 16, "GvPointXYZRGBA must be 16 bytes");
+
+/** @brief `GvPointXYZRGBA` 포인트맵 버퍼(행 우선, 간격 없음). */
+class GvColoredPointMapBuffer {
+public:
+    GvColoredPointMapBuffer() = default;
+
+    /** @brief 모든 포인트가 무효(xyz NaN, 색상/alpha 0)인 버퍼를 만든다. */
+    static GvColoredPointMapBuffer Create(const GvSize size) {
+        GvColoredPointMapBuffer pm;
+        if (size.width > 0 && size.height > 0) {
+            const float nan = std::numeric_limits<float>::quiet_NaN();
+            pm.m_size = size;
+            pm.m_points.assign(static_cast<size_t>(size.width) * static_cast<size_t>(size.height),
+                               GvPointXYZRGBA{nan, nan, nan, 0, 0, 0, 0});
+        }
+        return pm;
+    }
+
+    bool IsValid() const { return !m_points.empty(); }
+    GvSize GetSize() const { return m_size; }
+    size_t GetPointCount() const { return m_points.size(); }
+    size_t GetBytes() const { return m_points.size() * sizeof(GvPointXYZRGBA); }
+    GvPointXYZRGBA* GetPointDataPtr() { return m_points.empty() ? nullptr : m_points.data(); }
+    const GvPointXYZRGBA* GetPointDataConstPtr() const { return m_points.empty() ? nullptr : m_points.data(); }
+
+private:
+    GvSize m_size;
+    std::vector<GvPointXYZRGBA> m_points;
+};
+
+struct GvColorFuseOptions {
+    /**
+     * @brief 텍스처를 찍은 2D 카메라. nullptr이면 텍스처가 포인트맵과 같은 카메라/해상도라고 본다.
+     * @details 포인트를 `extrinsic`(포인트맵 좌표계 -> 2D 카메라 좌표계, 4x4 행 우선 [R|t], 포인트와 같은 단위)으로
+     *          옮긴 뒤 내부 파라미터와 왜곡 계수로 투영한다. `has_extrinsic`이 false면 회전/이동 없이 투영한다.
+     *          투영이 텍스처 밖이거나 카메라 뒤이면 색상 0, alpha 0이다.
+     */
+    const GvCameraCalibration* texture_camera = nullptr;
+    /** @brief 텍스처가 담고 있는 2D 센서 영역(ROI 캡처). 크기가 0이면 텍스처 전체가 센서 (0, 0)부터. */
+    GvROI texture_roi;
+    /** @brief `texture_camera` 투영 시 bilinear 보간. false면 가장 가까운 픽셀. */
+    bool bilinear = true;
+    /** @brief 처리 스레드 수(0 이하이면 하드웨어 동시 실행 수). */
+    int threads = 0;
+};
+
+/**
+ * @brief 포인트맵과 텍스처를 합쳐 `GvPointXYZRGBA` 배열(`size` 픽셀 수)을 채운다.
+ * @param points 포인트맵(xyz double, 행 우선). 무효 포인트는 NaN.
+ * @param texture Mono8/RGB8/BGR8 픽셀 데이터. nullptr이면 색상 없이(색상/alpha 0) xyz만 변환한다.
+ * @param textureSize, textureStride 텍스처 크기와 행 간격(bytes). 0이면 간격 없음.
+ * @return 실패 시 false(`GvGetLastHelperErrorMessage()`).
+ */
+bool GvFuseColoredPoints(const double* points, const GvSize& size, const unsigned char* texture,
+                         GvImageType::Enum textureType, const GvSize& textureSize, int textureStride,
+                         GvPointXYZRGBA* out, const GvColorFuseOptions& options = GvColorFuseOptions());
+
+/** @brief 15 bytes 압축 출력 버전. 무효 포인트도 자리를 유지한다(xyz NaN). */
+bool GvFuseColoredPoints(const double* points, const GvSize& size, const unsigned char* texture,
+                         GvImageType::Enum textureType, const GvSize& textureSize, int textureStride,
+                         GvPointXYZRGB* out, const GvColorFuseOptions& options = GvColorFuseOptions());
+
+/** @brief 버퍼 버전. `out`은 크기가 같으면 재사용하고 아니면 새로 만든다. */
+bool GvFuseColoredPointMap(const GvPointMapBuffer& points, const GvImageBuffer& texture, GvColoredPointMapBuffer& out,
+                           const GvColorFuseOptions& options = GvColorFuseOptions());
+
+/** @brief SDK 캡처 결과(`GetPointMap()`, `GetImage()`) 버전. 핸들은 읽기만 한다. */
+inline bool GvFuseColoredPointMap(const GvPointMap& points, const GvImage& texture, GvColoredPointMapBuffer& out,
+                                  const GvColorFuseOptions& options = GvColorFuseOptions()) {
+    if (!points.IsValid() || !texture.IsValid()) {
+        detail::GvSetLastHelperError("GvFuseColoredPointMap: invalid point map or image");
+        return false;
+    }
+    const GvSize size = points.GetSize();
+    if (out.GetSize() != size) {
+        out = GvColoredPointMapBuffer::Create(size);
+    }
+    return GvFuseColoredPoints(points.GetPointDataConstPtr(), size, texture.GetDataConstPtr(), texture.GetType(),
+                               texture.GetSize(), 0, out.GetPointDataPtr(), options);
+}
+
+}  // namespace gv
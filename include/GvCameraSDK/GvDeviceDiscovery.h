@@ -0,0 +1,243 @@
+#pragma once
+
+/**
+ * @file GvDeviceDiscovery.h
+ * @brief 백그라운드 장치 검색 캐시와 연결/해제 이벤트(GvCameraSDK::Processing).
+ * @details `GvSystemGetDeviceCount()`/`GvSystemGetDeviceInfo()`는 호출할 때마다 인터페이스 전체를 다시 검색한다.
+ *          `GvDeviceDiscovery`는 검색 소스(SDK, 가상 장치 등)마다 검색 스레드를 두어 소스끼리 병렬로 주기 검색하고,
+ *          결과를 장치 표(serial number 기준)에 캐시한다.
+ *          - 시작/재연결 경로는 `WaitForDevice()`로 필요한 장치 하나만 기다린다(다른 소스의 검색을 기다리지 않음).
+ *          - 연결/해제/정보 변경 시 콜백을 호출한다. 일시적인 검색 누락은 `missing_scans_before_removal`로 거른다.
+ *          - 장치 인덱스는 해당 소스의 마지막 검색 기준이므로 열기 직전에 조회한 값을 쓴다.
+ *          검색이 실행되는 동안 같은 소스의 열거 함수(`GvSystemGetDeviceCount()` 등)를 직접 호출하지 않는다.
+ *          - SDK 소스의 열거는 장치 목록 규칙(캡처 스레드 시작 전 한 스레드, `docs/GvCameraSDK-Concurrency.md`)의
+ *            예외이므로 `Open()`/`Capture()` 동안은 `PauseScans()`(또는 `GvDeviceDiscoveryPause`)로 검색을 멈춘다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gv {
+
+/**
+ * @brief 검색 소스. 현재 보이는 장치를 모두 `devices`에 채운다(벡터 순서 = 소스의 장치 인덱스).
+ * @details 소스마다 전용 스레드에서 호출되며, 실패하면 false를 반환한다(이번 검색 결과는 버림).
+ */
+using GvDeviceDiscoverySource = std::function<bool(std::vector<GvDeviceInfo>& devices)>;
+
+struct GvDeviceDiscoveryOptions {
+    /** @brief 소스별 검색 주기(ms). 검색 시간은 포함하지 않는다. */
+    int poll_interval_ms = 1000;
+    /** @brief 연속으로 이 횟수만큼 검색에서 빠지면 해제로 본다(1 이상). */
+    int missing_scans_before_removal = 2;
+};
+
+struct GvDeviceEventType {
+    enum Enum {
+        Arrived = 0,
+        Removed = 1,
+        /** @brief 같은 장치의 port/펌웨어/장치 인덱스 등이 바뀜(IP 재할당 등). */
+        Changed = 2,
+    };
+    static const char* ToString(GvDeviceEventType::Enum e);
+};
+
+struct GvDiscoveredDevice {
+    GvDeviceInfo info{};
+    /** @brief `AddSource()`가 반환한 소스 번호. */
+    int source = -1;
+    /** @brief 소스의 마지막 검색 기준 장치 인덱스(SDK 소스는 `GvSingle::Create()` 등에 쓰는 값). */
+    int device_index = -1;
+    /** @brief 처음/마지막으로 검색된 시각(`GvNowNs()` 기준). */
+    uint64_t first_seen_ns = 0;
+    uint64_t last_seen_ns = 0;
+};
+
+/**
+ * @brief 장치 이벤트 콜백. 검색 스레드에서 호출되며 여러 소스의 이벤트도 한 번에 하나씩 전달된다.
+ * @details 콜백이 도는 동안 모든 검색 스레드의 이벤트 전달이 멈춘다. 콜백 안에서는 조회 함수(`GetDevices()`,
+ *          `FindDevice()`)만 쓴다. 검색 완료를 기다리는 `Refresh()`/`WaitForFirstScan()`/`PauseScans()`는 바로 실패하고,
+ *          `WaitForDevice()`는 표에 이미 있는 장치만 돌려준다. `AddCallback()`/`RemoveCallback()`/`Stop()`은
+ *          호출하지 않는다(교착).
+ */
+using GvDeviceEventCallback = std::function<void(GvDeviceEventType::Enum type, const GvDiscoveredDevice& device)>;
+
+struct GvDeviceDiscoveryStats {
+    uint64_t scans = 0;
+    uint64_t failed_scans = 0;
+    /** @brief 소스별 마지막 검색 소요 시간의 최댓값. */
+    uint64_t last_scan_ns = 0;
+    uint64_t max_scan_ns = 0;
+    uint64_t arrivals = 0;
+    uint64_t removals = 0;
+};
+
+class GvDeviceDiscovery {
+public:
+    GvDeviceDiscovery() = default;
+    /** @brief `Stop()`을 호출한다. */
+    ~GvDeviceDiscovery();
+    GvDeviceDiscovery(const GvDeviceDiscovery&) = delete;
+    GvDeviceDiscovery& operator=(const GvDeviceDiscovery&) = delete;
+
+    /**
+     * @brief 검색 소스를 추가한다. `Start()` 전에만 호출할 수 있다.
+     * @return 소스 번호(0부터). 실패 시 -1.
+     */
+    int AddSource(const char* name, GvDeviceDiscoverySource source);
+
+    /** @brief 소스마다 검색 스레드를 시작한다. 첫 검색은 바로 시작한다. */
+    bool Start(const GvDeviceDiscoveryOptions& options = GvDeviceDiscoveryOptions());
+    /** @brief 검색 스레드를 정리한다. 콜백 안에서 호출하지 않는다. 장치 표는 유지된다. */
+    void Stop();
+    bool IsRunning() const;
+
+    /**
+     * @brief 모든 소스에서 지금 검색을 한 번 더 실행하고 끝날 때까지 기다린다.
+     * @param timeout_ms 0 이하이면 무기한.
+     * @return 이벤트 콜백 안에서 호출하면 기다리지 않고 false.
+     */
+    bool Refresh(int timeout_ms = 0);
+
+    std::vector<GvDiscoveredDevice> GetDevices() const;
+    /** @brief 캐시된 장치 표에서 serial number로 찾는다(검색하지 않음). */
+    bool FindDevice(const char* sn, GvDiscoveredDevice& device) const;
+    /**
+     * @brief serial number가 `sn`인 장치가 보일 때까지 기다린다. 이미 표에 있으면 바로 반환한다.
+     * @param timeout_ms 0 이하이면 무기한. 이벤트 콜백 안에서는 기다리지 않는다.
+     */
+    bool WaitForDevice(const char* sn, GvDiscoveredDevice& device, int timeout_ms = 0) const;
+    /** @brief 모든 소스가 첫 검색을 마칠 때까지 기다린다. */
+    bool WaitForFirstScan(int timeout_ms = 0) const;
+
+    /**
+     * @brief 새 검색을 멈추고, 진행 중인 검색이 끝날 때까지 기다린다. `ResumeScans()`와 짝으로, 중첩할 수 있다.
+     * @details 반환 후에는 `ResumeScans()`까지 어떤 소스도 검색 함수를 호출하지 않으므로 장치 핸들의
+     *          `Open()`/`Capture()`를 SDK 열거와 겹치지 않게 실행할 수 있다. 멈춘 동안 `Refresh()`는 바로 실패하고
+     *          `WaitForDevice()`는 표에 있는 장치만 찾는다.
+     * @return 이벤트 콜백 안에서 호출하면 멈추지 않고 false.
+     */
+    bool PauseScans();
+    void ResumeScans();
+
+    /**
+     * @brief 이벤트 콜백을 등록한다. 콜백 안에서 호출하지 않는다(콜백 잠금 교착).
+     * @details 콜백 안에서 할 수 있는 호출은 `GvDeviceEventCallback` 설명을 본다.
+     * @param notify_existing true면 이미 표에 있는 장치를 `Arrived`로 먼저 전달한다.
+     * @return 콜백 ID. `RemoveCallback()`에 쓴다.
+     */
+    uint64_t AddCallback(GvDeviceEventCallback callback, bool notify_existing = true);
+    /** @brief 반환 후에는 해당 콜백이 호출되지 않는다. 콜백 안에서 호출하지 않는다. */
+    void RemoveCallback(uint64_t id);
+
+    GvDeviceDiscoveryStats GetStats() const;
+
+private:
+    struct Source {
+        std::string name;
+        GvDeviceDiscoverySource scan;
+        uint64_t completed_request = 0;
+        uint64_t last_scan_ns = 0;
+        bool scanned = false;
+    };
+
+    struct Entry {
+        GvDiscoveredDevice device;
+        int missing = 0;
+    };
+
+    struct Event {
+        GvDeviceEventType::Enum type;
+        GvDiscoveredDevice device;
+    };
+
+    /** @brief 호출 스레드가 검색 스레드인지. `m_mutex`를 잡은 채 호출한다. */
+    bool OnSourceThread() const;
+    void SourceLoop(size_t sourceIndex);
+    void Merge(size_t sourceIndex, const std::vector<GvDeviceInfo>& found, std::vector<Event>& events);
+    /** @brief `m_callbackMutex`를 잡은 채 호출한다. */
+    void Dispatch(const std::vector<Event>& events);
+
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_tableCv;
+    std::condition_variable m_wakeCv;
+    std::vector<Source> m_sources;
+    std::vector<Entry> m_devices;
+    std::vector<std::thread> m_threads;
+    GvDeviceDiscoveryOptions m_options;
+    GvDeviceDiscoveryStats m_stats;
+    uint64_t m_refreshRequest = 0;
+    /** @brief `PauseScans()` 중첩 횟수와 검색 함수를 실행 중인 소스 수. */
+    int m_pauseCount = 0;
+    int m_scanning = 0;
+    bool m_running = false;
+    bool m_stopping = false;
+
+    // 콜백 목록과 호출은 장치 표와 다른 잠금으로 보호해 콜백 안에서 조회 함수를 호출할 수 있게 한다.
+    std::mutex m_callbackMutex;
+    std::vector<std::pair<uint64_t, GvDeviceEventCallback>> m_callbacks;
+    uint64_t m_nextCallbackId = 1;
+};
+
+/**
+ * @brief 범위 안에서 검색을 멈춘다(`PauseScans()`/`ResumeScans()`).
+ * @details 예: 장치를 열거나 캡처하는 동안 `GvDeviceDiscoveryPause pause(discovery);`.
+ */
+class GvDeviceDiscoveryPause {
+public:
+    explicit GvDeviceDiscoveryPause(GvDeviceDiscovery& discovery)
+        : m_discovery(discovery), m_paused(discovery.PauseScans()) {}
+    ~GvDeviceDiscoveryPause() {
+        if (m_paused) {
+            m_discovery.ResumeScans();
+        }
+    }
+    GvDeviceDiscoveryPause(const GvDeviceDiscoveryPause&) = delete;
+    GvDeviceDiscoveryPause& operator=(const GvDeviceDiscoveryPause&) = delete;
+
+    bool IsPaused() const { return m_paused; }
+
+private:
+    GvDeviceDiscovery& m_discovery;
+    bool m_paused;
+};
+
+/**
+ * @brief SDK 열거 함수(`GvSystemGetDeviceCount()`/`GvSystemGetDeviceInfo()`)를 쓰는 검색 소스.
+ * @details `GvSystemInit()` 뒤에 사용한다. 백그라운드 스레드에서 열거하므로 다른 스레드가 장치 핸들의
+ *          `Open()`/`Capture()`를 호출하는 동안은 `GvDeviceDiscoveryPause`로 검색을 멈춘다
+ *          (DLL은 열거와 핸들 호출의 동시 실행을 보장하지 않는다).
+ */
+inline GvDeviceDiscoverySource GvSdkDiscoverySource() {
+    return [](std::vector<GvDeviceInfo>& devices) {
+        const int count = GvSystemGetDeviceCount();
+        if (count < 0) {
+            const char* message = GvGetLastErrorMessage();
+            detail::GvSetLastHelperError(message != nullptr && message[0] != '\0' ? message
+                                                                                  : "GvSystemGetDeviceCount failed");
+            return false;
+        }
+        devices.resize(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            std::memset(&devices[static_cast<size_t>(i)], 0, sizeof(GvDeviceInfo));
+            if (!GvSystemGetDeviceInfo(i, &devices[static_cast<size_t>(i)])) {
+                // 검색과 조회 사이에 장치가 빠지면 이번 결과는 버리고 다음 주기에 다시 검색한다.
+                detail::GvSetLastHelperError("GvSystemGetDeviceInfo failed(index=" + std::to_string(i) + ")");
+                return false;
+            }
+        }
+        return true;
+    };
+}
+
+}  // namespace gv
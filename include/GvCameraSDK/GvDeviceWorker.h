@@ -0,0 +1,290 @@
+#pragma once
+
+/**
+ * @file GvDeviceWorker.h
+ * @brief 장치별 전용 스레드 실행기와 호출 스레드 단위 SDK 에러 보관(헤더 전용 보조 API).
+ * @details 여러 장치를 동시에 캡처할 때의 규칙(`docs/GvCameraSDK-Concurrency.md`)을 코드로 묶는다.
+ *          - `GvDeviceWorker<Camera>`: 장치 핸들 하나를 스레드 하나가 소유하고, 그 장치에 대한 호출을 모두 그 스레드에서
+ *            순서대로 실행한다. 서로 다른 장치의 작업자는 서로 기다리지 않는다.
+ *          - `GvCheckSdk()`: 실패한 DLL 호출 직후 같은 스레드에서 `GvGetLastError()`/`GvGetLastErrorMessage()`를
+ *            호출 스레드 저장소로 복사한다. 작업 결과(`GvDeviceCallResult`)는 이 값을 작업마다 담아 돌려준다.
+ *          - `GvRunOnDevices()`: 모든 작업자에 같은 작업을 넣고 전부 끝날 때까지 기다린다(다중 장치 동시 캡처).
+ *          `Camera`는 `GvSingle`, `GvStereo`, `GvVirtualSingle` 등 `Capture()`/`Capture2D()`를 가진 형식이다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gv {
+
+/** @brief SDK/보조 API 에러 스냅샷. `code`는 DLL 에러 코드(보조 API 실패면 0). */
+struct GvSdkError {
+    int code = 0;
+    std::string message;
+};
+
+namespace detail {
+
+inline GvSdkError& GvThreadSdkErrorStorage() {
+    static thread_local GvSdkError error;
+    return error;
+}
+
+}  // namespace detail
+
+/**
+ * @brief DLL 호출 결과를 검사한다. 실패면 DLL 에러 코드/메시지를 호출 스레드 저장소와 보조 API 에러에 복사한다.
+ * @details 실패한 호출과 같은 스레드에서, 다른 SDK 호출보다 먼저 불러야 한다.
+ * @return `ok` 그대로.
+ */
+inline bool GvCheckSdk(bool ok, const char* fallback = "SDK call failed") {
+    if (!ok) {
+        GvSdkError& error = detail::GvThreadSdkErrorStorage();
+        error.code = GvGetLastError();
+        const char* message = GvGetLastErrorMessage();
+        error.message = message != nullptr && message[0] != '\0' ? message : fallback;
+        detail::GvSetLastHelperError(error.message);
+    }
+    return ok;
+}
+
+/** @brief 호출 스레드에서 `GvCheckSdk()`가 마지막으로 기록한 SDK 에러. */
+inline const GvSdkError& GvGetThreadSdkError() {
+    return detail::GvThreadSdkErrorStorage();
+}
+
+inline void GvClearThreadSdkError() {
+    detail::GvThreadSdkErrorStorage() = GvSdkError();
+}
+
+namespace detail {
+
+// 작업이 false를 반환했을 때 장치 형식에 맞는 에러를 읽는다.
+// SDK 핸들은 DLL 에러, 그 외(가상 장치 등)는 보조 API 에러.
+inline GvSdkError GvDeviceFailure(const GvSingle*) {
+    GvCheckSdk(false);
+    return GvGetThreadSdkError();
+}
+
+inline GvSdkError GvDeviceFailure(const GvStereo*) {
+    GvCheckSdk(false);
+    return GvGetThreadSdkError();
+}
+
+template <typename Camera>
+GvSdkError GvDeviceFailure(const Camera*) {
+    GvSdkError error;
+    error.message = GvGetLastHelperErrorMessage();
+    return error;
+}
+
+}  // namespace detail
+
+struct GvDeviceCallResult {
+    bool ok = false;
+    /** @brief 실패 시 작업자 스레드에서 바로 읽은 에러. */
+    GvSdkError error;
+    /** @brief 큐에서 기다린 시간과 실행 시간(ns). */
+    uint64_t queued_ns = 0;
+    uint64_t run_ns = 0;
+};
+
+struct GvDeviceWorkerStats {
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    uint64_t pending = 0;
+    /** @brief 누적 실행 시간(ns). 벽시계 시간과 비교해 장치 스레드 점유율을 구한다. */
+    uint64_t busy_ns = 0;
+    GvSdkError last_error;
+};
+
+/**
+ * @brief 장치 하나를 전용 스레드에서 다루는 작업자.
+ * @details 장치 객체는 작업자보다 오래 살아 있어야 하며, 작업자가 실행 중인 동안에는 다른 스레드에서 직접 호출하지 않는다.
+ *          `Submit()`은 어느 스레드에서나 호출할 수 있다. 작업 안에서 같은 작업자의 결과를 기다리면 교착된다.
+ */
+template <typename Camera>
+class GvDeviceWorker {
+public:
+    using Job = std::function<bool(Camera&)>;
+
+    explicit GvDeviceWorker(Camera& camera) : m_camera(camera) {}
+    ~GvDeviceWorker() { Stop(); }
+    GvDeviceWorker(const GvDeviceWorker&) = delete;
+    GvDeviceWorker& operator=(const GvDeviceWorker&) = delete;
+
+    bool Start() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_thread.joinable()) {
+            return true;
+        }
+        if (m_joining) {
+            detail::GvSetLastHelperError("GvDeviceWorker::Start: worker is stopping");
+            return false;
+        }
+        m_stop = false;
+        try {
+            m_thread = std::thread(&GvDeviceWorker::WorkerMain, this);
+        } catch (const std::exception& e) {
+            detail::GvSetLastHelperError(std::string("GvDeviceWorker::Start: ") + e.what());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 대기 중인 작업을 모두 실행한 뒤 스레드를 종료한다.
+     * @details 작업 안(작업자 스레드)에서 호출하면 자기 스레드를 기다리게 되므로 아무것도 하지 않고 보조 API 에러를 남긴다.
+     *          작업자 소멸도 작업 밖에서 한다.
+     */
+    void Stop() {
+        std::thread worker;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_thread.joinable()) {
+                return;
+            }
+            if (m_thread.get_id() == std::this_thread::get_id()) {
+                detail::GvSetLastHelperError("GvDeviceWorker::Stop: called from a worker job");
+                return;
+            }
+            m_stop = true;
+            m_joining = true;
+            // 다른 스레드의 Stop()/IsRunning()과 겹치지 않게 스레드 객체는 잠금 안에서 꺼낸다.
+            worker = std::move(m_thread);
+        }
+        m_wake.notify_all();
+        worker.join();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_joining = false;
+    }
+
+    bool IsRunning() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_thread.joinable() && !m_stop;
+    }
+
+    /** @brief 작업을 등록한다. 작업자가 실행 중이 아니면 바로 실패 결과를 돌려준다. */
+    std::future<GvDeviceCallResult> Submit(Job job) {
+        auto task = std::make_shared<Task>();
+        task->job = std::move(job);
+        task->submit_ns = GvNowNs();
+        std::future<GvDeviceCallResult> result = task->promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_thread.joinable() && !m_stop) {
+                m_queue.push_back(std::move(task));
+                m_wake.notify_one();
+                return result;
+            }
+        }
+        GvDeviceCallResult failed;
+        failed.error.message = "GvDeviceWorker: worker is not running";
+        task->promise.set_value(std::move(failed));
+        return result;
+    }
+
+    /** @brief 작업을 등록하고 끝날 때까지 기다린다. */
+    GvDeviceCallResult Call(Job job) { return Submit(std::move(job)).get(); }
+
+    GvDeviceWorkerStats GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GvDeviceWorkerStats stats = m_stats;
+        stats.pending = m_queue.size();
+        return stats;
+    }
+
+    Camera& GetCamera() { return m_camera; }
+
+private:
+    struct Task {
+        Job job;
+        uint64_t submit_ns = 0;
+        std::promise<GvDeviceCallResult> promise;
+    };
+
+    void WorkerMain() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            std::shared_ptr<Task> task = std::move(m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+
+            // [1] 작업 실행. 실패하면 같은 스레드에서 바로 에러를 읽는다.
+            GvDeviceCallResult result;
+            const uint64_t start = GvNowNs();
+            result.queued_ns = start - task->submit_ns;
+            try {
+                result.ok = task->job ? task->job(m_camera) : false;
+                if (!result.ok) {
+                    result.error = detail::GvDeviceFailure(&m_camera);
+                }
+            } catch (const std::exception& e) {
+                result.ok = false;
+                result.error.message = std::string("GvDeviceWorker: job threw: ") + e.what();
+            }
+            result.run_ns = GvNowNs() - start;
+
+            // [2] 통계 갱신 후 결과 전달
+            lock.lock();
+            ++m_stats.completed;
+            m_stats.busy_ns += result.run_ns;
+            if (!result.ok) {
+                ++m_stats.failed;
+                m_stats.last_error = result.error;
+            }
+            lock.unlock();
+            task->promise.set_value(std::move(result));
+            lock.lock();
+        }
+    }
+
+    Camera& m_camera;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<std::shared_ptr<Task>> m_queue;
+    std::thread m_thread;
+    GvDeviceWorkerStats m_stats;
+    bool m_stop = false;
+    /** @brief `Stop()`이 꺼낸 스레드를 기다리는 중(그동안 `Start()`는 실패). */
+    bool m_joining = false;
+};
+
+/**
+ * @brief 모든 작업자에 같은 작업을 넣고 모두 끝날 때까지 기다린다.
+ * @return 작업자 순서대로의 결과.
+ */
+template <typename Camera>
+std::vector<GvDeviceCallResult> GvRunOnDevices(const std::vector<GvDeviceWorker<Camera>*>& workers,
+                                               const typename GvDeviceWorker<Camera>::Job& job) {
+    std::vector<std::future<GvDeviceCallResult>> futures;
+    futures.reserve(workers.size());
+    for (GvDeviceWorker<Camera>* worker : workers) {
+        futures.push_back(worker->Submit(job));
+    }
+    std::vector<GvDeviceCallResult> results;
+    results.reserve(futures.size());
+    for (std::future<GvDeviceCallResult>& future : futures) {
+        results.push_back(future.get());
+    }
+    return results;
+}
+
+}  // namespace gv
@@ -0,0 +1,185 @@
+#pragma once
+
+/**
+ * @file GvImageIO.h
+ * @brief 이미지 파일 저장/읽기(GvCameraSDK::Processing).
+ * @details PNG / baseline TIFF / PGM·PPM을 DLL 없이 저장하고 읽는다.
+ *          - PNG: 행 묶음(strip) 단위로 필터링과 deflate 압축을 작업 스레드에서 병렬 실행하고,
+ *            strip마다 독립된 IDAT chunk로 기록한다(zlib 스트림은 strip 경계에서 sync flush로 이어진다).
+ *          - TIFF: 비압축 또는 PackBits strip. PackBits strip은 병렬 압축한다.
+ *          - PGM(P5)/PPM(P6): 헤더 + 원본 행. Mono8/RGB8은 변환 없이 한 번에 기록한다.
+ *          BGR8 이미지는 RGB 순서로 변환해 저장한다.
+ *
+ *          읽기:
+ *          - `GvMappedImage`: 비압축 TIFF(연속 strip)/PGM/PPM을 메모리 매핑해 복사 없이 픽셀을 가리킨다.
+ *            `GvWrapSdkImage()`로 매핑을 그대로 감싼 `GvImage`를 만들 수 있다.
+ *          - `GvLoadImageFile()`: 압축 파일(PNG, PackBits/Deflate TIFF)을 포함해 버퍼로 디코딩한다.
+ *          - `GvImageBatchLoader`: 여러 파일을 병렬로 디코딩하며 호출 간 버퍼를 재사용한다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvMappedFile.h"
+#include "GvPlatform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gv {
+
+struct GvImageFileFormat {
+    enum Enum {
+        /** @brief 파일 확장자로 결정(.png, .tif/.tiff, .pgm/.ppm/.pnm). */
+        Auto = 0,
+        Png = 1,
+        Tiff = 2,
+        /** @brief Mono8은 PGM(P5), RGB8/BGR8은 PPM(P6). */
+        Pnm = 3,
+    };
+    static const char* ToString(GvImageFileFormat::Enum e);
+};
+
+struct GvPngProfile {
+    enum Enum {
+        /** @brief 압축하지 않음(stored deflate block). 가장 빠르고 파일이 가장 크다. */
+        Store = 0,
+        /** @brief Up 필터 + 단일 후보 LZ77 + 동적 Huffman. */
+        Fast = 1,
+        /** @brief 행별 적응 필터 + hash chain LZ77(lazy matching) + 동적 Huffman. */
+        Best = 2,
+    };
+    static const char* ToString(GvPngProfile::Enum e);
+};
+
+struct GvTiffCompression {
+    enum Enum {
+        None = 1,
+        PackBits = 32773,
+    };
+    static const char* ToString(GvTiffCompression::Enum e);
+};
+
+struct GvImageWriteOptions {
+    GvImageFileFormat::Enum format = GvImageFileFormat::Auto;
+    GvPngProfile::Enum png_profile = GvPngProfile::Fast;
+    GvTiffCompression::Enum tiff_compression = GvTiffCompression::None;
+    /** @brief 인코딩 작업 스레드 수(0이면 하드웨어 동시 실행 수). */
+    int threads = 0;
+    /** @brief strip 하나의 행 수. 0이면 strip이 약 256KB가 되도록 정한다. */
+    int rows_per_strip = 0;
+};
+
+/**
+ * @brief 이미지를 파일로 저장한다.
+ * @param pixels 패딩 없는 Mono8/RGB8/BGR8 데이터. `GvImage::GetDataConstPtr()`를 그대로 넘길 수 있다.
+ * @return 실패 시 false(`GvGetLastHelperErrorMessage()`).
+ */
+bool GvSaveImageFile(const char* fileName, const unsigned char* pixels, GvImageType::Enum type, const GvSize& size,
+                     const GvImageWriteOptions& options = GvImageWriteOptions());
+
+/** @brief 버퍼 버전. */
+bool GvSaveImageFile(const char* fileName, const GvImageBuffer& image,
+                     const GvImageWriteOptions& options = GvImageWriteOptions());
+
+/**
+ * @brief 이미지를 메모리에 인코딩한다.
+ * @details `options.format`은 `Auto`일 수 없다.
+ */
+bool GvEncodeImage(const unsigned char* pixels, GvImageType::Enum type, const GvSize& size,
+                   const GvImageWriteOptions& options, std::vector<uint8_t>& out);
+
+struct GvImageFileInfo {
+    /** @brief `Png`, `Tiff` 또는 `Pnm`. */
+    GvImageFileFormat::Enum format = GvImageFileFormat::Auto;
+    /** @brief 디코딩 결과 형식(Mono8 또는 RGB8). */
+    GvImageType::Enum type = GvImageType::None;
+    GvSize size;
+    /** @brief 비압축 픽셀이 파일 안에 연속으로 있으면 true(`GvMappedImage`로 열 수 있음). */
+    bool mappable = false;
+    /** @brief `mappable`일 때 픽셀 데이터 시작 위치(bytes). */
+    uint64_t data_offset = 0;
+};
+
+/**
+ * @brief 파일 헤더만 읽어 형식/크기를 확인한다.
+ * @details 지원: 8비트 PNG(Gray, RGB, Palette, Gray+Alpha, RGBA, 비인터레이스; 알파는 버림),
+ *          8비트 Gray/RGB baseline TIFF(비압축, PackBits, Deflate), maxval 255 PGM(P5)/PPM(P6).
+ */
+bool GvReadImageFileInfo(const char* fileName, GvImageFileInfo& info);
+
+/**
+ * @brief 메모리 매핑한 비압축 이미지 파일.
+ * @details 파일을 copy-on-write로 매핑하며 픽셀 포인터는 매핑 안을 가리킨다(복사 없음).
+ *          객체를 복사하면 매핑을 공유하고(참조 계수), 마지막 복사본이 사라질 때 해제된다.
+ */
+class GvMappedImage {
+public:
+    /** @return 압축되었거나 픽셀이 연속되지 않은 파일이면 false(`GvLoadImageFile()` 사용). */
+    bool Open(const char* fileName);
+    void Close();
+    bool IsValid() const { return m_file.IsOpen(); }
+
+    GvImageType::Enum GetType() const { return m_type; }
+    GvSize GetSize() const { return m_size; }
+    size_t GetBytes() const;
+    const unsigned char* GetDataConstPtr() const;
+    /** @brief copy-on-write 포인터. 쓴 페이지만 프로세스 안에서 복사되고 파일은 바뀌지 않는다. */
+    unsigned char* GetDataPtr() const;
+    const GvMappedFile& GetMappedFile() const { return m_file; }
+
+private:
+    GvMappedFile m_file;
+    GvImageType::Enum m_type = GvImageType::None;
+    GvSize m_size;
+    uint64_t m_offset = 0;
+};
+
+/**
+ * @brief 매핑된 이미지를 복사 없이 감싼 `GvImage`(`own_data = false`).
+ * @details `GvImage::CreateFromFile()` 대신 사용할 수 있다. 반환된 `GvImage`를 쓰는 동안
+ *          `image`(또는 그 복사본)를 유지해야 한다.
+ */
+inline GvImage GvWrapSdkImage(const GvMappedImage& image) {
+    if (!image.IsValid()) {
+        return GvImage();
+    }
+    return GvImage::Create(image.GetType(), image.GetSize(), image.GetDataPtr(), false);
+}
+
+/**
+ * @brief 이미지 파일을 버퍼로 디코딩한다.
+ * @details `image`가 이미 같은 형식/크기면 그 메모리를 재사용한다.
+ * @return 실패 시 false(`GvGetLastHelperErrorMessage()`).
+ */
+bool GvLoadImageFile(const char* fileName, GvImageBuffer& image);
+
+struct GvImageBatchLoadOptions {
+    /** @brief 파일 단위 디코딩 작업 스레드 수(0이면 하드웨어 동시 실행 수). */
+    int threads = 0;
+};
+
+/**
+ * @brief 여러 이미지 파일을 병렬로 디코딩한다.
+ * @details 버퍼는 파일 순서대로 보관하며, 다음 `Load()`에서 같은 자리의 형식/크기가 같으면 재사용한다
+ *          (같은 해상도의 패턴 묶음을 반복해 읽을 때 할당이 일어나지 않음).
+ */
+class GvImageBatchLoader {
+public:
+    /** @return 하나라도 실패하면 false(첫 실패 파일의 사유가 `GvGetLastHelperErrorMessage()`에 남음). */
+    bool Load(const std::vector<std::string>& fileNames,
+              const GvImageBatchLoadOptions& options = GvImageBatchLoadOptions());
+
+    size_t GetCount() const { return m_count; }
+    const GvImageBuffer& GetImage(size_t index) const { return m_images[index]; }
+    GvImageBuffer& GetImage(size_t index) { return m_images[index]; }
+    /** @brief 보관 중인 버퍼를 모두 해제한다. */
+    void Release();
+
+private:
+    std::vector<GvImageBuffer> m_images;
+    size_t m_count = 0;
+};
+
+}  // namespace gv
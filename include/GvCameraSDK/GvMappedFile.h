@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file GvMappedFile.h
+ * @brief 파일 메모리 매핑(GvCameraSDK::Processing).
+ * @details 파일 전체를 프로세스 주소 공간에 매핑한다. 객체를 복사하면 같은 매핑을 공유하며(참조 계수),
+ *          마지막 복사본이 소멸하거나 `Close()`될 때 매핑이 해제된다.
+ *          매핑 주소는 페이지 경계에 정렬된다.
+ */
+
+#include "GvPlatform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace gv {
+
+struct GvMappedFileMode {
+    enum Enum {
+        /** @brief 읽기 전용. 매핑 메모리에 쓰면 접근 위반이 발생한다. */
+        ReadOnly = 0,
+        /**
+         * @brief 쓰기 시 복사(copy-on-write).
+         * @details 매핑 메모리에 쓸 수 있지만 변경은 프로세스 안에만 남고 파일에는 기록되지 않는다.
+         *          SDK 객체가 데이터를 수정해도 안전하게 하려면 이 모드를 사용한다.
+         */
+        CopyOnWrite = 1,
+    };
+};
+
+struct GvMappedFileAccess {
+    /** @brief 운영체제 미리 읽기 정책 힌트. */
+    enum Enum {
+        Normal = 0,
+        Sequential = 1,
+        Random = 2,
+    };
+};
+
+namespace detail {
+struct GvMappedRegion;
+}
+
+class GvMappedFile {
+public:
+    GvMappedFile() = default;
+
+    /**
+     * @brief 파일을 매핑한다. 이미 열려 있으면 기존 매핑 참조를 먼저 놓는다.
+     * @details 빈 파일도 열 수 있으며 이때 `GetData()`는 nullptr이다.
+     * @return 실패 시 false(`GvGetLastHelperErrorMessage()`).
+     */
+    bool Open(const char* fileName, GvMappedFileMode::Enum mode = GvMappedFileMode::ReadOnly);
+    /** @brief 이 객체의 매핑 참조를 놓는다. 다른 복사본이 남아 있으면 매핑은 유지된다. */
+    void Close();
+    bool IsOpen() const { return m_region != nullptr; }
+
+    GvMappedFileMode::Enum GetMode() const;
+    const unsigned char* GetData() const;
+    /** @return `CopyOnWrite` 모드의 쓰기 가능 포인터. `ReadOnly`면 nullptr. */
+    unsigned char* GetMutableData() const;
+    uint64_t GetSize() const;
+    /** @brief 매핑을 공유하는 객체 수. */
+    long GetUseCount() const { return m_region.use_count(); }
+
+    /** @brief 접근 방식 힌트를 준다(Linux `madvise`). 지원하지 않는 플랫폼에서는 무시된다. */
+    void Advise(GvMappedFileAccess::Enum access) const;
+    /** @brief `[offset, offset + bytes)` 구간을 미리 읽도록 요청한다(비동기). */
+    void Prefetch(uint64_t offset, uint64_t bytes) const;
+
+private:
+    std::shared_ptr<detail::GvMappedRegion> m_region;
+};
+
+}  // namespace gv
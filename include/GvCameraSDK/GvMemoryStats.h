@@ -0,0 +1,414 @@
+#pragma once
+
+/**
+ * @file GvMemoryStats.h
+ * @brief 핸들/버퍼 메모리 사용량 집계와 전역 메모리 예산(헤더 전용 보조 API).
+ * @details 집계 대상은 `GvTrackedHandle`로 소유권을 넘긴 핸들과
+ *          `GvMemoryTryAcquire()`로 등록한 버퍼이다. DLL 내부 작업 버퍼는 포함되지 않는다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace gv {
+
+enum GvMemoryObjectType {
+    MemoryObject_Image = 0,
+    MemoryObject_PointMap = 1,
+    MemoryObject_DepthMap = 2,
+    MemoryObject_ConfidenceMap = 3,
+    /** @brief 핸들이 아닌 일반 버퍼(`GvMemoryTryAcquire()`로 직접 등록). */
+    MemoryObject_Buffer = 4,
+    MemoryObject_Count = 5,
+};
+
+inline const char* GvMemoryObjectTypeToString(GvMemoryObjectType type) {
+    switch (type) {
+        case MemoryObject_Image: return "Image";
+        case MemoryObject_PointMap: return "PointMap";
+        case MemoryObject_DepthMap: return "DepthMap";
+        case MemoryObject_ConfidenceMap: return "ConfidenceMap";
+        case MemoryObject_Buffer: return "Buffer";
+        default: return "Unknown";
+    }
+}
+
+struct GvMemoryTypeStats {
+    uint64_t live_handles = 0;
+    uint64_t live_bytes = 0;
+    uint64_t peak_bytes = 0;
+    /** @brief 집계 시작(또는 `GvResetMemoryStats()`) 이후 할당 횟수. */
+    uint64_t alloc_count = 0;
+    /** @brief 집계 시작(또는 `GvResetMemoryStats()`) 이후 해제 횟수. */
+    uint64_t free_count = 0;
+};
+
+struct GvMemoryStats {
+    GvMemoryTypeStats types[MemoryObject_Count];
+    uint64_t live_bytes = 0;
+    uint64_t peak_bytes = 0;
+    /** @brief 전역 메모리 예산(bytes). 0이면 제한 없음. */
+    uint64_t budget_bytes = 0;
+    /** @brief 예산 초과로 거절된 할당 횟수. */
+    uint64_t budget_rejects = 0;
+};
+
+/** @brief 이미지 버퍼 크기(bytes). 유효하지 않으면 0. */
+inline uint64_t GvGetDataBytes(const GvImage& img) {
+    if (!img.IsValid()) {
+        return 0;
+    }
+    const GvSize size = img.GetSize();
+    return static_cast<uint64_t>(size.width) * static_cast<uint64_t>(size.height) *
+           GvImageType::GetPixelSize(img.GetType());
+}
+
+/** @brief 포인트맵 버퍼 크기(bytes). 법선 버퍼가 있으면 포함한다. */
+inline uint64_t GvGetDataBytes(const GvPointMap& pm) {
+    if (!pm.IsValid()) {
+        return 0;
+    }
+    const GvSize size = pm.GetSize();
+    const uint64_t plane = static_cast<uint64_t>(size.width) * static_cast<uint64_t>(size.height) * 3 * sizeof(double);
+    return pm.GetNormalDataConstPtr() != nullptr ? plane * 2 : plane;
+}
+
+/** @brief Depth 버퍼 크기(bytes). */
+inline uint64_t GvGetDataBytes(GvDepthMap dm) {
+    if (!dm.IsValid()) {
+        return 0;
+    }
+    const GvSize size = dm.GetSize();
+    return static_cast<uint64_t>(size.width) * static_cast<uint64_t>(size.height) * sizeof(double);
+}
+
+/** @brief Confidence 버퍼 크기(bytes). */
+inline uint64_t GvGetDataBytes(GvConfidenceMap cm) {
+    if (!cm.IsValid()) {
+        return 0;
+    }
+    const GvSize size = cm.GetSize();
+    return static_cast<uint64_t>(size.width) * static_cast<uint64_t>(size.height) * sizeof(double);
+}
+
+namespace detail {
+
+struct GvMemoryTypeCounters {
+    std::atomic<uint64_t> live_handles{0};
+    std::atomic<uint64_t> live_bytes{0};
+    std::atomic<uint64_t> peak_bytes{0};
+    std::atomic<uint64_t> alloc_count{0};
+    std::atomic<uint64_t> free_count{0};
+};
+
+struct GvMemoryCounters {
+    GvMemoryTypeCounters types[MemoryObject_Count];
+    std::atomic<uint64_t> live_bytes{0};
+    std::atomic<uint64_t> peak_bytes{0};
+    std::atomic<uint64_t> budget_bytes{0};
+    std::atomic<uint64_t> budget_rejects{0};
+};
+
+inline GvMemoryCounters& GvMemoryGlobalCounters() {
+    static GvMemoryCounters counters;
+    return counters;
+}
+
+inline void GvMemoryUpdatePeak(std::atomic<uint64_t>& peak, uint64_t value) {
+    uint64_t current = peak.load(std::memory_order_relaxed);
+    while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+template <typename T>
+struct GvMemoryTraits;
+
+template <>
+struct GvMemoryTraits<GvImage> {
+    static constexpr GvMemoryObjectType kType = MemoryObject_Image;
+    static void Destroy(GvImage& h) { GvImage::Destroy(h); }
+};
+
+template <>
+struct GvMemoryTraits<GvPointMap> {
+    static constexpr GvMemoryObjectType kType = MemoryObject_PointMap;
+    static void Destroy(GvPointMap& h) { GvPointMap::Destroy(h); }
+};
+
+template <>
+struct GvMemoryTraits<GvDepthMap> {
+    static constexpr GvMemoryObjectType kType = MemoryObject_DepthMap;
+    static void Destroy(GvDepthMap& h) { GvDepthMap::Destroy(h); }
+};
+
+template <>
+struct GvMemoryTraits<GvConfidenceMap> {
+    static constexpr GvMemoryObjectType kType = MemoryObject_ConfidenceMap;
+    static void Destroy(GvConfidenceMap& h) { GvConfidenceMap::Destroy(h); }
+};
+
+}  // namespace detail
+
+/**
+ * @brief 전역 메모리 예산을 설정한다.
+ * @param bytes 예산(bytes). 0이면 제한하지 않는다.
+ */
+inline void GvSetMemoryBudget(uint64_t bytes) {
+    detail::GvMemoryGlobalCounters().budget_bytes.store(bytes, std::memory_order_relaxed);
+}
+
+inline uint64_t GvGetMemoryBudget() {
+    return detail::GvMemoryGlobalCounters().budget_bytes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 메모리 사용량을 등록한다.
+ * @details 예산이 설정되어 있고 등록 후 총 사용량이 예산을 넘으면 등록하지 않는다.
+ * @return 등록 성공 시 true. 예산 초과 시 false이며 `GvGetLastHelperErrorMessage()`에 사유가 남는다.
+ */
+inline bool GvMemoryTryAcquire(GvMemoryObjectType type, uint64_t bytes, uint64_t handles = 1) {
+    if (type < 0 || type >= MemoryObject_Count) {
+        detail::GvSetLastHelperError("GvMemoryTryAcquire: invalid object type");
+        return false;
+    }
+    detail::GvMemoryCounters& c = detail::GvMemoryGlobalCounters();
+    const uint64_t budget = c.budget_bytes.load(std::memory_order_relaxed);
+    uint64_t live = c.live_bytes.load(std::memory_order_relaxed);
+    for (;;) {
+        if (budget != 0 && live + bytes > budget) {
+            c.budget_rejects.fetch_add(1, std::memory_order_relaxed);
+            detail::GvSetLastHelperError("Memory budget exceeded: requested " + std::to_string(bytes) +
+                                         " bytes, live " + std::to_string(live) + " / budget " +
+                                         std::to_string(budget) + " bytes");
+            return false;
+        }
+        if (c.live_bytes.compare_exchange_weak(live, live + bytes, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    detail::GvMemoryUpdatePeak(c.peak_bytes, live + bytes);
+
+    detail::GvMemoryTypeCounters& t = c.types[type];
+    t.live_handles.fetch_add(handles, std::memory_order_relaxed);
+    const uint64_t typeLive = t.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    detail::GvMemoryUpdatePeak(t.peak_bytes, typeLive);
+    t.alloc_count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+/** @brief `GvMemoryTryAcquire()`로 등록한 사용량을 해제한다. */
+inline void GvMemoryRelease(GvMemoryObjectType type, uint64_t bytes, uint64_t handles = 1) {
+    if (type < 0 || type >= MemoryObject_Count) {
+        return;
+    }
+    detail::GvMemoryCounters& c = detail::GvMemoryGlobalCounters();
+    c.live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    detail::GvMemoryTypeCounters& t = c.types[type];
+    t.live_handles.fetch_sub(handles, std::memory_order_relaxed);
+    t.live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    t.free_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 주어진 크기를 추가로 할당해도 예산 안인지 확인한다.
+ * @return 예산이 없거나 여유가 있으면 true.
+ */
+inline bool GvMemoryCheckBudget(uint64_t bytes) {
+    const detail::GvMemoryCounters& c = detail::GvMemoryGlobalCounters();
+    const uint64_t budget = c.budget_bytes.load(std::memory_order_relaxed);
+    return budget == 0 || c.live_bytes.load(std::memory_order_relaxed) + bytes <= budget;
+}
+
+/** @brief 메모리 사용량 통계를 조회한다. */
+inline GvMemoryStats GvGetMemoryStats() {
+    const detail::GvMemoryCounters& c = detail::GvMemoryGlobalCounters();
+    GvMemoryStats stats;
+    for (int i = 0; i < MemoryObject_Count; ++i) {
+        const detail::GvMemoryTypeCounters& t = c.types[i];
+        stats.types[i].live_handles = t.live_handles.load(std::memory_order_relaxed);
+        stats.types[i].live_bytes = t.live_bytes.load(std::memory_order_relaxed);
+        stats.types[i].peak_bytes = t.peak_bytes.load(std::memory_order_relaxed);
+        stats.types[i].alloc_count = t.alloc_count.load(std::memory_order_relaxed);
+        stats.types[i].free_count = t.free_count.load(std::memory_order_relaxed);
+    }
+    stats.live_bytes = c.live_bytes.load(std::memory_order_relaxed);
+    stats.peak_bytes = c.peak_bytes.load(std::memory_order_relaxed);
+    stats.budget_bytes = c.budget_bytes.load(std::memory_order_relaxed);
+    stats.budget_rejects = c.budget_rejects.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * @brief 누적 카운터(할당/해제 횟수, peak, 거절 횟수)를 초기화한다.
+ * @details 현재 사용량(live)은 유지되며 peak는 현재 사용량으로 맞춘다.
+ */
+inline void GvResetMemoryStats() {
+    detail::GvMemoryCounters& c = detail::GvMemoryGlobalCounters();
+    for (int i = 0; i < MemoryObject_Count; ++i) {
+        detail::GvMemoryTypeCounters& t = c.types[i];
+        t.peak_bytes.store(t.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        t.alloc_count.store(0, std::memory_order_relaxed);
+        t.free_count.store(0, std::memory_order_relaxed);
+    }
+    c.peak_bytes.store(c.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    c.budget_rejects.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 소유 핸들을 메모리 집계에 등록하고 소멸 시 `Destroy()`하는 RAII 래퍼.
+ * @details `Create()`/`Clone()`/`CreateFromFile()` 결과처럼 호출자가 해제 책임을 갖는
+ *          핸들만 넘겨야 한다. 카메라가 소유하는 `GetPointMap()` 등의 결과는 대상이 아니다.
+ * @tparam T `GvImage`, `GvPointMap`, `GvDepthMap`, `GvConfidenceMap`.
+ */
+template <typename T>
+class GvTrackedHandle {
+public:
+    GvTrackedHandle() = default;
+
+    /**
+     * @brief 핸들 소유권을 넘겨받는다.
+     * @details 예산을 초과하면 핸들을 즉시 해제하고 `IsValid() == false`가 된다.
+     */
+    explicit GvTrackedHandle(T handle) {
+        const uint64_t bytes = GvGetDataBytes(handle);
+        if (!GvMemoryTryAcquire(detail::GvMemoryTraits<T>::kType, bytes)) {
+            detail::GvMemoryTraits<T>::Destroy(handle);
+            return;
+        }
+        m_handle = handle;
+        m_bytes = bytes;
+        m_owned = true;
+    }
+
+    ~GvTrackedHandle() { Reset(); }
+
+    GvTrackedHandle(GvTrackedHandle&& rhs) noexcept
+        : m_handle(rhs.m_handle), m_bytes(rhs.m_bytes), m_owned(rhs.m_owned) {
+        rhs.m_owned = false;
+        rhs.m_bytes = 0;
+    }
+
+    GvTrackedHandle& operator=(GvTrackedHandle&& rhs) noexcept {
+        if (this != &rhs) {
+            Reset();
+            m_handle = rhs.m_handle;
+            m_bytes = rhs.m_bytes;
+            m_owned = rhs.m_owned;
+            rhs.m_owned = false;
+            rhs.m_bytes = 0;
+        }
+        return *this;
+    }
+
+    GvTrackedHandle(const GvTrackedHandle&) = delete;
+    GvTrackedHandle& operator=(const GvTrackedHandle&) = delete;
+
+    bool IsValid() const { return m_owned; }
+    uint64_t GetBytes() const { return m_bytes; }
+    T& Get() { return m_handle; }
+    const T& Get() const { return m_handle; }
+    T* operator->() { return &m_handle; }
+    const T* operator->() const { return &m_handle; }
+
+    /** @brief 집계에서 제외하고 소유권을 호출자에게 돌려준다. */
+    T Release() {
+        if (m_owned) {
+            GvMemoryRelease(detail::GvMemoryTraits<T>::kType, m_bytes);
+        }
+        m_owned = false;
+        m_bytes = 0;
+        return m_handle;
+    }
+
+    /** @brief 핸들을 해제하고 집계에서 제외한다. */
+    void Reset() {
+        if (!m_owned) {
+            return;
+        }
+        detail::GvMemoryTraits<T>::Destroy(m_handle);
+        GvMemoryRelease(detail::GvMemoryTraits<T>::kType, m_bytes);
+        m_owned = false;
+        m_bytes = 0;
+    }
+
+private:
+    T m_handle{};
+    uint64_t m_bytes = 0;
+    bool m_owned = false;
+};
+
+using GvTrackedImage = GvTrackedHandle<GvImage>;
+using GvTrackedPointMap = GvTrackedHandle<GvPointMap>;
+using GvTrackedDepthMap = GvTrackedHandle<GvDepthMap>;
+using GvTrackedConfidenceMap = GvTrackedHandle<GvConfidenceMap>;
+
+/**
+ * @brief 3D 캡처 1회 결과(포인트맵, depth, confidence, 텍스처)의 예상 크기를 계산한다.
+ * @param resolution 결과 해상도(ROI 적용 후).
+ * @param texture_type 2D 텍스처 포맷(`None`이면 텍스처 없음).
+ * @param texture_images 텍스처 수(`GvSingle` 1, `GvStereo` 좌/우 2).
+ * @return 예상 크기(bytes).
+ */
+inline uint64_t GvEstimateCaptureBytes(const GvSize& resolution, GvImageType::Enum texture_type = GvImageType::RGB8,
+                                       int texture_images = 1) {
+    const uint64_t pixels = static_cast<uint64_t>(resolution.width) * static_cast<uint64_t>(resolution.height);
+    const uint64_t texturePixel = texture_type == GvImageType::None ? 0 : texture_type == GvImageType::Mono8 ? 1 : 3;
+    const uint64_t textures = texture_images > 0 ? static_cast<uint64_t>(texture_images) : 0;
+    return pixels * (3 * sizeof(double) + sizeof(double) + sizeof(double) + texturePixel * textures);
+}
+
+namespace detail {
+
+/** @brief 캡처 1회가 만드는 텍스처 수. */
+template <typename Camera>
+struct GvCaptureTextureImages {
+    static constexpr int value = 1;
+};
+
+template <>
+struct GvCaptureTextureImages<GvStereo> {
+    static constexpr int value = 2;
+};
+
+}  // namespace detail
+
+/**
+ * @brief 예산을 확인한 뒤 캡처한다.
+ * @details 예산이 설정되어 있고 결과를 복제해 보관할 여유가 없으면 장치에 캡처를
+ *          요청하지 않고 false를 반환한다. 사유는 `GvGetLastHelperErrorMessage()`로 조회한다.
+ *          캡처 옵션에는 텍스처 포맷이 없으므로 `texture_type`으로 넘긴다(기본값 RGB8은 가장 큰 경우).
+ *          `GvStereo`는 좌/우 텍스처 2장으로 계산한다.
+ * @tparam Camera `GvSingle` 또는 `GvStereo`.
+ * @param texture_type 장치의 2D 텍스처 포맷(Mono 장치는 `GvImageType::Mono8`).
+ * @return 캡처 성공 시 true.
+ */
+template <typename Camera>
+bool GvCaptureWithinBudget(Camera& camera, const typename Camera::GvCaptureOptions& opts,
+                           GvImageType::Enum texture_type = GvImageType::RGB8) {
+    if (GvGetMemoryBudget() != 0) {
+        GvSize resolution;
+        if (opts.roi.width > 0 && opts.roi.height > 0) {
+            resolution = GvSize(opts.roi.width, opts.roi.height);
+        } else if (!camera.GetCameraResolution(resolution)) {
+            detail::GvSetLastHelperError("GvCaptureWithinBudget: GetCameraResolution failed");
+            return false;
+        }
+        const uint64_t estimate =
+            GvEstimateCaptureBytes(resolution, texture_type, detail::GvCaptureTextureImages<Camera>::value);
+        if (!GvMemoryCheckBudget(estimate)) {
+            detail::GvMemoryGlobalCounters().budget_rejects.fetch_add(1, std::memory_order_relaxed);
+            detail::GvSetLastHelperError("Capture rejected by memory budget: estimated " + std::to_string(estimate) +
+                                         " bytes, live " + std::to_string(GvGetMemoryStats().live_bytes) +
+                                         " / budget " + std::to_string(GvGetMemoryBudget()) + " bytes");
+            return false;
+        }
+    }
+    return camera.Capture(opts);
+}
+
+}  // namespace gv
@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file GvParallel.h
+ * @brief 보조 API 공용 구간 분할 병렬 실행 유틸리티(헤더 전용).
+ * @details 실행기(`GvSetParallelExecutor()`, 보통 `GvThreadPool.h`의 상주 스레드 풀)가 등록되어 있으면
+ *          구간을 실행기에 넘기고, 없으면 호출마다 스레드를 만들어 실행한다.
+ *          처리 종류(`GvThreadSubsystem`)별 기본 스레드 수도 실행기가 정한다.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gv {
+
+/** @brief 병렬 처리 종류. 실행기가 종류별 스레드 수를 따로 정할 수 있다. */
+enum GvThreadSubsystem {
+    ThreadSubsystem_Default = 0,
+    /** @brief 패턴 디코딩/삼각측량. */
+    ThreadSubsystem_Decode = 1,
+    /** @brief 포인트맵/이미지 후처리(필터, 왜곡 보정, 색상 합성). */
+    ThreadSubsystem_Filter = 2,
+    /** @brief 파일 인코딩/저장/읽기(이미지, 포인트 클라우드, 보관 파일). */
+    ThreadSubsystem_IO = 3,
+    ThreadSubsystem_Count = 4,
+};
+
+inline const char* GvThreadSubsystemToString(GvThreadSubsystem subsystem) {
+    switch (subsystem) {
+        case ThreadSubsystem_Default: return "Default";
+        case ThreadSubsystem_Decode: return "Decode";
+        case ThreadSubsystem_Filter: return "Filter";
+        case ThreadSubsystem_IO: return "IO";
+        default: return "Unknown";
+    }
+}
+
+/**
+ * @brief `GvParallelFor()`가 구간을 넘기는 실행기.
+ * @details `Run()`은 `task(ctx, i)`를 `i = 0 .. tasks - 1`에 대해 모두 실행한 뒤 반환해야 하며,
+ *          호출 스레드도 작업에 참여해 실행기 스레드가 모두 바쁠 때(중첩 호출)에도 끝나야 한다.
+ *          false를 반환하면 `GvParallelFor()`는 스레드를 직접 만들어 실행한다(작업은 아직 실행되지 않아야 함).
+ */
+class GvParallelExecutor {
+public:
+    virtual ~GvParallelExecutor() = default;
+    /** @brief `threads <= 0`으로 호출했을 때 쓸 스레드 수(호출 스레드 포함). */
+    virtual int GetThreadCount(GvThreadSubsystem subsystem) const = 0;
+    virtual bool Run(GvThreadSubsystem subsystem, size_t tasks, void (*task)(void* ctx, size_t index), void* ctx) = 0;
+};
+
+namespace detail {
+
+inline std::atomic<GvParallelExecutor*>& GvParallelExecutorSlot() {
+    static std::atomic<GvParallelExecutor*> executor{nullptr};
+    return executor;
+}
+
+}  // namespace detail
+
+/**
+ * @brief 전역 실행기를 등록한다. nullptr이면 해제한다.
+ * @details 해제/교체는 병렬 처리가 실행 중이지 않을 때 한다. 실행기 객체는 해제 후까지 살아 있어야 한다.
+ */
+inline void GvSetParallelExecutor(GvParallelExecutor* executor) {
+    detail::GvParallelExecutorSlot().store(executor, std::memory_order_release);
+}
+
+inline GvParallelExecutor* GvGetParallelExecutor() {
+    return detail::GvParallelExecutorSlot().load(std::memory_order_acquire);
+}
+
+/**
+ * @brief 사용할 작업 스레드 수를 정한다.
+ * @param threads 요청 스레드 수. 0 이하이면 실행기의 `subsystem` 스레드 수, 실행기가 없으면 하드웨어 동시 실행 수.
+ * @param work_items 분할 대상 개수. 결과는 이 값을 넘지 않는다.
+ */
+inline int GvResolveThreadCount(int threads, size_t work_items,
+                                GvThreadSubsystem subsystem = ThreadSubsystem_Default) {
+    if (threads <= 0) {
+        GvParallelExecutor* executor = GvGetParallelExecutor();
+        threads = executor != nullptr ? executor->GetThreadCount(subsystem)
+                                      : static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threads = std::max(threads, 1);
+    if (work_items < static_cast<size_t>(threads)) {
+        threads = static_cast<int>(std::max<size_t>(work_items, 1));
+    }
+    return threads;
+}
+
+/**
+ * @brief `[begin, end)`를 연속 구간으로 나눠 병렬 실행한다.
+ * @details `fn(chunk_begin, chunk_end, chunk_index)` 형태로 호출된다. 스레드 1개면 호출 스레드에서 그대로 실행한다.
+ *          실행기가 있으면 구간을 실행기에 넘기고(호출 스레드도 참여), 없으면 마지막 구간을 호출 스레드에서 실행한다.
+ * @param subsystem 처리 종류(실행기의 종류별 스레드 수).
+ * @param threads 작업 스레드 수(0 이하이면 `GvResolveThreadCount()`).
+ */
+template <typename Fn>
+void GvParallelFor(GvThreadSubsystem subsystem, size_t begin, size_t end, int threads, Fn&& fn) {
+    if (end <= begin) {
+        return;
+    }
+    const size_t total = end - begin;
+    const int count = GvResolveThreadCount(threads, total, subsystem);
+    if (count == 1) {
+        fn(begin, end, 0);
+        return;
+    }
+    const size_t step = (total + static_cast<size_t>(count) - 1) / static_cast<size_t>(count);
+    if (GvParallelExecutor* executor = GvGetParallelExecutor()) {
+        struct Context {
+            Fn* fn;
+            size_t begin;
+            size_t end;
+            size_t step;
+        } context{&fn, begin, end, step};
+        auto task = [](void* ctx, size_t index) {
+            const Context& c = *static_cast<const Context*>(ctx);
+            const size_t chunkBegin = c.begin + index * c.step;
+            (*c.fn)(chunkBegin, std::min(chunkBegin + c.step, c.end), static_cast<int>(index));
+        };
+        if (executor->Run(subsystem, (total + step - 1) / step, task, &context)) {
+            return;
+        }
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(count - 1));
+    size_t chunkBegin = begin;
+    int index = 0;
+    for (; index < count - 1 && chunkBegin + step < end; ++index, chunkBegin += step) {
+        workers.emplace_back([&fn, chunkBegin, step, index]() { fn(chunkBegin, chunkBegin + step, index); });
+    }
+    fn(chunkBegin, end, index);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/** @brief `ThreadSubsystem_Default`로 실행한다. */
+template <typename Fn>
+void GvParallelFor(size_t begin, size_t end, int threads, Fn&& fn) {
+    GvParallelFor(ThreadSubsystem_Default, begin, end, threads, std::forward<Fn>(fn));
+}
+
+}  // namespace gv
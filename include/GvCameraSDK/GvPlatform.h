@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file GvPlatform.h
+ * @brief 보조 API 공용 시간/스레드/파일 유틸리티(헤더 전용).
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#if defined(_WIN32)
+#include <io.h>
+extern "C" __declspec(dllimport) unsigned long __stdcall GetCurrentThreadId(void);
+extern "C" __declspec(dllimport) unsigned long __stdcall GetCurrentProcessId(void);
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace gv {
+
+/**
+ * @brief 단조 증가 시계 기준 현재 시각을 조회한다.
+ * @details `std::chrono::steady_clock` 기준이므로 애플리케이션이 같은 시계를 쓰면
+ *          SDK 보조 API의 타임스탬프와 바로 비교할 수 있다.
+ * @return 현재 시각(ns).
+ */
+inline uint64_t GvNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+/**
+ * @brief 현재 OS 스레드 ID를 조회한다.
+ * @return Windows는 `GetCurrentThreadId()`, Linux는 `gettid` 값.
+ */
+inline uint64_t GvCurrentThreadId() {
+#if defined(_WIN32)
+    return static_cast<uint64_t>(::GetCurrentThreadId());
+#elif defined(__linux__)
+    static thread_local const uint64_t tid = static_cast<uint64_t>(::syscall(SYS_gettid));
+    return tid;
+#else
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return tid;
+#endif
+}
+
+/**
+ * @brief 현재 OS 프로세스 ID를 조회한다.
+ */
+inline uint64_t GvCurrentProcessId() {
+#if defined(_WIN32)
+    return static_cast<uint64_t>(::GetCurrentProcessId());
+#else
+    return static_cast<uint64_t>(::getpid());
+#endif
+}
+
+namespace detail {
+
+inline std::string& GvHelperLastErrorStorage() {
+    static thread_local std::string message;
+    return message;
+}
+
+inline void GvSetLastHelperError(const std::string& message) {
+    GvHelperLastErrorStorage() = message;
+}
+
+/** @brief 2GB를 넘는 파일에서도 동작하는 절대 위치 이동. */
+inline bool GvFileSeek(FILE* fp, uint64_t offset) {
+#if defined(_WIN32)
+    return ::_fseeki64(fp, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+    return ::fseeko(fp, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+inline bool GvFileSeekEnd(FILE* fp) {
+#if defined(_WIN32)
+    return ::_fseeki64(fp, 0, SEEK_END) == 0;
+#else
+    return ::fseeko(fp, 0, SEEK_END) == 0;
+#endif
+}
+
+/** @return 현재 파일 위치. 실패 시 UINT64_MAX. */
+inline uint64_t GvFileTell(FILE* fp) {
+#if defined(_WIN32)
+    const long long pos = ::_ftelli64(fp);
+#else
+    const off_t pos = ::ftello(fp);
+#endif
+    return pos < 0 ? UINT64_MAX : static_cast<uint64_t>(pos);
+}
+
+/** @brief 파일 크기를 `size`로 줄인다. 호출 전에 `fflush()`로 버퍼를 비워야 한다. */
+inline bool GvFileTruncate(FILE* fp, uint64_t size) {
+#if defined(_WIN32)
+    return ::_chsize_s(::_fileno(fp), static_cast<long long>(size)) == 0;
+#else
+    return ::ftruncate(::fileno(fp), static_cast<off_t>(size)) == 0;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief 보조 API의 마지막 에러 메시지를 조회한다.
+ * @details DLL 에러(`GvGetLastErrorMessage()`)와 별도로, 헤더 보조 API가 스스로 실패를
+ *          판단한 경우의 사유를 호출 스레드 단위로 보관한다.
+ * @return 널 종료 UTF-8 문자열. 에러가 없으면 빈 문자열.
+ */
+inline const char* GvGetLastHelperErrorMessage() {
+    return detail::GvHelperLastErrorStorage().c_str();
+}
+
+}  // namespace gv
@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file GvPointCloudIO.h
+ * @brief 포인트맵 파일 저장(GvCameraSDK::Processing).
+ * @details binary little-endian PLY / binary PCD(v0.7)를 DLL 없이 저장한다.
+ *          포인트를 구간(chunk) 단위로 작업 스레드에서 직렬화하고, 직렬화된 구간은 별도 쓰기 스레드가
+ *          큰 단위 순차 쓰기로 기록하므로 직렬화와 디스크 쓰기가 겹쳐 진행된다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <cstddef>
+
+namespace gv {
+
+struct GvPointCloudFormat {
+    enum Enum {
+        /** @brief binary_little_endian 1.0, 색상은 `uchar red/green/blue`. */
+        Ply = 0,
+        /** @brief PCD v0.7 `DATA binary`, 색상은 PCL 방식의 packed `rgb`(uint32). */
+        Pcd = 1,
+    };
+};
+
+struct GvPointCloudScalar {
+    enum Enum {
+        Float32 = 0,
+        Float64 = 1,
+    };
+};
+
+struct GvPointCloudWriteOptions {
+    GvPointCloudFormat::Enum format = GvPointCloudFormat::Ply;
+    GvPointCloudScalar::Enum scalar = GvPointCloudScalar::Float32;
+    /** @brief 저장 좌표 단위(입력 포인트는 meter). */
+    GvPointMapUnit::Enum unit = GvPointMapUnit::Meter;
+    /**
+     * @brief true면 무효(NaN) 포인트를 건너뛴다.
+     * @details false면 모든 픽셀을 NaN 그대로 저장하며 PCD는 정렬(organized, WIDTH x HEIGHT) 형식이 된다.
+     */
+    bool skip_invalid = true;
+    /** @brief 직렬화 작업 스레드 수(0이면 하드웨어 동시 실행 수). */
+    int threads = 0;
+    /** @brief 구간 하나의 포인트 수. 0이면 기본값(256K). */
+    size_t chunk_points = 0;
+};
+
+/**
+ * @brief 포인트 배열을 파일로 저장한다.
+ * @param points `[x0,y0,z0,...]` 순서 meter 단위 포인트(`size.width * size.height`개).
+ *               `GvPointMap::GetPointDataConstPtr()`를 그대로 넘길 수 있다.
+ * @param texture 같은 해상도의 Mono8/RGB8/BGR8 픽셀 데이터 또는 nullptr(색상 없음).
+ * @return 실패 시 false(`GvGetLastHelperErrorMessage()`).
+ */
+bool GvSavePointCloud(const char* fileName, const double* points, const GvSize& size, const unsigned char* texture,
+                      GvImageType::Enum textureType, const GvPointCloudWriteOptions& options);
+
+/** @brief 버퍼 버전. `texture`가 nullptr이거나 무효면 색상 없이 저장한다. */
+bool GvSavePointCloud(const char* fileName, const GvPointMapBuffer& points, const GvImageBuffer* texture,
+                      const GvPointCloudWriteOptions& options);
+
+/**
+ * @brief 포인트맵을 binary PLY(float)로 저장한다.
+ * @details 무효(NaN) 포인트는 건너뛰며, `texture`가 유효하면 RGB 색상을 함께 저장한다.
+ * @param texture 포인트맵과 같은 해상도의 Mono8/RGB8/BGR8 이미지 또는 nullptr.
+ * @param unit 저장 좌표 단위.
+ * @return 실패 시 false(`GvGetLastHelperErrorMessage()`).
+ */
+bool GvSavePointMapPly(const char* fileName, const GvPointMapBuffer& points, const GvImageBuffer* texture,
+                       GvPointMapUnit::Enum unit = GvPointMapUnit::Meter);
+
+}  // namespace gv
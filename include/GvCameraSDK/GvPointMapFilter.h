@@ -0,0 +1,190 @@
+#pragma once
+
+/**
+ * @file GvPointMapFilter.h
+ * @brief 정렬(organized) 포인트맵 후처리 필터(헤더 전용 보조 API).
+ * @details 캡처 옵션(`truncate_z_*`, `confidence_threshold`, `noise_removal_*`)과 같은 의미의
+ *          필터를 저장된/합성 포인트맵에 다시 적용할 때 사용한다.
+ *          포인트 버퍼는 `[x0,y0,z0,x1,y1,z1,...]` 순서이며 무효 포인트는 `(NaN, NaN, NaN)`이다.
+ *          거리/좌표 인자는 포인트 버퍼와 같은 단위를 사용한다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvParallel.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace gv {
+
+namespace detail {
+
+inline void GvInvalidatePoint(double* p) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    p[0] = nan;
+    p[1] = nan;
+    p[2] = nan;
+}
+
+inline size_t GvPointCount(const GvSize& size) {
+    if (size.width <= 0 || size.height <= 0) {
+        return 0;
+    }
+    return static_cast<size_t>(size.width) * static_cast<size_t>(size.height);
+}
+
+}  // namespace detail
+
+/**
+ * @brief z 범위를 벗어난 포인트를 무효화한다.
+ * @param points 포인트 버퍼(in/out).
+ * @param threads 작업 스레드 수(0 이하이면 하드웨어 동시 실행 수).
+ * @return 새로 무효화된 포인트 수.
+ */
+inline size_t GvTruncateZ(double* points, const GvSize& size, double z_min, double z_max, int threads = 0) {
+    const size_t count = detail::GvPointCount(size);
+    if (points == nullptr || count == 0) {
+        return 0;
+    }
+    std::atomic<size_t> removed{0};
+    GvParallelFor(ThreadSubsystem_Filter, 0, count, threads, [&](size_t begin, size_t end, int) {
+        size_t local = 0;
+        for (size_t i = begin; i < end; ++i) {
+            double* p = points + i * 3;
+            const double z = p[2];
+            if (z == z && (z < z_min || z > z_max)) {
+                detail::GvInvalidatePoint(p);
+                ++local;
+            }
+        }
+        removed.fetch_add(local, std::memory_order_relaxed);
+    });
+    return removed.load();
+}
+
+/**
+ * @brief confidence가 임계값보다 낮은 포인트를 무효화한다.
+ * @param confidence 포인트와 같은 해상도의 confidence 버퍼. NaN은 무효로 본다.
+ * @return 새로 무효화된 포인트 수.
+ */
+inline size_t GvConfidenceFilter(double* points, const double* confidence, const GvSize& size, double threshold,
+                                 int threads = 0) {
+    const size_t count = detail::GvPointCount(size);
+    if (points == nullptr || confidence == nullptr || count == 0) {
+        return 0;
+    }
+    std::atomic<size_t> removed{0};
+    GvParallelFor(ThreadSubsystem_Filter, 0, count, threads, [&](size_t begin, size_t end, int) {
+        size_t local = 0;
+        for (size_t i = begin; i < end; ++i) {
+            double* p = points + i * 3;
+            if (p[2] != p[2]) {
+                continue;
+            }
+            const double c = confidence[i];
+            if (!(c >= threshold)) {
+                detail::GvInvalidatePoint(p);
+                ++local;
+            }
+        }
+        removed.fetch_add(local, std::memory_order_relaxed);
+    });
+    return removed.load();
+}
+
+/**
+ * @brief 반경 내 이웃 수가 부족한 포인트(outlier)를 무효화한다.
+ * @details 정렬 포인트맵이므로 이웃 탐색은 픽셀 창 `(2*window+1)^2` 안으로 제한한다.
+ *          판정은 원본 기준으로 먼저 끝낸 뒤 일괄 적용하므로 결과는 스레드 수와 무관하다.
+ * @param radius 이웃 판정 반경. 0 이하이면 필터를 적용하지 않는다.
+ * @param min_neighbors 최소 이웃 수(자기 자신 제외). 0이면 필터를 적용하지 않는다.
+ * @param window 픽셀 탐색 반경.
+ * @return 새로 무효화된 포인트 수.
+ */
+inline size_t GvRadiusOutlierFilter(double* points, const GvSize& size, double radius, int min_neighbors,
+                                    int window = 3, int threads = 0) {
+    const size_t count = detail::GvPointCount(size);
+    if (points == nullptr || count == 0 || radius <= 0.0 || min_neighbors <= 0 || window <= 0) {
+        return 0;
+    }
+    const int width = size.width;
+    const int height = size.height;
+    const double r2 = radius * radius;
+    std::vector<uint8_t> reject(count, 0);
+    std::atomic<size_t> removed{0};
+
+    GvParallelFor(ThreadSubsystem_Filter, 0, static_cast<size_t>(height), threads,
+                  [&](size_t rowBegin, size_t rowEnd, int) {
+        size_t local = 0;
+        for (int y = static_cast<int>(rowBegin); y < static_cast<int>(rowEnd); ++y) {
+            const int y0 = y - window < 0 ? 0 : y - window;
+            const int y1 = y + window >= height ? height - 1 : y + window;
+            for (int x = 0; x < width; ++x) {
+                const size_t idx = static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x);
+                const double* p = points + idx * 3;
+                if (p[2] != p[2]) {
+                    continue;
+                }
+                const int x0 = x - window < 0 ? 0 : x - window;
+                const int x1 = x + window >= width ? width - 1 : x + window;
+                int neighbors = 0;
+                for (int ny = y0; ny <= y1 && neighbors < min_neighbors; ++ny) {
+                    const double* row = points + static_cast<size_t>(ny) * static_cast<size_t>(width) * 3;
+                    for (int nx = x0; nx <= x1; ++nx) {
+                        if (nx == x && ny == y) {
+                            continue;
+                        }
+                        const double* q = row + static_cast<size_t>(nx) * 3;
+                        const double dx = q[0] - p[0];
+                        const double dy = q[1] - p[1];
+                        const double dz = q[2] - p[2];
+                        // NaN 이웃은 비교 결과가 false이므로 자연히 제외된다.
+                        if (dx * dx + dy * dy + dz * dz <= r2 && ++neighbors >= min_neighbors) {
+                            break;
+                        }
+                    }
+                }
+                if (neighbors < min_neighbors) {
+                    reject[idx] = 1;
+                    ++local;
+                }
+            }
+        }
+        removed.fetch_add(local, std::memory_order_relaxed);
+    });
+
+    GvParallelFor(ThreadSubsystem_Filter, 0, count, threads, [&](size_t begin, size_t end, int) {
+        for (size_t i = begin; i < end; ++i) {
+            if (reject[i]) {
+                detail::GvInvalidatePoint(points + i * 3);
+            }
+        }
+    });
+    return removed.load();
+}
+
+/**
+ * @brief 유효 포인트 수를 센다.
+ */
+inline size_t GvCountValidPoints(const double* points, const GvSize& size, int threads = 0) {
+    const size_t count = detail::GvPointCount(size);
+    if (points == nullptr || count == 0) {
+        return 0;
+    }
+    std::atomic<size_t> valid{0};
+    GvParallelFor(ThreadSubsystem_Filter, 0, count, threads, [&](size_t begin, size_t end, int) {
+        size_t local = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const double z = points[i * 3 + 2];
+            local += z == z ? 1 : 0;
+        }
+        valid.fetch_add(local, std::memory_order_relaxed);
+    });
+    return valid.load();
+}
+
+}  // namespace gv
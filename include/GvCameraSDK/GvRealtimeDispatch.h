@@ -0,0 +1,358 @@
+#pragma once
+
+/**
+ * @file GvRealtimeDispatch.h
+ * @brief 실시간 이미지 콜백 우선순위 모드와 디스패치 지터 측정(GvCameraSDK::Processing).
+ * @details 부하가 걸린 PC에서 `GvSetRealtimeImageCallback()` 콜백 간격이 흔들리는 것을 줄이고 측정한다.
+ *          - `GvSetRealtimePriorityImageCallback()`: 콜백을 실행하는 DLL 디스패치 스레드가 처음 들어올 때
+ *            그 스레드의 우선순위를 올리고(Linux `SCHED_FIFO`/nice, Windows 스레드 우선순위) 스택을 미리 접근한다.
+ *            이후 프레임마다 하는 일은 시각 기록과 원자 카운터 갱신뿐이다(할당, 잠금, 시스템 호출 없음).
+ *            공용 실시간 훅(`GvRealtimeHook.h`)의 기록기로 등록하므로 전송 통계/추적과 함께 켤 수 있다.
+ *          - `GvGetRealtimeDispatchStats()`: `GvGetRealtimeImageFpsInfo()` 값에 측정한 간격/지터/콜백 시간을 더해 돌려준다.
+ *          - `GvLockedBuffer`, `GvLockProcessMemory()`: 콜백에서 쓸 버퍼를 미리 할당/접근(pre-fault)하고 메모리에 고정한다.
+ *          - 그래버 스레드는 DLL 내부 스레드이므로 직접 바꿀 수 없다. `GvSystemConfig::grabber_priority`로
+ *            `GvSystemInit()` 동안 호출 스레드 우선순위를 올려 그때 만들어지는 스레드가 물려받게 한다(Linux).
+ *          실시간 우선순위는 권한이 필요하다(Linux `CAP_SYS_NICE` 또는 `RLIMIT_RTPRIO`). 실패하면 일반 우선순위로 계속하고
+ *          `priority_failures`로 알린다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+#include "GvRealtimeHook.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace gv {
+
+struct GvThreadPriority {
+    enum Enum {
+        Normal = 0,
+        /** @brief 일반 스케줄러 안에서 높은 우선순위(Linux nice -10, Windows `THREAD_PRIORITY_HIGHEST`). */
+        High = 1,
+        /** @brief 실시간 스케줄링(Linux `SCHED_FIFO`, Windows `THREAD_PRIORITY_TIME_CRITICAL`). */
+        Realtime = 2,
+    };
+
+    static const char* ToString(Enum priority);
+};
+
+/** @brief `GvGetCurrentThreadPriority()`로 저장한 스레드 스케줄링 상태. */
+struct GvThreadPriorityState {
+    int policy = 0;
+    int priority = 0;
+    int nice = 0;
+    bool valid = false;
+};
+
+/**
+ * @brief 호출 스레드의 우선순위를 바꾼다.
+ * @param realtime_priority `Realtime`일 때 Linux `SCHED_FIFO` 우선순위. 0이면 허용 범위의 가운데.
+ */
+bool GvSetCurrentThreadPriority(GvThreadPriority::Enum priority, int realtime_priority = 0);
+bool GvGetCurrentThreadPriority(GvThreadPriorityState& state);
+bool GvRestoreCurrentThreadPriority(const GvThreadPriorityState& state);
+
+/** @brief 우선순위를 바꾸고 스택 일부를 미리 접근해 첫 프레임에서 페이지 폴트가 나지 않게 한다. */
+bool GvPrepareRealtimeThread(GvThreadPriority::Enum priority, int realtime_priority = 0);
+
+/**
+ * @brief 프로세스의 현재/이후 메모리를 모두 고정한다(Linux `mlockall`). DLL 내부 버퍼도 포함된다.
+ * @details Windows는 지원하지 않는다(false). 대신 `GvLockedBuffer`를 쓴다.
+ */
+bool GvLockProcessMemory();
+void GvUnlockProcessMemory();
+
+/**
+ * @brief 페이지 정렬, 미리 접근(pre-fault)하고 메모리에 고정한 버퍼.
+ * @details 고정(`mlock`/`VirtualLock`)이 권한/한도로 실패해도 버퍼는 쓸 수 있으며 `IsLocked()`가 false이다.
+ */
+class GvLockedBuffer {
+public:
+    GvLockedBuffer() = default;
+    ~GvLockedBuffer();
+    GvLockedBuffer(const GvLockedBuffer&) = delete;
+    GvLockedBuffer& operator=(const GvLockedBuffer&) = delete;
+    GvLockedBuffer(GvLockedBuffer&& other) noexcept;
+    GvLockedBuffer& operator=(GvLockedBuffer&& other) noexcept;
+
+    /** @brief 0으로 채운 버퍼를 할당한다. 기존 버퍼는 해제한다. 할당 실패 시 false. */
+    bool Allocate(size_t bytes);
+    void Release();
+
+    unsigned char* GetDataPtr() { return m_data; }
+    const unsigned char* GetDataConstPtr() const { return m_data; }
+    size_t GetBytes() const { return m_bytes; }
+    bool IsValid() const { return m_data != nullptr; }
+    bool IsLocked() const { return m_locked; }
+
+private:
+    unsigned char* m_data = nullptr;
+    size_t m_bytes = 0;
+    size_t m_mapped = 0;
+    bool m_locked = false;
+};
+
+struct GvRealtimeDispatchOptions {
+    GvThreadPriority::Enum priority = GvThreadPriority::Realtime;
+    int realtime_priority = 0;
+    /** @brief 기대 프레임 속도. 0이면 측정 간격의 이동 평균을 기준으로 지터를 구한다. */
+    double expected_fps = 0.0;
+};
+
+struct GvRealtimeDispatchStats {
+    /** @brief `GvGetRealtimeImageFpsInfo()` 결과. */
+    GvRealtimeImageFpsInfo fps;
+    uint64_t dispatched_frames = 0;
+    /** @brief 콜백 도착 간격: 마지막 값, 지터 기준(기대 간격 또는 이동 평균). */
+    double last_interval_ms = 0.0;
+    double expected_interval_ms = 0.0;
+    /** @brief |간격 - 기준 간격|의 평균/99 백분위(버킷 상한 근사, 오차 25% 이내)/최대. */
+    double jitter_mean_ms = 0.0;
+    double jitter_p99_ms = 0.0;
+    double jitter_max_ms = 0.0;
+    /** @brief 간격이 기준의 1.5배를 넘은 프레임. */
+    uint64_t late_frames = 0;
+    /** @brief 사용자 콜백 실행 시간(길면 다음 프레임이 큐에서 기다린다). */
+    double callback_mean_ms = 0.0;
+    double callback_max_ms = 0.0;
+    /** @brief 마지막 디스패치 스레드 ID와 우선순위 적용 실패 횟수. */
+    uint64_t dispatch_thread_id = 0;
+    uint64_t priority_failures = 0;
+};
+
+/**
+ * @brief 디스패치 간격/지터/콜백 시간 카운터. 기록은 할당/잠금 없이 원자 변수만 갱신한다.
+ * @details 기록은 측면마다 디스패치 스레드 하나에서 한다고 가정한다(조회는 어느 스레드에서나 가능).
+ */
+class GvDispatchJitterCounters {
+public:
+    static constexpr int kBuckets = 256;
+
+    GvDispatchJitterCounters() = default;
+    GvDispatchJitterCounters(const GvDispatchJitterCounters&) = delete;
+    GvDispatchJitterCounters& operator=(const GvDispatchJitterCounters&) = delete;
+
+    /** @param expected_interval_ns 0이면 측정 간격의 이동 평균(1/16)을 기준으로 쓴다. */
+    void SetExpectedInterval(uint64_t expected_interval_ns) {
+        m_expectedNs.store(expected_interval_ns, std::memory_order_relaxed);
+    }
+
+    /** @brief 콜백 하나를 기록한다. `arrival_ns`는 콜백 진입 시각, `callback_ns`는 사용자 콜백 실행 시간. */
+    void RecordDispatch(uint64_t arrival_ns, uint64_t callback_ns) {
+        m_frames.fetch_add(1, std::memory_order_relaxed);
+        m_callbackNs.fetch_add(callback_ns, std::memory_order_relaxed);
+        updateMax(m_callbackMaxNs, callback_ns);
+        const uint64_t previous = m_lastArrivalNs.exchange(arrival_ns, std::memory_order_relaxed);
+        if (previous == 0 || arrival_ns <= previous) {
+            return;
+        }
+        const uint64_t interval = arrival_ns - previous;
+        m_lastIntervalNs.store(interval, std::memory_order_relaxed);
+        uint64_t reference = m_expectedNs.load(std::memory_order_relaxed);
+        if (reference == 0) {
+            const uint64_t average = m_averageNs.load(std::memory_order_relaxed);
+            reference = average != 0 ? average : interval;
+            const int64_t delta = static_cast<int64_t>(interval) - static_cast<int64_t>(reference);
+            m_averageNs.store(static_cast<uint64_t>(static_cast<int64_t>(reference) + delta / 16),
+                              std::memory_order_relaxed);
+        }
+        const uint64_t jitter = interval > reference ? interval - reference : reference - interval;
+        m_intervals.fetch_add(1, std::memory_order_relaxed);
+        m_jitterNs.fetch_add(jitter, std::memory_order_relaxed);
+        updateMax(m_jitterMaxNs, jitter);
+        m_histogram[Bucket(jitter)].fetch_add(1, std::memory_order_relaxed);
+        if (interval * 2 > reference * 3) {
+            m_lateFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void RecordPriorityFailure() { m_priorityFailures.fetch_add(1, std::memory_order_relaxed); }
+
+    GvRealtimeDispatchStats Sample() const {
+        GvRealtimeDispatchStats s;
+        s.dispatched_frames = m_frames.load(std::memory_order_relaxed);
+        s.last_interval_ms = toMs(m_lastIntervalNs.load(std::memory_order_relaxed));
+        const uint64_t expected = m_expectedNs.load(std::memory_order_relaxed);
+        s.expected_interval_ms = toMs(expected != 0 ? expected : m_averageNs.load(std::memory_order_relaxed));
+        const uint64_t intervals = m_intervals.load(std::memory_order_relaxed);
+        if (intervals > 0) {
+            s.jitter_mean_ms = toMs(m_jitterNs.load(std::memory_order_relaxed)) / static_cast<double>(intervals);
+            uint64_t counted = 0;
+            const uint64_t target = intervals - intervals / 100;
+            for (int b = 0; b < kBuckets; ++b) {
+                counted += m_histogram[b].load(std::memory_order_relaxed);
+                if (counted >= target) {
+                    s.jitter_p99_ms = toMs(BucketUpperBound(b));
+                    break;
+                }
+            }
+        }
+        s.jitter_max_ms = toMs(m_jitterMaxNs.load(std::memory_order_relaxed));
+        s.jitter_p99_ms = s.jitter_p99_ms < s.jitter_max_ms ? s.jitter_p99_ms : s.jitter_max_ms;
+        s.late_frames = m_lateFrames.load(std::memory_order_relaxed);
+        if (s.dispatched_frames > 0) {
+            s.callback_mean_ms =
+                toMs(m_callbackNs.load(std::memory_order_relaxed)) / static_cast<double>(s.dispatched_frames);
+        }
+        s.callback_max_ms = toMs(m_callbackMaxNs.load(std::memory_order_relaxed));
+        s.priority_failures = m_priorityFailures.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    /** @brief 카운터를 0으로 되돌린다(기대 간격은 유지). */
+    void Reset() {
+        for (std::atomic<uint64_t>* c : {&m_frames, &m_lastArrivalNs, &m_lastIntervalNs, &m_averageNs, &m_intervals,
+                                         &m_jitterNs, &m_jitterMaxNs, &m_lateFrames, &m_callbackNs, &m_callbackMaxNs,
+                                         &m_priorityFailures}) {
+            c->store(0, std::memory_order_relaxed);
+        }
+        for (std::atomic<uint64_t>& bucket : m_histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief 지터 히스토그램 버킷: 2의 거듭제곱 구간을 4등분(0~3 ns는 값 그대로). */
+    static int Bucket(uint64_t ns) {
+        if (ns < 4) {
+            return static_cast<int>(ns);
+        }
+        int bit = 2;
+        while (bit < 63 && (ns >> (bit + 1)) != 0) {
+            ++bit;
+        }
+        return 4 * (bit - 1) + static_cast<int>((ns >> (bit - 2)) & 3);
+    }
+
+    static uint64_t BucketUpperBound(int bucket) {
+        if (bucket < 4) {
+            return static_cast<uint64_t>(bucket);
+        }
+        const int bit = bucket / 4 + 1;
+        const uint64_t sub = static_cast<uint64_t>(bucket % 4);
+        return ((5 + sub) << (bit - 2)) - 1;
+    }
+
+private:
+    static double toMs(uint64_t ns) { return static_cast<double>(ns) / 1.0e6; }
+
+    static void updateMax(std::atomic<uint64_t>& target, uint64_t value) {
+        uint64_t max = target.load(std::memory_order_relaxed);
+        while (value > max && !target.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::atomic<uint64_t> m_expectedNs{0};
+    std::atomic<uint64_t> m_frames{0};
+    std::atomic<uint64_t> m_lastArrivalNs{0};
+    std::atomic<uint64_t> m_lastIntervalNs{0};
+    std::atomic<uint64_t> m_averageNs{0};
+    std::atomic<uint64_t> m_intervals{0};
+    std::atomic<uint64_t> m_jitterNs{0};
+    std::atomic<uint64_t> m_jitterMaxNs{0};
+    std::atomic<uint64_t> m_lateFrames{0};
+    std::atomic<uint64_t> m_callbackNs{0};
+    std::atomic<uint64_t> m_callbackMaxNs{0};
+    std::atomic<uint64_t> m_priorityFailures{0};
+    std::atomic<uint64_t> m_histogram[kBuckets] = {};
+};
+
+namespace detail {
+
+struct GvRealtimeDispatchSlot {
+    std::atomic<int> priority{GvThreadPriority::Normal};
+    std::atomic<int> realtime_priority{0};
+    /** @brief 우선순위를 적용한 디스패치 스레드 ID. 0이면 다음 프레임에서 다시 적용한다. */
+    std::atomic<uint64_t> thread_id{0};
+    GvDispatchJitterCounters counters;
+};
+
+inline GvRealtimeDispatchSlot* GvRealtimeDispatchSlots() {
+    static GvRealtimeDispatchSlot slots[2];
+    return slots;
+}
+
+inline uint64_t GvRealtimeDispatchBefore(const GvRealtimeImageFrame*, GvCameraID side) {
+    GvRealtimeDispatchSlot& slot = GvRealtimeDispatchSlots()[side];
+    // 디스패치 스레드가 바뀌었을 때만 우선순위를 적용한다(시스템 호출은 스레드당 한 번).
+    const uint64_t tid = GvCurrentThreadId();
+    if (slot.thread_id.load(std::memory_order_relaxed) != tid) {
+        slot.thread_id.store(tid, std::memory_order_relaxed);
+        const auto priority = static_cast<GvThreadPriority::Enum>(slot.priority.load(std::memory_order_relaxed));
+        if (priority != GvThreadPriority::Normal &&
+            !GvPrepareRealtimeThread(priority, slot.realtime_priority.load(std::memory_order_relaxed))) {
+            slot.counters.RecordPriorityFailure();
+        }
+    }
+    return GvNowNs();
+}
+
+inline void GvRealtimeDispatchAfter(const GvRealtimeImageFrame*, GvCameraID side, uint64_t arrival) {
+    GvRealtimeDispatchSlots()[side].counters.RecordDispatch(arrival, GvNowNs() - arrival);
+}
+
+}  // namespace detail
+
+/** @brief 실시간 측면(Left/Right)의 디스패치 카운터. */
+inline GvDispatchJitterCounters& GvRealtimeDispatchCounters(GvCameraID side) {
+    return detail::GvRealtimeDispatchSlots()[side == CameraID_Right ? 1 : 0].counters;
+}
+
+/**
+ * @brief 실시간 훅(`GvRealtimeHook.h`)에 디스패치 우선순위/지터 기록기를 더한다. 사용자 콜백은 바꾸지 않는다.
+ * @details 콜백 시간은 이 기록기보다 나중에 등록한 기록기와 사용자 콜백의 실행 시간이다.
+ *          기록기만 끄려면 `GvRemoveRealtimeRecorder(camid, GvRealtimeDispatchRecorder())`.
+ */
+inline const GvRealtimeRecorder* GvRealtimeDispatchRecorder() {
+    static const GvRealtimeRecorder recorder = {&detail::GvRealtimeDispatchBefore, &detail::GvRealtimeDispatchAfter};
+    return &recorder;
+}
+
+inline bool GvAddRealtimeDispatchRecorder(GvCameraID camid,
+                                          const GvRealtimeDispatchOptions& options = GvRealtimeDispatchOptions()) {
+    detail::GvRealtimeDispatchSlot* slots = detail::GvRealtimeDispatchSlots();
+    const uint64_t expected = options.expected_fps > 0.0 ? static_cast<uint64_t>(1.0e9 / options.expected_fps) : 0;
+    for (const GvCameraID side : {CameraID_Left, CameraID_Right}) {
+        if (camid != side && camid != CameraID_Both) {
+            continue;
+        }
+        detail::GvRealtimeDispatchSlot& slot = slots[side];
+        slot.priority.store(options.priority, std::memory_order_relaxed);
+        slot.realtime_priority.store(options.realtime_priority, std::memory_order_relaxed);
+        slot.thread_id.store(0, std::memory_order_relaxed);
+        slot.counters.SetExpectedInterval(expected);
+    }
+    return GvAddRealtimeRecorder(camid, GvRealtimeDispatchRecorder());
+}
+
+/**
+ * @brief 우선순위 모드로 실시간 이미지 콜백을 등록한다.
+ * @details 사용자 콜백에 대해서는 `GvSetRealtimeImageCallback()`과 같은 의미이며, 디스패치 스레드의 우선순위를 올리고
+ *          간격/지터를 기록한다. 같은 측면의 다른 기록기(전송 통계, 추적)는 유지된다.
+ *          우선순위는 다음 프레임이 들어올 때 그 스레드에 적용된다. 해제는 `GvClearRealtimeHook(camid)`.
+ */
+inline bool GvSetRealtimePriorityImageCallback(GvCameraID camid, GvRealtimeImageCallback cb, UserPtr user_data,
+                                               const GvRealtimeDispatchOptions& options = GvRealtimeDispatchOptions()) {
+    const bool added = GvAddRealtimeDispatchRecorder(camid, options);
+    return GvSetHookedRealtimeImageCallback(camid, cb, user_data) && added;
+}
+
+/**
+ * @brief 실시간 측면의 FPS 정보(`GvGetRealtimeImageFpsInfo()`)와 디스패치 간격/지터를 조회한다.
+ * @param camid 카메라 측면(Left/Right).
+ * @return FPS 조회까지 성공하면 true. FPS 조회가 실패해도 디스패치 통계는 채운다.
+ */
+inline bool GvGetRealtimeDispatchStats(GvCameraID camid, GvRealtimeDispatchStats* stats) {
+    if (stats == nullptr || (camid != CameraID_Left && camid != CameraID_Right)) {
+        detail::GvSetLastHelperError("GvGetRealtimeDispatchStats: invalid arguments");
+        return false;
+    }
+    const detail::GvRealtimeDispatchSlot& slot = detail::GvRealtimeDispatchSlots()[camid];
+    *stats = slot.counters.Sample();
+    stats->dispatch_thread_id = slot.thread_id.load(std::memory_order_relaxed);
+    return GvGetRealtimeImageFpsInfo(camid, &stats->fps);
+}
+
+}  // namespace gv
@@ -0,0 +1,189 @@
+#pragma once
+
+/**
+ * @file GvRealtimeHook.h
+ * @brief 실시간 이미지 콜백에 여러 기록기를 겹쳐 거는 공용 훅(헤더 전용 보조 API).
+ * @details DLL은 측면(Left/Right)마다 콜백을 하나만 보관한다. 전송 통계(`GvTransportStats.h`), 디스패치 지터/우선순위
+ *          (`GvRealtimeDispatch.h`), 구간 추적(`GvTrace.h`)은 모두 이 훅에 기록기(`GvRealtimeRecorder`)를 더하는 방식으로
+ *          등록하므로 함께 켜도 서로 지우지 않는다.
+ *          - 훅이 DLL에 등록하는 콜백은 측면마다 하나(trampoline)이며, 프레임마다 기록기 `before`를 등록 순서대로,
+ *            사용자 콜백을, 기록기 `after`를 역순으로 호출한다(먼저 등록한 기록기가 바깥쪽).
+ *          - 기록기 추가/제거(`GvAddRealtimeRecorder()`/`GvRemoveRealtimeRecorder()`)는 사용자 콜백을 바꾸지 않는다.
+ *            `GvSetHookedRealtimeImageCallback()`과 각 보조 함수(`GvSetTransportRealtimeImageCallback()` 등)는
+ *            자기 기록기를 더하고 사용자 콜백을 바꾼다(`GvSetRealtimeImageCallback()`과 같은 의미).
+ *          - 기록기와 사용자 콜백이 모두 없으면 DLL 콜백을 해제한다. 모두 지우려면 `GvClearRealtimeHook()`.
+ *          - `GvSetRealtimeImageCallback()`을 직접 호출하면 훅이 DLL에서 빠진다(기록기 상태는 남는다).
+ *          프레임 경로는 원자 읽기만 하며 할당/잠금이 없다. 등록/해제는 내부 잠금으로 직렬화한다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+
+namespace gv {
+
+/**
+ * @brief 실시간 프레임 기록기. 정적 저장 기간 객체로 만들어 주소로 등록한다(같은 주소는 한 번만 등록된다).
+ * @details `before`의 반환값은 같은 프레임의 `after`에 그대로 전달된다(시작 시각 등). 둘 다 `nullptr`일 수 있다.
+ *          DLL 디스패치 스레드에서 호출되므로 할당/잠금 없이 짧게 끝나야 한다.
+ */
+struct GvRealtimeRecorder {
+    uint64_t (*before)(const GvRealtimeImageFrame* frame, GvCameraID side);
+    void (*after)(const GvRealtimeImageFrame* frame, GvCameraID side, uint64_t token);
+};
+
+namespace detail {
+
+constexpr int kGvRealtimeHookMaxRecorders = 8;
+
+struct GvRealtimeHookSlot {
+    std::atomic<const GvRealtimeRecorder*> recorders[kGvRealtimeHookMaxRecorders] = {};
+    std::atomic<GvRealtimeImageCallback> cb{nullptr};
+    std::atomic<UserPtr> user_data{nullptr};
+};
+
+inline GvRealtimeHookSlot* GvRealtimeHookSlots() {
+    static GvRealtimeHookSlot slots[2];
+    return slots;
+}
+
+inline std::mutex& GvRealtimeHookMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+template <int Side>
+void GvRealtimeHookTrampoline(const GvRealtimeImageFrame* frame, UserPtr) {
+    GvRealtimeHookSlot& slot = GvRealtimeHookSlots()[Side];
+    const GvCameraID side = static_cast<GvCameraID>(Side);
+    const GvRealtimeRecorder* recorders[kGvRealtimeHookMaxRecorders];
+    uint64_t tokens[kGvRealtimeHookMaxRecorders];
+    for (int i = 0; i < kGvRealtimeHookMaxRecorders; ++i) {
+        recorders[i] = slot.recorders[i].load(std::memory_order_acquire);
+        tokens[i] = recorders[i] != nullptr && recorders[i]->before ? recorders[i]->before(frame, side) : 0;
+    }
+    const GvRealtimeImageCallback cb = slot.cb.load(std::memory_order_acquire);
+    if (cb) {
+        cb(frame, slot.user_data.load(std::memory_order_acquire));
+    }
+    for (int i = kGvRealtimeHookMaxRecorders - 1; i >= 0; --i) {
+        if (recorders[i] != nullptr && recorders[i]->after) {
+            recorders[i]->after(frame, side, tokens[i]);
+        }
+    }
+}
+
+// GvRealtimeHookMutex()를 잡은 상태에서 호출한다. 할 일이 남아 있으면 훅을, 없으면 nullptr를 DLL에 등록한다.
+inline bool GvSyncRealtimeHook(GvCameraID side) {
+    const GvRealtimeHookSlot& slot = GvRealtimeHookSlots()[side];
+    bool active = slot.cb.load(std::memory_order_relaxed) != nullptr;
+    for (const std::atomic<const GvRealtimeRecorder*>& entry : slot.recorders) {
+        active = active || entry.load(std::memory_order_relaxed) != nullptr;
+    }
+    GvRealtimeImageCallback trampoline = nullptr;
+    if (active) {
+        trampoline = side == CameraID_Left ? &GvRealtimeHookTrampoline<CameraID_Left>
+                                           : &GvRealtimeHookTrampoline<CameraID_Right>;
+    }
+    return GvSetRealtimeImageCallback(side, trampoline, nullptr);
+}
+
+}  // namespace detail
+
+/**
+ * @brief 측면(`CameraID_Both`면 양쪽)에 기록기를 더하고 훅을 DLL에 등록한다. 사용자 콜백은 그대로 둔다.
+ * @return 이미 등록된 기록기면 true. 자리가 없거나 DLL 등록이 실패하면 false.
+ */
+inline bool GvAddRealtimeRecorder(GvCameraID camid, const GvRealtimeRecorder* recorder) {
+    if (recorder == nullptr) {
+        detail::GvSetLastHelperError("GvAddRealtimeRecorder: invalid arguments");
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(detail::GvRealtimeHookMutex());
+    bool ok = true;
+    for (const GvCameraID side : {CameraID_Left, CameraID_Right}) {
+        if (camid != side && camid != CameraID_Both) {
+            continue;
+        }
+        detail::GvRealtimeHookSlot& slot = detail::GvRealtimeHookSlots()[side];
+        int free = -1;
+        bool found = false;
+        for (int i = 0; i < detail::kGvRealtimeHookMaxRecorders && !found; ++i) {
+            const GvRealtimeRecorder* current = slot.recorders[i].load(std::memory_order_relaxed);
+            found = current == recorder;
+            free = free < 0 && current == nullptr ? i : free;
+        }
+        if (!found) {
+            if (free < 0) {
+                detail::GvSetLastHelperError("GvAddRealtimeRecorder: too many recorders");
+                ok = false;
+                continue;
+            }
+            slot.recorders[free].store(recorder, std::memory_order_release);
+        }
+        ok = detail::GvSyncRealtimeHook(side) && ok;
+    }
+    return ok;
+}
+
+/** @brief 기록기를 뺀다. 기록기와 사용자 콜백이 모두 없어지면 DLL 콜백을 해제한다. */
+inline bool GvRemoveRealtimeRecorder(GvCameraID camid, const GvRealtimeRecorder* recorder) {
+    std::lock_guard<std::mutex> lock(detail::GvRealtimeHookMutex());
+    bool ok = true;
+    for (const GvCameraID side : {CameraID_Left, CameraID_Right}) {
+        if (camid != side && camid != CameraID_Both) {
+            continue;
+        }
+        for (std::atomic<const GvRealtimeRecorder*>& entry : detail::GvRealtimeHookSlots()[side].recorders) {
+            if (entry.load(std::memory_order_relaxed) == recorder) {
+                entry.store(nullptr, std::memory_order_release);
+            }
+        }
+        ok = detail::GvSyncRealtimeHook(side) && ok;
+    }
+    return ok;
+}
+
+/**
+ * @brief 훅 뒤에서 실행할 사용자 콜백을 바꾼다. 기록기는 그대로 둔다.
+ * @details `cb`가 `nullptr`이면 기록기만 실행한다(기록기도 없으면 DLL 콜백 해제).
+ */
+inline bool GvSetHookedRealtimeImageCallback(GvCameraID camid, GvRealtimeImageCallback cb, UserPtr user_data) {
+    std::lock_guard<std::mutex> lock(detail::GvRealtimeHookMutex());
+    bool ok = true;
+    for (const GvCameraID side : {CameraID_Left, CameraID_Right}) {
+        if (camid != side && camid != CameraID_Both) {
+            continue;
+        }
+        detail::GvRealtimeHookSlot& slot = detail::GvRealtimeHookSlots()[side];
+        slot.user_data.store(user_data, std::memory_order_release);
+        slot.cb.store(cb, std::memory_order_release);
+        ok = detail::GvSyncRealtimeHook(side) && ok;
+    }
+    return ok;
+}
+
+/** @brief 기록기와 사용자 콜백을 모두 지우고 DLL 콜백을 해제한다. */
+inline bool GvClearRealtimeHook(GvCameraID camid) {
+    std::lock_guard<std::mutex> lock(detail::GvRealtimeHookMutex());
+    bool ok = true;
+    for (const GvCameraID side : {CameraID_Left, CameraID_Right}) {
+        if (camid != side && camid != CameraID_Both) {
+            continue;
+        }
+        detail::GvRealtimeHookSlot& slot = detail::GvRealtimeHookSlots()[side];
+        for (std::atomic<const GvRealtimeRecorder*>& entry : slot.recorders) {
+            entry.store(nullptr, std::memory_order_release);
+        }
+        slot.cb.store(nullptr, std::memory_order_release);
+        slot.user_data.store(nullptr, std::memory_order_release);
+        ok = detail::GvSyncRealtimeHook(side) && ok;
+    }
+    return ok;
+}
+
+}  // namespace gv
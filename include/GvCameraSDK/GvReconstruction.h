@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @file GvReconstruction.h
+ * @brief 원본 구조광 패턴 이미지로부터 포인트맵 복원(GvCameraSDK::Processing).
+ * @details 장치/DLL과 무관하며 Linux에서도 빌드된다.
+ *          패턴 순서는 white, black, 반주기 Gray code(MSB 우선), N-step 위상천이이다.
+ *          좌표계는 카메라 광학 중심 원점, +z 시선 방향, 프로젝터는 +x 방향 `baseline` 위치이며
+ *          포인트 단위는 `meter`이다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <cstddef>
+
+namespace gv {
+
+/** @brief 왜곡 없는 카메라-프로젝터(가로 방향 위상) 구조광 모델. */
+struct GvStructuredLightModel {
+    GvSize camera_resolution;
+    double camera_fx = 0.0;
+    double camera_fy = 0.0;
+    double camera_cx = 0.0;
+    double camera_cy = 0.0;
+    int projector_width = 0;
+    double projector_fx = 0.0;
+    double projector_cx = 0.0;
+    /** @brief 카메라-프로젝터 기준선(m). */
+    double baseline = 0.0;
+    /** @brief 위상천이 주기(프로젝터 pixel). */
+    int phase_period = 32;
+    /** @brief 위상천이 단계 수(3 이상). */
+    int phase_steps = 4;
+    /** @brief 반주기 Gray code 비트 수. `GvStructuredLightGrayBits()`로 구한다. */
+    int gray_bits = 0;
+};
+
+struct GvStructuredLightDecodeOptions {
+    /** @brief white - black 최소 대비(gray level). */
+    double contrast_threshold = 8.0;
+    /** @brief 작업 스레드 수(0이면 하드웨어 동시 실행 수). */
+    int threads = 0;
+};
+
+/** @brief 캡처 모드의 위상천이 단계 수. 시뮬레이션/복원을 지원하지 않는 모드는 0. */
+int GvStructuredLightPhaseSteps(GvCaptureMode mode);
+
+/** @brief 프로젝터 전체 column을 반주기 단위로 구분하는 데 필요한 Gray code 비트 수. */
+int GvStructuredLightGrayBits(int projector_width, int phase_period);
+
+/** @brief 패턴 이미지 수(2 + gray_bits + phase_steps). 모델이 잘못되면 0. */
+int GvStructuredLightPatternCount(const GvStructuredLightModel& model);
+
+/**
+ * @brief 프로젝터 column 하나의 패턴 세기(0~1)를 계산한다.
+ * @param pattern `GvStructuredLightPatternCount(model)`개 값을 받을 버퍼.
+ */
+void GvStructuredLightEncodeColumn(const GvStructuredLightModel& model, double column, double* pattern);
+
+/**
+ * @brief 패턴 이미지를 디코딩/삼각측량한다.
+ * @details `points`/`confidence`가 카메라 해상도와 다르면 새로 만든다(포인트 NaN, confidence NaN).
+ *          이미 값이 있으면 confidence가 더 높은 픽셀만 덮어쓰므로, 노출별로 반복 호출하면
+ *          HDR 합성이 된다. confidence는 0~1 변조 세기이다.
+ * @param patterns Mono8 패턴 이미지 `count`장.
+ * @return 입력이 잘못되면 false(`GvGetLastHelperErrorMessage()`).
+ */
+bool GvDecodeStructuredLight(const GvImageBuffer* patterns, size_t count, const GvStructuredLightModel& model,
+                             const GvStructuredLightDecodeOptions& options, GvPointMapBuffer& points,
+                             GvConfidenceMapBuffer& confidence);
+
+}  // namespace gv
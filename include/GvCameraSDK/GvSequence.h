@@ -0,0 +1,221 @@
+#pragma once
+
+/**
+ * @file GvSequence.h
+ * @brief 여러 프레임을 담는 캡처 시퀀스 파일(GvCameraSDK::Processing).
+ * @details 프레임 단위로 뒤에 이어 쓰는(append-only) 파일이며, 프레임마다 메타데이터(타임스탬프, 장치 SN,
+ *          프레임 ID, 캡처 옵션)와 포인트맵/depth/confidence/이미지 데이터를 원본 그대로 저장한다.
+ *          - 데이터는 파일 안에서 정렬 단위(기본 4096 bytes) 경계에 놓이므로, 매핑한 메모리를 복사 없이
+ *            `GvPointMap`/`GvImage` 등으로 감쌀 수 있다(`GvWrapSdkPointMap()` 등).
+ *          - 파일 끝의 색인(프레임 위치, 타임스탬프)으로 임의 프레임에 바로 접근한다.
+ *          - 색인이 없는 파일(기록 중 비정상 종료)은 프레임 레코드를 순서대로 따라가며 색인을 복구한다.
+ *          파일 구조: 파일 헤더 -> 프레임 레코드들 -> 색인 -> footer. 바이트 순서는 little-endian이다.
+ *          캡처 옵션은 `GvSingle::GvCaptureOptions`를 그대로 저장하므로 같은 SDK 버전에서만 복원된다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvMappedFile.h"
+#include "GvPlatform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace gv {
+
+struct GvSequencePayloadType {
+    enum Enum {
+        None = 0,
+        PointMap = 1,
+        DepthMap = 2,
+        ConfidenceMap = 3,
+        Image = 4,
+        /** @brief 형식 없는 bytes(`size = {bytes, 1}`). 세션 메타데이터 등 보조 레코드용. */
+        Blob = 5,
+    };
+    static const char* ToString(GvSequencePayloadType::Enum e);
+};
+
+/**
+ * @brief 프레임 데이터 하나.
+ * @details 쓰기 시에는 `data`가 호출자 메모리를, 읽기 시에는 매핑 메모리를 가리킨다.
+ *          데이터 배치는 SDK 핸들과 같다(GvBuffers.h 참고).
+ */
+struct GvSequencePayload {
+    GvSequencePayloadType::Enum type = GvSequencePayloadType::None;
+    /** @brief `Image`의 픽셀 형식. */
+    GvImageType::Enum image_type = GvImageType::None;
+    GvSize size;
+    const void* data = nullptr;
+    uint64_t bytes = 0;
+
+    static GvSequencePayload FromPointMap(const double* points, const GvSize& size);
+    static GvSequencePayload FromPointMap(const GvPointMapBuffer& points);
+    static GvSequencePayload FromDepthMap(const double* depth, const GvSize& size);
+    static GvSequencePayload FromDepthMap(const GvDepthMapBuffer& depth);
+    static GvSequencePayload FromConfidenceMap(const double* confidence, const GvSize& size);
+    static GvSequencePayload FromConfidenceMap(const GvConfidenceMapBuffer& confidence);
+    static GvSequencePayload FromImage(const unsigned char* pixels, GvImageType::Enum type, const GvSize& size);
+    static GvSequencePayload FromImage(const GvImageBuffer& image);
+    /** @param bytes 1 이상 `INT32_MAX` 이하. */
+    static GvSequencePayload FromBlob(const void* data, uint64_t bytes);
+};
+
+struct GvSequenceFrameInfo {
+    /** @brief 캡처 시각(ns). 0이면 기록 시 `GvNowNs()`로 채운다. */
+    uint64_t timestamp_ns = 0;
+    /** @brief 사용자 정의 프레임 ID(예: 장치 캡처 카운터). */
+    uint64_t frame_id = 0;
+    /** @brief 장치 SN(`GvDeviceInfo::sn`). */
+    char sn[64] = {};
+    bool has_options = false;
+    GvSingle::GvCaptureOptions options;
+    /** @brief 읽기 전용: 프레임 데이터 수. */
+    int payload_count = 0;
+};
+
+namespace detail {
+struct GvSequenceIndexEntry {
+    uint64_t offset;
+    uint64_t timestamp_ns;
+};
+
+/** @brief 형식/크기로 정해지는 데이터 크기(bytes). 형식이나 크기가 잘못되면 0. */
+uint64_t GvSequencePayloadBytes(GvSequencePayloadType::Enum type, GvImageType::Enum imageType, const GvSize& size);
+}  // namespace detail
+
+struct GvSequenceWriteOptions {
+    /** @brief true면 기존 파일 뒤에 이어 쓴다(파일이 없으면 새로 만든다). */
+    bool append = false;
+    /** @brief 데이터 정렬 단위(bytes, 2의 거듭제곱, 64 이상). 이어 쓰기에서는 기존 파일 값을 따른다. */
+    uint32_t alignment = 4096;
+};
+
+/**
+ * @brief 시퀀스 파일 작성기.
+ * @details 색인은 `Close()`에서 기록된다. `Close()` 전에 중단된 파일도 `GvSequenceReader`가 복구해 읽을 수 있다.
+ */
+class GvSequenceWriter {
+public:
+    GvSequenceWriter() = default;
+    ~GvSequenceWriter();
+    GvSequenceWriter(const GvSequenceWriter&) = delete;
+    GvSequenceWriter& operator=(const GvSequenceWriter&) = delete;
+
+    /** @return 실패 시 false(`GvGetLastHelperErrorMessage()`). */
+    bool Open(const char* fileName, const GvSequenceWriteOptions& options = GvSequenceWriteOptions());
+    bool IsOpen() const { return m_fp != nullptr; }
+
+    /**
+     * @brief 프레임 하나를 파일 끝에 추가한다.
+     * @param payloads 프레임 데이터 배열. 같은 형식을 여러 개 넣을 수 있다.
+     * @return 실패 시 false(`GvGetLastHelperErrorMessage()`). 기록 중 실패하면 쓰다 만 레코드는 잘라낸다.
+     */
+    bool AppendFrame(const GvSequenceFrameInfo& info, const GvSequencePayload* payloads, int count);
+    bool AppendFrame(const GvSequenceFrameInfo& info, const std::vector<GvSequencePayload>& payloads) {
+        return AppendFrame(info, payloads.data(), static_cast<int>(payloads.size()));
+    }
+
+    /** @brief 기록된 데이터를 운영체제로 넘긴다. */
+    bool Flush();
+    /** @brief 색인과 footer를 기록하고 파일을 닫는다. */
+    bool Close();
+
+    /** @brief 파일에 들어 있는 프레임 수(이어 쓰기 이전 프레임 포함). */
+    int GetFrameCount() const { return static_cast<int>(m_index.size()); }
+
+private:
+    FILE* m_fp = nullptr;
+    uint32_t m_alignment = 0;
+    uint64_t m_position = 0;
+    std::vector<detail::GvSequenceIndexEntry> m_index;
+    std::vector<uint8_t> m_zeros;
+};
+
+/**
+ * @brief 시퀀스 파일 읽기(메모리 매핑).
+ * @details 파일을 copy-on-write로 매핑하며 `GetPayload()`가 돌려주는 포인터는 매핑 메모리를 직접 가리킨다.
+ *          포인터와 이를 감싼 SDK 객체는 `Close()` 전까지 유효하다. 조회 함수는 여러 스레드에서 동시에 호출할 수 있다.
+ */
+class GvSequenceReader {
+public:
+    GvSequenceReader() = default;
+    ~GvSequenceReader() = default;
+    GvSequenceReader(const GvSequenceReader&) = delete;
+    GvSequenceReader& operator=(const GvSequenceReader&) = delete;
+
+    bool Open(const char* fileName);
+    void Close();
+    bool IsOpen() const { return m_file.IsOpen(); }
+    /** @brief 색인이 없어 프레임 레코드를 따라가며 색인을 복구했으면 true. */
+    bool IsRecovered() const { return m_recovered; }
+
+    int GetFrameCount() const { return static_cast<int>(m_index.size()); }
+    bool GetFrameInfo(int frame, GvSequenceFrameInfo& info) const;
+    uint64_t GetTimestamp(int frame) const;
+    /**
+     * @brief 타임스탬프가 `timestamp_ns` 이상인 첫 프레임을 찾는다.
+     * @details 프레임 타임스탬프가 기록 순서대로 증가한다고 가정한다(이진 탐색).
+     * @return 프레임 번호. 없으면 -1.
+     */
+    int FindFrame(uint64_t timestamp_ns) const;
+
+    bool GetPayload(int frame, int index, GvSequencePayload& payload) const;
+    /** @brief 프레임에서 `type`인 `nth`번째 데이터를 찾는다. */
+    bool FindPayload(int frame, GvSequencePayloadType::Enum type, GvSequencePayload& payload, int nth = 0) const;
+
+    /** @brief 프레임 레코드 전체를 미리 읽도록 요청한다(재생 시 다음 프레임에 사용). */
+    void Prefetch(int frame) const;
+    const GvMappedFile& GetMappedFile() const { return m_file; }
+
+private:
+    const unsigned char* Record(int frame, const char* caller) const;
+
+    GvMappedFile m_file;
+    std::vector<detail::GvSequenceIndexEntry> m_index;
+    uint64_t m_dataEnd = 0;
+    bool m_recovered = false;
+};
+
+/**
+ * @brief 매핑 메모리를 복사 없이 감싼 SDK 포인트맵 핸들을 만든다.
+ * @details 핸들은 데이터를 소유하지 않는다(`own_data = false`). 리더를 닫기 전에 `GvPointMap::Destroy()`로 해제한다.
+ *          매핑이 copy-on-write이므로 SDK가 데이터를 수정해도 파일은 바뀌지 않는다.
+ */
+inline GvPointMap GvWrapSdkPointMap(const GvSequencePayload& payload) {
+    if (payload.type != GvSequencePayloadType::PointMap || payload.data == nullptr) {
+        return GvPointMap();
+    }
+    return GvPointMap::Create(GvPointMapType::PointsOnly, payload.size,
+                              const_cast<double*>(static_cast<const double*>(payload.data)), false);
+}
+
+/** @brief `GvWrapSdkPointMap()`의 depth 맵 버전. */
+inline GvDepthMap GvWrapSdkDepthMap(const GvSequencePayload& payload) {
+    if (payload.type != GvSequencePayloadType::DepthMap || payload.data == nullptr) {
+        return GvDepthMap();
+    }
+    return GvDepthMap::Create(payload.size, const_cast<double*>(static_cast<const double*>(payload.data)), false);
+}
+
+/** @brief `GvWrapSdkPointMap()`의 confidence 맵 버전. */
+inline GvConfidenceMap GvWrapSdkConfidenceMap(const GvSequencePayload& payload) {
+    if (payload.type != GvSequencePayloadType::ConfidenceMap || payload.data == nullptr) {
+        return GvConfidenceMap();
+    }
+    return GvConfidenceMap::Create(payload.size, const_cast<double*>(static_cast<const double*>(payload.data)),
+                                   false);
+}
+
+/** @brief `GvWrapSdkPointMap()`의 이미지 버전. */
+inline GvImage GvWrapSdkImage(const GvSequencePayload& payload) {
+    if (payload.type != GvSequencePayloadType::Image || payload.data == nullptr) {
+        return GvImage();
+    }
+    return GvImage::Create(payload.image_type, payload.size,
+                           const_cast<unsigned char*>(static_cast<const unsigned char*>(payload.data)), false);
+}
+
+}  // namespace gv
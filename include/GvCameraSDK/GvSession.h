@@ -0,0 +1,345 @@
+#pragma once
+
+/**
+ * @file GvSession.h
+ * @brief 캡처 세션 기록/재생(GvCameraSDK::Processing).
+ * @details 세션 하나(장치 정보와 캘리브레이션, 캡처별 `GvCaptureOptions`와 원본 패턴 이미지, 2D 이미지,
+ *          실시간 2D 프레임과 frame ID)를 `GvSequence.h` 시퀀스 파일 하나에 시간 순서대로 기록하고,
+ *          가상 장치(`GvVirtualSingle`)로 원래 속도 또는 최대 속도로 재생한다.
+ *          - 기록: `Record*()`는 데이터를 복사해 큐에 넣고 바로 반환하며, 파일 쓰기는 기록 스레드가 한다.
+ *            대기 데이터가 예산을 넘으면 캡처는 자리가 날 때까지 기다리고, 실시간 프레임은 버린다(기본).
+ *          - 재생: 기록된 패턴을 `GvVirtualSingle::SetRawImageSource()`로 넣어 디코딩 -> 필터 -> 콜백을
+ *            다시 실행하고, 실시간 프레임은 매핑 메모리를 복사 없이 `GvRealtimeImageCallback`으로 전달한다.
+ *          같은 세션을 반복 재생하면 같은 입력으로 처리 지연과 SDK/보조 API 버전 간 결과를 비교할 수 있다.
+ *
+ *          파일 구성: 첫 프레임은 세션 정보, 이후 프레임마다 이벤트 하나. 각 프레임의 첫 데이터는
+ *          이벤트 기술자(`Blob`)이고, 이어서 이벤트 종류별 이미지가 온다. 세션 정보와 캡처 옵션은
+ *          구조체를 그대로 저장하므로 같은 SDK 버전에서만 복원된다.
+ *          재생 3D 캡처는 마지막 노출의 패턴 한 벌(`GetRawImage()`로 얻는 묶음)만 디코딩한다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+#include "GvSequence.h"
+#include "GvVirtualCamera.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gv {
+
+struct GvSessionEventType {
+    enum Enum {
+        None = 0,
+        /** @brief 세션 정보(파일의 첫 프레임). */
+        SessionInfo = 1,
+        /** @brief 3D 캡처: 캡처 옵션 + 원본 패턴 이미지 + 텍스처. */
+        Capture3D = 2,
+        /** @brief 2D 캡처: 캡처 옵션 + 이미지. */
+        Capture2D = 3,
+        /** @brief 실시간 2D 프레임(`GvRealtimeImageFrame`). */
+        RealtimeFrame = 4,
+    };
+    static const char* ToString(GvSessionEventType::Enum e);
+};
+
+/** @brief 세션을 기록한 장치 정보와 캘리브레이션. */
+struct GvSessionInfo {
+    GvDeviceInfo device{};
+    /** @brief `GvGetVersion()`. 가상 장치 세션은 빈 문자열. */
+    char sdk_version[64] = {};
+    GvSize resolution;
+    bool has_calibration = false;
+    /** @brief 3x3 행 우선 내부 파라미터, 왜곡 계수(k1, k2, p1, p2, k3), 4x4 외부 파라미터. */
+    float intrinsic[9] = {};
+    float distortion[5] = {};
+    float extrinsic[16] = {};
+    /** @brief 가상 장치 세션이면 true이고 아래 프로젝터 설정이 유효하다. */
+    bool is_virtual = false;
+    double focal_scale = 0.0;
+    int projector_width = 0;
+    double projector_focal_scale = 0.0;
+    double baseline = 0.0;
+    int phase_period = 0;
+    bool color = false;
+    /** @brief 기록 시작 시각(`GvNowNs()` 기준). `Open()`이 채운다. */
+    uint64_t start_ns = 0;
+};
+
+struct GvSessionRecordOptions {
+    GvSequenceWriteOptions sequence;
+    /**
+     * @brief 기록 대기 데이터 크기 합의 상한(bytes). 0이면 제한 없음.
+     * @details 예산보다 큰 이벤트 하나는 큐가 비어 있을 때 받아들인다.
+     */
+    uint64_t max_inflight_bytes = 512ull * 1024 * 1024;
+    /** @brief true면 예산이 찼을 때 실시간 프레임을 버린다. false면 캡처처럼 기다린다. */
+    bool drop_realtime_when_full = true;
+    /** @brief false면 3D 캡처의 원본 패턴을 기록하지 않는다(옵션과 텍스처만; 재생 불가). */
+    bool record_raw_images = true;
+};
+
+struct GvSessionRecordStats {
+    uint64_t captures_3d = 0;
+    uint64_t captures_2d = 0;
+    uint64_t realtime_frames = 0;
+    /** @brief 예산 초과로 버린 실시간 프레임 수. */
+    uint64_t dropped_realtime_frames = 0;
+    /** @brief 파일 쓰기에 실패한 이벤트 수. */
+    uint64_t failed = 0;
+    uint64_t pending = 0;
+    uint64_t inflight_bytes = 0;
+    uint64_t peak_inflight_bytes = 0;
+    uint64_t written_bytes = 0;
+    /** @brief 예산 때문에 `Record*()`가 기다린 총 시간. */
+    uint64_t blocked_ns = 0;
+};
+
+/**
+ * @brief 세션 기록기.
+ * @details `Record*()`는 여러 스레드(캡처 루프, 실시간 콜백)에서 동시에 호출할 수 있으며,
+ *          이벤트는 호출 순서대로 파일에 기록된다.
+ */
+class GvSessionRecorder {
+public:
+    GvSessionRecorder() = default;
+    /** @brief 남은 이벤트를 모두 기록하고 파일을 닫는다. */
+    ~GvSessionRecorder();
+    GvSessionRecorder(const GvSessionRecorder&) = delete;
+    GvSessionRecorder& operator=(const GvSessionRecorder&) = delete;
+
+    /** @return 실패 시 false(`GvGetLastHelperErrorMessage()`). */
+    bool Open(const char* fileName, const GvSessionInfo& info,
+              const GvSessionRecordOptions& options = GvSessionRecordOptions());
+    bool IsOpen() const;
+
+    /**
+     * @brief 3D 캡처를 기록한다. 버퍼는 기록기로 이동된다.
+     * @param rawImages 원본 패턴 묶음(`GetRawImage()` 순서).
+     * @param texture 2D 텍스처. 빈 버퍼면 기록하지 않는다.
+     * @param frame_id 0이면 기록기가 캡처 순번(1부터)을 붙인다.
+     * @param timestamp_ns 0이면 `GvNowNs()`.
+     */
+    bool RecordCapture3D(const GvSingle::GvCaptureOptions& options, std::vector<GvImageBuffer> rawImages,
+                         GvImageBuffer texture, uint64_t frame_id = 0, uint64_t timestamp_ns = 0);
+    /** @brief 2D 캡처를 기록한다. */
+    bool RecordCapture2D(const GvSingle::GvCaptureOptions& options, GvImageBuffer image, uint64_t frame_id = 0,
+                         uint64_t timestamp_ns = 0);
+    /**
+     * @brief 실시간 프레임을 복사해 기록한다(1채널 Mono8, 3채널 RGB8로 저장).
+     * @return 버렸거나 형식이 맞지 않으면 false.
+     */
+    bool RecordRealtimeFrame(const GvRealtimeImageFrame& frame, uint64_t timestamp_ns = 0);
+
+    /**
+     * @brief `GvSetRealtimeImageCallback()`에 바로 넘길 수 있는 콜백.
+     * @details `user_data`는 `GvSessionRecorder*`이다.
+     */
+    static void RealtimeImageCallback(const GvRealtimeImageFrame* frame, UserPtr user_data);
+
+    /** @brief 대기 중인 이벤트를 모두 기록하고 운영체제로 넘긴다. */
+    bool Flush();
+    /** @brief 남은 이벤트를 기록하고 색인을 쓴 뒤 닫는다. 기록 실패가 있었으면 false. */
+    bool Close();
+
+    GvSessionRecordStats GetStats() const;
+
+private:
+    struct Event {
+        GvSessionEventType::Enum type = GvSessionEventType::None;
+        GvSequenceFrameInfo info;
+        GvCameraID camera_id = CameraID_Left;
+        bool is_color = false;
+        /** @brief Capture3D에서 `images` 앞쪽의 원본 패턴 수(뒤에 텍스처가 올 수 있다). */
+        uint32_t raw_count = 0;
+        std::vector<GvImageBuffer> images;
+        uint64_t bytes = 0;
+    };
+
+    bool Push(Event event, bool blocking);
+    bool Write(const Event& event);
+    void WriterLoop();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workCv;
+    std::condition_variable m_spaceCv;
+    std::condition_variable m_idleCv;
+    std::deque<Event> m_events;
+    std::thread m_writer;
+    GvSequenceWriter m_sequence;
+    GvSessionRecordOptions m_options;
+    GvSessionRecordStats m_stats;
+    std::string m_sn;
+    uint64_t m_nextCaptureId = 1;
+    bool m_writing = false;
+    bool m_open = false;
+    bool m_stopping = false;
+    std::string m_firstError;
+};
+
+/** @brief 기록된 이벤트 하나. */
+struct GvSessionEvent {
+    GvSessionEventType::Enum type = GvSessionEventType::None;
+    uint64_t timestamp_ns = 0;
+    uint64_t frame_id = 0;
+    GvCameraID camera_id = CameraID_Left;
+    /** @brief Capture3D/Capture2D에서 true. */
+    bool has_options = false;
+    GvSingle::GvCaptureOptions options;
+    /** @brief Capture3D의 원본 패턴 수. */
+    int raw_image_count = 0;
+    /** @brief Capture3D 텍스처, Capture2D/RealtimeFrame 이미지가 있으면 true. */
+    bool has_image = false;
+    /** @brief RealtimeFrame의 `GvRealtimeImageFrame::is_color`. */
+    bool is_color = false;
+};
+
+/**
+ * @brief 세션 파일 읽기(메모리 매핑).
+ * @details 이미지 포인터는 매핑 메모리를 직접 가리키며 `Close()` 전까지 유효하다.
+ *          조회 함수는 여러 스레드에서 동시에 호출할 수 있다.
+ */
+class GvSessionPlayer {
+public:
+    bool Open(const char* fileName);
+    void Close();
+    bool IsOpen() const { return m_reader.IsOpen(); }
+
+    const GvSessionInfo& GetSessionInfo() const { return m_info; }
+    /** @brief 세션 정보 프레임을 뺀 이벤트 수. */
+    int GetEventCount() const { return m_reader.IsOpen() ? m_reader.GetFrameCount() - 1 : 0; }
+    bool GetEvent(int index, GvSessionEvent& event) const;
+    /** @brief Capture3D의 `nth`번째 원본 패턴. */
+    bool GetRawImage(int index, int nth, GvSequencePayload& image) const;
+    /** @brief Capture3D 텍스처 또는 Capture2D/RealtimeFrame 이미지. */
+    bool GetImage(int index, GvSequencePayload& image) const;
+    /** @brief RealtimeFrame을 기록 당시 형태로 만든다(`data`는 매핑 메모리). */
+    bool GetRealtimeFrame(int index, GvRealtimeImageFrame& frame) const;
+
+    /** @brief 이벤트 이미지 전체를 미리 읽도록 요청한다. */
+    void Prefetch(int index) const { m_reader.Prefetch(index + 1); }
+    const GvSequenceReader& GetReader() const { return m_reader; }
+
+private:
+    GvSequenceReader m_reader;
+    GvSessionInfo m_info;
+};
+
+struct GvSessionReplaySpeed {
+    enum Enum {
+        /** @brief 기록된 이벤트 간격(`time_scale` 배)을 지켜 재생한다. */
+        Original = 0,
+        /** @brief 대기 없이 연속으로 재생한다. */
+        Maximum = 1,
+    };
+    static const char* ToString(GvSessionReplaySpeed::Enum e);
+};
+
+struct GvSessionReplayOptions {
+    GvSessionReplaySpeed::Enum speed = GvSessionReplaySpeed::Original;
+    /** @brief `Original`에서 기록 간격에 곱하는 값(0.5면 2배속). */
+    double time_scale = 1.0;
+    int first_event = 0;
+    /** @brief 재생할 이벤트 수. 음수면 끝까지. */
+    int event_count = -1;
+    /** @brief 실시간 프레임을 전달할 콜백(`GvSetRealtimeImageCallback()`과 같은 형식). */
+    GvRealtimeImageCallback realtime_callback = nullptr;
+    UserPtr realtime_user_data = nullptr;
+};
+
+struct GvSessionReplayStats {
+    uint64_t events = 0;
+    uint64_t captures_3d = 0;
+    uint64_t captures_2d = 0;
+    uint64_t realtime_frames = 0;
+    /** @brief 가상 장치 캡처가 실패한 이벤트 수(첫 사유는 `GvGetLastHelperErrorMessage()`). */
+    uint64_t failed = 0;
+    uint64_t wall_ns = 0;
+    /** @brief `Original`에서 예정 시각보다 늦게 시작한 시간의 합/최대. */
+    uint64_t total_lateness_ns = 0;
+    uint64_t max_lateness_ns = 0;
+    /** @brief 이벤트 처리(캡처, 콜백) 시간의 합/최대. */
+    uint64_t total_process_ns = 0;
+    uint64_t max_process_ns = 0;
+};
+
+/**
+ * @brief 세션을 가상 장치로 재생한다.
+ * @details 재생 동안 `camera`의 원본 이미지 공급 함수를 세션으로 바꾸고, 끝나면 되돌린다(빈 함수).
+ *          `camera`는 열려 있어야 하며 해상도/프로젝터 설정이 세션과 같아야 한다(`GvSessionMakeVirtualConfig()`).
+ *          결과는 `camera`에 설정된 콜백과 `GetPointMap()` 등으로 받는다.
+ * @return 실패한 이벤트가 있으면 false.
+ */
+bool GvReplaySession(const GvSessionPlayer& player, GvVirtualSingle& camera,
+                     const GvSessionReplayOptions& options = GvSessionReplayOptions(),
+                     GvSessionReplayStats* stats = nullptr);
+
+/**
+ * @brief 세션 정보로 재생용 가상 장치 설정을 만든다.
+ * @details 가상 장치 세션은 기록 당시 설정을 그대로 복원한다. 실제 장치 세션은 해상도/초점거리/SN만
+ *          옮기고 프로젝터 설정은 기본값을 쓰므로, 재생은 처리 경로 부하 측정용이다.
+ */
+GvVirtualDeviceConfig GvSessionMakeVirtualConfig(const GvSessionInfo& info);
+
+/** @brief 가상 장치의 세션 정보. */
+GvSessionInfo GvSessionInfoFromVirtual(const GvVirtualSingle& camera);
+
+/**
+ * @brief 가상 장치의 직전 캡처를 기록한다.
+ * @param capture3d true면 `Capture()`, false면 `Capture2D()` 결과.
+ */
+bool GvSessionRecordLastCapture(GvSessionRecorder& recorder, const GvVirtualSingle& camera,
+                                const GvSingle::GvCaptureOptions& options, bool capture3d = true,
+                                uint64_t frame_id = 0);
+
+/**
+ * @brief SDK 장치의 세션 정보(장치 정보, SDK 버전, 해상도, 캘리브레이션)를 조회한다.
+ * @param deviceIndex `GvSystemGetDeviceInfo()` 인덱스.
+ */
+inline bool GvSessionInfoFromDevice(int deviceIndex, GvSingle& camera, GvSessionInfo& info) {
+    info = GvSessionInfo();
+    if (!GvSystemGetDeviceInfo(deviceIndex, &info.device)) {
+        detail::GvSetLastHelperError("GvSessionInfoFromDevice: GvSystemGetDeviceInfo failed");
+        return false;
+    }
+    const char* version = GvGetVersion();
+    if (version != nullptr) {
+        std::strncpy(info.sdk_version, version, sizeof(info.sdk_version) - 1);
+    }
+    camera.GetCameraResolution(info.resolution);
+    info.has_calibration = camera.GetIntrinsicParameters(info.intrinsic, info.distortion);
+    if (info.has_calibration && !camera.GetExtrinsicMatrix(info.extrinsic)) {
+        std::fill(info.extrinsic, info.extrinsic + 16, 0.0f);
+    }
+    return true;
+}
+
+/**
+ * @brief SDK 장치의 직전 캡처(원본 패턴, 텍스처)를 복사해 기록한다.
+ * @details 원본 패턴은 `GetRawImage()`가 실패할 때까지 순서대로 읽는다. 복사는 호출 스레드에서 하며
+ *          파일 쓰기는 기록 스레드가 한다. `SaveEncodedImagesData()`처럼 캡처마다 디렉터리를 만들지 않는다.
+ */
+inline bool GvSessionRecordLastCapture(GvSessionRecorder& recorder, GvSingle& camera,
+                                       const GvSingle::GvCaptureOptions& options, uint64_t frame_id = 0) {
+    std::vector<GvImageBuffer> rawImages;
+    for (uint16_t i = 0; i < 256; ++i) {
+        GvImage raw;
+        if (!camera.GetRawImage(raw, i) || !raw.IsValid()) {
+            break;
+        }
+        rawImages.push_back(GvCopyToImageBuffer(raw));
+    }
+    return recorder.RecordCapture3D(options, std::move(rawImages), GvCopyToImageBuffer(camera.GetImage()), frame_id);
+}
+
+}  // namespace gv
@@ -0,0 +1,189 @@
+#pragma once
+
+/**
+ * @file GvSharedRing.h
+ * @brief 캡처 결과를 다른 프로세스에 전달하는 공유 메모리 링(GvCameraSDK::Processing).
+ * @details 발행 프로세스가 이름 있는 공유 메모리(POSIX `shm_open`, Win32 `CreateFileMapping`)에 슬롯 N개짜리
+ *          링을 만들고 프레임마다 포인트맵/이미지/depth/confidence를 한 번 복사해 넣는다. 구독 프로세스는 같은
+ *          메모리를 읽기 전용으로 매핑해 복사 없이 `GvPointMap`/`GvImage` 등으로 감싼다(`GvWrapSdkPointMap()`).
+ *          - 잠금 없음: 슬롯마다 sequence 값(seqlock)을 두어 쓰는 중이면 홀수, 다 쓰면 짝수로 바꾼다.
+ *            구독자는 사용 전후 sequence를 비교해 읽는 동안 덮어써졌는지 확인한다(`IsValid()`).
+ *          - 발행은 구독자를 기다리지 않는다. 구독자는 최근 `slot_count - 1`개 프레임까지 안전하게 읽을 수 있고,
+ *            처리가 더 늦으면 해당 프레임은 덮어써져 `IsValid()`가 false가 된다.
+ *          - 데이터는 페이지(4096 bytes) 경계 슬롯 안에 64 bytes 정렬로 놓이며 배치는 SDK 핸들과 같다.
+ *          같은 아키텍처(바이트 순서, 64비트 lock-free atomic)의 프로세스끼리만 사용할 수 있다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+#include "GvSequence.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gv {
+
+struct GvSharedRingOptions {
+    /** @brief 슬롯 수(2 이상). 구독자가 늦어도 되는 프레임 수 + 1. */
+    int slot_count = 4;
+    /** @brief 슬롯 하나의 데이터 용량(bytes). `GvSharedRingCaptureBytes()`로 구할 수 있다. */
+    uint64_t slot_capacity = 0;
+};
+
+/** @brief 프레임 하나에 넣을 수 있는 데이터 수. */
+constexpr int kGvSharedRingMaxItems = 8;
+
+/**
+ * @brief 캡처 결과 한 프레임을 담는 데 필요한 슬롯 용량.
+ * @param textureType 텍스처가 없으면 `GvImageType::None`.
+ */
+uint64_t GvSharedRingCaptureBytes(const GvSize& resolution, GvImageType::Enum textureType, bool withDepth = false,
+                                  bool withConfidence = false);
+
+namespace detail {
+struct GvSharedMemory;
+}
+
+/**
+ * @brief 공유 메모리 링 발행자.
+ * @details 한 링에는 발행자가 하나여야 한다. `Publish()`는 한 스레드에서만 호출한다.
+ */
+class GvSharedRingPublisher {
+public:
+    GvSharedRingPublisher();
+    /** @brief `Close()`를 호출한다. */
+    ~GvSharedRingPublisher();
+    GvSharedRingPublisher(const GvSharedRingPublisher&) = delete;
+    GvSharedRingPublisher& operator=(const GvSharedRingPublisher&) = delete;
+
+    /**
+     * @brief 링을 만든다. 같은 이름의 링이 있으면 새로 만든다.
+     * @param name 영문/숫자/`_`/`-`만 사용(POSIX `/gv_ring_<name>`, Win32 `Local\gv_ring_<name>`).
+     * @return 실패 시 false(`GvGetLastHelperErrorMessage()`).
+     */
+    bool Create(const char* name, const GvSharedRingOptions& options);
+    /** @brief 매핑을 해제하고 이름을 제거한다(이미 매핑한 구독자는 계속 읽을 수 있다). */
+    void Close();
+    bool IsOpen() const { return m_memory != nullptr; }
+
+    /**
+     * @brief 프레임을 다음 슬롯에 복사하고 발행한다.
+     * @param frame_id 0이면 발행 sequence를 쓴다.
+     * @param timestamp_ns 0이면 `GvNowNs()`.
+     * @return 발행 sequence(1부터). 실패 시 0.
+     */
+    uint64_t Publish(uint64_t frame_id, uint64_t timestamp_ns, const GvSequencePayload* items, int count);
+    uint64_t Publish(uint64_t frame_id, uint64_t timestamp_ns, const std::vector<GvSequencePayload>& items) {
+        return Publish(frame_id, timestamp_ns, items.data(), static_cast<int>(items.size()));
+    }
+
+    uint64_t GetPublishedCount() const { return m_sequence; }
+    uint64_t GetSlotCapacity() const;
+
+private:
+    std::unique_ptr<detail::GvSharedMemory> m_memory;
+    uint64_t m_sequence = 0;
+};
+
+/**
+ * @brief 구독자가 본 프레임 하나.
+ * @details `items[i].data`는 공유 메모리를 직접 가리킨다(읽기 전용 매핑). 사용이 끝난 뒤
+ *          `GvSharedRingReader::IsValid()`로 읽는 동안 덮어써지지 않았는지 확인한다.
+ */
+struct GvSharedRingFrame {
+    uint64_t sequence = 0;
+    uint64_t frame_id = 0;
+    uint64_t timestamp_ns = 0;
+    /** @brief 발행 완료 시각(`GvNowNs()`, 같은 머신의 steady clock). */
+    uint64_t publish_ns = 0;
+    int item_count = 0;
+    GvSequencePayload items[kGvSharedRingMaxItems];
+
+    /** @brief `type`인 `nth`번째 데이터. 없으면 nullptr. */
+    const GvSequencePayload* Find(GvSequencePayloadType::Enum type, int nth = 0) const;
+};
+
+/**
+ * @brief 공유 메모리 링 구독자.
+ * @details 조회 함수는 여러 스레드에서 동시에 호출할 수 있다.
+ *          매핑은 읽기 전용이므로 감싼 SDK 객체로 데이터를 수정하면 접근 위반이 발생한다.
+ */
+class GvSharedRingReader {
+public:
+    GvSharedRingReader();
+    ~GvSharedRingReader();
+    GvSharedRingReader(const GvSharedRingReader&) = delete;
+    GvSharedRingReader& operator=(const GvSharedRingReader&) = delete;
+
+    /** @return 링이 없거나 형식이 다르면 false. 발행자가 링을 다시 만들면 다시 열어야 한다. */
+    bool Open(const char* name);
+    void Close();
+    bool IsOpen() const { return m_memory != nullptr; }
+
+    int GetSlotCount() const;
+    /** @brief 마지막으로 발행된 sequence. 아직 없으면 0. */
+    uint64_t GetLatestSequence() const;
+    /** @brief 링을 만든 시각. 발행자가 링을 다시 만들었는지 확인할 때 쓴다. */
+    uint64_t GetCreatedNs() const;
+
+    /** @brief 가장 최근 프레임을 가리킨다. 아직 발행된 프레임이 없으면 false. */
+    bool AcquireLatest(GvSharedRingFrame& frame) const;
+    /** @return 아직 발행되지 않았거나 이미 덮어써졌으면 false. */
+    bool Acquire(uint64_t sequence, GvSharedRingFrame& frame) const;
+    /**
+     * @brief `after`보다 새 프레임이 발행될 때까지 기다린 뒤 가장 최근 프레임을 가리킨다.
+     * @details 짧게 spin한 뒤 yield/sleep으로 대기한다(폴링).
+     * @param timeout_ms 0 이하이면 무기한.
+     */
+    bool WaitForNext(uint64_t after, GvSharedRingFrame& frame, int timeout_ms = 0) const;
+    /** @brief 프레임 슬롯이 아직 덮어써지지 않았으면 true. 데이터를 쓴 뒤(복사 후 등) 호출한다. */
+    bool IsValid(const GvSharedRingFrame& frame) const;
+
+private:
+    std::unique_ptr<detail::GvSharedMemory> m_memory;
+};
+
+/**
+ * @brief `GvSingle` 계산 콜백 결과(포인트맵, 텍스처, depth, confidence 중 유효한 것)를 발행한다.
+ * @return 발행 sequence. 실패 시 0.
+ */
+inline uint64_t GvSharedRingPublishCalculation(GvSharedRingPublisher& publisher,
+                                               const GvSingle::GvCalculationCallBackInfo& info,
+                                               uint64_t frame_id = 0) {
+    GvSingle::GvCalculationCallBackInfo handles = info;
+    GvSequencePayload items[4];
+    int count = 0;
+    if (handles.pointmap.IsValid()) {
+        items[count++] = GvSequencePayload::FromPointMap(handles.pointmap.GetPointDataConstPtr(),
+                                                         handles.pointmap.GetSize());
+    }
+    if (handles.image.IsValid()) {
+        items[count++] = GvSequencePayload::FromImage(handles.image.GetDataConstPtr(), handles.image.GetType(),
+                                                      handles.image.GetSize());
+    }
+    if (handles.depthmap.IsValid()) {
+        items[count++] = GvSequencePayload::FromDepthMap(handles.depthmap.GetDataConstPtr(), handles.depthmap.GetSize());
+    }
+    if (handles.confidencemap.IsValid()) {
+        items[count++] = GvSequencePayload::FromConfidenceMap(handles.confidencemap.GetDataConstPtr(),
+                                                              handles.confidencemap.GetSize());
+    }
+    return publisher.Publish(frame_id, 0, items, count);
+}
+
+/**
+ * @brief `GvSingle::SetCalculationCallBack()`에 바로 넘길 수 있는 발행 콜백.
+ * @details `ctx`는 `GvSharedRingPublisher*`이며 frame ID는 발행 sequence를 쓴다.
+ */
+inline void GvSharedRingCalculationCallBack(const GvSingle::GvCalculationCallBackInfo& info,
+                                            const GvSingle::GvCaptureOptions&, UserPtr ctx) {
+    if (ctx != nullptr) {
+        GvSharedRingPublishCalculation(*static_cast<GvSharedRingPublisher*>(ctx), info);
+    }
+}
+
+}  // namespace gv
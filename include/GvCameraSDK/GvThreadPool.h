@@ -0,0 +1,168 @@
+#pragma once
+
+/**
+ * @file GvThreadPool.h
+ * @brief 상주 처리 스레드 풀, CPU 선호도(affinity)와 NUMA 배치(GvCameraSDK::Processing).
+ * @details `GvParallelFor()`가 호출마다 스레드를 만드는 대신 미리 만든 작업 스레드를 쓰도록 한다.
+ *          - 처리 종류(`GvThreadSubsystem`: 디코딩/필터/I/O)별 기본 스레드 수를 따로 정한다.
+ *          - 작업 스레드를 `worker_cpus` 또는 `numa_node`의 CPU에 고정한다.
+ *          - NUMA 배치는 first-touch(처음 기록한 스레드의 노드)에 따른다. Processing 라이브러리에서 풀이 처음 기록하는
+ *            버퍼는 remap 테이블(`GvRemapTable`)뿐이다. `GvImageBuffer` 등 `GvBuffers.h` 버퍼는 할당할 때 호출 스레드가
+ *            0으로 채우므로 호출 스레드의 노드에 놓인다.
+ *          - `TouchPages()`는 호출자가 직접 할당해 아직 쓰지 않은 메모리(`malloc`/`mmap` 등)만 작업 스레드 노드에 배치한다.
+ *            이미 기록한 페이지는 옮기지 않는다.
+ *          - DLL 내부 스레드(그래버, 콜백 디스패치) 수와 배치는 DLL이 정한다.
+ *            `GvSystemInit(const GvSystemConfig&)`는 초기화 동안 호출 스레드를 `grabber_cpus`에 고정해
+ *            그 사이 DLL이 만드는 스레드가 선호도를 물려받게 한다(Linux 스레드 생성 규칙. Windows는 프로세스 선호도만 상속).
+ */
+
+#include "GvCameraAPI.h"
+#include "GvParallel.h"
+#include "GvPlatform.h"
+#include "GvRealtimeDispatch.h"
+#include "GvTrace.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gv {
+
+struct GvSystemConfig {
+    /** @brief 작업 스레드 수(호출 스레드 제외). 0 이하이면 CPU 목록 크기(없으면 하드웨어 동시 실행 수) - 1. */
+    int worker_threads = 0;
+    /** @brief 처리 종류별 기본 스레드 수(호출 스레드 포함). 0 이하이면 `worker_threads + 1`. */
+    int decode_threads = 0;
+    int filter_threads = 0;
+    int io_threads = 0;
+    /**
+     * @brief 작업 스레드를 고정할 CPU 번호(작업 스레드 i는 `worker_cpus[i % size]`).
+     * @details 비어 있으면 `numa_node`의 CPU, 그것도 없으면 고정하지 않는다.
+     */
+    std::vector<int> worker_cpus;
+    /** @brief `GvSystemInit()` 동안 호출 스레드를 고정할 CPU 번호(DLL 그래버/디스패치 스레드용). 비어 있으면 그대로. */
+    std::vector<int> grabber_cpus;
+    /** @brief 작업 스레드를 배치할 NUMA 노드. -1이면 지정하지 않는다. */
+    int numa_node = -1;
+    /**
+     * @brief `GvSystemInit()` 동안 호출 스레드에 적용할 우선순위(DLL 그래버/디스패치 스레드용, `GvRealtimeDispatch.h`).
+     * @details Linux에서는 그 사이 만들어지는 스레드가 스케줄링 정책/nice를 물려받는다. Windows는 상속되지 않는다.
+     */
+    GvThreadPriority::Enum grabber_priority = GvThreadPriority::Normal;
+    int grabber_realtime_priority = 0;
+};
+
+/**
+ * @brief 상주 작업 스레드 풀. `GvParallelExecutor`로 등록하면 `GvParallelFor()`가 사용한다.
+ * @details `Run()`은 호출 스레드도 작업을 실행하고, 끝나기 전에 남은 자기 작업을 직접 처리하므로
+ *          작업 안에서 다시 `GvParallelFor()`를 호출해도(중첩) 교착되지 않는다.
+ */
+class GvThreadPool : public GvParallelExecutor {
+public:
+    GvThreadPool() = default;
+    ~GvThreadPool() override;
+    GvThreadPool(const GvThreadPool&) = delete;
+    GvThreadPool& operator=(const GvThreadPool&) = delete;
+
+    /** @brief 작업 스레드를 만든다. 이미 실행 중이면 멈춘 뒤 다시 만든다. */
+    bool Start(const GvSystemConfig& config = GvSystemConfig());
+    /** @brief 대기 중인 작업을 마친 뒤 작업 스레드를 종료한다. */
+    void Stop();
+    bool IsRunning() const;
+
+    /** @brief 작업 스레드 수(호출 스레드 제외). */
+    int GetWorkerCount() const;
+    /** @brief 작업 스레드가 고정된 CPU 번호. 고정하지 않았으면 빈 목록. */
+    std::vector<int> GetWorkerCpus() const;
+
+    int GetThreadCount(GvThreadSubsystem subsystem) const override;
+    bool Run(GvThreadSubsystem subsystem, size_t tasks, void (*task)(void* ctx, size_t index), void* ctx) override;
+
+    /**
+     * @brief `[data, data + bytes)`의 페이지를 풀 스레드들이 나눠 0으로 기록한다(NUMA first-touch).
+     * @details 새로 할당해 아직 쓰지 않은 원시 메모리에 호출해야 작업 스레드의 노드에 배치된다. 내용은 0이 된다.
+     *          `std::vector`, `GvImageBuffer`처럼 할당하면서 0으로 채운 버퍼는 이미 할당 스레드 노드에 있으므로 효과가 없다.
+     *          `Run()`과 같이 호출 스레드도 일부를 기록하므로, 호출 스레드도 같은 노드에서 실행하는 것이 좋다.
+     */
+    void TouchPages(void* data, size_t bytes);
+
+private:
+    struct Job;
+
+    void WorkerMain(int index);
+    static bool RunOne(Job& job);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::deque<Job*> m_queue;
+    std::vector<std::thread> m_workers;
+    std::vector<int> m_cpus;
+    int m_threadCounts[ThreadSubsystem_Count] = {};
+    bool m_stop = false;
+    bool m_running = false;
+};
+
+/**
+ * @brief 전역 처리 스레드 풀을 시작하고 `GvParallelFor()` 실행기로 등록한다.
+ * @details 다시 호출하면 병렬 처리가 실행 중이지 않을 때 새 구성으로 다시 만든다.
+ */
+bool GvConfigureProcessingThreads(const GvSystemConfig& config);
+/** @brief 실행기 등록을 해제하고 전역 풀을 멈춘다. 이후 `GvParallelFor()`는 호출마다 스레드를 만든다. */
+void GvReleaseProcessingThreads();
+/** @brief 전역 풀. 시작하지 않았으면 nullptr. */
+GvThreadPool* GvGetProcessingThreadPool();
+
+/**
+ * @brief 호출자가 할당한 새 원시 메모리를 전역 풀 작업 스레드로 first-touch한다. 풀이 없으면 호출 스레드에서 0으로 채운다.
+ * @details 이미 기록한 페이지는 옮기지 않는다(`GvThreadPool::TouchPages()` 참고).
+ */
+void GvTouchProcessingMemory(void* data, size_t bytes);
+
+/** @brief 호출 스레드를 `cpus`에 고정한다. 빈 목록이면 아무것도 하지 않고 true. */
+bool GvSetCurrentThreadAffinity(const std::vector<int>& cpus);
+/** @brief 호출 스레드가 실행될 수 있는 CPU 번호. */
+bool GvGetCurrentThreadAffinity(std::vector<int>& cpus);
+/** @brief NUMA 노드의 CPU 번호(Linux: sysfs, Windows: `GetNumaNodeProcessorMask`, 프로세서 그룹 0). */
+bool GvGetNumaNodeCpus(int node, std::vector<int>& cpus);
+
+/**
+ * @brief 처리 스레드를 구성한 뒤 SDK를 초기화한다.
+ * @details `grabber_cpus`/`grabber_priority`가 있으면 `GvSystemInit()` 동안만 호출 스레드를 그 CPU에 고정하고
+ *          우선순위를 올린 뒤 원래대로 되돌린다. 우선순위 적용 실패(권한 부족)는 초기화를 막지 않는다.
+ *          SDK 초기화에 실패하면 처리 스레드도 해제한다. 종료 시 `GvSystemShutdown()` 후 `GvReleaseProcessingThreads()`.
+ */
+inline bool GvSystemInit(const GvSystemConfig& config) {
+    GV_TRACE_SCOPE("GvSystemInit", "system");
+    if (!GvConfigureProcessingThreads(config)) {
+        return false;
+    }
+    std::vector<int> saved;
+    const bool pin = !config.grabber_cpus.empty();
+    if (pin && (!GvGetCurrentThreadAffinity(saved) || !GvSetCurrentThreadAffinity(config.grabber_cpus))) {
+        GvReleaseProcessingThreads();
+        return false;
+    }
+    GvThreadPriorityState savedPriority;
+    const bool raise = config.grabber_priority != GvThreadPriority::Normal &&
+                       GvGetCurrentThreadPriority(savedPriority) &&
+                       GvSetCurrentThreadPriority(config.grabber_priority, config.grabber_realtime_priority);
+    const bool ok = GvSystemInit();
+    if (raise) {
+        GvRestoreCurrentThreadPriority(savedPriority);
+    }
+    if (pin) {
+        GvSetCurrentThreadAffinity(saved);
+    }
+    if (!ok) {
+        detail::GvSetLastHelperError(std::string("GvSystemInit failed: ") + GvGetLastErrorMessage());
+        GvReleaseProcessingThreads();
+    }
+    return ok;
+}
+
+}  // namespace gv
@@ -0,0 +1,349 @@
+#pragma once
+
+/**
+ * @file GvTrace.h
+ * @brief SDK 호출 구간 추적 및 Chrome/Perfetto trace JSON 내보내기(헤더 전용 보조 API).
+ * @details 구간(span)은 고정 크기 lock-free 링 버퍼에 기록되며,
+ *          버퍼가 가득 차면 가장 오래된 구간부터 덮어쓴다.
+ *          `GvTraceStart()` 전에는 모든 기록 함수가 원자 변수 1회 조회 후 반환한다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+#include "GvRealtimeHook.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace gv {
+
+struct GvTraceEvent {
+    /** @brief 구간 이름. 정적 수명 문자열(문자열 리터럴)이어야 한다. */
+    const char* name = nullptr;
+    /** @brief 구간 분류(system, device, capture, realtime, io 등). 정적 수명 문자열. */
+    const char* category = nullptr;
+    /** @brief 시작 시각(`GvNowNs()` 기준). */
+    uint64_t start_ns = 0;
+    uint64_t duration_ns = 0;
+    uint64_t thread_id = 0;
+    /** @brief 구간에서 이동한 데이터 크기(bytes). 0이면 기록하지 않는다. */
+    uint64_t bytes = 0;
+    /** @brief 캡처 일련번호/프레임 ID 등 보조 식별자. 0이면 기록하지 않는다. */
+    uint64_t id = 0;
+};
+
+/**
+ * @brief 다중 생산자 lock-free 링 버퍼.
+ * @details 생산자는 `fetch_add`로 슬롯을 확보하고 슬롯별 sequence 값으로
+ *          쓰기 완료를 표시한다. 읽기는 sequence가 쓰기 전후로 같은 슬롯만 채택한다.
+ */
+class GvTraceBuffer {
+public:
+    /** @param capacity 슬롯 개수. 2의 거듭제곱으로 올림된다. */
+    explicit GvTraceBuffer(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        m_mask = cap - 1;
+        m_slots.reset(new Slot[cap]);
+    }
+
+    size_t Capacity() const { return m_mask + 1; }
+
+    void Record(const GvTraceEvent& ev) {
+        const uint64_t idx = m_head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = m_slots[idx & m_mask];
+        slot.seq.store(idx * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(ev.name, std::memory_order_relaxed);
+        slot.category.store(ev.category, std::memory_order_relaxed);
+        slot.start_ns.store(ev.start_ns, std::memory_order_relaxed);
+        slot.duration_ns.store(ev.duration_ns, std::memory_order_relaxed);
+        slot.thread_id.store(ev.thread_id, std::memory_order_relaxed);
+        slot.bytes.store(ev.bytes, std::memory_order_relaxed);
+        slot.id.store(ev.id, std::memory_order_relaxed);
+        slot.seq.store(idx * 2 + 2, std::memory_order_release);
+    }
+
+    /** @brief 기록 완료된 구간을 시작 시각 순으로 복사한다. */
+    std::vector<GvTraceEvent> Snapshot() const {
+        std::vector<GvTraceEvent> out;
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        uint64_t first = head > Capacity() ? head - Capacity() : 0;
+        first = std::max<uint64_t>(first, m_base.load(std::memory_order_acquire));
+        out.reserve(static_cast<size_t>(head - first));
+        for (uint64_t idx = first; idx < head; ++idx) {
+            const Slot& slot = m_slots[idx & m_mask];
+            const uint64_t before = slot.seq.load(std::memory_order_acquire);
+            if (before != idx * 2 + 2) {
+                continue;
+            }
+            GvTraceEvent ev;
+            ev.name = slot.name.load(std::memory_order_relaxed);
+            ev.category = slot.category.load(std::memory_order_relaxed);
+            ev.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+            ev.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+            ev.thread_id = slot.thread_id.load(std::memory_order_relaxed);
+            ev.bytes = slot.bytes.load(std::memory_order_relaxed);
+            ev.id = slot.id.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != before) {
+                continue;
+            }
+            out.push_back(ev);
+        }
+        std::sort(out.begin(), out.end(),
+                  [](const GvTraceEvent& a, const GvTraceEvent& b) { return a.start_ns < b.start_ns; });
+        return out;
+    }
+
+    /** @brief 기록된 구간을 모두 버린다. 동시에 기록 중인 구간은 유실될 수 있다. */
+    void Clear() { m_base.store(m_head.load(std::memory_order_acquire), std::memory_order_release); }
+
+    /** @brief 마지막 `Clear()` 이후 링 버퍼 덮어쓰기로 유실된 구간 수. */
+    uint64_t DroppedCount() const {
+        const uint64_t recorded = m_head.load(std::memory_order_relaxed) - m_base.load(std::memory_order_relaxed);
+        return recorded > Capacity() ? recorded - Capacity() : 0;
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<const char*> category{nullptr};
+        std::atomic<uint64_t> start_ns{0};
+        std::atomic<uint64_t> duration_ns{0};
+        std::atomic<uint64_t> thread_id{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> id{0};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    uint64_t m_mask = 0;
+    std::atomic<uint64_t> m_head{0};
+    std::atomic<uint64_t> m_base{0};
+};
+
+namespace detail {
+
+struct GvTraceState {
+    std::atomic<bool> enabled{false};
+    std::atomic<GvTraceBuffer*> buffer{nullptr};
+    std::mutex mutex;
+    std::unique_ptr<GvTraceBuffer> storage;
+};
+
+inline GvTraceState& GvTraceGlobalState() {
+    static GvTraceState state;
+    return state;
+}
+
+inline void GvTraceWriteJsonString(std::FILE* fp, const char* s) {
+    std::fputc('"', fp);
+    for (; s != nullptr && *s != '\0'; ++s) {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', fp);
+            std::fputc(c, fp);
+        } else if (c < 0x20) {
+            std::fprintf(fp, "\\u%04x", c);
+        } else {
+            std::fputc(c, fp);
+        }
+    }
+    std::fputc('"', fp);
+}
+
+}  // namespace detail
+
+/**
+ * @brief 구간 추적을 시작한다.
+ * @param capacity 링 버퍼 슬롯 개수. 첫 호출에서만 적용되며 이후 호출은 기존 버퍼를 재사용한다.
+ */
+inline void GvTraceStart(size_t capacity = 1 << 16) {
+    detail::GvTraceState& state = detail::GvTraceGlobalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!state.storage) {
+        state.storage.reset(new GvTraceBuffer(capacity == 0 ? 1 : capacity));
+        state.buffer.store(state.storage.get(), std::memory_order_release);
+    }
+    state.enabled.store(true, std::memory_order_release);
+}
+
+/** @brief 구간 추적을 중지한다. 기록된 구간은 내보내기를 위해 유지된다. */
+inline void GvTraceStop() {
+    detail::GvTraceGlobalState().enabled.store(false, std::memory_order_release);
+}
+
+inline bool GvTraceIsEnabled() {
+    return detail::GvTraceGlobalState().enabled.load(std::memory_order_relaxed);
+}
+
+/** @brief 기록된 구간을 모두 버린다. */
+inline void GvTraceClear() {
+    GvTraceBuffer* buffer = detail::GvTraceGlobalState().buffer.load(std::memory_order_acquire);
+    if (buffer) {
+        buffer->Clear();
+    }
+}
+
+/**
+ * @brief 완료된 구간 하나를 기록한다.
+ * @param name 정적 수명 문자열.
+ * @param category 정적 수명 문자열.
+ */
+inline void GvTraceRecord(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns,
+                          uint64_t bytes = 0, uint64_t id = 0) {
+    detail::GvTraceState& state = detail::GvTraceGlobalState();
+    if (!state.enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    GvTraceBuffer* buffer = state.buffer.load(std::memory_order_acquire);
+    if (!buffer) {
+        return;
+    }
+    GvTraceEvent ev;
+    ev.name = name;
+    ev.category = category;
+    ev.start_ns = start_ns;
+    ev.duration_ns = end_ns > start_ns ? end_ns - start_ns : 0;
+    ev.thread_id = GvCurrentThreadId();
+    ev.bytes = bytes;
+    ev.id = id;
+    buffer->Record(ev);
+}
+
+/** @brief 기록된 구간을 시작 시각 순으로 조회한다. */
+inline std::vector<GvTraceEvent> GvTraceSnapshot() {
+    GvTraceBuffer* buffer = detail::GvTraceGlobalState().buffer.load(std::memory_order_acquire);
+    return buffer ? buffer->Snapshot() : std::vector<GvTraceEvent>();
+}
+
+/**
+ * @brief 기록된 구간을 Chrome trace JSON(`chrome://tracing`, Perfetto UI)으로 저장한다.
+ * @details `ts`/`dur`는 `GvNowNs()` 기준 microsecond이다. 애플리케이션 trace도
+ *          `steady_clock`을 쓰면 같은 타임라인에 겹쳐 볼 수 있다.
+ * @param path 출력 파일 경로.
+ * @return 성공 시 true.
+ */
+inline bool GvTraceWriteChromeJson(const char* path) {
+    if (path == nullptr) {
+        return false;
+    }
+    const std::vector<GvTraceEvent> events = GvTraceSnapshot();
+    std::FILE* fp = std::fopen(path, "wb");
+    if (!fp) {
+        return false;
+    }
+    std::vector<char> iobuf(1 << 20);
+    std::setvbuf(fp, iobuf.data(), _IOFBF, iobuf.size());
+
+    const unsigned long long pid = static_cast<unsigned long long>(GvCurrentProcessId());
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", fp);
+    bool first = true;
+    for (const GvTraceEvent& ev : events) {
+        std::fputs(first ? "\n" : ",\n", fp);
+        first = false;
+        std::fputs("{\"name\":", fp);
+        detail::GvTraceWriteJsonString(fp, ev.name ? ev.name : "unknown");
+        std::fputs(",\"cat\":", fp);
+        detail::GvTraceWriteJsonString(fp, ev.category ? ev.category : "gv");
+        std::fprintf(fp, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%llu,\"tid\":%llu",
+                     static_cast<double>(ev.start_ns) / 1000.0, static_cast<double>(ev.duration_ns) / 1000.0,
+                     pid, static_cast<unsigned long long>(ev.thread_id));
+        if (ev.bytes != 0 || ev.id != 0) {
+            std::fprintf(fp, ",\"args\":{\"bytes\":%llu,\"id\":%llu}", static_cast<unsigned long long>(ev.bytes),
+                         static_cast<unsigned long long>(ev.id));
+        }
+        std::fputc('}', fp);
+    }
+    std::fputs("\n]}\n", fp);
+    const bool ok = std::ferror(fp) == 0;
+    return std::fclose(fp) == 0 && ok;
+}
+
+/**
+ * @brief 생성~소멸 구간을 기록하는 RAII 객체.
+ * @details 추적 비활성 상태에서는 시각을 조회하지 않는다.
+ */
+class GvTraceScope {
+public:
+    GvTraceScope(const char* name, const char* category, uint64_t bytes = 0, uint64_t id = 0)
+        : m_name(name), m_category(category), m_bytes(bytes), m_id(id), m_start(GvTraceIsEnabled() ? GvNowNs() : 0) {}
+    ~GvTraceScope() {
+        if (m_start != 0) {
+            GvTraceRecord(m_name, m_category, m_start, GvNowNs(), m_bytes, m_id);
+        }
+    }
+    GvTraceScope(const GvTraceScope&) = delete;
+    GvTraceScope& operator=(const GvTraceScope&) = delete;
+
+    void SetBytes(uint64_t bytes) { m_bytes = bytes; }
+
+private:
+    const char* m_name;
+    const char* m_category;
+    uint64_t m_bytes;
+    uint64_t m_id;
+    uint64_t m_start;
+};
+
+#define GV_TRACE_CONCAT_INNER(a, b) a##b
+#define GV_TRACE_CONCAT(a, b) GV_TRACE_CONCAT_INNER(a, b)
+/** @brief 현재 블록 구간을 기록한다. 예: `GV_TRACE_SCOPE("GvSystemInit", "system");` */
+#define GV_TRACE_SCOPE(name, category) ::gv::GvTraceScope GV_TRACE_CONCAT(gv_trace_scope_, __LINE__)(name, category)
+
+namespace detail {
+
+inline uint64_t GvTraceRecorderBefore(const GvRealtimeImageFrame*, GvCameraID) {
+    return GvTraceIsEnabled() ? GvNowNs() : 0;
+}
+
+inline void GvTraceRecorderAfter(const GvRealtimeImageFrame* frame, GvCameraID side, uint64_t start) {
+    if (start == 0) {
+        return;
+    }
+    uint64_t bytes = 0;
+    uint64_t frameId = 0;
+    if (frame) {
+        bytes = static_cast<uint64_t>(frame->stride_bytes) * static_cast<uint64_t>(frame->height);
+        frameId = frame->frame_id;
+    }
+    GvTraceRecord(side == CameraID_Left ? "RealtimeDispatchLeft" : "RealtimeDispatchRight", "realtime", start,
+                  GvNowNs(), bytes, frameId);
+}
+
+}  // namespace detail
+
+/**
+ * @brief 실시간 훅(`GvRealtimeHook.h`)에 더할 디스패치 구간 기록기.
+ * @details 구간은 이 기록기보다 나중에 등록한 기록기와 사용자 콜백을 감싼다.
+ */
+inline const GvRealtimeRecorder* GvTraceRealtimeRecorder() {
+    static const GvRealtimeRecorder recorder = {&detail::GvTraceRecorderBefore, &detail::GvTraceRecorderAfter};
+    return &recorder;
+}
+
+/**
+ * @brief 디스패치 구간을 추적하는 실시간 이미지 콜백을 등록한다.
+ * @details 사용자 콜백에 대해서는 `GvSetRealtimeImageCallback()`과 같은 의미이며, 실행 구간이 `realtime` 분류로 기록된다.
+ *          같은 측면의 다른 기록기(전송 통계, 디스패치 지터)는 유지된다.
+ *          `nullptr`를 전달하면 추적 기록기와 사용자 콜백을 해제한다.
+ * @return 성공 시 true.
+ */
+inline bool GvSetTracedRealtimeImageCallback(GvCameraID camid, GvRealtimeImageCallback cb, UserPtr user_data) {
+    if (cb == nullptr) {
+        const bool removed = GvRemoveRealtimeRecorder(camid, GvTraceRealtimeRecorder());
+        return GvSetHookedRealtimeImageCallback(camid, nullptr, nullptr) && removed;
+    }
+    const bool added = GvAddRealtimeRecorder(camid, GvTraceRealtimeRecorder());
+    return GvSetHookedRealtimeImageCallback(camid, cb, user_data) && added;
+}
+
+}  // namespace gv
@@ -0,0 +1,281 @@
+#pragma once
+
+/**
+ * @file GvTransportStats.h
+ * @brief GigE/USB 전송 계층 통계(헤더 전용 보조 API).
+ * @details 장치(또는 실시간 측면 Left/Right)별 카운터를 원자 변수로 누적하고, 조회는 잠금 없이 스냅샷으로 읽는다.
+ *          - 수신 bytes, 패킷 수(프레임 bytes를 패킷 payload 크기로 나눈 추정값), 재전송/누락 패킷,
+ *            불완전 프레임, frame ID 건너뜀(누락 프레임), 처리량(MB/s), 프레임 전송 시간.
+ *          - 실시간 경로: `GvSetTransportRealtimeImageCallback()`으로 등록한 콜백 앞에서 프레임을 기록하고,
+ *            `GvGetTransportStats()`가 `GvGetRealtimeImageFpsInfo()`의 FPS/큐 드롭 값을 함께 돌려준다.
+ *            DLL이 완성된 프레임만 전달하므로 이 경로에서 셀 수 있는 손실은 데이터 없는 프레임과 frame ID 건너뜀뿐이고,
+ *            프레임 전송 시간은 기록하지 않는다(0).
+ *          - 캡처 경로: `GvCaptureProfiler`의 Acquisition 단계(노출 + 전송, bytes)를
+ *            `GvRecordCaptureTransport()`로 기록한다. 전송 시간은 이 경로에서만 채워진다.
+ *          DLL은 패킷 단위 재전송/누락 수를 공개하지 않는다. 해당 값은 드라이버 등 외부에서 얻은 경우
+ *          `RecordResends()`/`RecordMissingPackets()`로 넣는다. 캡처 경로에 예상 수신량을 주면 부족분을 누락 패킷으로 환산한다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvCaptureProfiler.h"
+#include "GvPlatform.h"
+#include "GvRealtimeHook.h"
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+
+namespace gv {
+
+struct GvTransportStats {
+    GvPortType port_type = PortType_Unknown;
+    /** @brief 패킷 수 추정에 쓴 payload 크기(bytes). */
+    uint32_t packet_bytes = 0;
+    uint64_t bytes_received = 0;
+    uint64_t packets = 0;
+    uint64_t resends = 0;
+    uint64_t missing_packets = 0;
+    uint64_t frames = 0;
+    /** @brief 데이터가 없거나 예상 크기보다 작은 프레임. */
+    uint64_t incomplete_frames = 0;
+    /** @brief frame ID가 건너뛴 수(실시간 경로). */
+    uint64_t missing_frames = 0;
+    /** @brief 첫 기록(또는 `Reset()`) 이후 평균 처리량(MB/s). */
+    double throughput_mbps = 0.0;
+    /** @brief 전송 시간이 기록된 프레임의 마지막/평균/최대 전송 시간(ms). 캡처 경로만 기록한다(실시간 경로는 0). */
+    double last_transfer_ms = 0.0;
+    double avg_transfer_ms = 0.0;
+    double max_transfer_ms = 0.0;
+    /** @brief 실시간 FPS 통계(`GvGetTransportStats()`만 채움). */
+    double camera_fps = 0.0;
+    double throttled_fps = 0.0;
+    uint64_t queue_dropped_frames = 0;
+    /** @brief 스냅샷 시각(`GvNowNs()` 기준). 두 스냅샷으로 구간 처리량을 구한다. */
+    uint64_t sample_ns = 0;
+};
+
+/** @brief 두 스냅샷 사이 구간 처리량(MB/s). */
+inline double GvTransportThroughputMBps(const GvTransportStats& previous, const GvTransportStats& current) {
+    if (current.sample_ns <= previous.sample_ns || current.bytes_received < previous.bytes_received) {
+        return 0.0;
+    }
+    return static_cast<double>(current.bytes_received - previous.bytes_received) /
+           (static_cast<double>(current.sample_ns - previous.sample_ns) / 1.0e9) / 1.0e6;
+}
+
+/** @brief 포트 형식별 기본 패킷 payload 크기: GigE 1500 MTU GVSP(1464), USB3 bulk(1024). */
+inline uint32_t GvDefaultTransportPacketBytes(GvPortType type) {
+    return type == PortType_GIGE ? 1464u : 1024u;
+}
+
+/**
+ * @brief 장치 하나의 전송 카운터. 기록/조회는 잠금 없이 여러 스레드에서 호출할 수 있다.
+ * @details 스냅샷은 카운터별 원자 읽기이므로 기록과 겹치면 항목 사이가 한 프레임 어긋날 수 있다.
+ */
+class GvTransportCounters {
+public:
+    explicit GvTransportCounters(GvPortType type = PortType_Unknown, uint32_t packet_bytes = 0) {
+        Configure(type, packet_bytes);
+    }
+    GvTransportCounters(const GvTransportCounters&) = delete;
+    GvTransportCounters& operator=(const GvTransportCounters&) = delete;
+
+    /** @param packet_bytes 0이면 `GvDefaultTransportPacketBytes(type)`. */
+    void Configure(GvPortType type, uint32_t packet_bytes = 0) {
+        m_type.store(type, std::memory_order_relaxed);
+        m_packetBytes.store(packet_bytes > 0 ? packet_bytes : GvDefaultTransportPacketBytes(type),
+                            std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 프레임 하나를 기록한다.
+     * @param bytes 받은 bytes.
+     * @param expected_bytes 예상 bytes. 0이면 비교하지 않는다. `bytes`가 더 작으면 불완전 프레임 + 누락 패킷.
+     * @param frame_id 0이 아니면 이전 ID와 비교해 건너뛴 프레임을 센다.
+     * @param transfer_ns 0이면 전송 시간을 기록하지 않는다.
+     */
+    void RecordFrame(uint64_t bytes, uint64_t expected_bytes = 0, uint64_t frame_id = 0, uint64_t transfer_ns = 0) {
+        const uint64_t now = GvNowNs();
+        uint64_t expectedStart = 0;
+        m_startNs.compare_exchange_strong(expectedStart, now, std::memory_order_relaxed);
+        const uint64_t packet = m_packetBytes.load(std::memory_order_relaxed);
+        m_frames.fetch_add(1, std::memory_order_relaxed);
+        m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        m_packets.fetch_add((bytes + packet - 1) / packet, std::memory_order_relaxed);
+        if (bytes == 0 || (expected_bytes > 0 && bytes < expected_bytes)) {
+            m_incompleteFrames.fetch_add(1, std::memory_order_relaxed);
+            if (expected_bytes > bytes) {
+                m_missingPackets.fetch_add((expected_bytes - bytes + packet - 1) / packet, std::memory_order_relaxed);
+            }
+        }
+        if (frame_id != 0) {
+            const uint64_t previous = m_lastFrameId.exchange(frame_id, std::memory_order_relaxed);
+            if (previous != 0 && frame_id > previous + 1) {
+                m_missingFrames.fetch_add(frame_id - previous - 1, std::memory_order_relaxed);
+            }
+        }
+        if (transfer_ns > 0) {
+            m_transferFrames.fetch_add(1, std::memory_order_relaxed);
+            m_transferNs.fetch_add(transfer_ns, std::memory_order_relaxed);
+            m_lastTransferNs.store(transfer_ns, std::memory_order_relaxed);
+            uint64_t max = m_maxTransferNs.load(std::memory_order_relaxed);
+            while (transfer_ns > max &&
+                   !m_maxTransferNs.compare_exchange_weak(max, transfer_ns, std::memory_order_relaxed)) {
+            }
+        }
+        m_lastNs.store(now, std::memory_order_relaxed);
+    }
+
+    void RecordResends(uint64_t packets) { m_resends.fetch_add(packets, std::memory_order_relaxed); }
+    void RecordMissingPackets(uint64_t packets) { m_missingPackets.fetch_add(packets, std::memory_order_relaxed); }
+
+    GvTransportStats Sample() const {
+        GvTransportStats s;
+        s.port_type = m_type.load(std::memory_order_relaxed);
+        s.packet_bytes = m_packetBytes.load(std::memory_order_relaxed);
+        s.bytes_received = m_bytes.load(std::memory_order_relaxed);
+        s.packets = m_packets.load(std::memory_order_relaxed);
+        s.resends = m_resends.load(std::memory_order_relaxed);
+        s.missing_packets = m_missingPackets.load(std::memory_order_relaxed);
+        s.frames = m_frames.load(std::memory_order_relaxed);
+        s.incomplete_frames = m_incompleteFrames.load(std::memory_order_relaxed);
+        s.missing_frames = m_missingFrames.load(std::memory_order_relaxed);
+        s.sample_ns = GvNowNs();
+        const uint64_t start = m_startNs.load(std::memory_order_relaxed);
+        const uint64_t last = m_lastNs.load(std::memory_order_relaxed);
+        if (start != 0 && last > start) {
+            s.throughput_mbps = static_cast<double>(s.bytes_received) / (static_cast<double>(last - start) / 1.0e9) /
+                                1.0e6;
+        }
+        const uint64_t transferFrames = m_transferFrames.load(std::memory_order_relaxed);
+        s.last_transfer_ms = static_cast<double>(m_lastTransferNs.load(std::memory_order_relaxed)) / 1.0e6;
+        s.max_transfer_ms = static_cast<double>(m_maxTransferNs.load(std::memory_order_relaxed)) / 1.0e6;
+        if (transferFrames > 0) {
+            s.avg_transfer_ms = static_cast<double>(m_transferNs.load(std::memory_order_relaxed)) /
+                                static_cast<double>(transferFrames) / 1.0e6;
+        }
+        return s;
+    }
+
+    /** @brief 카운터를 0으로 되돌린다(포트 형식/패킷 크기는 유지). */
+    void Reset() {
+        for (std::atomic<uint64_t>* c : {&m_bytes, &m_packets, &m_resends, &m_missingPackets, &m_frames,
+                                         &m_incompleteFrames, &m_missingFrames, &m_lastFrameId, &m_transferFrames,
+                                         &m_transferNs, &m_lastTransferNs, &m_maxTransferNs, &m_startNs, &m_lastNs}) {
+            c->store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<GvPortType> m_type{PortType_Unknown};
+    std::atomic<uint32_t> m_packetBytes{1024};
+    std::atomic<uint64_t> m_bytes{0};
+    std::atomic<uint64_t> m_packets{0};
+    std::atomic<uint64_t> m_resends{0};
+    std::atomic<uint64_t> m_missingPackets{0};
+    std::atomic<uint64_t> m_frames{0};
+    std::atomic<uint64_t> m_incompleteFrames{0};
+    std::atomic<uint64_t> m_missingFrames{0};
+    std::atomic<uint64_t> m_lastFrameId{0};
+    std::atomic<uint64_t> m_transferFrames{0};
+    std::atomic<uint64_t> m_transferNs{0};
+    std::atomic<uint64_t> m_lastTransferNs{0};
+    std::atomic<uint64_t> m_maxTransferNs{0};
+    std::atomic<uint64_t> m_startNs{0};
+    std::atomic<uint64_t> m_lastNs{0};
+};
+
+/**
+ * @brief 캡처 1회의 Acquisition 단계(노출 + 전송)를 기록한다.
+ * @details `GvCaptureProfiler::GetLastCaptureProfile()` 결과를 넘긴다. 실패한 캡처는 불완전 프레임으로 센다.
+ * @param expected_bytes 캡처 1회 예상 수신량(해상도 x 패턴 수 등). 0이면 비교하지 않는다.
+ */
+inline void GvRecordCaptureTransport(GvTransportCounters& counters, const GvCaptureProfile& profile,
+                                     uint64_t expected_bytes = 0) {
+    if (profile.capture_id == 0) {
+        return;
+    }
+    const GvCaptureStageRecord& acquisition = profile.Stage(CaptureStage_Acquisition);
+    const uint64_t bytes = profile.success ? acquisition.bytes : 0;
+    const uint64_t transfer = acquisition.IsValid() ? acquisition.end_ns - acquisition.start_ns : 0;
+    counters.RecordFrame(bytes, expected_bytes, 0, transfer);
+}
+
+namespace detail {
+
+inline GvTransportCounters* GvTransportRealtimeCountersArray() {
+    static GvTransportCounters counters[2];
+    return counters;
+}
+
+}  // namespace detail
+
+/** @brief 실시간 측면(Left/Right)의 전송 카운터. `Configure()`로 포트 형식을 지정한다. */
+inline GvTransportCounters& GvRealtimeTransportCounters(GvCameraID side) {
+    return detail::GvTransportRealtimeCountersArray()[side == CameraID_Right ? 1 : 0];
+}
+
+/**
+ * @brief 실시간 프레임 하나를 해당 측면 카운터에 기록한다. 사용자 콜백 안에서 직접 호출해도 된다.
+ * @details 수신량은 행 패딩을 뺀 payload(`width x channels x height`)이다. `data`가 없으면 불완전 프레임으로 센다.
+ *          전송 시간은 기록하지 않는다.
+ */
+inline void GvRecordRealtimeTransport(const GvRealtimeImageFrame* frame) {
+    if (frame == nullptr) {
+        return;
+    }
+    GvTransportCounters& counters = GvRealtimeTransportCounters(frame->camera_id);
+    const uint64_t payload = static_cast<uint64_t>(frame->width > 0 ? frame->width : 0) *
+                             static_cast<uint64_t>(frame->channels > 0 ? frame->channels : 0) *
+                             static_cast<uint64_t>(frame->height > 0 ? frame->height : 0);
+    counters.RecordFrame(frame->data != nullptr ? payload : 0, 0, frame->frame_id);
+}
+
+namespace detail {
+
+inline uint64_t GvTransportRecorderBefore(const GvRealtimeImageFrame* frame, GvCameraID) {
+    GvRecordRealtimeTransport(frame);
+    return 0;
+}
+
+}  // namespace detail
+
+/** @brief 실시간 훅(`GvRealtimeHook.h`)에 더할 전송 통계 기록기. 사용자 콜백을 바꾸지 않고 켤 때 쓴다. */
+inline const GvRealtimeRecorder* GvTransportRealtimeRecorder() {
+    static const GvRealtimeRecorder recorder = {&detail::GvTransportRecorderBefore, nullptr};
+    return &recorder;
+}
+
+/**
+ * @brief 전송 통계 기록기를 실시간 훅에 더하고 사용자 콜백을 등록한다.
+ * @details 사용자 콜백에 대해서는 `GvSetRealtimeImageCallback()`과 같은 의미이며, 사용자 콜백 전에 프레임을 기록한다.
+ *          같은 측면의 다른 기록기(디스패치 지터, 추적)는 유지된다. `cb`가 `nullptr`이면 사용자 콜백 없이 기록만 하고,
+ *          기록만 끄려면 `GvRemoveRealtimeRecorder(camid, GvTransportRealtimeRecorder())`, 모두 해제는 `GvClearRealtimeHook()`.
+ */
+inline bool GvSetTransportRealtimeImageCallback(GvCameraID camid, GvRealtimeImageCallback cb, UserPtr user_data) {
+    const bool added = GvAddRealtimeRecorder(camid, GvTransportRealtimeRecorder());
+    return GvSetHookedRealtimeImageCallback(camid, cb, user_data) && added;
+}
+
+/**
+ * @brief 실시간 측면의 전송 통계를 조회한다. `GvGetRealtimeImageFpsInfo()`의 FPS/큐 드롭 값을 함께 채운다.
+ * @param camid 카메라 측면(Left/Right).
+ * @return FPS 조회까지 성공하면 true. FPS 조회가 실패해도 전송 카운터는 채운다.
+ */
+inline bool GvGetTransportStats(GvCameraID camid, GvTransportStats* stats) {
+    if (stats == nullptr || (camid != CameraID_Left && camid != CameraID_Right)) {
+        detail::GvSetLastHelperError("GvGetTransportStats: invalid arguments");
+        return false;
+    }
+    *stats = GvRealtimeTransportCounters(camid).Sample();
+    GvRealtimeImageFpsInfo fps;
+    if (!GvGetRealtimeImageFpsInfo(camid, &fps)) {
+        return false;
+    }
+    stats->camera_fps = fps.camera_fps;
+    stats->throttled_fps = fps.throttled_fps;
+    stats->queue_dropped_frames = fps.queue_dropped_frames;
+    return true;
+}
+
+}  // namespace gv
@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * @file GvUndistort.h
+ * @brief 2D 이미지 왜곡 보정/스테레오 평행화 remap 테이블(GvCameraSDK::Processing).
+ * @details 렌즈 모델(`GetIntrinsicParameters()`의 3x3 내부 파라미터 + k1, k2, p1, p2, k3)로 출력 픽셀마다
+ *          원본 좌표를 한 번 계산해 고정소수점 테이블(정수 좌표 + 1/256 단위 bilinear 가중치)로 보관한다.
+ *          적용 시에는 다항식 계산 없이 테이블을 따라 정수 bilinear 보간만 하며, 행 단위로 병렬 처리한다.
+ *          - 장치/ROI마다 한 번 만들고(`GvBuildUndistortTable()`, `GvBuildRectifyTables()`) 캡처 결과
+ *            (`GvImage`, `GvImageBuffer`)와 실시간 프레임(`GvRealtimeImageFrame`)에 재사용한다.
+ *          - Mono8/RGB8/BGR8(채널 1/3)을 지원한다. 원본 범위를 벗어난 출력 픽셀은 0이다.
+ *          - 스테레오 평행화는 두 카메라를 평균 회전으로 맞춘 뒤 기준선이 x(또는 y)축이 되도록 회전한다
+ *            (OpenCV `stereoRectify(alpha = -1)`과 같은 방식, 새 초점거리는 두 카메라 중 작은 값).
+ */
+
+#include "GvBuffers.h"
+#include "GvCalibrationCache.h"
+#include "GvCameraAPI.h"
+#include "GvPlatform.h"
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gv {
+
+struct GvRemapOptions {
+    /** @brief 만들 출력 영역(전체 해상도 기준 보정 좌표). 크기가 0이면 전체 해상도. */
+    GvROI output_roi;
+    /** @brief 입력 이미지가 담고 있는 센서 영역(ROI 캡처). 크기가 0이면 전체 해상도. */
+    GvROI source_roi;
+    /** @brief 테이블 생성 스레드 수(0 이하이면 하드웨어 동시 실행 수). */
+    int threads = 0;
+};
+
+/** @brief 출력 이미지의 투영(카메라 행렬 + 회전). 왜곡만 보정할 때는 원본 행렬 + 단위 회전. */
+struct GvRemapProjection {
+    /** @brief 출력 카메라 행렬(3x3 행 우선). */
+    double camera_matrix[9] = {};
+    /** @brief 원본 카메라 좌표계 -> 출력 좌표계 회전(OpenCV `R1`/`R2`, 3x3 행 우선). */
+    double rotation[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+};
+
+namespace detail {
+
+/**
+ * @brief 출력 픽셀 하나의 원본 위치(왼쪽 위 정수 좌표 + 1/256 단위 소수부). x < 0이면 원본 밖.
+ * @details 가장자리는 (x, y)를 [0, w - 2]x[0, h - 2]로 당기고 소수부를 256으로 맞춰 분기 없이 보간한다.
+ */
+struct GvRemapEntry {
+    int16_t x;
+    int16_t y;
+    uint16_t fx;
+    uint16_t fy;
+};
+
+/**
+ * @brief 원소를 기본 초기화(POD는 초기화하지 않음)하는 할당자.
+ * @details `resize()`가 페이지를 0으로 채우지 않으므로 처음 기록하는 스레드(풀 작업 스레드)의 NUMA 노드에 놓인다.
+ */
+template <typename T>
+struct GvDefaultInitAllocator : std::allocator<T> {
+    template <typename U>
+    struct rebind {
+        using other = GvDefaultInitAllocator<U>;
+    };
+    GvDefaultInitAllocator() = default;
+    template <typename U>
+    GvDefaultInitAllocator(const GvDefaultInitAllocator<U>&) noexcept {}
+
+    template <typename U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible<U>::value) {
+        ::new (static_cast<void*>(p)) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+}  // namespace detail
+
+class GvRemapTable {
+public:
+    bool IsValid() const { return !m_entries.empty(); }
+    /** @brief 입력 이미지 크기(`source_roi`). */
+    GvSize GetSourceSize() const { return m_sourceSize; }
+    /** @brief 출력 이미지 크기(`output_roi`). */
+    GvSize GetOutputSize() const { return m_outputSize; }
+    /** @brief 테이블 메모리(bytes). */
+    size_t GetBytes() const { return m_entries.size() * sizeof(detail::GvRemapEntry); }
+
+    /**
+     * @brief `src`(원본 크기, 채널 `channels`)를 `dst`(출력 크기)로 remap한다.
+     * @param srcStride, dstStride 행 간격(bytes).
+     */
+    bool Apply(const unsigned char* src, int srcStride, int channels, unsigned char* dst, int dstStride,
+               int threads = 0) const;
+    /** @brief `dst`는 형식/크기가 같으면 재사용하고 아니면 새로 만든다. */
+    bool Apply(const GvImageBuffer& src, GvImageBuffer& dst, int threads = 0) const;
+    /** @brief 실시간 프레임(`stride_bytes` 반영)을 remap한다. Mono면 Mono8, 컬러면 RGB8 출력. */
+    bool Apply(const GvRealtimeImageFrame& frame, GvImageBuffer& dst, int threads = 0) const;
+
+private:
+    friend bool GvBuildRemapTable(const GvCameraCalibration&, const GvRemapProjection&, const GvSize&, GvRemapTable&,
+                                  const GvRemapOptions&);
+
+    GvSize m_sourceSize;
+    GvSize m_outputSize;
+    // 생성 시 GvParallelFor 작업 스레드가 처음 기록한다(first-touch).
+    std::vector<detail::GvRemapEntry, detail::GvDefaultInitAllocator<detail::GvRemapEntry>> m_entries;
+};
+
+/**
+ * @brief 임의 투영으로 remap 테이블을 만든다.
+ * @param camera 원본 렌즈 모델(내부 파라미터, 왜곡 계수).
+ * @param resolution 센서 전체 해상도.
+ */
+bool GvBuildRemapTable(const GvCameraCalibration& camera, const GvRemapProjection& projection,
+                       const GvSize& resolution, GvRemapTable& table, const GvRemapOptions& options = GvRemapOptions());
+
+/** @brief 같은 카메라 행렬로 왜곡만 보정하는 테이블을 만든다. */
+bool GvBuildUndistortTable(const GvCameraCalibration& camera, const GvSize& resolution, GvRemapTable& table,
+                           const GvRemapOptions& options = GvRemapOptions());
+
+struct GvStereoRectification {
+    /** @brief 좌/우 출력 투영(공통 카메라 행렬 + 평행화 회전). */
+    GvRemapProjection left;
+    GvRemapProjection right;
+    /** @brief 평행화 좌표계에서의 기준선 길이(외부 파라미터 단위). */
+    double baseline = 0.0;
+    /** @brief true면 기준선이 세로(y)축. */
+    bool vertical = false;
+};
+
+/**
+ * @brief 좌/우 외부 파라미터로 평행화 회전과 공통 카메라 행렬을 구한다.
+ * @details 외부 파라미터는 공통 좌표계 -> 카메라 좌표계 변환(4x4 행 우선 [R|t])으로 해석한다.
+ */
+bool GvComputeStereoRectification(const GvCameraCalibration& left, const GvCameraCalibration& right,
+                                  GvStereoRectification& rectification);
+
+/** @brief `GvStereo` 캘리브레이션(`camera_count == 2`)으로 좌/우 평행화 테이블을 만든다. */
+bool GvBuildRectifyTables(const GvDeviceCalibration& calibration, GvRemapTable& left, GvRemapTable& right,
+                          const GvRemapOptions& options = GvRemapOptions(),
+                          GvStereoRectification* rectification = nullptr);
+
+/** @brief SDK 이미지(`GetImage()` 등)를 remap한다. 핸들은 읽기만 한다. */
+inline bool GvRemapImage(const GvRemapTable& table, GvImage image, GvImageBuffer& dst, int threads = 0) {
+    if (!image.IsValid()) {
+        detail::GvSetLastHelperError("GvRemapImage: invalid image");
+        return false;
+    }
+    const GvSize size = image.GetSize();
+    const int channels = static_cast<int>(GvImageBufferPixelSize(image.GetType()));
+    if (size != table.GetSourceSize() || channels == 0) {
+        detail::GvSetLastHelperError("GvRemapImage: image does not match table");
+        return false;
+    }
+    if (dst.GetType() != image.GetType() || dst.GetSize() != table.GetOutputSize()) {
+        dst = GvImageBuffer::Create(image.GetType(), table.GetOutputSize());
+    }
+    return table.Apply(image.GetDataConstPtr(), size.width * channels, channels, dst.GetDataPtr(),
+                       static_cast<int>(dst.GetStrideBytes()), threads);
+}
+
+}  // namespace gv
@@ -0,0 +1,807 @@
+#pragma once
+
+/**
+ * @file GvVirtualCamera.h
+ * @brief 소프트웨어 구조광 가상 장치(헤더 전용 보조 API).
+ * @details 합성 장면(평면 + 구)에 프로젝터 패턴(Gray code + N-step 위상천이)을 투영한
+ *          원본 패턴 이미지를 렌더링하고, 디코딩 -> 삼각측량 -> HDR 합성 -> 후처리 필터 ->
+ *          콜백까지 `GvSingle::Capture()`와 같은 순서로 실행한다.
+ *          카메라 없이 처리량/지연 부하 테스트를 하기 위한 용도이며 DLL 장치 목록
+ *          (`GvSystemGetDeviceInfo()`)과는 별개의 `GvVirtualSystem*()` 목록으로 관리된다.
+ *          `GvVirtualSingle::SetRawImageSource()`로 렌더링 대신 기록된 원본 패턴을 넣을 수 있다(GvSession.h 재생).
+ *
+ *          좌표계: 카메라 광학 중심이 원점, +z가 시선 방향, 프로젝터는 +x 방향으로
+ *          `baseline`만큼 떨어져 같은 방향을 본다. 포인트/depth 단위는 `meter`이다.
+ *          패턴 부호화/복원은 `GvReconstruction.h`를 사용하므로 `GvCameraSDK::Processing`을 링크해야 한다.
+ */
+
+#include "GvBuffers.h"
+#include "GvCameraAPI.h"
+#include "GvColoredPointMap.h"
+#include "GvDeviceDiscovery.h"
+#include "GvParallel.h"
+#include "GvPlatform.h"
+#include "GvPointMapFilter.h"
+#include "GvReconstruction.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gv {
+
+struct GvVirtualSphere {
+    double center[3] = {0.0, 0.0, 0.8};
+    double radius = 0.05;
+    double albedo = 0.8;
+};
+
+struct GvVirtualScene {
+    /** @brief 광축 위 배경 평면 거리(m). */
+    double plane_distance = 0.9;
+    /** @brief 배경 평면 기울기(dz/dx, dz/dy). */
+    double plane_slope_x = 0.15;
+    double plane_slope_y = 0.05;
+    double plane_albedo = 0.6;
+    /** @brief 3D 패턴 촬영 시 주변광 비율(0~1). */
+    double ambient_3d = 0.05;
+    /** @brief 프로젝터 없이 2D 촬영 시 주변광 비율(0~1). */
+    double ambient_2d = 0.5;
+    std::vector<GvVirtualSphere> spheres;
+
+    /** @brief 배경 평면 앞에 구 3개를 둔 기본 장면. */
+    static GvVirtualScene Default() {
+        GvVirtualScene scene;
+        GvVirtualSphere s;
+        s.center[0] = -0.08; s.center[1] = 0.02; s.center[2] = 0.75; s.radius = 0.06; s.albedo = 0.85;
+        scene.spheres.push_back(s);
+        s.center[0] = 0.07; s.center[1] = -0.05; s.center[2] = 0.80; s.radius = 0.04; s.albedo = 0.4;
+        scene.spheres.push_back(s);
+        s.center[0] = 0.05; s.center[1] = 0.08; s.center[2] = 0.70; s.radius = 0.03; s.albedo = 0.95;
+        scene.spheres.push_back(s);
+        return scene;
+    }
+};
+
+struct GvVirtualDeviceConfig {
+    std::string name = "GvVirtualCamera";
+    std::string sn = "VIRTUAL-0000";
+    std::string firmware_version = "virtual";
+    GvSize resolution{1280, 1024};
+    /** @brief 카메라 초점거리 = `resolution.width * focal_scale`(pixel). */
+    double focal_scale = 1.2;
+    /** @brief 프로젝터 가로 해상도(column 수)와 초점거리 배율. */
+    int projector_width = 1280;
+    double projector_focal_scale = 1.2;
+    /** @brief 카메라-프로젝터 기준선(m). */
+    double baseline = 0.12;
+    /** @brief 위상천이 주기(프로젝터 pixel). */
+    int phase_period = 32;
+    /** @brief 지원 캡처 모드 비트마스크. Fast=3-step, Normal=4-step, Ultra=6-step. */
+    int support_capture_mode = CaptureMode_Fast | CaptureMode_Normal | CaptureMode_Ultra;
+    /** @brief true면 2D 텍스처를 RGB8로, false면 Mono8로 만든다. */
+    bool color = false;
+    /** @brief 게인 1 기준 센서 잡음 표준편차(gray level). */
+    double noise_sigma = 1.0;
+    /** @brief 패턴 1장당 모사할 취득(노출+전송) 시간(us). 0이면 대기하지 않는다. */
+    uint32_t frame_time_us = 0;
+    /** @brief 렌더링/디코딩 작업 스레드 수(0이면 하드웨어 동시 실행 수). */
+    int worker_threads = 0;
+    int workingdist_near_mm = 400;
+    int workingdist_far_mm = 1500;
+    GvVirtualScene scene = GvVirtualScene::Default();
+};
+
+namespace detail {
+
+struct GvVirtualSystemState {
+    std::mutex mutex;
+    std::vector<GvVirtualDeviceConfig> devices;
+};
+
+inline GvVirtualSystemState& GvVirtualSystemGlobalState() {
+    static GvVirtualSystemState state;
+    return state;
+}
+
+inline void GvVirtualCopyString(char* dst, size_t capacity, const std::string& src) {
+    const size_t n = std::min(capacity - 1, src.size());
+    std::memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+}
+
+/** @brief (seed, index) 기반 결정적 잡음. 평균 0, 표준편차 약 1. */
+inline double GvVirtualNoise(uint64_t seed, uint64_t index) {
+    uint64_t x = seed ^ (index * 0x9E3779B97F4A7C15ull);
+    double sum = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdull;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ull;
+        x ^= x >> 33;
+        sum += static_cast<double>(x >> 11) / static_cast<double>(1ull << 53);
+    }
+    // 균등분포 4개 합의 분산은 4/12이므로 sqrt(3)을 곱해 표준편차를 1로 맞춘다.
+    return (sum - 2.0) * 1.7320508075688772;
+}
+
+/** @brief 카메라 픽셀 1개의 광선 추적 결과. */
+struct GvVirtualHit {
+    bool valid = false;
+    double point[3] = {0.0, 0.0, 0.0};
+    double albedo = 0.0;
+    /** @brief 프로젝터 조명 세기(Lambert, 그림자 반영). */
+    double lit = 0.0;
+    /** @brief 프로젝터 column(연속값). 조명이 닿지 않으면 음수. */
+    double projector_column = -1.0;
+};
+
+inline double GvVirtualIntersect(const GvVirtualScene& scene, const double origin[3], const double dir[3],
+                                 double normal[3], double* albedo) {
+    double best = std::numeric_limits<double>::infinity();
+    // 평면: z = d + sx*x + sy*y  ->  sx*x + sy*y - z + d = 0
+    const double denom = scene.plane_slope_x * dir[0] + scene.plane_slope_y * dir[1] - dir[2];
+    if (std::fabs(denom) > 1e-12) {
+        const double t = -(scene.plane_slope_x * origin[0] + scene.plane_slope_y * origin[1] - origin[2] +
+                           scene.plane_distance) /
+                         denom;
+        if (t > 1e-9) {
+            best = t;
+            const double len = std::sqrt(scene.plane_slope_x * scene.plane_slope_x +
+                                         scene.plane_slope_y * scene.plane_slope_y + 1.0);
+            // 카메라 쪽(-z)을 향하는 법선
+            normal[0] = scene.plane_slope_x / len;
+            normal[1] = scene.plane_slope_y / len;
+            normal[2] = -1.0 / len;
+            *albedo = scene.plane_albedo;
+        }
+    }
+    for (const GvVirtualSphere& s : scene.spheres) {
+        const double oc[3] = {origin[0] - s.center[0], origin[1] - s.center[1], origin[2] - s.center[2]};
+        const double a = dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2];
+        const double b = oc[0] * dir[0] + oc[1] * dir[1] + oc[2] * dir[2];
+        const double c = oc[0] * oc[0] + oc[1] * oc[1] + oc[2] * oc[2] - s.radius * s.radius;
+        const double disc = b * b - a * c;
+        if (disc < 0.0) {
+            continue;
+        }
+        const double t = (-b - std::sqrt(disc)) / a;
+        if (t > 1e-9 && t < best) {
+            best = t;
+            for (int k = 0; k < 3; ++k) {
+                normal[k] = (origin[k] + t * dir[k] - s.center[k]) / s.radius;
+            }
+            *albedo = s.albedo;
+        }
+    }
+    return best;
+}
+
+}  // namespace detail
+
+/**
+ * @brief 가상 장치를 등록한다.
+ * @return 등록된 가상 장치 인덱스.
+ */
+inline int GvVirtualSystemAddDevice(const GvVirtualDeviceConfig& config) {
+    detail::GvVirtualSystemState& state = detail::GvVirtualSystemGlobalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.devices.push_back(config);
+    return static_cast<int>(state.devices.size()) - 1;
+}
+
+/** @brief 등록된 가상 장치를 모두 제거한다. 이미 생성된 `GvVirtualSingle`은 설정 사본으로 계속 동작한다. */
+inline void GvVirtualSystemClearDevices() {
+    detail::GvVirtualSystemState& state = detail::GvVirtualSystemGlobalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.devices.clear();
+}
+
+/** @brief `GvSystemGetDeviceCount()`와 같은 의미의 가상 장치 개수. */
+inline int GvVirtualSystemGetDeviceCount() {
+    detail::GvVirtualSystemState& state = detail::GvVirtualSystemGlobalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return static_cast<int>(state.devices.size());
+}
+
+inline bool GvVirtualSystemGetDeviceConfig(int deviceIndex, GvVirtualDeviceConfig* config) {
+    detail::GvVirtualSystemState& state = detail::GvVirtualSystemGlobalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (config == nullptr || deviceIndex < 0 || deviceIndex >= static_cast<int>(state.devices.size())) {
+        detail::GvSetLastHelperError("GvVirtualSystemGetDeviceConfig: invalid device index");
+        return false;
+    }
+    *config = state.devices[static_cast<size_t>(deviceIndex)];
+    return true;
+}
+
+namespace detail {
+
+inline void GvVirtualFillDeviceInfo(const GvVirtualDeviceConfig& config, const std::string& port, GvDeviceInfo* pinfo) {
+    std::memset(pinfo, 0, sizeof(GvDeviceInfo));
+    GvVirtualCopyString(pinfo->name, sizeof(pinfo->name), config.name);
+    GvVirtualCopyString(pinfo->sn, sizeof(pinfo->sn), config.sn);
+    GvVirtualCopyString(pinfo->factroydate, sizeof(pinfo->factroydate), "virtual");
+    GvVirtualCopyString(pinfo->port, sizeof(pinfo->port), port);
+    GvVirtualCopyString(pinfo->firmware_version, sizeof(pinfo->firmware_version), config.firmware_version);
+    pinfo->type = PortType_Unknown;
+    pinfo->cameraid = CameraID_Left;
+    pinfo->support_stereo = false;
+    pinfo->support_single = true;
+    pinfo->support_color = ProjectorColor_White;
+    pinfo->support_protective_cover = false;
+    pinfo->workingdist_near_mm = config.workingdist_near_mm;
+    pinfo->workingdist_far_mm = config.workingdist_far_mm;
+    pinfo->support_capture_mode = static_cast<GvCaptureMode>(config.support_capture_mode);
+}
+
+}  // namespace detail
+
+/**
+ * @brief `GvSystemGetDeviceInfo()`와 같은 형식으로 가상 장치 정보를 채운다.
+ * @details `port`는 `virtual:<index>`, `type`은 `PortType_Unknown`이다.
+ */
+inline bool GvVirtualSystemGetDeviceInfo(int deviceIndex, GvDeviceInfo* pinfo) {
+    GvVirtualDeviceConfig config;
+    if (pinfo == nullptr || !GvVirtualSystemGetDeviceConfig(deviceIndex, &config)) {
+        detail::GvSetLastHelperError("GvVirtualSystemGetDeviceInfo: invalid device index");
+        return false;
+    }
+    detail::GvVirtualFillDeviceInfo(config, "virtual:" + std::to_string(deviceIndex), pinfo);
+    return true;
+}
+
+/** @brief 가상 장치 목록을 쓰는 `GvDeviceDiscovery` 검색 소스(`device_index`는 `GvVirtualSingle` 생성 인덱스). */
+inline GvDeviceDiscoverySource GvVirtualDiscoverySource() {
+    return [](std::vector<GvDeviceInfo>& devices) {
+        detail::GvVirtualSystemState& state = detail::GvVirtualSystemGlobalState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        devices.resize(state.devices.size());
+        for (size_t i = 0; i < state.devices.size(); ++i) {
+            detail::GvVirtualFillDeviceInfo(state.devices[i], "virtual:" + std::to_string(i), &devices[i]);
+        }
+        return true;
+    };
+}
+
+/**
+ * @brief `GvSingle`과 같은 사용 흐름의 가상 구조광 카메라.
+ * @details 결과는 SDK 핸들 대신 `GvBuffers.h` 컨테이너로 제공된다.
+ *          `GvCaptureProfiler<GvVirtualSingle>`로 단계별 타이밍을 측정할 수 있다.
+ *          한 인스턴스의 메서드는 동시에 호출하지 않아야 한다.
+ */
+class GvVirtualSingle {
+public:
+    using GvCaptureOptions = GvSingle::GvCaptureOptions;
+
+    struct GvCollectionCallBackInfo {
+        const GvImageBuffer* image = nullptr;
+    };
+
+    struct GvCalculationCallBackInfo {
+        const GvImageBuffer* image = nullptr;
+        const GvPointMapBuffer* pointmap = nullptr;
+        const GvDepthMapBuffer* depthmap = nullptr;
+        const GvConfidenceMapBuffer* confidencemap = nullptr;
+    };
+
+    using CollectionCallBackPtr = void (*)(const GvCollectionCallBackInfo&, const GvCaptureOptions&, UserPtr);
+    using CalculationCallBackPtr = void (*)(const GvCalculationCallBackInfo&, const GvCaptureOptions&, UserPtr);
+
+    /**
+     * @brief 렌더링 대신 원본 이미지를 공급하는 함수(세션 재생 등).
+     * @details 3D 캡처(`capture3d == true`)에서는 `stack`에 패턴 한 벌(white, black, Gray code, 위상천이 순,
+     *          Mono8)을 채우고, `texture`에 빈 버퍼(`GvImageBuffer()`)를 대입하면 white 패턴을 텍스처로 쓴다.
+     *          2D 캡처에서는 `texture`만 채운다.
+     *          두 버퍼는 직전 캡처의 내용을 담은 채 전달되므로 형식/크기가 같으면 메모리를 재사용할 수 있다.
+     *          false를 반환하면 캡처가 실패하며 사유는 공급 함수가 `detail::GvSetLastHelperError()`로 남긴다.
+     */
+    using RawImageSource = std::function<bool(const GvCaptureOptions& opts, bool capture3d,
+                                              std::vector<GvImageBuffer>& stack, GvImageBuffer& texture)>;
+
+    /** @param deviceIndex `GvVirtualSystemAddDevice()`가 반환한 인덱스. */
+    explicit GvVirtualSingle(int deviceIndex) { m_valid = GvVirtualSystemGetDeviceConfig(deviceIndex, &m_config); }
+
+    /** @brief 등록 절차 없이 설정으로 바로 만든다. */
+    explicit GvVirtualSingle(const GvVirtualDeviceConfig& config) : m_config(config), m_valid(true) {}
+
+    GvVirtualSingle(const GvVirtualSingle&) = delete;
+    GvVirtualSingle& operator=(const GvVirtualSingle&) = delete;
+
+    bool IsValid() const { return m_valid; }
+
+    bool Open() {
+        if (!m_valid) {
+            detail::GvSetLastHelperError("GvVirtualSingle::Open: invalid device");
+            return false;
+        }
+        m_open = true;
+        return true;
+    }
+
+    void Close() { m_open = false; }
+    bool IsOpen() const { return m_open; }
+    bool IsPhysicallyConnected() const { return m_valid; }
+
+    bool SetCollectionCallBack(CollectionCallBackPtr cb, UserPtr ctx) {
+        m_collectionCb = cb;
+        m_collectionCtx = ctx;
+        return true;
+    }
+
+    bool SetCalculationCallBack(CalculationCallBackPtr cb, UserPtr ctx) {
+        m_calculationCb = cb;
+        m_calculationCtx = ctx;
+        return true;
+    }
+
+    /**
+     * @brief 원본 이미지 공급 함수를 설정한다(빈 함수면 렌더링으로 되돌린다).
+     * @details 공급 함수를 쓰는 동안에는 장면 렌더링, 잡음, 취득 시간 모사, HDR 노출별 촬영을 하지 않고
+     *          공급된 패턴 한 벌을 그대로 디코딩한다. 이후 필터와 콜백은 같다.
+     */
+    void SetRawImageSource(RawImageSource source) { m_rawSource = std::move(source); }
+
+    bool Capture() { return Capture(m_defaultOptions); }
+
+    /**
+     * @brief 패턴 렌더링 -> (HDR 노출별) 디코딩/삼각측량 -> HDR 합성 -> 필터 -> 콜백을 실행한다.
+     * @details 옵션 단위: `truncate_z_*`, `noise_removal_distance`는 mm,
+     *          `confidence_threshold`는 0~1 변조 세기 기준이다.
+     */
+    bool Capture(const GvCaptureOptions& opts) {
+        int steps = 0;
+        if (!CheckCaptureOptions(opts, &steps)) {
+            return false;
+        }
+        ++m_captureId;
+        const GvSize size = m_config.resolution;
+
+        int exposures[3] = {opts.exposure_time_3d, 0, 0};
+        float gains[3] = {opts.gain_3d, opts.gain_3d, opts.gain_3d};
+        int exposureCount = 1;
+        if (opts.hdr_exposure_times > 1) {
+            exposureCount = std::min(opts.hdr_exposure_times, 3);
+            for (int i = 0; i < exposureCount; ++i) {
+                exposures[i] = opts.hdr_exposuretime_content[i] > 0 ? opts.hdr_exposuretime_content[i]
+                                                                    : opts.exposure_time_3d;
+                gains[i] = opts.hdr_gain_3d[i] > 0.0f ? opts.hdr_gain_3d[i] : opts.gain_3d;
+            }
+        }
+
+        // [1] 취득: 장면 광선 추적 1회 + 노출별 패턴 이미지 렌더링(또는 외부 공급 패턴 한 벌)
+        std::vector<std::vector<GvImageBuffer>> stacks;
+        if (m_rawSource) {
+            if (!AcquireFromSource(opts, steps)) {
+                return false;
+            }
+        } else {
+            Trace(size);
+            stacks.resize(static_cast<size_t>(exposureCount));
+            for (int e = 0; e < exposureCount; ++e) {
+                RenderPatterns(opts, steps, exposures[e], gains[e], static_cast<uint64_t>(e),
+                               &stacks[static_cast<size_t>(e)]);
+                SimulateAcquisitionTime(stacks[static_cast<size_t>(e)].size());
+            }
+            m_rawImages = stacks.back();
+            RenderTexture(opts, opts.use_projector_capturing_2d_image);
+        }
+
+        if (m_collectionCb) {
+            GvCollectionCallBackInfo info;
+            info.image = &m_image;
+            m_collectionCb(info, opts, m_collectionCtx);
+        }
+
+        // [2] 계산: 노출별 디코딩 후 confidence가 가장 높은 결과로 HDR 합성
+        const GvStructuredLightModel model = Model(steps);
+        GvStructuredLightDecodeOptions decodeOpts;
+        decodeOpts.contrast_threshold = opts.light_contrast_threshold > 0 ? opts.light_contrast_threshold : 8.0;
+        decodeOpts.threads = m_config.worker_threads;
+        m_pointMap = GvPointMapBuffer::Create(size);
+        m_depthMap = GvDepthMapBuffer::Create(size);
+        m_confidenceMap = GvConfidenceMapBuffer::Create(size);
+        const size_t stackCount = m_rawSource ? 1 : stacks.size();
+        for (size_t s = 0; s < stackCount; ++s) {
+            const std::vector<GvImageBuffer>& stack = m_rawSource ? m_rawImages : stacks[s];
+            if (!GvDecodeStructuredLight(stack.data(), stack.size(), model, decodeOpts, m_pointMap, m_confidenceMap)) {
+                return false;
+            }
+        }
+
+        // [3] 후처리 필터
+        ApplyFilters(opts);
+        const size_t count = PixelCount(size);
+        const double* pts = m_pointMap.GetPointDataConstPtr();
+        double* depth = m_depthMap.GetDataPtr();
+        for (size_t i = 0; i < count; ++i) {
+            depth[i] = pts[i * 3 + 2];
+        }
+
+        if (m_calculationCb) {
+            GvCalculationCallBackInfo info;
+            info.image = &m_image;
+            info.pointmap = &m_pointMap;
+            info.depthmap = &m_depthMap;
+            info.confidencemap = &m_confidenceMap;
+            m_calculationCb(info, opts, m_calculationCtx);
+        }
+        return true;
+    }
+
+    bool Capture2D() { return Capture2D(m_defaultOptions); }
+
+    bool Capture2D(const GvCaptureOptions& opts) {
+        if (!m_open) {
+            detail::GvSetLastHelperError("GvVirtualSingle::Capture2D: device is not open");
+            return false;
+        }
+        ++m_captureId;
+        if (m_rawSource) {
+            std::vector<GvImageBuffer> unused;
+            if (!m_rawSource(opts, false, unused, m_image)) {
+                return false;
+            }
+            if (!m_image.IsValid()) {
+                detail::GvSetLastHelperError("GvVirtualSingle::Capture2D: raw image source returned no image");
+                return false;
+            }
+            return true;
+        }
+        Trace(m_config.resolution);
+        SimulateAcquisitionTime(1);
+        RenderTexture(opts, opts.use_projector_capturing_2d_image);
+        return true;
+    }
+
+    const GvImageBuffer& GetImage() const { return m_image; }
+    const GvPointMapBuffer& GetPointMap() const { return m_pointMap; }
+    const GvDepthMapBuffer& GetDepthMap() const { return m_depthMap; }
+    const GvConfidenceMapBuffer& GetConfidenceMap() const { return m_confidenceMap; }
+
+    /**
+     * @brief 최근 3D 캡처의 포인트맵과 텍스처를 합친 색상 포인트맵. 텍스처가 없으면 색상/alpha 0.
+     * @details `options.threads`가 0이면 `worker_threads`를 쓴다.
+     */
+    bool GetColoredPointMap(GvColoredPointMapBuffer& out,
+                            const GvColorFuseOptions& options = GvColorFuseOptions()) const {
+        GvColorFuseOptions opts = options;
+        if (opts.threads == 0) {
+            opts.threads = m_config.worker_threads;
+        }
+        return GvFuseColoredPointMap(m_pointMap, m_image, out, opts);
+    }
+
+    /** @brief 최근 3D 캡처의 원본 패턴 이미지 수(white, black, Gray code, 위상천이 순). */
+    int GetRawImageCount() const { return static_cast<int>(m_rawImages.size()); }
+
+    bool GetRawImage(GvImageBuffer& img, uint16_t index) const {
+        if (index >= m_rawImages.size()) {
+            detail::GvSetLastHelperError("GvVirtualSingle::GetRawImage: index out of range");
+            return false;
+        }
+        img = m_rawImages[index];
+        return true;
+    }
+
+    /**
+     * @brief 카메라 내부 파라미터를 조회한다.
+     * @param instrinsic_matrix 3x3 행 우선(9개).
+     * @param distortion k1, k2, p1, p2, k3(5개). 가상 장치는 왜곡이 없다.
+     */
+    bool GetIntrinsicParameters(float* instrinsic_matrix, float* distortion) const {
+        if (instrinsic_matrix == nullptr) {
+            return false;
+        }
+        const double f = CameraFocal();
+        const float k[9] = {static_cast<float>(f), 0.0f, static_cast<float>(CameraCx()),
+                            0.0f, static_cast<float>(f), static_cast<float>(CameraCy()),
+                            0.0f, 0.0f, 1.0f};
+        std::memcpy(instrinsic_matrix, k, sizeof(k));
+        if (distortion) {
+            std::fill(distortion, distortion + 5, 0.0f);
+        }
+        return true;
+    }
+
+    bool GetCameraResolution(GvSize& resolution) const {
+        resolution = m_config.resolution;
+        return m_valid;
+    }
+
+    bool GetExposureTimeRange(int* min_value, int* max_value) const {
+        if (min_value) *min_value = 1;
+        if (max_value) *max_value = 1000;
+        return true;
+    }
+
+    bool GetGainRange(float* min_value, float* max_value) const {
+        if (min_value) *min_value = 1.0f;
+        if (max_value) *max_value = 16.0f;
+        return true;
+    }
+
+    const GvVirtualDeviceConfig& GetConfig() const { return m_config; }
+
+private:
+    static size_t PixelCount(const GvSize& size) {
+        return static_cast<size_t>(size.width) * static_cast<size_t>(size.height);
+    }
+
+    double CameraFocal() const { return m_config.resolution.width * m_config.focal_scale; }
+    double CameraCx() const { return (m_config.resolution.width - 1) * 0.5; }
+    double CameraCy() const { return (m_config.resolution.height - 1) * 0.5; }
+    double ProjectorFocal() const { return m_config.projector_width * m_config.projector_focal_scale; }
+    double ProjectorCx() const { return (m_config.projector_width - 1) * 0.5; }
+
+    /** @brief 캡처 모드에 맞춘 복원 모델. */
+    GvStructuredLightModel Model(int steps) const {
+        GvStructuredLightModel model;
+        model.camera_resolution = m_config.resolution;
+        model.camera_fx = CameraFocal();
+        model.camera_fy = CameraFocal();
+        model.camera_cx = CameraCx();
+        model.camera_cy = CameraCy();
+        model.projector_width = m_config.projector_width;
+        model.projector_fx = ProjectorFocal();
+        model.projector_cx = ProjectorCx();
+        model.baseline = m_config.baseline;
+        model.phase_period = m_config.phase_period;
+        model.phase_steps = steps;
+        model.gray_bits = GvStructuredLightGrayBits(m_config.projector_width, m_config.phase_period);
+        return model;
+    }
+
+    bool CheckCaptureOptions(const GvCaptureOptions& opts, int* steps) {
+        if (!m_open) {
+            detail::GvSetLastHelperError("GvVirtualSingle::Capture: device is not open");
+            return false;
+        }
+        if ((m_config.support_capture_mode & opts.capture_mode) == 0) {
+            detail::GvSetLastHelperError("GvVirtualSingle::Capture: capture mode " +
+                                         std::to_string(static_cast<int>(opts.capture_mode)) +
+                                         " is not supported by this device");
+            return false;
+        }
+        *steps = GvStructuredLightPhaseSteps(opts.capture_mode);
+        if (*steps == 0) {
+            detail::GvSetLastHelperError("GvVirtualSingle::Capture: line-scan modes are not simulated");
+            return false;
+        }
+        if (m_config.phase_period < 2 || m_config.projector_width < 2 || m_config.baseline <= 0.0) {
+            detail::GvSetLastHelperError("GvVirtualSingle::Capture: invalid projector configuration");
+            return false;
+        }
+        return true;
+    }
+
+    bool AcquireFromSource(const GvCaptureOptions& opts, int steps) {
+        if (!m_rawSource(opts, true, m_rawImages, m_image)) {
+            return false;
+        }
+        const size_t expected = static_cast<size_t>(GvStructuredLightPatternCount(Model(steps)));
+        if (m_rawImages.size() != expected) {
+            detail::GvSetLastHelperError("GvVirtualSingle::Capture: raw image source returned " +
+                                         std::to_string(m_rawImages.size()) + " images, expected " +
+                                         std::to_string(expected));
+            return false;
+        }
+        if (!m_image.IsValid()) {
+            m_image = m_rawImages.front();
+        }
+        return true;
+    }
+
+    void SimulateAcquisitionTime(size_t frames) const {
+        if (m_config.frame_time_us > 0 && frames > 0) {
+            const uint64_t us = static_cast<uint64_t>(m_config.frame_time_us) * frames;
+            std::this_thread::sleep_for(std::chrono::microseconds(us));
+        }
+    }
+
+    /** @brief 카메라 픽셀별 광선 추적(장면이 고정이므로 결과를 재사용한다). */
+    void Trace(const GvSize& size) {
+        if (m_hits.size() == PixelCount(size)) {
+            return;
+        }
+        m_hits.assign(PixelCount(size), detail::GvVirtualHit());
+        const double f = CameraFocal();
+        const double cx = CameraCx();
+        const double cy = CameraCy();
+        const double pf = ProjectorFocal();
+        const double pcx = ProjectorCx();
+        const double b = m_config.baseline;
+        const GvVirtualScene& scene = m_config.scene;
+
+        GvParallelFor(0, static_cast<size_t>(size.height), m_config.worker_threads, [&](size_t r0, size_t r1, int) {
+            const double origin[3] = {0.0, 0.0, 0.0};
+            const double projector[3] = {b, 0.0, 0.0};
+            for (size_t v = r0; v < r1; ++v) {
+                for (int u = 0; u < size.width; ++u) {
+                    detail::GvVirtualHit& hit = m_hits[v * static_cast<size_t>(size.width) + static_cast<size_t>(u)];
+                    const double dir[3] = {(u - cx) / f, (static_cast<double>(v) - cy) / f, 1.0};
+                    double normal[3] = {};
+                    double albedo = 0.0;
+                    const double t = detail::GvVirtualIntersect(scene, origin, dir, normal, &albedo);
+                    if (!std::isfinite(t)) {
+                        continue;
+                    }
+                    hit.valid = true;
+                    hit.albedo = albedo;
+                    for (int k = 0; k < 3; ++k) {
+                        hit.point[k] = t * dir[k];
+                    }
+                    // 프로젝터에서 본 방향/그림자/입사각
+                    double toProj[3] = {projector[0] - hit.point[0], projector[1] - hit.point[1],
+                                        projector[2] - hit.point[2]};
+                    const double dist =
+                        std::sqrt(toProj[0] * toProj[0] + toProj[1] * toProj[1] + toProj[2] * toProj[2]);
+                    for (double& c : toProj) {
+                        c /= dist;
+                    }
+                    const double cosine = normal[0] * toProj[0] + normal[1] * toProj[1] + normal[2] * toProj[2];
+                    if (cosine <= 0.0 || hit.point[2] <= 0.0) {
+                        continue;
+                    }
+                    const double pdir[3] = {-toProj[0], -toProj[1], -toProj[2]};
+                    double pn[3] = {};
+                    double palbedo = 0.0;
+                    const double pt = detail::GvVirtualIntersect(scene, projector, pdir, pn, &palbedo);
+                    if (pt < dist - 1e-6) {
+                        continue;
+                    }
+                    const double column = pf * (hit.point[0] - b) / hit.point[2] + pcx;
+                    if (column < 0.0 || column > m_config.projector_width - 1) {
+                        continue;
+                    }
+                    hit.lit = cosine;
+                    hit.projector_column = column;
+                }
+            }
+        });
+    }
+
+    unsigned char Expose(double radiance, double scale, double noiseSigma, uint64_t seed, uint64_t index) const {
+        double value = 255.0 * radiance * scale;
+        if (noiseSigma > 0.0) {
+            value += noiseSigma * detail::GvVirtualNoise(seed, index);
+        }
+        value = value < 0.0 ? 0.0 : (value > 255.0 ? 255.0 : value);
+        return static_cast<unsigned char>(value + 0.5);
+    }
+
+    /** @brief 패턴 순서: white, black, Gray code(MSB 우선), 위상천이 `steps`장. */
+    void RenderPatterns(const GvCaptureOptions& opts, int steps, int exposure, float gain, uint64_t exposureIndex,
+                        std::vector<GvImageBuffer>* stack) const {
+        const GvSize size = m_config.resolution;
+        const GvStructuredLightModel model = Model(steps);
+        const int patternCount = GvStructuredLightPatternCount(model);
+        stack->assign(static_cast<size_t>(patternCount), GvImageBuffer());
+        for (GvImageBuffer& img : *stack) {
+            img = GvImageBuffer::Create(GvImageType::Mono8, size);
+        }
+        const double scale = (exposure > 0 ? exposure : 50) / 50.0 * (gain > 0.0f ? gain : 1.0f) *
+                             (opts.projector_brightness > 0 ? opts.projector_brightness / 100.0 : 1.0);
+        const double noiseSigma = m_config.noise_sigma * (gain > 0.0f ? gain : 1.0f);
+        const double ambient = m_config.scene.ambient_3d;
+        const uint64_t seed = (m_captureId << 8) ^ exposureIndex;
+
+        GvParallelFor(0, static_cast<size_t>(size.height), m_config.worker_threads, [&](size_t r0, size_t r1, int) {
+            std::vector<double> pattern(static_cast<size_t>(patternCount));
+            for (size_t v = r0; v < r1; ++v) {
+                for (int u = 0; u < size.width; ++u) {
+                    const size_t i = v * static_cast<size_t>(size.width) + static_cast<size_t>(u);
+                    const detail::GvVirtualHit& hit = m_hits[i];
+                    GvStructuredLightEncodeColumn(model, hit.projector_column, pattern.data());
+                    for (int p = 0; p < patternCount; ++p) {
+                        const double radiance =
+                            hit.valid ? hit.albedo * (ambient + hit.lit * pattern[static_cast<size_t>(p)]) : 0.0;
+                        (*stack)[static_cast<size_t>(p)].GetDataPtr()[i] =
+                            Expose(radiance, scale, noiseSigma, seed + static_cast<uint64_t>(p) * 0x10001ull, i);
+                    }
+                }
+            }
+        });
+    }
+
+    void RenderTexture(const GvCaptureOptions& opts, bool withProjector) {
+        const GvSize size = m_config.resolution;
+        const GvImageType::Enum type = m_config.color ? GvImageType::RGB8 : GvImageType::Mono8;
+        if (!m_image.IsValid() || m_image.GetType() != type || m_image.GetSize() != size) {
+            m_image = GvImageBuffer::Create(type, size);
+        }
+        const double scale = (opts.exposure_time_2d > 0 ? opts.exposure_time_2d : 50) / 50.0 *
+                             (opts.gain_2d > 0.0f ? opts.gain_2d : 1.0f);
+        const double gamma = opts.gamma_2d > 0.0f ? opts.gamma_2d : 1.0f;
+        const double noiseSigma = m_config.noise_sigma * (opts.gain_2d > 0.0f ? opts.gain_2d : 1.0f);
+        const double ambient = m_config.scene.ambient_2d;
+        const uint64_t seed = (m_captureId << 8) ^ 0xFFull;
+        const size_t channels = GvImageBufferPixelSize(type);
+        const double tint[3] = {1.0, 0.92, 0.85};
+        unsigned char* dst = m_image.GetDataPtr();
+
+        GvParallelFor(0, static_cast<size_t>(size.height), m_config.worker_threads, [&](size_t r0, size_t r1, int) {
+            for (size_t v = r0; v < r1; ++v) {
+                for (int u = 0; u < size.width; ++u) {
+                    const size_t i = v * static_cast<size_t>(size.width) + static_cast<size_t>(u);
+                    const detail::GvVirtualHit& hit = m_hits[i];
+                    double radiance = 0.0;
+                    if (hit.valid) {
+                        // 체커 무늬로 표면 질감을 준다(1cm 격자).
+                        const int cell = (static_cast<int>(std::floor(hit.point[0] * 100.0)) +
+                                          static_cast<int>(std::floor(hit.point[1] * 100.0))) & 1;
+                        radiance = hit.albedo * (cell ? 1.0 : 0.8) * (ambient + (withProjector ? hit.lit : 0.0));
+                        radiance = std::pow(std::min(radiance * scale, 1.0), 1.0 / gamma);
+                    }
+                    for (size_t ch = 0; ch < channels; ++ch) {
+                        dst[i * channels + ch] = Expose(radiance * (channels == 3 ? tint[ch] : 1.0), 1.0,
+                                                        noiseSigma, seed + ch, i);
+                    }
+                }
+            }
+        });
+    }
+
+    void ApplyFilters(const GvCaptureOptions& opts) {
+        const GvSize size = m_config.resolution;
+        double* points = m_pointMap.GetPointDataPtr();
+        const int threads = m_config.worker_threads;
+        if (opts.confidence_threshold > 0.0f) {
+            GvConfidenceFilter(points, m_confidenceMap.GetDataConstPtr(), size, opts.confidence_threshold, threads);
+        }
+        GvTruncateZ(points, size, opts.truncate_z_min / 1000.0, opts.truncate_z_max / 1000.0, threads);
+        if (opts.noise_removal_point_number > 0 && opts.noise_removal_distance > 0.0f) {
+            const double radius = opts.noise_removal_distance / 1000.0;
+            const double pixelPitch = m_config.scene.plane_distance / CameraFocal();
+            const int window = std::max(1, std::min(8, static_cast<int>(std::ceil(radius / pixelPitch))));
+            GvRadiusOutlierFilter(points, size, radius, opts.noise_removal_point_number, window, threads);
+        }
+        const size_t count = PixelCount(size);
+        double* confidence = m_confidenceMap.GetDataPtr();
+        for (size_t i = 0; i < count; ++i) {
+            if (points[i * 3 + 2] != points[i * 3 + 2]) {
+                confidence[i] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    }
+
+    GvVirtualDeviceConfig m_config;
+    bool m_valid = false;
+    bool m_open = false;
+    uint64_t m_captureId = 0;
+    GvCaptureOptions m_defaultOptions;
+
+    std::vector<detail::GvVirtualHit> m_hits;
+    std::vector<GvImageBuffer> m_rawImages;
+    GvImageBuffer m_image;
+    GvPointMapBuffer m_pointMap;
+    GvDepthMapBuffer m_depthMap;
+    GvConfidenceMapBuffer m_confidenceMap;
+
+    CollectionCallBackPtr m_collectionCb = nullptr;
+    UserPtr m_collectionCtx = nullptr;
+    CalculationCallBackPtr m_calculationCb = nullptr;
+    UserPtr m_calculationCtx = nullptr;
+    RawImageSource m_rawSource;
+};
+
+inline uint64_t GvGetDataBytes(const GvVirtualSingle::GvCollectionCallBackInfo& info) {
+    return info.image ? GvGetDataBytes(*info.image) : 0;
+}
+
+inline uint64_t GvGetDataBytes(const GvVirtualSingle::GvCalculationCallBackInfo& info) {
+    return (info.image ? GvGetDataBytes(*info.image) : 0) + (info.pointmap ? GvGetDataBytes(*info.pointmap) : 0) +
+           (info.depthmap ? GvGetDataBytes(*info.depthmap) : 0) +
+           (info.confidencemap ? GvGetDataBytes(*info.confidencemap) : 0);
+}
+
+}  // namespace gv
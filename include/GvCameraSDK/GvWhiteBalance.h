@@ -0,0 +1,312 @@
+#pragma once
+
+/**
+ * @file GvWhiteBalance.h
+ * @brief 실시간 컬러 프레임 기반 백그라운드 화이트 밸런스(GvCameraSDK::Processing).
+ * @details `AutoWhiteBalance()`는 호출 동안 장치를 점유하는 블로킹 작업이라 주변 조명이 바뀔 때마다 다시 부르기 어렵다.
+ *          `GvWhiteBalance`는 실시간 컬러 프레임(`GvRealtimeImageFrame::is_color`)의 ROI 채널별 합으로
+ *          gray-world 추정을 계속 갱신하고, 적용은 장치를 소유한 스레드에서 캡처 사이에 한다.
+ *          - 채널 합은 표본 간격(`sample_step`)만큼 건너뛰며 분기 없이 누적한다. 포화(어느 채널이든 `saturation_level` 이상)나
+ *            너무 어두운(모든 채널이 `dark_level` 이하) 픽셀은 마스크로 제외한다.
+ *          - 프레임은 현재 장치 비율(`SetCurrentRatios()`)로 찍혔다고 보고, G 비율을 유지한 채 R/B 비율을
+ *            평균이 G와 같아지도록 고친다. 보정 배율은 로그 영역에서 평활한다.
+ *          - `GvApplyWhiteBalance()`: 추정이 현재 비율과 `min_change` 이상 다를 때만 `SetBalanceRatio()`를 호출한다.
+ *            비율을 바꾼 직후 `settle_frames`개 프레임은 이전 비율로 찍혔을 수 있어 측정하지 않는다.
+ *          - `GvWhiteBalanceApplier<Camera>`: 정해진 주기로 `GvDeviceWorker` 큐에 적용 작업을 넣는다.
+ *            같은 장치의 캡처와 같은 스레드에서 순서대로 실행되므로 진행 중인 3D 캡처를 끊지 않는다.
+ *          `SetBalanceRatio()`는 `GvSingle`에만 있다.
+ */
+
+#include "GvCameraAPI.h"
+#include "GvDeviceWorker.h"
+#include "GvPlatform.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace gv {
+
+struct GvWhiteBalanceOptions {
+    /** @brief 측정 영역(프레임 좌표). 크기가 0이면 프레임 전체. 프레임을 벗어난 부분은 잘라 낸다. */
+    GvROI roi;
+    /** @brief 측정할 측면. `CameraID_Both`면 모든 측면의 프레임을 같은 추정기에 넣는다. */
+    GvCameraID camera_id = CameraID_Left;
+    /** @brief 프레임 채널 순서. false면 RGB, true면 BGR(4채널이면 앞 3채널). */
+    bool bgr_order = false;
+    /** @brief 행/열 표본 간격(1이면 모든 픽셀). */
+    int sample_step = 2;
+    /** @brief N번째 프레임마다 측정한다(1이면 매 프레임). */
+    int frame_interval = 2;
+
+    /** @brief 제외할 포화 값(어느 채널이든 이 값 이상)과 어두운 값(모든 채널이 이 값 이하). */
+    int saturation_level = 245;
+    int dark_level = 10;
+    /** @brief 측정에 쓸 수 있는 표본 비율 하한. 모자라면 추정을 바꾸지 않는다. */
+    double min_valid_fraction = 0.05;
+    /** @brief 새 측정의 가중치(0~1, 1이면 평활 없음). 로그 영역에서 적용한다. */
+    double smoothing = 0.2;
+    /** @brief 적용 문턱: 추정 비율이 현재 비율과 이 비율 이상 달라야 적용한다. */
+    double min_change = 0.02;
+    /** @brief 비율을 적용한 뒤 측정하지 않을 프레임 수. */
+    int settle_frames = 3;
+
+    /** @brief 비율 범위. `GvLoadBalanceState()`로 장치 범위를 채울 수 있다. */
+    float min_ratio = 0.5f;
+    float max_ratio = 4.0f;
+};
+
+/** @brief 측정 가능한 표본의 채널별 합(R, G, B 순서). */
+struct GvChannelSums {
+    uint64_t sum[3] = {0, 0, 0};
+    uint64_t valid = 0;
+    uint64_t total = 0;
+};
+
+/**
+ * @brief 실시간 컬러 프레임의 ROI 채널별 합을 만든다(3/4채널 8비트).
+ * @return 형식이 맞지 않거나 ROI가 비면 false.
+ */
+bool GvComputeChannelSums(const GvRealtimeImageFrame& frame, const GvROI& roi, int sample_step, bool bgr_order,
+                          int saturation_level, int dark_level, GvChannelSums& sums);
+
+struct GvWhiteBalanceEstimate {
+    /** @brief 한 번 이상 측정했는지. false면 `ratio`는 현재 비율과 같다. */
+    bool valid = false;
+    /** @brief 추정 비율이 현재 비율과 `min_change` 이상 달라 적용이 필요하다. */
+    bool pending = false;
+    /** @brief 추천 비율과 장치에 적용된(것으로 알려진) 비율(R, G, B). */
+    float ratio[3] = {1.0f, 1.0f, 1.0f};
+    float current[3] = {1.0f, 1.0f, 1.0f};
+    /** @brief 마지막 측정의 채널 평균(0~255)과 측정에 쓴 표본 비율. */
+    double channel_mean[3] = {0.0, 0.0, 0.0};
+    double valid_fraction = 0.0;
+
+    uint64_t frame_id = 0;
+    uint64_t measured_frames = 0;
+    uint64_t applied_count = 0;
+    /** @brief 마지막 측정 시각(`GvNowNs()`)과 측정에 걸린 시간. */
+    uint64_t updated_ns = 0;
+    uint64_t measure_ns = 0;
+};
+
+/**
+ * @brief 실시간 컬러 프레임으로 화이트 밸런스 비율을 계속 추정하는 추정기.
+ * @details 모든 메서드는 어느 스레드에서나 호출할 수 있다. 채널 합 계산은 잠금 밖에서 하고 잠금은 결과 반영/복사에만 쓴다.
+ */
+class GvWhiteBalance {
+public:
+    explicit GvWhiteBalance(const GvWhiteBalanceOptions& options = GvWhiteBalanceOptions());
+    GvWhiteBalance(const GvWhiteBalance&) = delete;
+    GvWhiteBalance& operator=(const GvWhiteBalance&) = delete;
+
+    void SetOptions(const GvWhiteBalanceOptions& options);
+    GvWhiteBalanceOptions GetOptions() const;
+
+    /** @brief 장치의 현재 비율(R, G, B)을 알린다. 평활 상태는 지우고 이 비율에서 다시 시작한다. */
+    void SetCurrentRatios(const float ratio[3]);
+
+    /**
+     * @brief 프레임 하나를 측정해 추정을 갱신한다.
+     * @return 이 프레임으로 추정을 갱신했으면 true(측면/프레임 간격/안정화 대기/표본 부족이면 false, 에러 아님).
+     *         흑백 프레임이나 형식이 맞지 않으면 false와 함께 보조 API 에러를 남긴다.
+     */
+    bool Update(const GvRealtimeImageFrame& frame);
+
+    GvWhiteBalanceEstimate GetEstimate() const;
+
+    /** @brief 비율을 장치에 적용했음을 알린다. 현재 비율을 바꾸고 다음 `settle_frames`개 프레임은 측정하지 않는다. */
+    void MarkApplied(const float ratio[3]);
+
+    /** @brief 평활 상태와 추정을 지운다(옵션/현재 비율은 유지). */
+    void Reset();
+
+    /**
+     * @brief 실시간 훅의 사용자 콜백으로 등록할 수 있는 콜백. `user_data`는 `GvWhiteBalance*`.
+     * @details `GvSetHookedRealtimeImageCallback()`(`GvRealtimeHook.h`)으로 등록한다. `GvSetRealtimeImageCallback()`에
+     *          직접 넘기면 공용 훅이 DLL에서 빠져 전송 통계/디스패치/추적 기록이 멈춘다.
+     *          같은 측면에서 `GvAutoExposure`와 함께 쓰려면 사용자 콜백 하나에서 두 `Update()`를 호출한다.
+     */
+    static void RealtimeCallback(const GvRealtimeImageFrame* frame, UserPtr user_data);
+
+private:
+    void refreshPending();
+
+    GvWhiteBalanceOptions m_options;
+    /** @brief 평활한 R/B 비율의 로그. */
+    double m_logRatio[3] = {0.0, 0.0, 0.0};
+    GvWhiteBalanceEstimate m_estimate;
+    uint64_t m_settleUntil = 0;
+    mutable std::mutex m_mutex;
+    std::atomic<uint64_t> m_frameCounter{0};
+};
+
+/**
+ * @brief 장치의 현재 비율과 비율 범위를 읽어 추정기에 알린다(`GetBalanceRatio()`, `GetBalanceRange()`).
+ * @details 범위는 R/B 범위를 합친 것(작은 최대값, 큰 최소값)을 쓴다.
+ */
+template <typename Camera>
+bool GvLoadBalanceState(Camera& camera, GvWhiteBalance& estimator) {
+    const GvBalanceSelector selectors[3] = {BalanceSelector_R, BalanceSelector_G, BalanceSelector_B};
+    float ratio[3] = {1.0f, 1.0f, 1.0f};
+    GvWhiteBalanceOptions options = estimator.GetOptions();
+    bool rangeSet = false;
+    for (int c = 0; c < 3; ++c) {
+        float low = 0.0f;
+        float high = 0.0f;
+        if (!GvCheckSdk(camera.GetBalanceRatio(selectors[c], &ratio[c]), "GetBalanceRatio failed") ||
+            !GvCheckSdk(camera.GetBalanceRange(selectors[c], &low, &high), "GetBalanceRange failed")) {
+            return false;
+        }
+        if (c == 1) {
+            continue;
+        }
+        options.min_ratio = rangeSet && options.min_ratio > low ? options.min_ratio : low;
+        options.max_ratio = rangeSet && options.max_ratio < high ? options.max_ratio : high;
+        rangeSet = true;
+    }
+    estimator.SetOptions(options);
+    estimator.SetCurrentRatios(ratio);
+    return true;
+}
+
+/**
+ * @brief 적용이 필요하면(`pending`) 추정 비율을 장치에 적용한다. 장치를 소유한 스레드에서 캡처 사이에 호출한다.
+ * @details 일부 채널만 적용하고 실패하면 실제로 쓴 비율을 추정기에 알린 뒤 false를 반환한다
+ *          (이후 보정이 장치의 실제 비율을 기준으로 계산되고, 남은 채널은 다음 호출에서 다시 적용한다).
+ * @param applied 모든 채널을 적용했으면 true(적용할 것이 없으면 false, 에러 아님).
+ */
+template <typename Camera>
+bool GvApplyWhiteBalance(Camera& camera, GvWhiteBalance& estimator, bool* applied = nullptr) {
+    if (applied) {
+        *applied = false;
+    }
+    const GvWhiteBalanceEstimate estimate = estimator.GetEstimate();
+    if (!estimate.pending) {
+        return true;
+    }
+    const GvBalanceSelector selectors[3] = {BalanceSelector_R, BalanceSelector_G, BalanceSelector_B};
+    float written[3] = {estimate.current[0], estimate.current[1], estimate.current[2]};
+    for (int c = 0; c < 3; ++c) {
+        if (estimate.ratio[c] == estimate.current[c]) {
+            continue;
+        }
+        if (!GvCheckSdk(camera.SetBalanceRatio(selectors[c], estimate.ratio[c]), "SetBalanceRatio failed")) {
+            // 앞 채널은 이미 바뀌었으므로 추정기의 현재 비율을 장치와 맞춘다.
+            if (c > 0 && (written[0] != estimate.current[0] || written[1] != estimate.current[1])) {
+                estimator.MarkApplied(written);
+            }
+            return false;
+        }
+        written[c] = estimate.ratio[c];
+    }
+    estimator.MarkApplied(written);
+    if (applied) {
+        *applied = true;
+    }
+    return true;
+}
+
+struct GvWhiteBalanceApplierStats {
+    uint64_t checks = 0;
+    uint64_t applied = 0;
+    uint64_t failed = 0;
+    GvSdkError last_error;
+};
+
+/**
+ * @brief `apply_interval_ms`마다 장치 작업자(`GvDeviceWorker`)에 `GvApplyWhiteBalance()` 작업을 넣는 스케줄러.
+ * @details 작업은 그 장치의 캡처 작업 사이에 실행된다. 작업자와 추정기는 스케줄러보다 오래 살아 있어야 한다.
+ *          적용할 것이 없으면 작업을 넣지 않는다.
+ */
+template <typename Camera>
+class GvWhiteBalanceApplier {
+public:
+    GvWhiteBalanceApplier(GvDeviceWorker<Camera>& worker, GvWhiteBalance& estimator, int apply_interval_ms = 1000)
+        : m_worker(worker), m_estimator(estimator), m_intervalMs(apply_interval_ms > 0 ? apply_interval_ms : 1) {}
+    ~GvWhiteBalanceApplier() { Stop(); }
+    GvWhiteBalanceApplier(const GvWhiteBalanceApplier&) = delete;
+    GvWhiteBalanceApplier& operator=(const GvWhiteBalanceApplier&) = delete;
+
+    bool Start() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_thread.joinable()) {
+            return true;
+        }
+        m_stop = false;
+        try {
+            m_thread = std::thread(&GvWhiteBalanceApplier::SchedulerMain, this);
+        } catch (const std::exception& e) {
+            detail::GvSetLastHelperError(std::string("GvWhiteBalanceApplier::Start: ") + e.what());
+            return false;
+        }
+        return true;
+    }
+
+    /** @brief 진행 중인 적용 작업이 끝날 때까지 기다린 뒤 스레드를 종료한다. */
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_thread.joinable()) {
+                return;
+            }
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        m_thread.join();
+    }
+
+    GvWhiteBalanceApplierStats GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+private:
+    void SchedulerMain() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_wake.wait_for(lock, std::chrono::milliseconds(m_intervalMs), [this]() { return m_stop; });
+            if (m_stop) {
+                return;
+            }
+            ++m_stats.checks;
+            if (!m_estimator.GetEstimate().pending) {
+                continue;
+            }
+            lock.unlock();
+
+            // [1] 장치 작업자 큐에서 캡처 사이에 적용
+            bool applied = false;
+            GvWhiteBalance& estimator = m_estimator;
+            const GvDeviceCallResult result =
+                m_worker.Call([&estimator, &applied](Camera& camera) {
+                    return GvApplyWhiteBalance(camera, estimator, &applied);
+                });
+
+            // [2] 결과 집계
+            lock.lock();
+            if (!result.ok) {
+                ++m_stats.failed;
+                m_stats.last_error = result.error;
+            } else if (applied) {
+                ++m_stats.applied;
+            }
+        }
+    }
+
+    GvDeviceWorker<Camera>& m_worker;
+    GvWhiteBalance& m_estimator;
+    const int m_intervalMs;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::thread m_thread;
+    GvWhiteBalanceApplierStats m_stats;
+    bool m_stop = false;
+};
+
+}  // namespace gv
@@ -1,4 +1,5 @@
 #include "GvCameraAPI.h"
+#include "GvImageIO.h"
 
 #include <iostream>
 
@@ -90,10 +91,13 @@ int main() {
             const gv::GvSize size = image.GetSize();
             std::cout << "Capture2D OK: " << size.width << "x" << size.height
                       << " (" << gv::GvImageType::ToString(image.GetType()) << ")\n";
-            if (image.SaveImage(kOutput2DPath)) {
+            // Processing 라이브러리의 병렬 PNG 인코더로 저장(strip 단위 필터링/압축)
+            gv::GvImageWriteOptions writeOpts;
+            writeOpts.png_profile = gv::GvPngProfile::Fast;
+            if (gv::GvSaveImageFile(kOutput2DPath, image.GetDataConstPtr(), image.GetType(), size, writeOpts)) {
                 std::cout << "Saved: " << kOutput2DPath << "\n";
             } else {
-                std::cerr << "SaveImage failed: " << gv::GvGetLastErrorMessage() << "\n";
+                std::cerr << "GvSaveImageFile failed: " << gv::GvGetLastHelperErrorMessage() << "\n";
                 ok = false;
             }
         } else {
@@ -1,8 +1,11 @@
 #include "GvCameraAPI.h"
+#include "GvColoredPointMap.h"
 
 #include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 namespace {
 
@@ -20,12 +23,6 @@ void writeInt32BE(std::ofstream& ofs, int value) {
     ofs.write(reinterpret_cast<const char*>(buf), sizeof(buf));
 }
 
-bool isSupportedTextureType(const gv::GvImageType::Enum type) {
-    return type == gv::GvImageType::Mono8 ||
-           type == gv::GvImageType::RGB8 ||
-           type == gv::GvImageType::BGR8;
-}
-
 // PointMap을 간단한 바이너리로 저장합니다.
 // 형식:
 // - int32(be) width
@@ -34,6 +31,8 @@ bool isSupportedTextureType(const gv::GvImageType::Enum type) {
 //
 // 주의:
 // - 본 SDK의 포인트 단위는 mm 이므로 별도 단위 변환 없이 그대로 저장합니다.
+// - 레코드는 gv::GvPointXYZRGB(15 bytes)와 같으므로, 포인트맵과 텍스처(Mono8/RGB8/BGR8)를
+//   GvFuseColoredPoints()로 한 행씩 합쳐 그대로 기록합니다(채널 변환은 Processing 라이브러리가 처리).
 bool savePointMapBin(const gv::GvPointMap& pointMap, const gv::GvImage& texture, const char* path) {
     if (path == nullptr || !pointMap.IsValid() || !texture.IsValid()) {
         return false;
@@ -45,20 +44,15 @@ bool savePointMapBin(const gv::GvPointMap& pointMap, const gv::GvImage& texture,
     }
 
     const double* points = pointMap.GetPointDataConstPtr();
-    if (points == nullptr) {
+    const unsigned char* textureData = texture.GetDataConstPtr();
+    if (points == nullptr || textureData == nullptr || texture.GetSize() != size) {
         return false;
     }
 
-    const gv::GvSize textureSize = texture.GetSize();
-    if (textureSize.width != size.width || textureSize.height != size.height) {
-        return false;
-    }
-    const gv::GvImageType::Enum textureType = texture.GetType();
-    if (!isSupportedTextureType(textureType)) {
-        return false;
-    }
-    const unsigned char* textureData = texture.GetDataConstPtr();
-    if (textureData == nullptr) {
+    // 텍스처 형식(Mono8/RGB8/BGR8)은 파일을 만들기 전에 확인합니다.
+    const std::size_t pixelSize = gv::GvImageBufferPixelSize(texture.GetType());
+    if (pixelSize == 0) {
+        std::cerr << "Unsupported texture type: " << static_cast<int>(texture.GetType()) << "\n";
         return false;
     }
 
@@ -70,34 +64,24 @@ bool savePointMapBin(const gv::GvPointMap& pointMap, const gv::GvImage& texture,
     writeInt32BE(ofs, size.width);
     writeInt32BE(ofs, size.height);
 
-    const std::size_t count = static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height);
-    for (std::size_t i = 0; i < count; ++i) {
-        const std::size_t base = i * 3;
-        const float x = static_cast<float>(points[base]);
-        const float y = static_cast<float>(points[base + 1]);
-        const float z = static_cast<float>(points[base + 2]);
-        ofs.write(reinterpret_cast<const char*>(&x), sizeof(float));
-        ofs.write(reinterpret_cast<const char*>(&y), sizeof(float));
-        ofs.write(reinterpret_cast<const char*>(&z), sizeof(float));
-
-        unsigned char rgb[3]{0, 0, 0};
-        if (textureType == gv::GvImageType::Mono8) {
-            const unsigned char v = textureData[i];
-            rgb[0] = v;
-            rgb[1] = v;
-            rgb[2] = v;
-        } else if (textureType == gv::GvImageType::RGB8) {
-            const std::size_t tbase = i * 3;
-            rgb[0] = textureData[tbase];
-            rgb[1] = textureData[tbase + 1];
-            rgb[2] = textureData[tbase + 2];
-        } else if (textureType == gv::GvImageType::BGR8) {
-            const std::size_t tbase = i * 3;
-            rgb[0] = textureData[tbase + 2];
-            rgb[1] = textureData[tbase + 1];
-            rgb[2] = textureData[tbase];
+    // 포인트마다 ofs.write를 호출하면 느리므로 한 행(row)씩 버퍼에 모아 기록합니다.
+    // 중간에 실패하면 잘린 파일을 남기지 않도록 지웁니다.
+    const std::size_t width = static_cast<std::size_t>(size.width);
+    const gv::GvSize rowSize(size.width, 1);
+    const std::size_t textureStride = width * pixelSize;
+    std::vector<gv::GvPointXYZRGB> rowBuffer(width);
+    gv::GvColorFuseOptions fuseOpts;
+    fuseOpts.threads = 1;
+    for (int row = 0; row < size.height && ofs.good(); ++row) {
+        if (!gv::GvFuseColoredPoints(points + static_cast<std::size_t>(row) * width * 3, rowSize,
+                                     textureData + static_cast<std::size_t>(row) * textureStride,
+                                     texture.GetType(), rowSize, 0, rowBuffer.data(), fuseOpts)) {
+            ofs.close();
+            std::remove(path);
+            return false;
         }
-        ofs.write(reinterpret_cast<const char*>(rgb), sizeof(rgb));
+        ofs.write(reinterpret_cast<const char*>(rowBuffer.data()),
+                  static_cast<std::streamsize>(rowBuffer.size() * sizeof(gv::GvPointXYZRGB)));
     }
 
     return ofs.good();
@@ -0,0 +1,138 @@
+#include "GvCameraAPI.h"
+#include "GvCaptureProfiler.h"
+#include "GvTrace.h"
+
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+// 반복 캡처 횟수
+constexpr int kCaptureCount = 3;
+// 저장 파일명 (실행 폴더 기준)
+constexpr const char* kOutputPlyPath = "gvsdk_capture_profile.ply";
+// Chrome trace 파일명 (chrome://tracing 또는 https://ui.perfetto.dev 에서 열기)
+constexpr const char* kOutputTracePath = "gvsdk_capture_profile_trace.json";
+
+void printProfile(const gv::GvCaptureProfile& profile) {
+    std::printf("capture #%llu (%s)\n", static_cast<unsigned long long>(profile.capture_id),
+                profile.success ? "ok" : "failed");
+    for (int i = 0; i < gv::CaptureStage_Count; ++i) {
+        const gv::GvCaptureStage stage = static_cast<gv::GvCaptureStage>(i);
+        const gv::GvCaptureStageRecord& rec = profile.Stage(stage);
+        if (!rec.IsValid()) {
+            continue;
+        }
+        std::printf("  %-20s %9.2f ms  %10.2f MB  tid=%llu\n", gv::GvCaptureStageToString(stage),
+                    rec.DurationMs(), static_cast<double>(rec.bytes) / (1024.0 * 1024.0),
+                    static_cast<unsigned long long>(rec.thread_id));
+    }
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// 샘플 목적
+// - Single 카메라 3D 캡처를 여러 번 수행하면서 단계별 소요 시간을 출력합니다.
+// - 캡처가 느려졌을 때 취득(노출+전송), 계산, 콜백, 조회, 저장 중
+//   어느 구간이 원인인지 확인하는 용도입니다.
+// - 같은 구간을 Chrome trace JSON으로도 저장합니다.
+// -----------------------------------------------------------------------------
+int main() {
+    // [0] 구간 추적 시작 (GV_TRACE_SCOPE 구간 + 프로파일러 단계가 기록됩니다)
+    gv::GvTraceStart();
+
+    // [1] SDK 시스템 시작
+    bool inited = false;
+    {
+        GV_TRACE_SCOPE("GvSystemInit", "system");
+        inited = gv::GvSystemInit();
+    }
+    if (!inited) {
+        std::cerr << "GvSystemInit failed: " << gv::GvGetLastErrorMessage() << "\n";
+        return 1;
+    }
+
+    // [2] 장치 검색
+    int count = 0;
+    {
+        GV_TRACE_SCOPE("GvSystemGetDeviceCount", "device");
+        count = gv::GvSystemGetDeviceCount();
+    }
+    if (count <= 0) {
+        std::cerr << "No devices found: " << gv::GvGetLastErrorMessage() << "\n";
+        gv::GvSystemShutdown();
+        return 1;
+    }
+
+    gv::GvDeviceInfo info{};
+    if (!gv::GvSystemGetDeviceInfo(0, &info) || !info.support_single) {
+        std::cerr << "This sample supports Single camera only.\n";
+        gv::GvSystemShutdown();
+        return 1;
+    }
+
+    // [3] Single 카메라 생성 및 연결
+    gv::GvSingle cam = gv::GvSingle::Create(0, gv::CameraID_Left);
+    bool opened = false;
+    {
+        GV_TRACE_SCOPE("GvSingle::Open", "device");
+        opened = cam.IsValid() && cam.Open();
+    }
+    if (!opened) {
+        std::cerr << "GvSingle::Open failed: " << gv::GvGetLastErrorMessage() << "\n";
+        gv::GvSingle::Destroy(cam);
+        gv::GvSystemShutdown();
+        return 1;
+    }
+
+    // [4] 프로파일러 연결
+    // - Attach() 이후 콜백은 cam이 아닌 profiler에 등록해야 합니다.
+    bool ok = true;
+    {
+        gv::GvCaptureProfiler<gv::GvSingle> profiler(cam);
+        if (!profiler.Attach()) {
+            std::cerr << "Profiler attach failed: " << gv::GvGetLastErrorMessage() << "\n";
+            ok = false;
+        }
+        profiler.SetEnabled(true);
+
+        gv::GvSingle::GvCaptureOptions captureOpts;
+        captureOpts.capture_mode = gv::CaptureMode_Normal;
+        captureOpts.exposure_time_3d = 20;
+        captureOpts.noise_removal_point_number = 40;
+        captureOpts.noise_removal_distance = 3.0f;
+
+        // [5] 캡처 + 조회 + 저장을 반복하며 단계별 시간 출력
+        for (int i = 0; ok && i < kCaptureCount; ++i) {
+            if (!profiler.Capture(captureOpts)) {
+                std::cerr << "Capture failed: " << gv::GvGetLastErrorMessage() << "\n";
+                ok = false;
+                break;
+            }
+            gv::GvPointMap pointMap = profiler.GetPointMap();
+            const gv::GvImage texture = profiler.GetImage();
+            if (pointMap.IsValid()) {
+                const uint64_t bytes = gv::GvGetDataBytes(pointMap);
+                auto scope = profiler.ScopeStage(gv::CaptureStage_Save, bytes);
+                GV_TRACE_SCOPE("GvPointMap::Save", "io");
+                if (!pointMap.Save(kOutputPlyPath, gv::GvPointMapUnit::Millimeter, texture)) {
+                    std::cerr << "PointMap save failed: " << gv::GvGetLastErrorMessage() << "\n";
+                }
+            }
+            printProfile(profiler.GetLastCaptureProfile());
+        }
+    }
+
+    // [6] 자원 정리
+    cam.Close();
+    gv::GvSingle::Destroy(cam);
+    gv::GvSystemShutdown();
+
+    // [7] 추적 결과 저장
+    gv::GvTraceStop();
+    if (gv::GvTraceWriteChromeJson(kOutputTracePath)) {
+        std::cout << "Trace saved: " << kOutputTracePath << "\n";
+    }
+    return ok ? 0 : 1;
+}
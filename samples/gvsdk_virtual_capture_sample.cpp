@@ -0,0 +1,125 @@
+#include "GvCaptureProfiler.h"
+#include "GvPointMapFilter.h"
+#include "GvVirtualCamera.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// 반복 캡처 횟수
+constexpr int kCaptureCount = 10;
+// 패턴 1장당 모사 취득 시간(us). 0이면 계산 시간만 측정합니다.
+constexpr uint32_t kFrameTimeUs = 2000;
+
+struct CallbackStats {
+    int collectionCount = 0;
+    int calculationCount = 0;
+};
+
+void onCollection(const gv::GvVirtualSingle::GvCollectionCallBackInfo&, const gv::GvSingle::GvCaptureOptions&,
+                  gv::UserPtr user) {
+    ++static_cast<CallbackStats*>(user)->collectionCount;
+}
+
+void onCalculation(const gv::GvVirtualSingle::GvCalculationCallBackInfo& info,
+                   const gv::GvSingle::GvCaptureOptions&, gv::UserPtr user) {
+    if (info.pointmap != nullptr && info.pointmap->IsValid()) {
+        ++static_cast<CallbackStats*>(user)->calculationCount;
+    }
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// 샘플 목적
+// - 카메라 없이 가상 구조광 장치로 3D 캡처 파이프라인을 반복 실행합니다.
+// - 캡처별 단계 시간과 전체 처리량(captures/s, MB/s), 지연 분포를 출력합니다.
+// - 실제 장치 코드와 같은 흐름(장치 목록 -> Open -> 콜백 -> Capture -> 조회)을 따릅니다.
+// -----------------------------------------------------------------------------
+int main() {
+    // [1] 가상 장치 등록
+    gv::GvVirtualDeviceConfig config;
+    config.sn = "VIRTUAL-0001";
+    config.resolution = gv::GvSize(1280, 1024);
+    config.frame_time_us = kFrameTimeUs;
+    const int deviceIndex = gv::GvVirtualSystemAddDevice(config);
+
+    // [2] 장치 정보 확인
+    gv::GvDeviceInfo info{};
+    if (!gv::GvVirtualSystemGetDeviceInfo(deviceIndex, &info)) {
+        std::cerr << "GvVirtualSystemGetDeviceInfo failed: " << gv::GvGetLastHelperErrorMessage() << "\n";
+        return 1;
+    }
+    std::cout << "Virtual device: " << info.name << " (" << info.sn << ", " << info.port << ")\n";
+
+    // [3] 가상 카메라 생성 및 연결
+    gv::GvVirtualSingle cam(deviceIndex);
+    if (!cam.IsValid() || !cam.Open()) {
+        std::cerr << "GvVirtualSingle::Open failed: " << gv::GvGetLastHelperErrorMessage() << "\n";
+        return 1;
+    }
+
+    // [4] 프로파일러 연결 및 콜백 등록
+    gv::GvCaptureProfiler<gv::GvVirtualSingle> profiler(cam);
+    if (!profiler.Attach()) {
+        std::cerr << "Profiler attach failed\n";
+        return 1;
+    }
+    profiler.SetEnabled(true);
+    CallbackStats callbackStats;
+    profiler.SetCollectionCallBack(&onCollection, &callbackStats);
+    profiler.SetCalculationCallBack(&onCalculation, &callbackStats);
+
+    gv::GvSingle::GvCaptureOptions captureOpts;
+    captureOpts.capture_mode = gv::CaptureMode_Normal;
+    captureOpts.exposure_time_3d = 40;
+    captureOpts.truncate_z_min = 300.0f;
+    captureOpts.truncate_z_max = 1500.0f;
+    captureOpts.noise_removal_point_number = 8;
+    captureOpts.noise_removal_distance = 3.0f;
+
+    // [5] 반복 캡처
+    std::vector<double> latenciesMs;
+    uint64_t totalBytes = 0;
+    const uint64_t startNs = gv::GvNowNs();
+    for (int i = 0; i < kCaptureCount; ++i) {
+        if (!profiler.Capture(captureOpts)) {
+            std::cerr << "Capture failed: " << gv::GvGetLastHelperErrorMessage() << "\n";
+            return 1;
+        }
+        const gv::GvPointMapBuffer& pointMap = profiler.GetPointMap();
+        const gv::GvCaptureProfile& profile = profiler.GetLastCaptureProfile();
+        const gv::GvCaptureStageRecord& total = profile.Stage(gv::CaptureStage_Total);
+        latenciesMs.push_back(total.DurationMs());
+        totalBytes += gv::GvGetDataBytes(pointMap);
+
+        std::printf("capture #%llu  valid=%zu  acquisition=%.2f ms  processing=%.2f ms  total=%.2f ms\n",
+                    static_cast<unsigned long long>(profile.capture_id),
+                    gv::GvCountValidPoints(pointMap.GetPointDataConstPtr(), pointMap.GetSize()),
+                    profile.Stage(gv::CaptureStage_Acquisition).DurationMs(),
+                    profile.Stage(gv::CaptureStage_Processing).DurationMs(), total.DurationMs());
+    }
+    const double elapsedSec = static_cast<double>(gv::GvNowNs() - startNs) * 1e-9;
+
+    // [6] 처리량/지연 요약
+    std::sort(latenciesMs.begin(), latenciesMs.end());
+    const auto percentile = [&](double p) {
+        const size_t idx = static_cast<size_t>(p * static_cast<double>(latenciesMs.size() - 1) + 0.5);
+        return latenciesMs[idx];
+    };
+    std::printf("throughput: %.2f captures/s, %.2f MB/s (point map)\n", kCaptureCount / elapsedSec,
+                static_cast<double>(totalBytes) / (1024.0 * 1024.0) / elapsedSec);
+    std::printf("latency: p50=%.2f ms  p90=%.2f ms  max=%.2f ms\n", percentile(0.5), percentile(0.9),
+                latenciesMs.back());
+    std::printf("callbacks: collection=%d calculation=%d\n", callbackStats.collectionCount,
+                callbackStats.calculationCount);
+
+    // [7] 자원 정리
+    profiler.Detach();
+    cam.Close();
+    gv::GvVirtualSystemClearDevices();
+    return 0;
+}
@@ -0,0 +1,810 @@
+#include "GvArchive.h"
+
+#include "GvParallel.h"
+#include "GvPlatform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace gv {
+
+namespace {
+
+constexpr uint32_t kFileMagic = 0x52415647u;    // "GVAR"
+constexpr uint32_t kEntryMagic = 0x4E455647u;   // "GVEN"
+constexpr uint32_t kFooterMagic = 0x45415647u;  // "GVAE"
+constexpr uint32_t kFormatVersion = 1;
+constexpr size_t kFooterBytes = 16;
+constexpr size_t kRiceBlock = 64;
+constexpr uint32_t kRiceEscape = 32;
+// 2^52 이내여야 양자화 값이 double로 정확히 복원된다.
+constexpr double kMaxQuantized = 4503599627370496.0;
+
+// -----------------------------------------------------------------------------
+// 비트 입출력 (LSB 우선)
+// -----------------------------------------------------------------------------
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    /** @brief n <= 32 */
+    void Put(uint64_t value, int n) {
+        m_acc |= value << m_bits;
+        m_bits += n;
+        while (m_bits >= 8) {
+            m_out.push_back(static_cast<uint8_t>(m_acc));
+            m_acc >>= 8;
+            m_bits -= 8;
+        }
+    }
+
+    void PutWide(uint64_t value, int n) {
+        if (n > 32) {
+            Put(value & 0xFFFFFFFFull, 32);
+            Put(value >> 32, n - 32);
+        } else if (n > 0) {
+            Put(value, n);
+        }
+    }
+
+    void PutOnes(uint32_t n) {
+        while (n > 0) {
+            const int m = static_cast<int>(std::min<uint32_t>(n, 32));
+            Put((1ull << m) - 1, m);
+            n -= static_cast<uint32_t>(m);
+        }
+    }
+
+    void Flush() {
+        if (m_bits > 0) {
+            m_out.push_back(static_cast<uint8_t>(m_acc));
+        }
+        m_acc = 0;
+        m_bits = 0;
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_acc = 0;
+    int m_bits = 0;
+};
+
+inline int countTrailingOnes(uint64_t v) {
+    const uint64_t inv = ~v;
+    if (inv == 0) {
+        return 64;
+    }
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, inv);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(inv);
+#endif
+}
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t bytes)
+        : m_ptr(data), m_end(data + bytes), m_available(static_cast<uint64_t>(bytes) * 8) {}
+
+    /** @brief n <= 32 */
+    uint64_t Get(int n) {
+        if (m_bits < n) {
+            Fill();
+        }
+        const uint64_t value = m_acc & ((1ull << n) - 1);
+        Consume(n);
+        return value;
+    }
+
+    uint64_t GetWide(int n) {
+        if (n > 32) {
+            const uint64_t lo = Get(32);
+            return lo | (Get(n - 32) << 32);
+        }
+        return n > 0 ? Get(n) : 0;
+    }
+
+    /** @brief 연속된 1의 개수(최대 limit)를 읽는다. limit 미만이면 끝의 0도 소비한다. */
+    uint32_t GetUnary(uint32_t limit) {
+        uint32_t ones = 0;
+        while (ones < limit && !Overrun()) {
+            if (m_bits < 32) {
+                Fill();
+            }
+            const int run = std::min(countTrailingOnes(m_acc), m_bits);
+            const uint32_t take = std::min<uint32_t>(static_cast<uint32_t>(run), limit - ones);
+            Consume(static_cast<int>(take));
+            ones += take;
+            if (ones < limit && m_bits > 0) {
+                Consume(1);
+                break;
+            }
+        }
+        return ones;
+    }
+
+    /** @brief 실제 데이터보다 많이 읽었으면 true(손상된 스트림). */
+    bool Overrun() const { return m_consumed > m_available; }
+
+private:
+    void Fill() {
+        // 끝을 지나면 0으로 채운다. 과다 읽기는 Overrun()으로 판정한다.
+        while (m_bits <= 56) {
+            const uint64_t byte = m_ptr < m_end ? *m_ptr++ : 0;
+            m_acc |= byte << m_bits;
+            m_bits += 8;
+        }
+    }
+
+    void Consume(int n) {
+        m_acc = n >= 64 ? 0 : m_acc >> n;
+        m_bits -= n;
+        m_consumed += static_cast<uint64_t>(n);
+    }
+
+    const uint8_t* m_ptr;
+    const uint8_t* m_end;
+    uint64_t m_available;
+    uint64_t m_consumed = 0;
+    uint64_t m_acc = 0;
+    int m_bits = 0;
+};
+
+// -----------------------------------------------------------------------------
+// 블록 적응형 Rice 부호
+// - 64개 값마다 평균으로 k(0~58)를 정해 6비트로 기록한다.
+// - 몫이 32 이상이면 1을 32개 쓰고 값 전체(64비트)를 그대로 기록한다.
+// -----------------------------------------------------------------------------
+
+inline uint64_t zigzag(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t unzigzag(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+void riceEncode(BitWriter& bw, const uint64_t* values, size_t count) {
+    for (size_t block = 0; block < count; block += kRiceBlock) {
+        const size_t n = std::min(kRiceBlock, count - block);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += std::min<uint64_t>(values[block + i], 1ull << 56);
+        }
+        const uint64_t mean = sum / n;
+        int k = 0;
+        while (k < 58 && (2ull << k) <= mean + 1) {
+            ++k;
+        }
+        bw.Put(static_cast<uint64_t>(k), 6);
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t v = values[block + i];
+            const uint64_t q = v >> k;
+            if (q < kRiceEscape) {
+                bw.PutOnes(static_cast<uint32_t>(q));
+                bw.Put(0, 1);
+                bw.PutWide(v & ((1ull << k) - 1), k);
+            } else {
+                bw.PutOnes(kRiceEscape);
+                bw.PutWide(v, 64);
+            }
+        }
+    }
+}
+
+bool riceDecode(BitReader& br, uint64_t* values, size_t count) {
+    for (size_t block = 0; block < count; block += kRiceBlock) {
+        const size_t n = std::min(kRiceBlock, count - block);
+        const int k = static_cast<int>(br.Get(6));
+        if (k > 58) {
+            return false;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t q = br.GetUnary(kRiceEscape);
+            if (q < kRiceEscape) {
+                values[block + i] = (q << k) | br.GetWide(k);
+            } else {
+                values[block + i] = br.GetWide(64);
+            }
+        }
+        if (br.Overrun()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// tile 부호화
+// -----------------------------------------------------------------------------
+
+struct TileShape {
+    int width = 0;
+    int rows = 0;
+    int channels = 0;
+    /** @brief true면 실수 데이터(유효 마스크 + 양자화), false면 8비트 이미지. */
+    bool masked = false;
+    double step = 1.0;
+};
+
+/** @brief 평면 예측: 왼쪽/위/왼쪽 위가 모두 유효하면 L + U - UL, 아니면 L, U, 0 순. */
+template <typename Fn>
+void forEachPrediction(const TileShape& shape, const uint8_t* valid, const int64_t* q, Fn&& fn) {
+    const size_t width = static_cast<size_t>(shape.width);
+    const size_t ch = static_cast<size_t>(shape.channels);
+    for (size_t y = 0; y < static_cast<size_t>(shape.rows); ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            const size_t i = y * width + x;
+            if (!valid[i]) {
+                continue;
+            }
+            const bool hasL = x > 0 && valid[i - 1];
+            const bool hasU = y > 0 && valid[i - width];
+            const bool hasUL = hasL && hasU && valid[i - width - 1];
+            for (size_t c = 0; c < ch; ++c) {
+                int64_t pred = 0;
+                if (hasUL) {
+                    pred = q[(i - 1) * ch + c] + q[(i - width) * ch + c] - q[(i - width - 1) * ch + c];
+                } else if (hasL) {
+                    pred = q[(i - 1) * ch + c];
+                } else if (hasU) {
+                    pred = q[(i - width) * ch + c];
+                }
+                fn(i * ch + c, pred);
+            }
+        }
+    }
+}
+
+bool encodeTile(const TileShape& shape, const void* data, std::vector<uint8_t>& out) {
+    const size_t pixels = static_cast<size_t>(shape.width) * static_cast<size_t>(shape.rows);
+    const size_t ch = static_cast<size_t>(shape.channels);
+    std::vector<uint8_t> valid(pixels, 1);
+    std::vector<int64_t> q(pixels * ch, 0);
+
+    if (shape.masked) {
+        const double* src = static_cast<const double*>(data);
+        const double inv = 1.0 / shape.step;
+        for (size_t i = 0; i < pixels; ++i) {
+            bool ok = true;
+            for (size_t c = 0; c < ch && ok; ++c) {
+                ok = std::isfinite(src[i * ch + c]);
+            }
+            if (!ok) {
+                valid[i] = 0;
+                continue;
+            }
+            for (size_t c = 0; c < ch; ++c) {
+                const double scaled = std::nearbyint(src[i * ch + c] * inv);
+                if (std::fabs(scaled) >= kMaxQuantized) {
+                    return false;
+                }
+                q[i * ch + c] = static_cast<int64_t>(scaled);
+            }
+        }
+    } else {
+        const unsigned char* src = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < pixels * ch; ++i) {
+            q[i] = src[i];
+        }
+    }
+
+    // 유효 마스크: 유효부터 시작하는 교대 run 길이
+    std::vector<uint64_t> runs;
+    if (shape.masked) {
+        uint8_t state = 1;
+        uint64_t run = 0;
+        for (size_t i = 0; i < pixels; ++i) {
+            if (valid[i] == state) {
+                ++run;
+            } else {
+                runs.push_back(run);
+                state ^= 1;
+                run = 1;
+            }
+        }
+        runs.push_back(run);
+    }
+
+    std::vector<uint64_t> residuals;
+    residuals.reserve(pixels * ch);
+    forEachPrediction(shape, valid.data(), q.data(),
+                      [&](size_t index, int64_t pred) { residuals.push_back(zigzag(q[index] - pred)); });
+
+    out.clear();
+    out.reserve(residuals.size() + 16);
+    BitWriter bw(out);
+    bw.Put(runs.size(), 32);
+    riceEncode(bw, runs.data(), runs.size());
+    riceEncode(bw, residuals.data(), residuals.size());
+    bw.Flush();
+    return true;
+}
+
+bool decodeTile(const TileShape& shape, const uint8_t* bytes, size_t size, void* data) {
+    const size_t pixels = static_cast<size_t>(shape.width) * static_cast<size_t>(shape.rows);
+    const size_t ch = static_cast<size_t>(shape.channels);
+    BitReader br(bytes, size);
+    std::vector<uint8_t> valid(pixels, 1);
+
+    const size_t runCount = static_cast<size_t>(br.Get(32));
+    if (shape.masked) {
+        if (runCount == 0 || runCount > pixels + 1) {
+            return false;
+        }
+        std::vector<uint64_t> runs(runCount);
+        if (!riceDecode(br, runs.data(), runCount)) {
+            return false;
+        }
+        size_t pos = 0;
+        uint8_t state = 1;
+        for (uint64_t run : runs) {
+            if (run > pixels - pos) {
+                return false;
+            }
+            std::fill(valid.begin() + static_cast<std::ptrdiff_t>(pos),
+                      valid.begin() + static_cast<std::ptrdiff_t>(pos + run), state);
+            pos += static_cast<size_t>(run);
+            state ^= 1;
+        }
+        if (pos != pixels) {
+            return false;
+        }
+    } else if (runCount != 0) {
+        return false;
+    }
+
+    size_t validCount = 0;
+    for (uint8_t v : valid) {
+        validCount += v;
+    }
+    std::vector<uint64_t> residuals(validCount * ch);
+    if (!riceDecode(br, residuals.data(), residuals.size())) {
+        return false;
+    }
+    std::vector<int64_t> q(pixels * ch, 0);
+    size_t next = 0;
+    forEachPrediction(shape, valid.data(), q.data(),
+                      [&](size_t index, int64_t pred) { q[index] = pred + unzigzag(residuals[next++]); });
+
+    if (shape.masked) {
+        double* dst = static_cast<double*>(data);
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        for (size_t i = 0; i < pixels; ++i) {
+            for (size_t c = 0; c < ch; ++c) {
+                dst[i * ch + c] = valid[i] ? static_cast<double>(q[i * ch + c]) * shape.step : nan;
+            }
+        }
+    } else {
+        unsigned char* dst = static_cast<unsigned char*>(data);
+        for (size_t i = 0; i < pixels * ch; ++i) {
+            if (q[i] < 0 || q[i] > 255) {
+                return false;
+            }
+            dst[i] = static_cast<unsigned char>(q[i]);
+        }
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// 헤더 직렬화
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void append(std::vector<uint8_t>& out, T value) {
+    const size_t pos = out.size();
+    out.resize(pos + sizeof(T));
+    std::memcpy(out.data() + pos, &value, sizeof(T));
+}
+
+template <typename T>
+bool readValue(FILE* fp, T* value) {
+    return std::fread(value, sizeof(T), 1, fp) == 1;
+}
+
+bool writeBytes(FILE* fp, const void* data, size_t bytes) {
+    return bytes == 0 || std::fwrite(data, 1, bytes, fp) == bytes;
+}
+
+size_t elementBytes(GvArchiveEntryType::Enum type) {
+    return type == GvArchiveEntryType::Image ? 1 : sizeof(double);
+}
+
+}  // namespace
+
+const char* GvArchiveEntryType::ToString(GvArchiveEntryType::Enum e) {
+    switch (e) {
+        case PointMap: return "PointMap";
+        case DepthMap: return "DepthMap";
+        case ConfidenceMap: return "ConfidenceMap";
+        case Image: return "Image";
+        default: return "None";
+    }
+}
+
+// -----------------------------------------------------------------------------
+// GvArchiveWriter
+// -----------------------------------------------------------------------------
+
+GvArchiveWriter::~GvArchiveWriter() {
+    Close();
+}
+
+bool GvArchiveWriter::Open(const char* fileName, const GvArchiveOptions& options) {
+    Close();
+    if (fileName == nullptr || options.tile_rows <= 0 || !(options.point_precision > 0.0) ||
+        !(options.depth_precision > 0.0) || !(options.confidence_precision > 0.0)) {
+        detail::GvSetLastHelperError("GvArchiveWriter::Open: invalid arguments");
+        return false;
+    }
+    m_fp = std::fopen(fileName, "wb");
+    if (m_fp == nullptr) {
+        detail::GvSetLastHelperError(std::string("GvArchiveWriter::Open: cannot open ") + fileName);
+        return false;
+    }
+    m_options = options;
+    m_offsets.clear();
+    std::vector<uint8_t> header;
+    append(header, kFileMagic);
+    append(header, kFormatVersion);
+    if (!writeBytes(m_fp, header.data(), header.size())) {
+        detail::GvSetLastHelperError("GvArchiveWriter::Open: write failed");
+        std::fclose(m_fp);
+        m_fp = nullptr;
+        return false;
+    }
+    m_position = header.size();
+    return true;
+}
+
+bool GvArchiveWriter::AddPointMap(const char* name, const double* points, const GvSize& size) {
+    return AddEntry(name, GvArchiveEntryType::PointMap, points, size, GvImageType::None, m_options.point_precision);
+}
+
+bool GvArchiveWriter::AddPointMap(const char* name, const GvPointMapBuffer& points) {
+    return AddPointMap(name, points.GetPointDataConstPtr(), points.GetSize());
+}
+
+bool GvArchiveWriter::AddDepthMap(const char* name, const double* depth, const GvSize& size) {
+    return AddEntry(name, GvArchiveEntryType::DepthMap, depth, size, GvImageType::None, m_options.depth_precision);
+}
+
+bool GvArchiveWriter::AddDepthMap(const char* name, const GvDepthMapBuffer& depth) {
+    return AddDepthMap(name, depth.GetDataConstPtr(), depth.GetSize());
+}
+
+bool GvArchiveWriter::AddConfidenceMap(const char* name, const double* confidence, const GvSize& size) {
+    return AddEntry(name, GvArchiveEntryType::ConfidenceMap, confidence, size, GvImageType::None,
+                    m_options.confidence_precision);
+}
+
+bool GvArchiveWriter::AddConfidenceMap(const char* name, const GvConfidenceMapBuffer& confidence) {
+    return AddConfidenceMap(name, confidence.GetDataConstPtr(), confidence.GetSize());
+}
+
+bool GvArchiveWriter::AddImage(const char* name, const unsigned char* pixels, GvImageType::Enum type,
+                               const GvSize& size) {
+    return AddEntry(name, GvArchiveEntryType::Image, pixels, size, type, 1.0);
+}
+
+bool GvArchiveWriter::AddImage(const char* name, const GvImageBuffer& image) {
+    return AddImage(name, image.GetDataConstPtr(), image.GetType(), image.GetSize());
+}
+
+bool GvArchiveWriter::AddEntry(const char* name, GvArchiveEntryType::Enum type, const void* data,
+                               const GvSize& size, GvImageType::Enum imageType, double precision) {
+    if (m_fp == nullptr) {
+        detail::GvSetLastHelperError("GvArchiveWriter: archive is not open");
+        return false;
+    }
+    size_t channels = 1;
+    if (type == GvArchiveEntryType::PointMap) {
+        channels = 3;
+    } else if (type == GvArchiveEntryType::Image) {
+        channels = GvImageBufferPixelSize(imageType);
+    }
+    if (data == nullptr || size.width <= 0 || size.height <= 0 || channels == 0) {
+        detail::GvSetLastHelperError("GvArchiveWriter: invalid entry data");
+        return false;
+    }
+    const std::string entryName = name ? name : "";
+    const size_t tileRows = static_cast<size_t>(m_options.tile_rows);
+    const size_t tileCount = (static_cast<size_t>(size.height) + tileRows - 1) / tileRows;
+    const size_t rowBytes = static_cast<size_t>(size.width) * channels * elementBytes(type);
+
+    // [1] tile 병렬 압축
+    std::vector<std::vector<uint8_t>> tiles(tileCount);
+    std::atomic<bool> rangeError{false};
+    GvParallelFor(ThreadSubsystem_IO, 0, tileCount, m_options.threads, [&](size_t t0, size_t t1, int) {
+        for (size_t t = t0; t < t1; ++t) {
+            TileShape shape;
+            shape.width = size.width;
+            shape.rows = static_cast<int>(std::min(tileRows, static_cast<size_t>(size.height) - t * tileRows));
+            shape.channels = static_cast<int>(channels);
+            shape.masked = type != GvArchiveEntryType::Image;
+            shape.step = precision;
+            const void* src = static_cast<const uint8_t*>(data) + t * tileRows * rowBytes;
+            if (!encodeTile(shape, src, tiles[t])) {
+                rangeError.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+    if (rangeError.load()) {
+        detail::GvSetLastHelperError("GvArchiveWriter: value out of range for precision " + std::to_string(precision));
+        return false;
+    }
+
+    // [2] 항목 헤더 + tile 크기 표 + tile 데이터 순차 기록
+    std::vector<uint8_t> header;
+    append(header, kEntryMagic);
+    append(header, static_cast<uint32_t>(type));
+    append(header, static_cast<uint32_t>(imageType));
+    append(header, static_cast<int32_t>(size.width));
+    append(header, static_cast<int32_t>(size.height));
+    append(header, static_cast<uint32_t>(channels));
+    append(header, precision);
+    append(header, static_cast<uint32_t>(tileRows));
+    append(header, static_cast<uint32_t>(tileCount));
+    append(header, static_cast<uint64_t>(rowBytes) * static_cast<uint64_t>(size.height));
+    append(header, static_cast<uint32_t>(entryName.size()));
+    header.insert(header.end(), entryName.begin(), entryName.end());
+    uint64_t entryBytes = header.size();
+    for (const std::vector<uint8_t>& tile : tiles) {
+        append(header, static_cast<uint64_t>(tile.size()));
+        entryBytes += sizeof(uint64_t) + tile.size();
+    }
+    bool ok = writeBytes(m_fp, header.data(), header.size());
+    for (size_t t = 0; ok && t < tileCount; ++t) {
+        ok = writeBytes(m_fp, tiles[t].data(), tiles[t].size());
+    }
+    if (!ok) {
+        detail::GvSetLastHelperError("GvArchiveWriter: write failed");
+        return false;
+    }
+    m_offsets.push_back(m_position);
+    m_position += entryBytes;
+    return true;
+}
+
+bool GvArchiveWriter::Close() {
+    if (m_fp == nullptr) {
+        return true;
+    }
+    std::vector<uint8_t> tail;
+    for (uint64_t offset : m_offsets) {
+        append(tail, offset);
+    }
+    append(tail, m_position);
+    append(tail, static_cast<uint32_t>(m_offsets.size()));
+    append(tail, kFooterMagic);
+    bool ok = writeBytes(m_fp, tail.data(), tail.size());
+    ok = std::fclose(m_fp) == 0 && ok;
+    m_fp = nullptr;
+    m_offsets.clear();
+    if (!ok) {
+        detail::GvSetLastHelperError("GvArchiveWriter::Close: write failed");
+    }
+    return ok;
+}
+
+// -----------------------------------------------------------------------------
+// GvArchiveReader
+// -----------------------------------------------------------------------------
+
+GvArchiveReader::~GvArchiveReader() {
+    Close();
+}
+
+void GvArchiveReader::Close() {
+    if (m_fp != nullptr) {
+        std::fclose(m_fp);
+        m_fp = nullptr;
+    }
+    m_entries.clear();
+}
+
+bool GvArchiveReader::Open(const char* fileName, int threads) {
+    Close();
+    if (fileName == nullptr) {
+        detail::GvSetLastHelperError("GvArchiveReader::Open: invalid arguments");
+        return false;
+    }
+    m_fp = std::fopen(fileName, "rb");
+    if (m_fp == nullptr) {
+        detail::GvSetLastHelperError(std::string("GvArchiveReader::Open: cannot open ") + fileName);
+        return false;
+    }
+    m_threads = threads;
+    const auto fail = [&](const char* reason) {
+        detail::GvSetLastHelperError(std::string("GvArchiveReader::Open: ") + reason + ": " + fileName);
+        Close();
+        return false;
+    };
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (!readValue(m_fp, &magic) || !readValue(m_fp, &version) || magic != kFileMagic) {
+        return fail("not a GvArchive file");
+    }
+    if (version != kFormatVersion) {
+        return fail("unsupported format version");
+    }
+    if (!detail::GvFileSeekEnd(m_fp)) {
+        return fail("seek failed");
+    }
+    const uint64_t fileBytes = detail::GvFileTell(m_fp);
+    uint64_t indexOffset = 0;
+    uint32_t count = 0;
+    if (fileBytes < 8 + kFooterBytes || !detail::GvFileSeek(m_fp, fileBytes - kFooterBytes) ||
+        !readValue(m_fp, &indexOffset) || !readValue(m_fp, &count) || !readValue(m_fp, &magic) ||
+        magic != kFooterMagic || indexOffset + static_cast<uint64_t>(count) * 8 + kFooterBytes != fileBytes) {
+        return fail("missing or corrupt index (archive not closed?)");
+    }
+    std::vector<uint64_t> offsets(count);
+    if (!detail::GvFileSeek(m_fp, indexOffset) ||
+        (count > 0 && std::fread(offsets.data(), sizeof(uint64_t), count, m_fp) != count)) {
+        return fail("cannot read index");
+    }
+
+    m_entries.resize(count);
+    for (uint32_t e = 0; e < count; ++e) {
+        Entry& entry = m_entries[e];
+        uint32_t type = 0;
+        uint32_t imageType = 0;
+        int32_t width = 0;
+        int32_t height = 0;
+        uint32_t tileCount = 0;
+        uint32_t nameBytes = 0;
+        if (!detail::GvFileSeek(m_fp, offsets[e]) || !readValue(m_fp, &magic) || magic != kEntryMagic ||
+            !readValue(m_fp, &type) || !readValue(m_fp, &imageType) || !readValue(m_fp, &width) ||
+            !readValue(m_fp, &height) || !readValue(m_fp, &entry.channels) || !readValue(m_fp, &entry.info.precision) ||
+            !readValue(m_fp, &entry.tile_rows) || !readValue(m_fp, &tileCount) ||
+            !readValue(m_fp, &entry.info.raw_bytes) || !readValue(m_fp, &nameBytes) || nameBytes > 4096) {
+            return fail("corrupt entry header");
+        }
+        entry.info.name.resize(nameBytes);
+        entry.tile_bytes.resize(tileCount);
+        if ((nameBytes > 0 && std::fread(&entry.info.name[0], 1, nameBytes, m_fp) != nameBytes) ||
+            (tileCount > 0 && std::fread(entry.tile_bytes.data(), sizeof(uint64_t), tileCount, m_fp) != tileCount)) {
+            return fail("corrupt entry header");
+        }
+        entry.info.type = static_cast<GvArchiveEntryType::Enum>(type);
+        entry.info.image_type = static_cast<GvImageType::Enum>(imageType);
+        entry.info.size = GvSize(width, height);
+        entry.tiles_offset = detail::GvFileTell(m_fp);
+        entry.info.stored_bytes = (e + 1 < count ? offsets[e + 1] : indexOffset) - offsets[e];
+        if (width <= 0 || height <= 0 || entry.tile_rows == 0 ||
+            tileCount != (static_cast<uint32_t>(height) + entry.tile_rows - 1) / entry.tile_rows) {
+            return fail("corrupt entry header");
+        }
+    }
+    return true;
+}
+
+bool GvArchiveReader::GetEntryInfo(int index, GvArchiveEntryInfo& info) const {
+    if (index < 0 || index >= GetEntryCount()) {
+        detail::GvSetLastHelperError("GvArchiveReader::GetEntryInfo: index out of range");
+        return false;
+    }
+    info = m_entries[static_cast<size_t>(index)].info;
+    return true;
+}
+
+int GvArchiveReader::FindEntry(const char* name) const {
+    for (size_t i = 0; name != nullptr && i < m_entries.size(); ++i) {
+        if (m_entries[i].info.name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool GvArchiveReader::ReadPointMap(int index, GvPointMapBuffer& points) {
+    if (index < 0 || index >= GetEntryCount()) {
+        detail::GvSetLastHelperError("GvArchiveReader::ReadPointMap: index out of range");
+        return false;
+    }
+    GvPointMapBuffer result = GvPointMapBuffer::Create(m_entries[static_cast<size_t>(index)].info.size);
+    if (!Decode(index, GvArchiveEntryType::PointMap, result.GetPointDataPtr())) {
+        return false;
+    }
+    points = std::move(result);
+    return true;
+}
+
+bool GvArchiveReader::ReadScalarMap(int index, GvScalarMapBuffer& map) {
+    if (index < 0 || index >= GetEntryCount()) {
+        detail::GvSetLastHelperError("GvArchiveReader::ReadScalarMap: index out of range");
+        return false;
+    }
+    const Entry& entry = m_entries[static_cast<size_t>(index)];
+    if (entry.info.type != GvArchiveEntryType::DepthMap && entry.info.type != GvArchiveEntryType::ConfidenceMap) {
+        detail::GvSetLastHelperError("GvArchiveReader::ReadScalarMap: entry is not a depth/confidence map");
+        return false;
+    }
+    GvScalarMapBuffer result = GvScalarMapBuffer::Create(entry.info.size);
+    if (!Decode(index, entry.info.type, result.GetDataPtr())) {
+        return false;
+    }
+    map = std::move(result);
+    return true;
+}
+
+bool GvArchiveReader::ReadImage(int index, GvImageBuffer& image) {
+    if (index < 0 || index >= GetEntryCount()) {
+        detail::GvSetLastHelperError("GvArchiveReader::ReadImage: index out of range");
+        return false;
+    }
+    const Entry& entry = m_entries[static_cast<size_t>(index)];
+    GvImageBuffer result = GvImageBuffer::Create(entry.info.image_type, entry.info.size);
+    if (!result.IsValid() || GvImageBufferPixelSize(entry.info.image_type) != entry.channels) {
+        detail::GvSetLastHelperError("GvArchiveReader::ReadImage: unsupported image entry");
+        return false;
+    }
+    if (!Decode(index, GvArchiveEntryType::Image, result.GetDataPtr())) {
+        return false;
+    }
+    image = std::move(result);
+    return true;
+}
+
+bool GvArchiveReader::Decode(int index, GvArchiveEntryType::Enum expected, void* out) {
+    const Entry& entry = m_entries[static_cast<size_t>(index)];
+    if (entry.info.type != expected) {
+        detail::GvSetLastHelperError(std::string("GvArchiveReader: entry type is ") +
+                                     GvArchiveEntryType::ToString(entry.info.type) + ", expected " +
+                                     GvArchiveEntryType::ToString(expected));
+        return false;
+    }
+    const size_t expectedChannels = expected == GvArchiveEntryType::PointMap ? 3 : 1;
+    if (expected != GvArchiveEntryType::Image && entry.channels != expectedChannels) {
+        detail::GvSetLastHelperError("GvArchiveReader: corrupt entry channel count");
+        return false;
+    }
+    std::vector<uint64_t> tileStart(entry.tile_bytes.size() + 1, 0);
+    for (size_t t = 0; t < entry.tile_bytes.size(); ++t) {
+        tileStart[t + 1] = tileStart[t] + entry.tile_bytes[t];
+    }
+    std::vector<uint8_t> payload(static_cast<size_t>(tileStart.back()));
+    if (!detail::GvFileSeek(m_fp, entry.tiles_offset) ||
+        (!payload.empty() && std::fread(payload.data(), 1, payload.size(), m_fp) != payload.size())) {
+        detail::GvSetLastHelperError("GvArchiveReader: read failed");
+        return false;
+    }
+
+    const size_t height = static_cast<size_t>(entry.info.size.height);
+    const size_t rowBytes = static_cast<size_t>(entry.info.size.width) * entry.channels * elementBytes(expected);
+    std::atomic<bool> corrupt{false};
+    GvParallelFor(ThreadSubsystem_IO, 0, entry.tile_bytes.size(), m_threads, [&](size_t t0, size_t t1, int) {
+        for (size_t t = t0; t < t1; ++t) {
+            TileShape shape;
+            shape.width = entry.info.size.width;
+            shape.rows = static_cast<int>(std::min<size_t>(entry.tile_rows, height - t * entry.tile_rows));
+            shape.channels = static_cast<int>(entry.channels);
+            shape.masked = expected != GvArchiveEntryType::Image;
+            shape.step = entry.info.precision;
+            void* dst = static_cast<uint8_t*>(out) + t * entry.tile_rows * rowBytes;
+            if (!decodeTile(shape, payload.data() + tileStart[t], static_cast<size_t>(entry.tile_bytes[t]), dst)) {
+                corrupt.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+    if (corrupt.load()) {
+        detail::GvSetLastHelperError("GvArchiveReader: corrupt tile data in entry '" + entry.info.name + "'");
+        return false;
+    }
+    return true;
+}
+
+}  // namespace gv
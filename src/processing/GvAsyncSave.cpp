@@ -0,0 +1,295 @@
+#include "GvAsyncSave.h"
+
+#include "GvTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace gv {
+
+namespace {
+
+constexpr size_t kMaxFailures = 64;
+
+std::mutex& queueRegistryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<GvAsyncSaveQueue*>& queueRegistry() {
+    static std::vector<GvAsyncSaveQueue*> queues;
+    return queues;
+}
+
+}  // namespace
+
+GvAsyncSaveQueue::~GvAsyncSaveQueue() {
+    Stop();
+}
+
+bool GvAsyncSaveQueue::Start(const GvAsyncSaveOptions& options) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_started) {
+            detail::GvSetLastHelperError("GvAsyncSaveQueue::Start: queue is already running");
+            return false;
+        }
+        m_options = options;
+        m_options.threads = std::max(options.threads, 1);
+        m_stats = GvAsyncSaveStats();
+        m_failures.clear();
+        m_started = true;
+        m_stopping = false;
+        for (int i = 0; i < m_options.threads; ++i) {
+            m_workers.emplace_back([this]() { WorkerLoop(); });
+            m_workerIds.push_back(m_workers.back().get_id());
+        }
+    }
+    std::lock_guard<std::mutex> lock(queueRegistryMutex());
+    queueRegistry().push_back(this);
+    return true;
+}
+
+void GvAsyncSaveQueue::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_started) {
+            return;
+        }
+        if (OnWorkerThread()) {
+            detail::GvSetLastHelperError("GvAsyncSaveQueue::Stop: called from a completion callback");
+            return;
+        }
+    }
+    Drain();
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 다른 Stop()이 이미 스레드를 가져갔으면 정리는 그쪽이 한다.
+        if (m_workers.empty()) {
+            return;
+        }
+        m_stopping = true;
+        workers.swap(m_workers);
+    }
+    m_workCv.notify_all();
+    m_spaceCv.notify_all();
+    // 작업 스레드는 남은 작업을 모두 처리한 뒤 종료한다.
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_workerIds.clear();
+        m_started = false;
+        m_stopping = false;
+    }
+    std::lock_guard<std::mutex> lock(queueRegistryMutex());
+    std::vector<GvAsyncSaveQueue*>& queues = queueRegistry();
+    queues.erase(std::remove(queues.begin(), queues.end(), this), queues.end());
+}
+
+bool GvAsyncSaveQueue::IsRunning() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_started && !m_stopping;
+}
+
+uint64_t GvAsyncSaveQueue::Enqueue(const char* fileName, uint64_t bytes, GvAsyncSaveJob job,
+                                   GvAsyncSaveCallback callback) {
+    if (fileName == nullptr || !job) {
+        detail::GvSetLastHelperError("GvAsyncSaveQueue::Enqueue: invalid arguments");
+        return 0;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_started || m_stopping) {
+        detail::GvSetLastHelperError("GvAsyncSaveQueue::Enqueue: queue is not running");
+        return 0;
+    }
+
+    // [1] in-flight 예산 확인. 비어 있는 큐는 예산보다 큰 작업도 받는다.
+    const uint64_t limit = m_options.max_inflight_bytes;
+    const auto fits = [&]() {
+        return limit == 0 || m_stats.inflight_bytes == 0 || m_stats.inflight_bytes + bytes <= limit;
+    };
+    if (!fits()) {
+        if (!m_options.block_when_full) {
+            ++m_stats.rejected;
+            detail::GvSetLastHelperError("GvAsyncSaveQueue::Enqueue: in-flight byte budget exceeded");
+            return 0;
+        }
+        const uint64_t waitStart = GvNowNs();
+        m_spaceCv.wait(lock, [&]() { return fits() || m_stopping; });
+        m_stats.blocked_ns += GvNowNs() - waitStart;
+        if (m_stopping) {
+            detail::GvSetLastHelperError("GvAsyncSaveQueue::Enqueue: queue is stopping");
+            return 0;
+        }
+    }
+
+    // [2] 등록
+    Task task;
+    task.id = m_nextId++;
+    task.file_name = fileName;
+    task.bytes = bytes;
+    task.queued_ns = GvNowNs();
+    task.job = std::move(job);
+    task.callback = std::move(callback);
+    const uint64_t id = task.id;
+    m_tasks.push_back(std::move(task));
+    ++m_stats.enqueued;
+    ++m_stats.pending;
+    m_stats.inflight_bytes += bytes;
+    m_stats.peak_inflight_bytes = std::max(m_stats.peak_inflight_bytes, m_stats.inflight_bytes);
+    lock.unlock();
+    m_workCv.notify_one();
+    return id;
+}
+
+uint64_t GvAsyncSaveQueue::EnqueuePointCloud(const char* fileName, GvPointMapBuffer points, GvImageBuffer texture,
+                                             const GvPointCloudWriteOptions& options, GvAsyncSaveCallback callback) {
+    if (!points.IsValid()) {
+        detail::GvSetLastHelperError("GvAsyncSaveQueue::EnqueuePointCloud: invalid point map");
+        return 0;
+    }
+    struct Frame {
+        GvPointMapBuffer points;
+        GvImageBuffer texture;
+    };
+    // std::function은 복사 가능한 함수 객체만 받으므로 버퍼는 shared_ptr로 옮겨 담는다.
+    const std::shared_ptr<Frame> frame = std::make_shared<Frame>();
+    frame->points = std::move(points);
+    frame->texture = std::move(texture);
+    const uint64_t bytes = frame->points.GetBytes() + frame->texture.GetBytes();
+    const std::string name = fileName != nullptr ? fileName : "";
+    return Enqueue(
+        fileName, bytes,
+        [frame, name, options]() {
+            return GvSavePointCloud(name.c_str(), frame->points, frame->texture.IsValid() ? &frame->texture : nullptr,
+                                    options);
+        },
+        std::move(callback));
+}
+
+uint64_t GvAsyncSaveQueue::EnqueueImage(const char* fileName, GvImageBuffer image, const GvImageWriteOptions& options,
+                                        GvAsyncSaveCallback callback) {
+    if (!image.IsValid()) {
+        detail::GvSetLastHelperError("GvAsyncSaveQueue::EnqueueImage: invalid image");
+        return 0;
+    }
+    const std::shared_ptr<GvImageBuffer> held = std::make_shared<GvImageBuffer>(std::move(image));
+    const std::string name = fileName != nullptr ? fileName : "";
+    return Enqueue(
+        fileName, held->GetBytes(), [held, name, options]() { return GvSaveImageFile(name.c_str(), *held, options); },
+        std::move(callback));
+}
+
+bool GvAsyncSaveQueue::Drain(int timeout_ms) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // 완료 콜백(작업 스레드)에서 기다리면 자기 작업이 끝나지 않아 교착된다.
+    if (OnWorkerThread()) {
+        detail::GvSetLastHelperError("GvAsyncSaveQueue::Drain: called from a completion callback");
+        return false;
+    }
+    const auto idle = [&]() { return m_tasks.empty() && m_running == 0; };
+    if (timeout_ms <= 0) {
+        m_idleCv.wait(lock, idle);
+        return true;
+    }
+    return m_idleCv.wait_for(lock, std::chrono::milliseconds(timeout_ms), idle);
+}
+
+GvAsyncSaveStats GvAsyncSaveQueue::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+std::vector<GvAsyncSaveResult> GvAsyncSaveQueue::TakeFailures() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<GvAsyncSaveResult> failures;
+    failures.swap(m_failures);
+    return failures;
+}
+
+// m_mutex를 잡은 상태에서 호출한다.
+bool GvAsyncSaveQueue::OnWorkerThread() const {
+    return std::find(m_workerIds.begin(), m_workerIds.end(), std::this_thread::get_id()) != m_workerIds.end();
+}
+
+void GvAsyncSaveQueue::WorkerLoop() {
+    for (;;) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workCv.wait(lock, [&]() { return m_stopping || !m_tasks.empty(); });
+        if (m_tasks.empty()) {
+            return;
+        }
+        Task task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        --m_stats.pending;
+        ++m_running;
+        lock.unlock();
+
+        GvAsyncSaveResult result;
+        result.id = task.id;
+        result.file_name = task.file_name;
+        result.bytes = task.bytes;
+        result.queued_ns = task.queued_ns;
+        result.start_ns = GvNowNs();
+        detail::GvSetLastHelperError(std::string());
+        try {
+            GvTraceScope trace("GvAsyncSaveQueue::Job", "io", task.bytes, task.id);
+            result.ok = task.job();
+        } catch (const std::exception& e) {
+            result.error = std::string("exception: ") + e.what();
+        } catch (...) {
+            result.error = "unknown exception";
+        }
+        if (!result.ok && result.error.empty()) {
+            result.error = GvGetLastHelperErrorMessage();
+            if (result.error.empty()) {
+                result.error = "save failed";
+            }
+        }
+        result.end_ns = GvNowNs();
+        // 작업이 붙잡고 있는 데이터(SDK 핸들 복제본 포함)는 완료를 알리기 전에 해제한다.
+        task.job = GvAsyncSaveJob();
+        if (task.callback) {
+            try {
+                task.callback(result);
+            } catch (...) {
+            }
+            task.callback = GvAsyncSaveCallback();
+        }
+
+        lock.lock();
+        --m_running;
+        m_stats.inflight_bytes -= task.bytes;
+        if (result.ok) {
+            ++m_stats.completed;
+            m_stats.written_bytes += task.bytes;
+        } else {
+            ++m_stats.failed;
+            if (m_failures.size() >= kMaxFailures) {
+                m_failures.erase(m_failures.begin());
+            }
+            m_failures.push_back(result);
+        }
+        // Drain() 반환 직후 큐가 소멸할 수 있으므로 잠금을 쥔 채로 알린다.
+        m_spaceCv.notify_all();
+        if (m_tasks.empty() && m_running == 0) {
+            m_idleCv.notify_all();
+        }
+    }
+}
+
+bool GvDrainAsyncSaveQueues(int timeout_ms) {
+    std::lock_guard<std::mutex> lock(queueRegistryMutex());
+    bool drained = true;
+    for (GvAsyncSaveQueue* queue : queueRegistry()) {
+        drained = queue->Drain(timeout_ms) && drained;
+    }
+    return drained;
+}
+
+}  // namespace gv
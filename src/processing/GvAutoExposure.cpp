@@ -0,0 +1,296 @@
+#include "GvAutoExposure.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gv {
+
+namespace {
+
+constexpr double kConvergedLog = 0.0953101798;  // log(1.1)
+constexpr double kHdrMaxScale = 64.0;
+constexpr double kHdrHeadroom = 0.9;
+
+GvAutoExposureOptions sanitize(GvAutoExposureOptions options) {
+    options.sample_step = std::max(options.sample_step, 1);
+    options.frame_interval = std::max(options.frame_interval, 1);
+    options.saturation_level = std::min(std::max(options.saturation_level, 1), 255);
+    options.target_level = std::min(std::max(options.target_level, 1.0), 254.0);
+    options.smoothing = std::min(std::max(options.smoothing, 0.01), 1.0);
+    options.max_step_ratio = std::max(options.max_step_ratio, 1.0);
+    options.min_exposure = std::max(options.min_exposure, 1);
+    options.max_exposure = std::max(options.max_exposure, options.min_exposure);
+    options.min_gain = std::max(options.min_gain, 0.001f);
+    options.max_gain = std::max(options.max_gain, options.min_gain);
+    options.exposure_3d_ratio = options.exposure_3d_ratio > 0.0 ? options.exposure_3d_ratio : 1.0;
+    options.max_hdr_levels = std::min(std::max(options.max_hdr_levels, 1), 3);
+    return options;
+}
+
+// 부분 히스토그램 4개에 번갈아 누적한다. 같은 값이 이어지는 영역(배경, 포화)에서 한 칸을 연속으로 갱신하면
+// 이전 증가의 저장이 끝나야 다음 적재를 할 수 있어 느려진다.
+struct PartialHistogram {
+    uint32_t bins[4][256];
+};
+
+void accumulateMono(const unsigned char* row, int count, int step, PartialHistogram& h) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const unsigned char* p = row + static_cast<size_t>(i) * step;
+        ++h.bins[0][p[0]];
+        ++h.bins[1][p[step]];
+        ++h.bins[2][p[2 * step]];
+        ++h.bins[3][p[3 * step]];
+    }
+    for (; i < count; ++i) {
+        ++h.bins[0][row[static_cast<size_t>(i) * step]];
+    }
+}
+
+// 휘도 근사 (R + 2G + B) / 4는 채널 순서(RGB/BGR)와 무관하다. 포화는 최대 채널로 센다.
+inline void colorSample(const unsigned char* p, uint32_t* bins, int saturation, uint64_t& saturated) {
+    const int c0 = p[0];
+    const int c1 = p[1];
+    const int c2 = p[2];
+    ++bins[(c0 + 2 * c1 + c2 + 2) >> 2];
+    saturated += static_cast<uint64_t>(std::max(c0, std::max(c1, c2)) >= saturation);
+}
+
+void accumulateColor(const unsigned char* row, int count, int pixelStride, int saturation, PartialHistogram& h,
+                     uint64_t& saturated) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const unsigned char* p = row + static_cast<size_t>(i) * pixelStride;
+        colorSample(p, h.bins[0], saturation, saturated);
+        colorSample(p + pixelStride, h.bins[1], saturation, saturated);
+        colorSample(p + 2 * pixelStride, h.bins[2], saturation, saturated);
+        colorSample(p + 3 * pixelStride, h.bins[3], saturation, saturated);
+    }
+    for (; i < count; ++i) {
+        colorSample(row + static_cast<size_t>(i) * pixelStride, h.bins[0], saturation, saturated);
+    }
+}
+
+// 누적 비율이 fraction에 처음 도달하는 칸.
+int percentile(const GvExposureHistogram& histogram, double fraction) {
+    const double target = fraction * static_cast<double>(histogram.total);
+    uint64_t counted = 0;
+    for (int v = 0; v < 256; ++v) {
+        counted += histogram.bins[v];
+        if (static_cast<double>(counted) >= target) {
+            return v;
+        }
+    }
+    return 255;
+}
+
+double clampScale(double scale, double limit) {
+    return std::min(std::max(scale, 1.0 / limit), limit);
+}
+
+// 노출량(노출 x 게인)을 노출 우선으로 나눈다.
+void splitExposure(double amount, const GvAutoExposureOptions& options, int& exposure, float& gain) {
+    const double wanted = std::round(amount / options.min_gain);
+    exposure = static_cast<int>(std::min(std::max(wanted, static_cast<double>(options.min_exposure)),
+                                         static_cast<double>(options.max_exposure)));
+    const double g = amount / static_cast<double>(exposure);
+    gain = static_cast<float>(std::min(std::max(g, static_cast<double>(options.min_gain)),
+                                       static_cast<double>(options.max_gain)));
+}
+
+}  // namespace
+
+bool GvComputeExposureHistogram(const GvRealtimeImageFrame& frame, const GvROI& roi, int sample_step,
+                                int saturation_level, GvExposureHistogram& histogram) {
+    histogram = GvExposureHistogram();
+    if (frame.data == nullptr || frame.width <= 0 || frame.height <= 0 ||
+        (frame.channels != 1 && frame.channels != 3 && frame.channels != 4) ||
+        frame.stride_bytes < frame.width * frame.channels) {
+        detail::GvSetLastHelperError("GvComputeExposureHistogram: unsupported frame");
+        return false;
+    }
+    // [1] ROI를 프레임 안으로 자른다(크기 0이면 전체).
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = frame.width;
+    int y1 = frame.height;
+    if (roi.width > 0 && roi.height > 0) {
+        x0 = std::max(roi.x, 0);
+        y0 = std::max(roi.y, 0);
+        x1 = std::min(roi.x + roi.width, frame.width);
+        y1 = std::min(roi.y + roi.height, frame.height);
+    }
+    if (x0 >= x1 || y0 >= y1) {
+        detail::GvSetLastHelperError("GvComputeExposureHistogram: ROI outside frame");
+        return false;
+    }
+    const int step = std::max(sample_step, 1);
+    const int count = (x1 - x0 + step - 1) / step;
+    const int saturation = std::min(std::max(saturation_level, 1), 255);
+
+    // [2] 표본 행마다 부분 히스토그램에 누적
+    PartialHistogram partial;
+    std::memset(&partial, 0, sizeof(partial));
+    uint64_t saturated = 0;
+    for (int y = y0; y < y1; y += step) {
+        const unsigned char* row = frame.data + static_cast<size_t>(y) * static_cast<size_t>(frame.stride_bytes) +
+                                   static_cast<size_t>(x0) * static_cast<size_t>(frame.channels);
+        if (frame.channels == 1) {
+            accumulateMono(row, count, step, partial);
+        } else {
+            accumulateColor(row, count, step * frame.channels, saturation, partial, saturated);
+        }
+    }
+
+    // [3] 합치기. 흑백은 히스토그램에서 포화를 센다.
+    for (int v = 0; v < 256; ++v) {
+        const uint32_t n = partial.bins[0][v] + partial.bins[1][v] + partial.bins[2][v] + partial.bins[3][v];
+        histogram.bins[v] = n;
+        histogram.total += n;
+        if (frame.channels == 1 && v >= saturation) {
+            saturated += n;
+        }
+    }
+    histogram.saturated = saturated;
+    return true;
+}
+
+GvAutoExposure::GvAutoExposure(const GvAutoExposureOptions& options) : m_options(sanitize(options)) {}
+
+void GvAutoExposure::SetOptions(const GvAutoExposureOptions& options) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_options = sanitize(options);
+}
+
+GvAutoExposureOptions GvAutoExposure::GetOptions() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_options;
+}
+
+void GvAutoExposure::SetStreamSettings(int exposure_time, float gain) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_streamExposure = std::max(exposure_time, 1);
+    m_streamGain = gain > 0.0f ? gain : 1.0f;
+}
+
+bool GvAutoExposure::Update(const GvRealtimeImageFrame& frame) {
+    // [1] 설정 복사, 측면/프레임 간격 확인
+    GvAutoExposureOptions options;
+    double streamAmount = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        options = m_options;
+        streamAmount = static_cast<double>(m_streamExposure) * static_cast<double>(m_streamGain);
+    }
+    if (options.camera_id != CameraID_Both && frame.camera_id != options.camera_id) {
+        return false;
+    }
+    const uint64_t sequence = m_frameCounter.fetch_add(1, std::memory_order_relaxed);
+    if (sequence % static_cast<uint64_t>(options.frame_interval) != 0) {
+        return false;
+    }
+
+    // [2] 히스토그램과 통계(잠금 밖)
+    const uint64_t start = GvNowNs();
+    GvExposureHistogram histogram;
+    if (!GvComputeExposureHistogram(frame, options.roi, options.sample_step, options.saturation_level, histogram)) {
+        return false;
+    }
+    const double total = static_cast<double>(histogram.total);
+    uint64_t sum = 0;
+    for (int v = 0; v < 256; ++v) {
+        sum += static_cast<uint64_t>(v) * histogram.bins[v];
+    }
+    const double mean = static_cast<double>(sum) / total;
+    const double saturatedFraction = static_cast<double>(histogram.saturated) / total;
+    const double dark = percentile(histogram, options.hdr_dark_percentile);
+    const double bright = percentile(histogram, options.hdr_bright_percentile);
+
+    // [3] 보정 배율: 평균을 목표로, 포화가 한도를 넘으면 넘은 비율만큼 줄인다.
+    double scale = options.target_level / std::max(mean, 0.5);
+    if (saturatedFraction > options.max_saturated_fraction) {
+        scale = std::min(scale, options.max_saturated_fraction / saturatedFraction);
+    }
+    scale = clampScale(scale, options.max_step_ratio);
+
+    // [4] HDR 양끝 배율. 밝은 쪽이 이미 포화면 실제 밝기를 모르므로 최대 한 단계만 줄인다.
+    double longScale = clampScale(options.target_level / std::max(dark, 0.5), kHdrMaxScale);
+    double shortScale = bright >= options.saturation_level
+                            ? 1.0 / options.max_step_ratio
+                            : clampScale(kHdrHeadroom * options.saturation_level / std::max(bright, 0.5), kHdrMaxScale);
+    if (shortScale > longScale) {
+        shortScale = longScale = scale;
+    }
+    const uint64_t measureNs = GvNowNs() - start;
+
+    // [5] 로그 영역 평활 후 추천 반영
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const double logAmount = std::log(streamAmount * scale);
+    const double logShort = std::log(streamAmount * shortScale);
+    const double logLong = std::log(streamAmount * longScale);
+    GvExposureSuggestion& s = m_suggestion;
+    if (!s.valid) {
+        m_logExposure = logAmount;
+        m_logHdrShort = logShort;
+        m_logHdrLong = logLong;
+    } else {
+        m_logExposure += options.smoothing * (logAmount - m_logExposure);
+        m_logHdrShort += options.smoothing * (logShort - m_logHdrShort);
+        m_logHdrLong += options.smoothing * (logLong - m_logHdrLong);
+    }
+
+    const double amount = std::exp(m_logExposure);
+    splitExposure(amount, options, s.exposure_time_2d, s.gain_2d);
+    splitExposure(amount * options.exposure_3d_ratio, options, s.exposure_time_3d, s.gain_3d);
+
+    const double ratio = std::exp(m_logHdrLong - m_logHdrShort);
+    int levels = ratio < 2.0 ? 1 : (ratio < 8.0 ? 2 : 3);
+    levels = std::min(levels, options.max_hdr_levels);
+    s.hdr_levels = levels;
+    for (int i = 0; i < 3; ++i) {
+        s.hdr_exposure_time[i] = 0;
+        s.hdr_gain[i] = 1.0f;
+    }
+    for (int i = 0; i < levels; ++i) {
+        // 한 단계면 일반 추천, 여러 단계면 짧은 노출~긴 노출을 등비로 나눈다.
+        const double logLevel = levels == 1 ? m_logExposure
+                                            : m_logHdrShort + (m_logHdrLong - m_logHdrShort) * i / (levels - 1);
+        splitExposure(std::exp(logLevel) * options.exposure_3d_ratio, options, s.hdr_exposure_time[i], s.hdr_gain[i]);
+    }
+
+    s.valid = true;
+    s.converged = std::fabs(std::log(scale)) < kConvergedLog;
+    s.mean_level = mean;
+    s.saturated_fraction = saturatedFraction;
+    s.dark_level = dark;
+    s.bright_level = bright;
+    s.correction = scale;
+    s.frame_id = frame.frame_id;
+    ++s.measured_frames;
+    s.updated_ns = GvNowNs();
+    s.measure_ns = measureNs;
+    return true;
+}
+
+GvExposureSuggestion GvAutoExposure::GetSuggestion() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_suggestion;
+}
+
+void GvAutoExposure::Reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_suggestion = GvExposureSuggestion();
+    m_logExposure = 0.0;
+    m_logHdrShort = 0.0;
+    m_logHdrLong = 0.0;
+    m_frameCounter.store(0, std::memory_order_relaxed);
+}
+
+void GvAutoExposure::RealtimeCallback(const GvRealtimeImageFrame* frame, UserPtr user_data) {
+    if (frame != nullptr && user_data != nullptr) {
+        static_cast<GvAutoExposure*>(user_data)->Update(*frame);
+    }
+}
+
+}  // namespace gv
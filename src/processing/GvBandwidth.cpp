@@ -0,0 +1,437 @@
+#include "GvBandwidth.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <iphlpapi.h>
+#else
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#endif
+
+namespace gv {
+
+namespace {
+
+constexpr double kThroughputSmoothing = 0.3;
+
+#if defined(_WIN32)
+uint32_t prefixMask(unsigned prefix) {
+    return prefix == 0 ? 0u : prefix >= 32 ? 0xFFFFFFFFu : ~((1u << (32 - prefix)) - 1u);
+}
+#else
+uint64_t linkSpeedBps(const char* name) {
+    // /sys/class/net/<name>/speed: Mb/s, 링크가 없거나 가상 장치면 -1 또는 읽기 실패.
+    const std::string path = std::string("/sys/class/net/") + name + "/speed";
+    FILE* fp = std::fopen(path.c_str(), "r");
+    if (fp == nullptr) {
+        return 0;
+    }
+    long mbps = -1;
+    const int read = std::fscanf(fp, "%ld", &mbps);
+    std::fclose(fp);
+    return read == 1 && mbps > 0 ? static_cast<uint64_t>(mbps) * 1000000ull : 0;
+}
+#endif
+
+}  // namespace
+
+bool GvListNetworkInterfaces(std::vector<GvNetworkInterface>& interfaces) {
+    interfaces.clear();
+#if defined(_WIN32)
+    ULONG size = 16 * 1024;
+    std::vector<unsigned char> buffer;
+    ULONG result = ERROR_BUFFER_OVERFLOW;
+    const ULONG flags = GAA_FLAG_SKIP_ANYCAST | GAA_FLAG_SKIP_MULTICAST | GAA_FLAG_SKIP_DNS_SERVER;
+    for (int attempt = 0; attempt < 3 && result == ERROR_BUFFER_OVERFLOW; ++attempt) {
+        buffer.resize(size);
+        result = ::GetAdaptersAddresses(AF_INET, flags, nullptr,
+                                        reinterpret_cast<IP_ADAPTER_ADDRESSES*>(buffer.data()), &size);
+    }
+    if (result != NO_ERROR) {
+        detail::GvSetLastHelperError("GvListNetworkInterfaces: GetAdaptersAddresses failed(" +
+                                     std::to_string(result) + ")");
+        return false;
+    }
+    for (const IP_ADAPTER_ADDRESSES* a = reinterpret_cast<const IP_ADAPTER_ADDRESSES*>(buffer.data()); a != nullptr;
+         a = a->Next) {
+        if (a->OperStatus != IfOperStatusUp || a->IfType == IF_TYPE_SOFTWARE_LOOPBACK) {
+            continue;
+        }
+        for (const IP_ADAPTER_UNICAST_ADDRESS* u = a->FirstUnicastAddress; u != nullptr; u = u->Next) {
+            if (u->Address.lpSockaddr == nullptr || u->Address.lpSockaddr->sa_family != AF_INET) {
+                continue;
+            }
+            GvNetworkInterface nic;
+            nic.name = a->AdapterName;
+            nic.ipv4 = ntohl(reinterpret_cast<const sockaddr_in*>(u->Address.lpSockaddr)->sin_addr.s_addr);
+            nic.netmask = prefixMask(u->OnLinkPrefixLength);
+            // 속도를 모르면 ULONG64 최댓값이 들어온다.
+            nic.link_speed_bps = a->ReceiveLinkSpeed != ~0ull ? a->ReceiveLinkSpeed : 0;
+            interfaces.push_back(std::move(nic));
+        }
+    }
+#else
+    ifaddrs* list = nullptr;
+    if (::getifaddrs(&list) != 0) {
+        detail::GvSetLastHelperError("GvListNetworkInterfaces: getifaddrs failed");
+        return false;
+    }
+    for (const ifaddrs* a = list; a != nullptr; a = a->ifa_next) {
+        if (a->ifa_addr == nullptr || a->ifa_addr->sa_family != AF_INET || (a->ifa_flags & IFF_UP) == 0 ||
+            (a->ifa_flags & IFF_LOOPBACK) != 0) {
+            continue;
+        }
+        GvNetworkInterface nic;
+        nic.name = a->ifa_name;
+        nic.ipv4 = ntohl(reinterpret_cast<const sockaddr_in*>(a->ifa_addr)->sin_addr.s_addr);
+        nic.netmask = a->ifa_netmask != nullptr
+                          ? ntohl(reinterpret_cast<const sockaddr_in*>(a->ifa_netmask)->sin_addr.s_addr)
+                          : 0;
+        nic.link_speed_bps = linkSpeedBps(a->ifa_name);
+        interfaces.push_back(std::move(nic));
+    }
+    ::freeifaddrs(list);
+#endif
+    return true;
+}
+
+bool GvParseIpv4(const char* text, uint32_t& address) {
+    if (text == nullptr) {
+        return false;
+    }
+    unsigned parts[4];
+    char tail = '\0';
+    const int n = std::sscanf(text, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &tail);
+    if (n < 4 || (n == 5 && tail != ':') || parts[0] > 255 || parts[1] > 255 || parts[2] > 255 || parts[3] > 255) {
+        return false;
+    }
+    address = (parts[0] << 24) | (parts[1] << 16) | (parts[2] << 8) | parts[3];
+    return true;
+}
+
+int GvFindNetworkInterface(const std::vector<GvNetworkInterface>& interfaces, uint32_t address) {
+    int best = -1;
+    for (size_t i = 0; i < interfaces.size(); ++i) {
+        const GvNetworkInterface& nic = interfaces[i];
+        if (nic.netmask == 0 || (nic.ipv4 & nic.netmask) != (address & nic.netmask)) {
+            continue;
+        }
+        if (best < 0 || nic.netmask > interfaces[static_cast<size_t>(best)].netmask) {
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+bool GvBandwidthAllocator::Initialize(const GvBandwidthOptions& options) {
+    std::vector<GvNetworkInterface> interfaces;
+    if (!GvListNetworkInterfaces(interfaces)) {
+        return false;
+    }
+    return Initialize(std::move(interfaces), options);
+}
+
+bool GvBandwidthAllocator::Initialize(std::vector<GvNetworkInterface> interfaces, const GvBandwidthOptions& options) {
+    if (!(options.link_utilization > 0.0 && options.link_utilization <= 1.0) || !(options.device_max_bps > 0.0) ||
+        !(options.default_link_bps > 0.0) || options.min_percent < 0.0f || options.max_percent > 100.0f ||
+        options.min_percent > options.max_percent) {
+        detail::GvSetLastHelperError("GvBandwidthAllocator::Initialize: invalid options");
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_devices.empty()) {
+        detail::GvSetLastHelperError("GvBandwidthAllocator::Initialize: devices already added");
+        return false;
+    }
+    m_options = options;
+    m_interfaces = std::move(interfaces);
+    m_links.assign(m_interfaces.size(), Link());
+    for (size_t i = 0; i < m_interfaces.size(); ++i) {
+        GvBandwidthLinkStats& link = m_links[i].stats;
+        link.interface_name = m_interfaces[i].name;
+        link.ipv4 = m_interfaces[i].ipv4;
+        link.link_bps = m_interfaces[i].link_speed_bps > 0 ? static_cast<double>(m_interfaces[i].link_speed_bps)
+                                                            : options.default_link_bps;
+    }
+    return true;
+}
+
+int GvBandwidthAllocator::AddDevice(const GvDeviceInfo& info, GvBandwidthSetter setter, uint64_t bytes_per_capture) {
+    if (!setter) {
+        detail::GvSetLastHelperError("GvBandwidthAllocator::AddDevice: setter is empty");
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Device device;
+    device.setter = std::move(setter);
+    device.bytes_per_capture = bytes_per_capture;
+    device.stats.id = m_nextId++;
+    device.stats.sn.assign(info.sn, strnlen(info.sn, sizeof(info.sn)));
+    uint32_t address = 0;
+    if (info.type == PortType_GIGE && GvParseIpv4(info.port, address)) {
+        device.stats.link = GvFindNetworkInterface(m_interfaces, address);
+    }
+    m_devices.push_back(std::move(device));
+    return m_devices.back().stats.id;
+}
+
+bool GvBandwidthAllocator::RemoveDevice(int id) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_devices.begin(), m_devices.end(), [id](const Device& d) { return d.stats.id == id; });
+        if (it == m_devices.end()) {
+            detail::GvSetLastHelperError("GvBandwidthAllocator::RemoveDevice: unknown device id");
+            return false;
+        }
+        m_devices.erase(it);
+    }
+    // 남은 장치가 빠진 몫을 나눠 갖는다.
+    return Rebalance();
+}
+
+void GvBandwidthAllocator::BeginCapture(int id) {
+    bool rebalance = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Device* device = FindDevice(id);
+        if (device == nullptr) {
+            return;
+        }
+        rebalance = !device->applied || !IsActive(*device, GvNowNs());
+        device->in_capture = true;
+    }
+    if (rebalance) {
+        Rebalance();
+    }
+    // 이 장치 몫만 호출 스레드(장치를 쓰는 스레드)에서 적용한다.
+    ApplyPending(id);
+    // 분배 적용(`SetBandwidth()`) 시간은 전송 시간에 넣지 않는다.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Device* device = FindDevice(id);
+    if (device != nullptr) {
+        device->capture_start_ns = GvNowNs();
+    }
+}
+
+bool GvBandwidthAllocator::ApplyPending(int id) {
+    GvBandwidthSetter setter;
+    float percent = 0.0f;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Device* device = FindDevice(id);
+        if (device == nullptr) {
+            return false;
+        }
+        if (!device->has_pending) {
+            return true;
+        }
+        device->has_pending = false;
+        setter = device->setter;
+        percent = device->pending_percent;
+    }
+    const bool applied = setter(percent);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Device* device = FindDevice(id);
+    if (device == nullptr) {
+        return false;
+    }
+    if (!applied) {
+        ++device->stats.set_failures;
+        // 다음 BeginCapture()에서 다시 시도한다(그 사이 새 값이 정해졌으면 그것을 쓴다).
+        if (!device->has_pending) {
+            device->has_pending = true;
+            device->pending_percent = percent;
+        }
+        detail::GvSetLastHelperError("GvBandwidthAllocator::ApplyPending: SetBandwidth failed");
+        return false;
+    }
+    device->stats.percent = percent;
+    device->applied = true;
+    return true;
+}
+
+void GvBandwidthAllocator::EndCapture(int id, bool ok, uint64_t transfer_ns, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Device* device = FindDevice(id);
+    if (device == nullptr) {
+        return;
+    }
+    const uint64_t now = GvNowNs();
+    GvBandwidthDeviceStats& s = device->stats;
+    const bool measured = transfer_ns != 0;
+    if (transfer_ns == 0 && device->in_capture) {
+        transfer_ns = now - device->capture_start_ns;
+    }
+    device->in_capture = false;
+    device->last_end_ns = now;
+    ++s.captures;
+    if (!ok) {
+        ++s.failed_captures;
+        return;
+    }
+    if (bytes == 0) {
+        bytes = device->bytes_per_capture;
+    }
+    s.bytes += bytes;
+    s.last_transfer_ms = static_cast<double>(transfer_ns) / 1.0e6;
+    if (bytes == 0 || transfer_ns == 0) {
+        return;
+    }
+
+    // [1] 처리량(지수 이동 평균)
+    const double mbps = static_cast<double>(bytes) / (static_cast<double>(transfer_ns) / 1.0e9) / 1.0e6;
+    s.throughput_mbps =
+        s.throughput_mbps == 0.0 ? mbps : s.throughput_mbps + kThroughputSmoothing * (mbps - s.throughput_mbps);
+
+    // [2] 할당 대역폭으로 예상한 전송 시간과 비교(손실/재전송이 있으면 길어진다).
+    //     호출자가 전송 시간을 준 경우만: 경과 시간에는 노출/계산이 들어 있어 정상 캡처도 느리게 보인다.
+    if (measured && s.percent > 0.0f) {
+        const double allocatedBps = m_options.device_max_bps * s.percent / 100.0;
+        const double expectedNs = static_cast<double>(bytes) * 8.0 / allocatedBps * 1.0e9;
+        if (static_cast<double>(transfer_ns) > expectedNs * m_options.slow_capture_ratio) {
+            ++s.slow_captures;
+        }
+    }
+
+    // [3] 링크 처리량: 같은 링크에서 캡처 중인 장치의 합
+    if (s.link >= 0) {
+        GvBandwidthLinkStats& link = m_links[static_cast<size_t>(s.link)].stats;
+        double sum = 0.0;
+        for (const Device& d : m_devices) {
+            if (d.stats.link == s.link && IsActive(d, now)) {
+                sum += d.stats.throughput_mbps;
+            }
+        }
+        link.measured_mbps = sum;
+        link.peak_mbps = std::max(link.peak_mbps, sum);
+    }
+}
+
+void GvBandwidthAllocator::RecordRetry(int id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (Device* device = FindDevice(id)) {
+        ++device->stats.retries;
+    }
+}
+
+bool GvBandwidthAllocator::Rebalance() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const uint64_t now = GvNowNs();
+        const double deviceMax = m_options.device_max_bps;
+        std::vector<float> target(m_devices.size(), m_options.max_percent);
+
+        // [1] 링크별: 유휴 장치는 최소값, 남은 예산은 캡처 중인 장치에 수요 비율로
+        for (size_t l = 0; l < m_links.size(); ++l) {
+            GvBandwidthLinkStats& link = m_links[l].stats;
+            link.devices = 0;
+            link.active_devices = 0;
+            double weights = 0.0;
+            double measured = 0.0;
+            for (Device& d : m_devices) {
+                d.stats.active = IsActive(d, now);
+                if (d.stats.link != static_cast<int>(l)) {
+                    continue;
+                }
+                ++link.devices;
+                if (d.stats.active) {
+                    ++link.active_devices;
+                    weights += static_cast<double>(std::max<uint64_t>(d.bytes_per_capture, 1));
+                    measured += d.stats.throughput_mbps;
+                }
+            }
+            link.measured_mbps = measured;
+            const double idleBps = deviceMax * m_options.min_percent / 100.0 * (link.devices - link.active_devices);
+            const double remaining = std::max(0.0, link.link_bps * m_options.link_utilization - idleBps);
+            for (size_t i = 0; i < m_devices.size(); ++i) {
+                const Device& d = m_devices[i];
+                if (d.stats.link != static_cast<int>(l)) {
+                    continue;
+                }
+                double percent = m_options.min_percent;
+                if (d.stats.active && weights > 0.0) {
+                    const double share = remaining * static_cast<double>(std::max<uint64_t>(d.bytes_per_capture, 1)) /
+                                         weights;
+                    percent = share / deviceMax * 100.0;
+                }
+                target[i] = static_cast<float>(
+                    std::min<double>(m_options.max_percent, std::max<double>(m_options.min_percent, percent)));
+            }
+        }
+        for (Device& d : m_devices) {
+            d.stats.active = IsActive(d, now);
+        }
+
+        // [2] 바뀐 장치만 적용 대기로 표시한다. 적용은 각 장치의 `ApplyPending()`(`BeginCapture()`)에서 한다.
+        for (size_t i = 0; i < m_devices.size(); ++i) {
+            Device& d = m_devices[i];
+            const float planned = d.has_pending ? d.pending_percent : d.stats.percent;
+            if (!d.applied || std::abs(target[i] - planned) >= m_options.hysteresis_percent) {
+                d.pending_percent = target[i];
+                d.has_pending = true;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<GvBandwidthDeviceStats> GvBandwidthAllocator::GetDeviceStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint64_t now = GvNowNs();
+    std::vector<GvBandwidthDeviceStats> out;
+    out.reserve(m_devices.size());
+    for (const Device& d : m_devices) {
+        out.push_back(d.stats);
+        out.back().active = IsActive(d, now);
+    }
+    return out;
+}
+
+std::vector<GvBandwidthLinkStats> GvBandwidthAllocator::GetLinkStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<GvBandwidthLinkStats> out;
+    out.reserve(m_links.size());
+    for (const Link& link : m_links) {
+        out.push_back(link.stats);
+    }
+    return out;
+}
+
+bool GvBandwidthAllocator::IsActive(const Device& device, uint64_t now) const {
+    if (device.in_capture) {
+        return true;
+    }
+    const uint64_t timeout = static_cast<uint64_t>(std::max(0, m_options.idle_timeout_ms)) * 1000000ull;
+    return device.last_end_ns != 0 && now - device.last_end_ns < timeout;
+}
+
+GvBandwidthAllocator::Device* GvBandwidthAllocator::FindDevice(int id) {
+    for (Device& d : m_devices) {
+        if (d.stats.id == id) {
+            return &d;
+        }
+    }
+    detail::GvSetLastHelperError("GvBandwidthAllocator: unknown device id " + std::to_string(id));
+    return nullptr;
+}
+
+const GvBandwidthAllocator::Device* GvBandwidthAllocator::FindDevice(int id) const {
+    return const_cast<GvBandwidthAllocator*>(this)->FindDevice(id);
+}
+
+}  // namespace gv
@@ -0,0 +1,178 @@
+#include "GvCalibrationCache.h"
+
+#include "GvDeflate.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+namespace gv {
+
+namespace {
+
+constexpr uint32_t kCacheMagic = 0x42435647;  // "GVCB"
+constexpr uint32_t kCacheVersion = 1;
+
+// 파일: FileHeader -> GvDeviceCalibration(raw). CRC는 본문만 덮는다.
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t payload_bytes;
+    uint32_t payload_crc;
+    char sn[64];
+    char firmware_version[64];
+};
+
+// 키는 GvDeviceInfo 필드를 그대로(64 bytes 전체) 복사해 비교한다.
+static_assert(sizeof(FileHeader::sn) == sizeof(GvDeviceInfo::sn), "sn key size");
+static_assert(sizeof(FileHeader::firmware_version) == sizeof(GvDeviceInfo::firmware_version), "firmware key size");
+
+std::string sanitize(const char* text, size_t capacity) {
+    std::string out(text, strnlen(text, capacity));
+    for (char& c : out) {
+        const bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' ||
+                        c == '.';
+        if (!ok) {
+            c = '_';
+        }
+    }
+    return out.empty() ? "_" : out;
+}
+
+bool sameKey(const FileHeader& header, const GvDeviceInfo& info) {
+    return std::strncmp(header.sn, info.sn, sizeof(header.sn)) == 0 &&
+           std::strncmp(header.firmware_version, info.firmware_version, sizeof(header.firmware_version)) == 0;
+}
+
+uint32_t crcOf(uint32_t crc, const void* data, size_t size) {
+    return detail::GvCrc32(crc, static_cast<const uint8_t*>(data), size);
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+#if defined(_WIN32)
+    return ::MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+}  // namespace
+
+uint32_t GvDeviceCalibrationHash(const GvDeviceCalibration& calibration) {
+    const int32_t size[3] = {calibration.resolution.width, calibration.resolution.height, calibration.camera_count};
+    uint32_t crc = crcOf(0, size, sizeof(size));
+    for (int i = 0; i < calibration.camera_count && i < 2; ++i) {
+        const GvCameraCalibration& cam = calibration.cameras[i];
+        crc = crcOf(crc, cam.intrinsic, sizeof(cam.intrinsic));
+        crc = crcOf(crc, cam.distortion, sizeof(cam.distortion));
+        if (cam.has_extrinsic) {
+            crc = crcOf(crc, cam.extrinsic, sizeof(cam.extrinsic));
+        }
+    }
+    return crc;
+}
+
+const char* GvCalibrationCacheStatus::ToString(GvCalibrationCacheStatus::Enum e) {
+    switch (e) {
+        case Hit: return "Hit";
+        case Miss: return "Miss";
+        case Stale: return "Stale";
+    }
+    return "Unknown";
+}
+
+std::string GvCalibrationCache::GetPath(const GvDeviceInfo& info) const {
+    std::string path = m_directory;
+    if (!path.empty() && path.back() != '/' && path.back() != '\\') {
+        path += '/';
+    }
+    return path + sanitize(info.sn, sizeof(info.sn)) + "_" +
+           sanitize(info.firmware_version, sizeof(info.firmware_version)) + ".gvcal";
+}
+
+bool GvCalibrationCache::Load(const GvDeviceInfo& info, GvDeviceCalibration& calibration) const {
+    if (info.sn[0] == '\0') {
+        detail::GvSetLastHelperError("GvCalibrationCache::Load: device has no serial number");
+        return false;
+    }
+    const std::string path = GetPath(info);
+    FILE* fp = std::fopen(path.c_str(), "rb");
+    if (fp == nullptr) {
+        detail::GvSetLastHelperError("GvCalibrationCache::Load: no cache entry: " + path);
+        return false;
+    }
+    FileHeader header;
+    GvDeviceCalibration loaded;
+    const bool read = std::fread(&header, sizeof(header), 1, fp) == 1 &&
+                      header.payload_bytes == sizeof(GvDeviceCalibration) &&
+                      std::fread(&loaded, sizeof(loaded), 1, fp) == 1;
+    std::fclose(fp);
+    // [1] 형식/키 확인 -> [2] 본문 CRC 확인(깨진 파일, 다른 구조체 배치)
+    if (!read || header.magic != kCacheMagic || header.version != kCacheVersion || !sameKey(header, info)) {
+        detail::GvSetLastHelperError("GvCalibrationCache::Load: cache entry does not match: " + path);
+        return false;
+    }
+    if (crcOf(0, &loaded, sizeof(loaded)) != header.payload_crc || loaded.camera_count < 1 ||
+        loaded.camera_count > 2) {
+        detail::GvSetLastHelperError("GvCalibrationCache::Load: corrupt cache entry: " + path);
+        return false;
+    }
+    calibration = loaded;
+    return true;
+}
+
+bool GvCalibrationCache::Store(const GvDeviceInfo& info, const GvDeviceCalibration& calibration) const {
+    if (info.sn[0] == '\0' || calibration.camera_count < 1 || calibration.camera_count > 2) {
+        detail::GvSetLastHelperError("GvCalibrationCache::Store: invalid arguments");
+        return false;
+    }
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = kCacheMagic;
+    header.version = kCacheVersion;
+    header.payload_bytes = sizeof(GvDeviceCalibration);
+    header.payload_crc = crcOf(0, &calibration, sizeof(calibration));
+    std::memcpy(header.sn, info.sn, sizeof(header.sn));
+    std::memcpy(header.firmware_version, info.firmware_version, sizeof(header.firmware_version));
+
+    // 다른 프로세스가 같은 장치를 동시에 저장해도 임시 파일이 겹치지 않게 PID를 붙인다.
+    const std::string path = GetPath(info);
+    const std::string temp = path + "." + std::to_string(GvCurrentProcessId()) + ".tmp";
+    FILE* fp = std::fopen(temp.c_str(), "wb");
+    if (fp == nullptr) {
+        detail::GvSetLastHelperError("GvCalibrationCache::Store: cannot open " + temp);
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              std::fwrite(&calibration, sizeof(calibration), 1, fp) == 1;
+    ok = std::fflush(fp) == 0 && ok;
+    ok = std::fclose(fp) == 0 && ok;
+    if (!ok || !replaceFile(temp, path)) {
+        std::remove(temp.c_str());
+        detail::GvSetLastHelperError("GvCalibrationCache::Store: cannot write " + path);
+        return false;
+    }
+    return true;
+}
+
+bool GvCalibrationCache::Remove(const GvDeviceInfo& info) const {
+    const std::string path = GetPath(info);
+    if (std::remove(path.c_str()) != 0) {
+        detail::GvSetLastHelperError("GvCalibrationCache::Remove: cannot remove " + path);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace gv
@@ -0,0 +1,268 @@
+#include "GvColoredPointMap.h"
+
+#include "GvParallel.h"
+
+namespace gv {
+
+namespace {
+
+constexpr int kFracBits = 8;
+constexpr int kFracOne = 1 << kFracBits;
+
+struct FuseJob {
+    const double* points;
+    GvSize size;
+    const unsigned char* texture;
+    GvSize textureSize;
+    size_t textureStride;
+    // texture_camera 투영(mapped == false면 픽셀 단위 대응)
+    bool mapped;
+    bool bilinear;
+    double K[9];
+    double dist[5];
+    double R[9];
+    double t[3];
+    double roiX;
+    double roiY;
+};
+
+inline void setColor(GvPointXYZRGBA& p, int r, int g, int b, bool valid) {
+    p.r = static_cast<uint8_t>(r);
+    p.g = static_cast<uint8_t>(g);
+    p.b = static_cast<uint8_t>(b);
+    p.a = valid ? 255 : 0;
+}
+
+inline void setColor(GvPointXYZRGB& p, int r, int g, int b, bool) {
+    p.r = static_cast<uint8_t>(r);
+    p.g = static_cast<uint8_t>(g);
+    p.b = static_cast<uint8_t>(b);
+}
+
+// 형식별 픽셀 읽기(RGB 순서로 돌려준다). 형식은 템플릿 인자라 호출부에 분기가 남지 않는다.
+template <GvImageType::Enum Type>
+inline void pixelRgb(const unsigned char* row, size_t x, int* rgb) {
+    if (Type == GvImageType::Mono8) {
+        rgb[0] = rgb[1] = rgb[2] = row[x];
+    } else if (Type == GvImageType::RGB8) {
+        rgb[0] = row[x * 3];
+        rgb[1] = row[x * 3 + 1];
+        rgb[2] = row[x * 3 + 2];
+    } else if (Type == GvImageType::BGR8) {
+        rgb[0] = row[x * 3 + 2];
+        rgb[1] = row[x * 3 + 1];
+        rgb[2] = row[x * 3];
+    } else {
+        rgb[0] = rgb[1] = rgb[2] = 0;
+    }
+}
+
+// 같은 카메라: 포인트 i <-> 텍스처 픽셀 i.
+template <typename Point, GvImageType::Enum Type>
+void fuseDirectRows(const FuseJob& job, Point* out, size_t r0, size_t r1) {
+    const size_t width = static_cast<size_t>(job.size.width);
+    for (size_t row = r0; row < r1; ++row) {
+        const double* p = job.points + row * width * 3;
+        const unsigned char* tex = Type == GvImageType::None ? nullptr : job.texture + row * job.textureStride;
+        Point* o = out + row * width;
+        for (size_t u = 0; u < width; ++u, p += 3, ++o) {
+            o->x = static_cast<float>(p[0]);
+            o->y = static_cast<float>(p[1]);
+            o->z = static_cast<float>(p[2]);
+            int rgb[3];
+            pixelRgb<Type>(tex, u, rgb);
+            setColor(*o, rgb[0], rgb[1], rgb[2], Type != GvImageType::None && p[2] == p[2]);
+        }
+    }
+}
+
+// 다른 카메라: 포인트 -> 2D 카메라 좌표 -> 왜곡 -> 텍스처 픽셀(보간).
+template <typename Point, GvImageType::Enum Type>
+void fuseProjectedRows(const FuseJob& job, Point* out, size_t r0, size_t r1) {
+    const size_t width = static_cast<size_t>(job.size.width);
+    const int tw = job.textureSize.width;
+    const int th = job.textureSize.height;
+    const double* K = job.K;
+    const double* d = job.dist;
+    const double* R = job.R;
+    for (size_t row = r0; row < r1; ++row) {
+        const double* p = job.points + row * width * 3;
+        Point* o = out + row * width;
+        for (size_t u = 0; u < width; ++u, p += 3, ++o) {
+            o->x = static_cast<float>(p[0]);
+            o->y = static_cast<float>(p[1]);
+            o->z = static_cast<float>(p[2]);
+            setColor(*o, 0, 0, 0, false);
+            if (!(p[2] == p[2])) {
+                continue;
+            }
+            const double cz = R[6] * p[0] + R[7] * p[1] + R[8] * p[2] + job.t[2];
+            if (!(cz > 0.0)) {
+                continue;
+            }
+            const double x = (R[0] * p[0] + R[1] * p[1] + R[2] * p[2] + job.t[0]) / cz;
+            const double y = (R[3] * p[0] + R[4] * p[1] + R[5] * p[2] + job.t[1]) / cz;
+            const double r2 = x * x + y * y;
+            const double radial = 1.0 + r2 * (d[0] + r2 * (d[1] + r2 * d[4]));
+            const double xd = x * radial + 2.0 * d[2] * x * y + d[3] * (r2 + 2.0 * x * x);
+            const double yd = y * radial + d[2] * (r2 + 2.0 * y * y) + 2.0 * d[3] * x * y;
+            const double su = K[0] * xd + K[1] * yd + K[2] - job.roiX;
+            const double sv = K[4] * yd + K[5] - job.roiY;
+            // 픽셀 중심 기준 [0, w - 1]x[0, h - 1] 밖은 색상 없음.
+            if (!(su >= 0.0 && sv >= 0.0 && su <= tw - 1 && sv <= th - 1)) {
+                continue;
+            }
+            int rgb[3];
+            if (!job.bilinear) {
+                const size_t ix = static_cast<size_t>(su + 0.5);
+                const size_t iy = static_cast<size_t>(sv + 0.5);
+                pixelRgb<Type>(job.texture + iy * job.textureStride, ix, rgb);
+                setColor(*o, rgb[0], rgb[1], rgb[2], true);
+                continue;
+            }
+            // su, sv >= 0이므로 +0.5 절사가 반올림이다(lround보다 빠름).
+            const int fixedU = static_cast<int>(su * kFracOne + 0.5);
+            const int fixedV = static_cast<int>(sv * kFracOne + 0.5);
+            int ix = fixedU >> kFracBits;
+            int iy = fixedV >> kFracBits;
+            int fx = fixedU & (kFracOne - 1);
+            int fy = fixedV & (kFracOne - 1);
+            if (ix >= tw - 1) {
+                ix = tw - 2;
+                fx = kFracOne;
+            }
+            if (iy >= th - 1) {
+                iy = th - 2;
+                fy = kFracOne;
+            }
+            const unsigned char* row0 = job.texture + static_cast<size_t>(iy) * job.textureStride;
+            const unsigned char* row1 = row0 + job.textureStride;
+            int c00[3], c01[3], c10[3], c11[3];
+            pixelRgb<Type>(row0, static_cast<size_t>(ix), c00);
+            pixelRgb<Type>(row0, static_cast<size_t>(ix) + 1, c01);
+            pixelRgb<Type>(row1, static_cast<size_t>(ix), c10);
+            pixelRgb<Type>(row1, static_cast<size_t>(ix) + 1, c11);
+            for (int c = 0; c < 3; ++c) {
+                const int top = c00[c] * (kFracOne - fx) + c01[c] * fx;
+                const int bottom = c10[c] * (kFracOne - fx) + c11[c] * fx;
+                rgb[c] = (top * (kFracOne - fy) + bottom * fy + (1 << (2 * kFracBits - 1))) >> (2 * kFracBits);
+            }
+            setColor(*o, rgb[0], rgb[1], rgb[2], true);
+        }
+    }
+}
+
+template <typename Point, GvImageType::Enum Type>
+void fuseRows(const FuseJob& job, Point* out, size_t r0, size_t r1) {
+    if (job.mapped) {
+        fuseProjectedRows<Point, Type>(job, out, r0, r1);
+    } else {
+        fuseDirectRows<Point, Type>(job, out, r0, r1);
+    }
+}
+
+template <typename Point>
+bool fusePoints(const double* points, const GvSize& size, const unsigned char* texture, GvImageType::Enum textureType,
+                const GvSize& textureSize, int textureStride, Point* out, const GvColorFuseOptions& options) {
+    // [1] 입력 확인
+    if (points == nullptr || out == nullptr || size.width <= 0 || size.height <= 0) {
+        detail::GvSetLastHelperError("GvFuseColoredPoints: invalid arguments");
+        return false;
+    }
+    FuseJob job;
+    job.points = points;
+    job.size = size;
+    job.texture = texture;
+    job.textureSize = textureSize;
+    job.mapped = texture != nullptr && options.texture_camera != nullptr;
+    job.bilinear = options.bilinear;
+    const GvImageType::Enum type = texture != nullptr ? textureType : GvImageType::None;
+    if (texture != nullptr) {
+        const size_t pixelSize = GvImageBufferPixelSize(textureType);
+        if (pixelSize == 0) {
+            detail::GvSetLastHelperError("GvFuseColoredPoints: texture must be Mono8, RGB8 or BGR8");
+            return false;
+        }
+        const size_t packed = static_cast<size_t>(textureSize.width > 0 ? textureSize.width : 0) * pixelSize;
+        job.textureStride = textureStride > 0 ? static_cast<size_t>(textureStride) : packed;
+        if (textureSize.width <= 0 || textureSize.height <= 0 || job.textureStride < packed) {
+            detail::GvSetLastHelperError("GvFuseColoredPoints: invalid texture size or stride");
+            return false;
+        }
+        if (!job.mapped && textureSize != size) {
+            detail::GvSetLastHelperError(
+                "GvFuseColoredPoints: texture size does not match the point map (set texture_camera)");
+            return false;
+        }
+    }
+
+    // [2] 2D 카메라 투영 준비(공통 좌표계 = 포인트맵 좌표계)
+    if (job.mapped) {
+        const GvCameraCalibration& cam = *options.texture_camera;
+        if (cam.intrinsic[0] == 0.0f || cam.intrinsic[4] == 0.0f || textureSize.width < 2 ||
+            textureSize.height < 2) {
+            detail::GvSetLastHelperError("GvFuseColoredPoints: invalid texture camera");
+            return false;
+        }
+        for (int i = 0; i < 9; ++i) {
+            job.K[i] = cam.intrinsic[i];
+        }
+        for (int i = 0; i < 5; ++i) {
+            job.dist[i] = cam.distortion[i];
+        }
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                job.R[r * 3 + c] = cam.has_extrinsic ? cam.extrinsic[r * 4 + c] : (r == c ? 1.0 : 0.0);
+            }
+            job.t[r] = cam.has_extrinsic ? cam.extrinsic[r * 4 + 3] : 0.0;
+        }
+        job.roiX = options.texture_roi.width > 0 ? options.texture_roi.x : 0;
+        job.roiY = options.texture_roi.height > 0 ? options.texture_roi.y : 0;
+    }
+
+    // [3] 형식은 여기서 한 번만 고르고 행 단위로 병렬 처리
+    void (*rows)(const FuseJob&, Point*, size_t, size_t) = nullptr;
+    switch (type) {
+        case GvImageType::Mono8: rows = fuseRows<Point, GvImageType::Mono8>; break;
+        case GvImageType::RGB8: rows = fuseRows<Point, GvImageType::RGB8>; break;
+        case GvImageType::BGR8: rows = fuseRows<Point, GvImageType::BGR8>; break;
+        default: rows = fuseDirectRows<Point, GvImageType::None>; break;
+    }
+    const size_t height = static_cast<size_t>(size.height);
+    GvParallelFor(ThreadSubsystem_Filter, 0, height, options.threads,
+                  [&](size_t r0, size_t r1, int) { rows(job, out, r0, r1); });
+    return true;
+}
+
+}  // namespace
+
+bool GvFuseColoredPoints(const double* points, const GvSize& size, const unsigned char* texture,
+                         GvImageType::Enum textureType, const GvSize& textureSize, int textureStride,
+                         GvPointXYZRGBA* out, const GvColorFuseOptions& options) {
+    return fusePoints(points, size, texture, textureType, textureSize, textureStride, out, options);
+}
+
+bool GvFuseColoredPoints(const double* points, const GvSize& size, const unsigned char* texture,
+                         GvImageType::Enum textureType, const GvSize& textureSize, int textureStride,
+                         GvPointXYZRGB* out, const GvColorFuseOptions& options) {
+    return fusePoints(points, size, texture, textureType, textureSize, textureStride, out, options);
+}
+
+bool GvFuseColoredPointMap(const GvPointMapBuffer& points, const GvImageBuffer& texture, GvColoredPointMapBuffer& out,
+                           const GvColorFuseOptions& options) {
+    if (!points.IsValid()) {
+        detail::GvSetLastHelperError("GvFuseColoredPointMap: invalid point map");
+        return false;
+    }
+    if (out.GetSize() != points.GetSize()) {
+        out = GvColoredPointMapBuffer::Create(points.GetSize());
+    }
+    const bool withColor = texture.IsValid();
+    return GvFuseColoredPoints(points.GetPointDataConstPtr(), points.GetSize(),
+                               withColor ? texture.GetDataConstPtr() : nullptr,
+                               withColor ? texture.GetType() : GvImageType::None, texture.GetSize(),
+                               withColor ? static_cast<int>(texture.GetStrideBytes()) : 0, out.GetPointDataPtr(),
+                               options);
+}
+
+}  // namespace gv
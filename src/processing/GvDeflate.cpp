@@ -0,0 +1,967 @@
+#include "GvDeflate.h"
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace gv {
+namespace detail {
+
+namespace {
+
+constexpr size_t kWindowSize = 32768;
+constexpr int kMinMatch = 3;
+constexpr int kMaxMatch = 258;
+constexpr int kHashBits = 15;
+constexpr size_t kBlockTokens = 1u << 15;
+constexpr size_t kMaxStoredBlock = 65535;
+constexpr int kLitLenSymbols = 286;
+constexpr int kDistSymbols = 30;
+constexpr int kCodeLenSymbols = 19;
+constexpr int kBestMaxChain = 128;
+constexpr int kBestGoodLength = 32;
+constexpr int kBestNiceLength = 128;
+
+const uint16_t kLengthBase[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                  31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t kDistBase[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t kDistExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+const uint8_t kCodeLenOrder[kCodeLenSymbols] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+struct CodeTables {
+    uint8_t length_code[kMaxMatch + 1];
+    /** @brief `d - 1 < 256`이면 `[d - 1]`, 아니면 `[256 + ((d - 1) >> 7)]`. */
+    uint8_t dist_code[512];
+
+    CodeTables() {
+        for (int c = 0; c < 29; ++c) {
+            for (int i = 0; i < (1 << kLengthExtra[c]) && kLengthBase[c] + i <= kMaxMatch; ++i) {
+                length_code[kLengthBase[c] + i] = static_cast<uint8_t>(c);
+            }
+        }
+        for (int c = 0; c < 30; ++c) {
+            for (int i = 0; i < (1 << kDistExtra[c]); ++i) {
+                const int d = kDistBase[c] + i - 1;
+                dist_code[d < 256 ? d : 256 + (d >> 7)] = static_cast<uint8_t>(c);
+            }
+        }
+    }
+
+    int DistCode(int dist) const {
+        const int d = dist - 1;
+        return dist_code[d < 256 ? d : 256 + (d >> 7)];
+    }
+};
+
+const CodeTables& codeTables() {
+    static const CodeTables tables;
+    return tables;
+}
+
+struct Token {
+    /** @brief `dist == 0`이면 literal 값, 아니면 일치 길이. */
+    uint16_t litlen;
+    uint16_t dist;
+};
+
+// -----------------------------------------------------------------------------
+// 비트 출력 (LSB 우선)
+// -----------------------------------------------------------------------------
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    /** @brief n <= 32 */
+    void Put(uint32_t value, int n) {
+        m_acc |= static_cast<uint64_t>(value) << m_bits;
+        m_bits += n;
+        if (m_bits >= 32) {
+            const uint8_t bytes[4] = {static_cast<uint8_t>(m_acc), static_cast<uint8_t>(m_acc >> 8),
+                                      static_cast<uint8_t>(m_acc >> 16), static_cast<uint8_t>(m_acc >> 24)};
+            m_out.insert(m_out.end(), bytes, bytes + 4);
+            m_acc >>= 32;
+            m_bits -= 32;
+        }
+    }
+
+    void AlignToByte() {
+        while (m_bits > 0) {
+            m_out.push_back(static_cast<uint8_t>(m_acc));
+            m_acc >>= 8;
+            m_bits = std::max(m_bits - 8, 0);
+        }
+        m_acc = 0;
+    }
+
+    /** @brief `AlignToByte()` 이후에만 호출한다. */
+    void PutBytes(const uint8_t* data, size_t size) { m_out.insert(m_out.end(), data, data + size); }
+
+private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_acc = 0;
+    int m_bits = 0;
+};
+
+// -----------------------------------------------------------------------------
+// Huffman 부호
+// -----------------------------------------------------------------------------
+
+/** @brief 최대 길이 `limit`인 Huffman 부호 길이. 넘치면 빈도를 절반으로 줄여 다시 만든다. */
+void buildLengths(const uint32_t* freq, int n, int limit, uint8_t* lengths) {
+    std::fill(lengths, lengths + n, 0);
+    std::vector<int> symbols;
+    for (int i = 0; i < n; ++i) {
+        if (freq[i] != 0) {
+            symbols.push_back(i);
+        }
+    }
+    if (symbols.empty()) {
+        return;
+    }
+    if (symbols.size() == 1) {
+        // 부호가 하나뿐이면 일부 decoder가 거부하므로 두 번째 부호를 둔다.
+        lengths[symbols[0]] = 1;
+        lengths[symbols[0] == 0 ? 1 : 0] = 1;
+        return;
+    }
+    std::vector<uint64_t> weight(symbols.size());
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        weight[i] = freq[symbols[i]];
+    }
+    const size_t leaves = symbols.size();
+    std::vector<int> parent(leaves * 2 - 1);
+    std::vector<int> depth(leaves * 2 - 1);
+    for (;;) {
+        using Item = std::pair<uint64_t, int>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+        std::vector<uint64_t> nodeWeight(weight);
+        nodeWeight.resize(leaves * 2 - 1);
+        for (size_t i = 0; i < leaves; ++i) {
+            heap.push(Item(weight[i], static_cast<int>(i)));
+        }
+        int next = static_cast<int>(leaves);
+        while (heap.size() > 1) {
+            const Item a = heap.top();
+            heap.pop();
+            const Item b = heap.top();
+            heap.pop();
+            nodeWeight[static_cast<size_t>(next)] = a.first + b.first;
+            parent[static_cast<size_t>(a.second)] = next;
+            parent[static_cast<size_t>(b.second)] = next;
+            heap.push(Item(a.first + b.first, next));
+            ++next;
+        }
+        // 노드는 부모보다 먼저 만들어지므로 뒤에서부터 깊이를 채운다.
+        const int root = next - 1;
+        depth[static_cast<size_t>(root)] = 0;
+        int maxDepth = 0;
+        for (int node = root - 1; node >= 0; --node) {
+            depth[static_cast<size_t>(node)] = depth[static_cast<size_t>(parent[static_cast<size_t>(node)])] + 1;
+            maxDepth = std::max(maxDepth, depth[static_cast<size_t>(node)]);
+        }
+        if (maxDepth <= limit) {
+            for (size_t i = 0; i < leaves; ++i) {
+                lengths[symbols[i]] = static_cast<uint8_t>(depth[i]);
+            }
+            return;
+        }
+        for (uint64_t& w : weight) {
+            w = (w >> 1) | 1;
+        }
+    }
+}
+
+inline uint32_t reverseBits(uint32_t code, int n) {
+    uint32_t r = 0;
+    for (int i = 0; i < n; ++i) {
+        r = (r << 1) | (code & 1);
+        code >>= 1;
+    }
+    return r;
+}
+
+/** @brief canonical Huffman 부호(출력 순서에 맞게 비트 반전). */
+void buildCodes(const uint8_t* lengths, int n, uint32_t* codes) {
+    int count[16] = {};
+    for (int i = 0; i < n; ++i) {
+        ++count[lengths[i]];
+    }
+    count[0] = 0;
+    uint32_t nextCode[16] = {};
+    uint32_t code = 0;
+    for (int bits = 1; bits < 16; ++bits) {
+        code = (code + static_cast<uint32_t>(count[bits - 1])) << 1;
+        nextCode[bits] = code;
+    }
+    for (int i = 0; i < n; ++i) {
+        codes[i] = lengths[i] != 0 ? reverseBits(nextCode[lengths[i]]++, lengths[i]) : 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// block 출력
+// -----------------------------------------------------------------------------
+
+void emitStored(BitWriter& bw, const uint8_t* raw, size_t size, bool final) {
+    size_t offset = 0;
+    do {
+        const size_t chunk = std::min(size - offset, kMaxStoredBlock);
+        const bool last = offset + chunk == size;
+        bw.Put(final && last ? 1 : 0, 1);
+        bw.Put(0, 2);
+        bw.AlignToByte();
+        const uint8_t header[4] = {static_cast<uint8_t>(chunk), static_cast<uint8_t>(chunk >> 8),
+                                   static_cast<uint8_t>(~chunk), static_cast<uint8_t>(~chunk >> 8)};
+        bw.PutBytes(header, 4);
+        bw.PutBytes(raw + offset, chunk);
+        offset += chunk;
+    } while (offset < size);
+}
+
+uint64_t storedBits(size_t size) {
+    const uint64_t blocks = std::max<uint64_t>(1, (size + kMaxStoredBlock - 1) / kMaxStoredBlock);
+    return blocks * (3 + 7 + 32) + static_cast<uint64_t>(size) * 8;
+}
+
+struct CodeLenSymbol {
+    uint8_t symbol;
+    uint8_t extra;
+};
+
+void rleCodeLengths(const uint8_t* lengths, int n, std::vector<CodeLenSymbol>& out) {
+    int i = 0;
+    while (i < n) {
+        const uint8_t cur = lengths[i];
+        int run = 1;
+        while (i + run < n && lengths[i + run] == cur) {
+            ++run;
+        }
+        i += run;
+        if (cur == 0) {
+            while (run >= 11) {
+                const int r = std::min(run, 138);
+                out.push_back({18, static_cast<uint8_t>(r - 11)});
+                run -= r;
+            }
+            if (run >= 3) {
+                out.push_back({17, static_cast<uint8_t>(run - 3)});
+                run = 0;
+            }
+        } else {
+            out.push_back({cur, 0});
+            --run;
+            while (run >= 3) {
+                const int r = std::min(run, 6);
+                out.push_back({16, static_cast<uint8_t>(r - 3)});
+                run -= r;
+            }
+        }
+        for (; run > 0; --run) {
+            out.push_back({cur, 0});
+        }
+    }
+}
+
+/** @brief 동적 Huffman block 하나. stored가 더 작으면 `raw`를 stored block으로 쓴다. */
+void emitBlock(BitWriter& bw, const Token* tokens, size_t count, const uint8_t* raw, size_t rawSize, bool final) {
+    const CodeTables& tables = codeTables();
+    uint32_t litFreq[kLitLenSymbols] = {};
+    uint32_t distFreq[kDistSymbols] = {};
+    for (size_t t = 0; t < count; ++t) {
+        if (tokens[t].dist == 0) {
+            ++litFreq[tokens[t].litlen];
+        } else {
+            ++litFreq[257 + tables.length_code[tokens[t].litlen]];
+            ++distFreq[tables.DistCode(tokens[t].dist)];
+        }
+    }
+    litFreq[256] = 1;
+
+    uint8_t litLen[kLitLenSymbols];
+    uint8_t distLen[kDistSymbols];
+    buildLengths(litFreq, kLitLenSymbols, 15, litLen);
+    buildLengths(distFreq, kDistSymbols, 15, distLen);
+    if (std::all_of(distLen, distLen + kDistSymbols, [](uint8_t l) { return l == 0; })) {
+        distLen[0] = distLen[1] = 1;
+    }
+    int hlit = kLitLenSymbols;
+    while (hlit > 257 && litLen[hlit - 1] == 0) {
+        --hlit;
+    }
+    int hdist = kDistSymbols;
+    while (hdist > 1 && distLen[hdist - 1] == 0) {
+        --hdist;
+    }
+
+    uint8_t allLen[kLitLenSymbols + kDistSymbols];
+    std::memcpy(allLen, litLen, static_cast<size_t>(hlit));
+    std::memcpy(allLen + hlit, distLen, static_cast<size_t>(hdist));
+    std::vector<CodeLenSymbol> rle;
+    rleCodeLengths(allLen, hlit + hdist, rle);
+    uint32_t clFreq[kCodeLenSymbols] = {};
+    for (const CodeLenSymbol& s : rle) {
+        ++clFreq[s.symbol];
+    }
+    uint8_t clLen[kCodeLenSymbols];
+    buildLengths(clFreq, kCodeLenSymbols, 7, clLen);
+    int hclen = kCodeLenSymbols;
+    while (hclen > 4 && clLen[kCodeLenOrder[hclen - 1]] == 0) {
+        --hclen;
+    }
+
+    // [1] 부호화 비용 비교
+    static const uint8_t kRleExtra[3] = {2, 3, 7};
+    uint64_t bits = 3 + 5 + 5 + 4 + 3 * static_cast<uint64_t>(hclen);
+    for (const CodeLenSymbol& s : rle) {
+        bits += clLen[s.symbol] + (s.symbol >= 16 ? kRleExtra[s.symbol - 16] : 0);
+    }
+    for (int s = 0; s < kLitLenSymbols; ++s) {
+        bits += static_cast<uint64_t>(litFreq[s]) * (litLen[s] + (s >= 257 ? kLengthExtra[s - 257] : 0));
+    }
+    for (int s = 0; s < kDistSymbols; ++s) {
+        bits += static_cast<uint64_t>(distFreq[s]) * (distLen[s] + kDistExtra[s]);
+    }
+    if (storedBits(rawSize) <= bits) {
+        emitStored(bw, raw, rawSize, final);
+        return;
+    }
+
+    // [2] 헤더 + 부호
+    uint32_t litCode[kLitLenSymbols];
+    uint32_t distCode[kDistSymbols];
+    uint32_t clCode[kCodeLenSymbols];
+    buildCodes(litLen, kLitLenSymbols, litCode);
+    buildCodes(distLen, kDistSymbols, distCode);
+    buildCodes(clLen, kCodeLenSymbols, clCode);
+    bw.Put(final ? 1 : 0, 1);
+    bw.Put(2, 2);
+    bw.Put(static_cast<uint32_t>(hlit - 257), 5);
+    bw.Put(static_cast<uint32_t>(hdist - 1), 5);
+    bw.Put(static_cast<uint32_t>(hclen - 4), 4);
+    for (int i = 0; i < hclen; ++i) {
+        bw.Put(clLen[kCodeLenOrder[i]], 3);
+    }
+    for (const CodeLenSymbol& s : rle) {
+        bw.Put(clCode[s.symbol], clLen[s.symbol]);
+        if (s.symbol >= 16) {
+            bw.Put(s.extra, kRleExtra[s.symbol - 16]);
+        }
+    }
+    for (size_t t = 0; t < count; ++t) {
+        const Token& token = tokens[t];
+        if (token.dist == 0) {
+            bw.Put(litCode[token.litlen], litLen[token.litlen]);
+            continue;
+        }
+        const int lc = tables.length_code[token.litlen];
+        const int ls = 257 + lc;
+        bw.Put(litCode[ls] | (static_cast<uint32_t>(token.litlen - kLengthBase[lc]) << litLen[ls]),
+               litLen[ls] + kLengthExtra[lc]);
+        const int dc = tables.DistCode(token.dist);
+        bw.Put(distCode[dc] | (static_cast<uint32_t>(token.dist - kDistBase[dc]) << distLen[dc]),
+               distLen[dc] + kDistExtra[dc]);
+    }
+    bw.Put(litCode[256], litLen[256]);
+}
+
+// -----------------------------------------------------------------------------
+// LZ77
+// -----------------------------------------------------------------------------
+
+inline uint32_t load32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline int countTrailingZeros(uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+/** @brief `a`, `b`에서 시작하는 공통 길이(`limit` 이하). */
+inline int matchLength(const uint8_t* a, const uint8_t* b, int limit) {
+    int len = 0;
+    while (len + 8 <= limit) {
+        uint64_t x;
+        uint64_t y;
+        std::memcpy(&x, a + len, 8);
+        std::memcpy(&y, b + len, 8);
+        if (x != y) {
+            return len + (countTrailingZeros(x ^ y) >> 3);
+        }
+        len += 8;
+    }
+    while (len < limit && a[len] == b[len]) {
+        ++len;
+    }
+    return len;
+}
+
+inline uint32_t hash4(const uint8_t* p) {
+    return (load32(p) * 2654435761u) >> (32 - kHashBits);
+}
+
+inline uint32_t hash3(const uint8_t* p) {
+    const uint32_t v = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                       (static_cast<uint32_t>(p[2]) << 16);
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+/** @brief 토큰을 모아 `kBlockTokens`마다 block으로 내보낸다. */
+class BlockSink {
+public:
+    BlockSink(BitWriter& bw, const uint8_t* data) : m_bw(bw), m_data(data) { m_tokens.reserve(kBlockTokens); }
+
+    void Literal(size_t pos) {
+        m_tokens.push_back({m_data[pos], 0});
+        Check(pos + 1);
+    }
+
+    void Match(size_t pos, int len, int dist) {
+        m_tokens.push_back({static_cast<uint16_t>(len), static_cast<uint16_t>(dist)});
+        Check(pos + static_cast<size_t>(len));
+    }
+
+    void Finish(size_t end, bool final) {
+        if (!m_tokens.empty() || final) {
+            emitBlock(m_bw, m_tokens.data(), m_tokens.size(), m_data + m_rawStart, end - m_rawStart, final);
+        }
+        m_tokens.clear();
+    }
+
+private:
+    void Check(size_t end) {
+        if (m_tokens.size() >= kBlockTokens) {
+            emitBlock(m_bw, m_tokens.data(), m_tokens.size(), m_data + m_rawStart, end - m_rawStart, false);
+            m_tokens.clear();
+            m_rawStart = end;
+        }
+    }
+
+    BitWriter& m_bw;
+    const uint8_t* m_data;
+    std::vector<Token> m_tokens;
+    size_t m_rawStart = 0;
+};
+
+void compressFast(const uint8_t* data, size_t size, BlockSink& sink) {
+    std::vector<int32_t> head(static_cast<size_t>(1) << kHashBits, -1);
+    size_t i = 0;
+    while (i < size) {
+        if (i + 4 <= size) {
+            const uint32_t h = hash4(data + i);
+            const int32_t cand = head[h];
+            head[h] = static_cast<int32_t>(i);
+            if (cand >= 0 && i - static_cast<size_t>(cand) <= kWindowSize &&
+                load32(data + cand) == load32(data + i)) {
+                const int limit = static_cast<int>(std::min<size_t>(kMaxMatch, size - i));
+                const int len = 4 + matchLength(data + cand + 4, data + i + 4, limit - 4);
+                sink.Match(i, len, static_cast<int>(i - static_cast<size_t>(cand)));
+                // 긴 일치 안쪽은 끝부분만 등록해 속도를 유지한다.
+                const size_t end = i + static_cast<size_t>(len);
+                for (size_t j = len <= 32 ? i + 1 : end - 3; j < end && j + 4 <= size; ++j) {
+                    head[hash4(data + j)] = static_cast<int32_t>(j);
+                }
+                i = end;
+                continue;
+            }
+        }
+        sink.Literal(i);
+        ++i;
+    }
+}
+
+class ChainMatcher {
+public:
+    ChainMatcher(const uint8_t* data, size_t size)
+        : m_data(data), m_size(size), m_head(static_cast<size_t>(1) << kHashBits, -1), m_prev(kWindowSize, -1) {}
+
+    /** @brief `pos`까지(포함) 아직 등록하지 않은 위치를 hash chain에 등록한다. */
+    void InsertUpTo(size_t pos) {
+        for (; m_inserted <= pos && m_inserted + kMinMatch <= m_size; ++m_inserted) {
+            const uint32_t h = hash3(m_data + m_inserted);
+            m_prev[m_inserted & (kWindowSize - 1)] = m_head[h];
+            m_head[h] = static_cast<int32_t>(m_inserted);
+        }
+    }
+
+    /** @brief `pos`에서 `minLen`보다 긴 일치를 찾는다. 없으면 길이 0. */
+    std::pair<int, int> Find(size_t pos, int minLen) const {
+        if (pos + kMinMatch > m_size) {
+            return std::make_pair(0, 0);
+        }
+        const int limit = static_cast<int>(std::min<size_t>(kMaxMatch, m_size - pos));
+        int best = std::max(minLen, kMinMatch - 1);
+        int bestDist = 0;
+        int chain = minLen >= kBestGoodLength ? kBestMaxChain / 4 : kBestMaxChain;
+        int32_t cand = m_prev[pos & (kWindowSize - 1)];
+        if (best >= limit) {
+            return std::make_pair(0, 0);
+        }
+        while (cand >= 0 && pos - static_cast<size_t>(cand) <= kWindowSize && chain-- > 0) {
+            const uint8_t* c = m_data + cand;
+            const uint8_t* p = m_data + pos;
+            if (c[best] == p[best] && c[0] == p[0] && c[1] == p[1]) {
+                const int len = matchLength(c, p, limit);
+                if (len > best) {
+                    best = len;
+                    bestDist = static_cast<int>(pos - static_cast<size_t>(cand));
+                    if (len >= kBestNiceLength || len >= limit) {
+                        break;
+                    }
+                }
+            }
+            const int32_t next = m_prev[static_cast<size_t>(cand) & (kWindowSize - 1)];
+            if (next >= cand) {
+                break;
+            }
+            cand = next;
+        }
+        return bestDist != 0 ? std::make_pair(best, bestDist) : std::make_pair(0, 0);
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    std::vector<int32_t> m_head;
+    std::vector<int32_t> m_prev;
+    size_t m_inserted = 0;
+};
+
+void compressBest(const uint8_t* data, size_t size, BlockSink& sink) {
+    ChainMatcher matcher(data, size);
+    size_t i = 0;
+    matcher.InsertUpTo(0);
+    // Find()는 pos 자신을 제외한 이전 후보를 본다(pos는 이미 등록되어 chain 맨 앞에 있음).
+    std::pair<int, int> match = matcher.Find(0, 0);
+    while (i < size) {
+        if (match.first >= kMinMatch) {
+            if (match.first < kBestNiceLength && i + 1 < size) {
+                matcher.InsertUpTo(i + 1);
+                const std::pair<int, int> next = matcher.Find(i + 1, match.first);
+                if (next.first > match.first) {
+                    sink.Literal(i);
+                    ++i;
+                    match = next;
+                    continue;
+                }
+            }
+            sink.Match(i, match.first, match.second);
+            i += static_cast<size_t>(match.first);
+        } else {
+            sink.Literal(i);
+            ++i;
+        }
+        if (i < size) {
+            matcher.InsertUpTo(i);
+            match = matcher.Find(i, 0);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// inflate
+// -----------------------------------------------------------------------------
+
+/** @brief 입력 끝을 넘으면 0을 채워 읽고, 채운 비트를 실제로 소비했는지는 `Overrun()`으로 확인한다. */
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : m_p(data), m_end(data + size) {}
+
+    /** @brief 비트 버퍼를 57비트 이상으로 채운다. */
+    void Refill() {
+        while (m_bits <= 56) {
+            uint64_t b = 0;
+            if (m_p < m_end) {
+                b = *m_p++;
+            } else {
+                ++m_pad;
+            }
+            m_acc |= b << m_bits;
+            m_bits += 8;
+        }
+    }
+
+    uint32_t Peek(int n) const { return static_cast<uint32_t>(m_acc & ((1ull << n) - 1)); }
+
+    void Drop(int n) {
+        m_acc >>= n;
+        m_bits -= n;
+    }
+
+    uint32_t Take(int n) {
+        const uint32_t v = Peek(n);
+        Drop(n);
+        return v;
+    }
+
+    bool Overrun() const { return static_cast<size_t>(m_bits) < m_pad * 8; }
+
+    /** @brief byte 경계로 맞춘 뒤 남은 비트 버퍼를 입력 위치로 되돌린다(stored block용). */
+    bool AlignAndRewind() {
+        Drop(m_bits & 7);
+        const size_t buffered = static_cast<size_t>(m_bits / 8);
+        if (buffered < m_pad) {
+            return false;
+        }
+        m_p -= buffered - m_pad;
+        m_acc = 0;
+        m_bits = 0;
+        m_pad = 0;
+        return true;
+    }
+
+    const uint8_t* Position() const { return m_p; }
+    size_t Remaining() const { return static_cast<size_t>(m_end - m_p); }
+    void Skip(size_t n) { m_p += n; }
+
+private:
+    const uint8_t* m_p;
+    const uint8_t* m_end;
+    uint64_t m_acc = 0;
+    int m_bits = 0;
+    size_t m_pad = 0;
+};
+
+/** @brief 최대 부호 길이 전체를 한 번에 찾는 decode 표. 항목은 `(symbol << 4) | length`, 0이면 잘못된 부호. */
+class HuffmanTable {
+public:
+    bool Build(const uint8_t* lengths, int n) {
+        m_bits = 0;
+        int count[16] = {};
+        for (int i = 0; i < n; ++i) {
+            ++count[lengths[i]];
+            m_bits = std::max<int>(m_bits, lengths[i]);
+        }
+        count[0] = 0;
+        // 과잉 부호(over-subscribed)는 거부한다. 부족한 부호는 표에 빈 칸으로 남는다.
+        int left = 1;
+        for (int len = 1; len < 16; ++len) {
+            left = (left << 1) - count[len];
+            if (left < 0) {
+                return false;
+            }
+        }
+        if (m_bits == 0) {
+            m_bits = 1;
+        }
+        m_table.assign(static_cast<size_t>(1) << m_bits, 0);
+        uint32_t codes[kLitLenSymbols + 2];
+        buildCodes(lengths, n, codes);
+        for (int s = 0; s < n; ++s) {
+            const int len = lengths[s];
+            if (len == 0) {
+                continue;
+            }
+            const uint16_t entry = static_cast<uint16_t>((s << 4) | len);
+            for (size_t i = codes[s]; i < m_table.size(); i += static_cast<size_t>(1) << len) {
+                m_table[i] = entry;
+            }
+        }
+        return true;
+    }
+
+    /** @brief 잘못된 부호면 -1. 호출 전 `Refill()`이 필요하다. */
+    int Decode(BitReader& br) const {
+        const uint16_t entry = m_table[br.Peek(m_bits)];
+        if (entry == 0) {
+            return -1;
+        }
+        br.Drop(entry & 15);
+        return entry >> 4;
+    }
+
+private:
+    std::vector<uint16_t> m_table;
+    int m_bits = 0;
+};
+
+struct FixedTables {
+    HuffmanTable lit;
+    HuffmanTable dist;
+
+    FixedTables() {
+        uint8_t lengths[288];
+        std::fill(lengths, lengths + 144, 8);
+        std::fill(lengths + 144, lengths + 256, 9);
+        std::fill(lengths + 256, lengths + 280, 7);
+        std::fill(lengths + 280, lengths + 288, 8);
+        lit.Build(lengths, 288);
+        std::fill(lengths, lengths + 30, 5);
+        dist.Build(lengths, 30);
+    }
+};
+
+const FixedTables& fixedTables() {
+    static const FixedTables tables;
+    return tables;
+}
+
+bool readDynamicTables(BitReader& br, HuffmanTable& lit, HuffmanTable& dist) {
+    br.Refill();
+    const int hlit = static_cast<int>(br.Take(5)) + 257;
+    const int hdist = static_cast<int>(br.Take(5)) + 1;
+    const int hclen = static_cast<int>(br.Take(4)) + 4;
+    if (hlit > kLitLenSymbols || hdist > kDistSymbols) {
+        return false;
+    }
+    uint8_t clLen[kCodeLenSymbols] = {};
+    br.Refill();
+    for (int i = 0; i < hclen; ++i) {
+        clLen[kCodeLenOrder[i]] = static_cast<uint8_t>(br.Take(3));
+    }
+    HuffmanTable clTable;
+    if (!clTable.Build(clLen, kCodeLenSymbols)) {
+        return false;
+    }
+    uint8_t lengths[kLitLenSymbols + kDistSymbols] = {};
+    int i = 0;
+    while (i < hlit + hdist) {
+        br.Refill();
+        const int sym = clTable.Decode(br);
+        if (sym < 0) {
+            return false;
+        }
+        if (sym < 16) {
+            lengths[i++] = static_cast<uint8_t>(sym);
+            continue;
+        }
+        int repeat = 0;
+        uint8_t value = 0;
+        if (sym == 16) {
+            if (i == 0) {
+                return false;
+            }
+            value = lengths[i - 1];
+            repeat = 3 + static_cast<int>(br.Take(2));
+        } else if (sym == 17) {
+            repeat = 3 + static_cast<int>(br.Take(3));
+        } else {
+            repeat = 11 + static_cast<int>(br.Take(7));
+        }
+        if (i + repeat > hlit + hdist) {
+            return false;
+        }
+        std::fill(lengths + i, lengths + i + repeat, value);
+        i += repeat;
+    }
+    if (lengths[256] == 0) {
+        return false;
+    }
+    return lit.Build(lengths, hlit) && dist.Build(lengths + hlit, hdist) && !br.Overrun();
+}
+
+bool inflateBlock(BitReader& br, const HuffmanTable& lit, const HuffmanTable& dist, uint8_t* out, size_t outSize,
+                  size_t& pos) {
+    for (;;) {
+        br.Refill();
+        const int sym = lit.Decode(br);
+        if (sym < 0) {
+            return false;
+        }
+        if (sym < 256) {
+            if (pos >= outSize) {
+                return false;
+            }
+            out[pos++] = static_cast<uint8_t>(sym);
+            continue;
+        }
+        if (sym == 256) {
+            return !br.Overrun();
+        }
+        const int lc = sym - 257;
+        if (lc >= 29) {
+            return false;
+        }
+        const size_t len = kLengthBase[lc] + br.Take(kLengthExtra[lc]);
+        const int dc = dist.Decode(br);
+        if (dc < 0 || dc >= 30) {
+            return false;
+        }
+        const size_t d = kDistBase[dc] + br.Take(kDistExtra[dc]);
+        if (d > pos || len > outSize - pos) {
+            return false;
+        }
+        uint8_t* dst = out + pos;
+        const uint8_t* src = dst - d;
+        if (d >= len) {
+            std::memcpy(dst, src, len);
+        } else {
+            for (size_t k = 0; k < len; ++k) {
+                dst[k] = src[k];
+            }
+        }
+        pos += len;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// 체크섬
+// -----------------------------------------------------------------------------
+
+struct CrcTables {
+    uint32_t table[8][256];
+
+    CrcTables() {
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[0][n] = c;
+        }
+        for (uint32_t n = 0; n < 256; ++n) {
+            for (int t = 1; t < 8; ++t) {
+                table[t][n] = (table[t - 1][n] >> 8) ^ table[0][table[t - 1][n] & 0xFF];
+            }
+        }
+    }
+};
+
+const CrcTables& crcTables() {
+    static const CrcTables tables;
+    return tables;
+}
+
+constexpr uint32_t kAdlerBase = 65521;
+// 32비트 누적이 넘치지 않는 최대 구간(zlib NMAX).
+constexpr size_t kAdlerMax = 5552;
+
+}  // namespace
+
+void GvDeflateRaw(const uint8_t* data, size_t size, GvDeflateLevel::Enum level, bool final,
+                  std::vector<uint8_t>& out) {
+    BitWriter bw(out);
+    if (level == GvDeflateLevel::Store || size == 0) {
+        if (size > 0 || final) {
+            emitStored(bw, data, size, final);
+        }
+    } else {
+        BlockSink sink(bw, data);
+        if (level == GvDeflateLevel::Best) {
+            compressBest(data, size, sink);
+        } else {
+            compressFast(data, size, sink);
+        }
+        sink.Finish(size, final);
+    }
+    if (!final) {
+        // sync flush: 빈 stored block으로 byte 경계를 맞춘다.
+        bw.Put(0, 3);
+        bw.AlignToByte();
+        const uint8_t marker[4] = {0x00, 0x00, 0xFF, 0xFF};
+        bw.PutBytes(marker, 4);
+    }
+    bw.AlignToByte();
+}
+
+bool GvInflateRaw(const uint8_t* data, size_t size, uint8_t* out, size_t outSize, size_t& produced) {
+    BitReader br(data, size);
+    size_t pos = 0;
+    HuffmanTable lit;
+    HuffmanTable dist;
+    for (;;) {
+        br.Refill();
+        const bool last = br.Take(1) != 0;
+        const uint32_t type = br.Take(2);
+        bool ok = false;
+        if (type == 0) {
+            if (br.AlignAndRewind() && br.Remaining() >= 4) {
+                const uint8_t* p = br.Position();
+                const size_t len = static_cast<size_t>(p[0]) | (static_cast<size_t>(p[1]) << 8);
+                const size_t nlen = static_cast<size_t>(p[2]) | (static_cast<size_t>(p[3]) << 8);
+                br.Skip(4);
+                ok = (len ^ 0xFFFF) == nlen && len <= br.Remaining() && len <= outSize - pos;
+                if (ok) {
+                    std::memcpy(out + pos, br.Position(), len);
+                    br.Skip(len);
+                    pos += len;
+                }
+            }
+        } else if (type == 1) {
+            ok = inflateBlock(br, fixedTables().lit, fixedTables().dist, out, outSize, pos);
+        } else if (type == 2) {
+            ok = readDynamicTables(br, lit, dist) && inflateBlock(br, lit, dist, out, outSize, pos);
+        }
+        if (!ok || br.Overrun()) {
+            return false;
+        }
+        if (last) {
+            produced = pos;
+            return true;
+        }
+    }
+}
+
+uint32_t GvAdler32(uint32_t adler, const uint8_t* data, size_t size) {
+    uint32_t s1 = adler & 0xFFFF;
+    uint32_t s2 = adler >> 16;
+    while (size > 0) {
+        const size_t n = std::min(size, kAdlerMax);
+        for (size_t i = 0; i < n; ++i) {
+            s1 += data[i];
+            s2 += s1;
+        }
+        s1 %= kAdlerBase;
+        s2 %= kAdlerBase;
+        data += n;
+        size -= n;
+    }
+    return s1 | (s2 << 16);
+}
+
+uint32_t GvAdler32Combine(uint32_t adler1, uint32_t adler2, uint64_t size2) {
+    const uint32_t rem = static_cast<uint32_t>(size2 % kAdlerBase);
+    uint32_t sum1 = adler1 & 0xFFFF;
+    uint32_t sum2 = static_cast<uint32_t>((static_cast<uint64_t>(rem) * sum1) % kAdlerBase);
+    sum1 += (adler2 & 0xFFFF) + kAdlerBase - 1;
+    sum2 += (adler1 >> 16) + (adler2 >> 16) + kAdlerBase - rem;
+    if (sum1 >= kAdlerBase) {
+        sum1 -= kAdlerBase;
+    }
+    if (sum1 >= kAdlerBase) {
+        sum1 -= kAdlerBase;
+    }
+    if (sum2 >= (kAdlerBase << 1)) {
+        sum2 -= (kAdlerBase << 1);
+    }
+    if (sum2 >= kAdlerBase) {
+        sum2 -= kAdlerBase;
+    }
+    return sum1 | (sum2 << 16);
+}
+
+uint32_t GvCrc32(uint32_t crc, const uint8_t* data, size_t size) {
+    const CrcTables& t = crcTables();
+    uint32_t c = ~crc;
+    while (size >= 8) {
+        const uint32_t lo = load32(data) ^ c;
+        const uint32_t hi = load32(data + 4);
+        c = t.table[7][lo & 0xFF] ^ t.table[6][(lo >> 8) & 0xFF] ^ t.table[5][(lo >> 16) & 0xFF] ^
+            t.table[4][lo >> 24] ^ t.table[3][hi & 0xFF] ^ t.table[2][(hi >> 8) & 0xFF] ^
+            t.table[1][(hi >> 16) & 0xFF] ^ t.table[0][hi >> 24];
+        data += 8;
+        size -= 8;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        c = t.table[0][(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    }
+    return ~c;
+}
+
+}  // namespace detail
+}  // namespace gv
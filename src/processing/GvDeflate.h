@@ -0,0 +1,46 @@
+#pragma once
+
+// Processing 라이브러리 내부용 deflate/inflate(RFC 1951)/zlib 체크섬 유틸리티. 공개 헤더가 아니다.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gv {
+namespace detail {
+
+struct GvDeflateLevel {
+    enum Enum {
+        /** @brief stored block만 사용. */
+        Store = 0,
+        /** @brief 단일 후보 hash LZ77(greedy) + 동적 Huffman. */
+        Fast = 1,
+        /** @brief hash chain LZ77(lazy matching) + 동적 Huffman. */
+        Best = 2,
+    };
+};
+
+/**
+ * @brief raw deflate 스트림을 `out` 뒤에 덧붙인다.
+ * @param final true면 마지막 block에 BFINAL을 설정한다. false면 sync flush(빈 stored block)로 끝나
+ *              byte 경계에서 끝나므로, 독립적으로 압축한 스트림을 이어 붙여 하나의 스트림으로 만들 수 있다.
+ */
+void GvDeflateRaw(const uint8_t* data, size_t size, GvDeflateLevel::Enum level, bool final,
+                  std::vector<uint8_t>& out);
+
+/**
+ * @brief raw deflate 스트림을 `out[0, outSize)`에 푼다.
+ * @param produced 성공 시 출력 bytes.
+ * @return 스트림이 손상되었거나 출력이 `outSize`를 넘으면 false.
+ */
+bool GvInflateRaw(const uint8_t* data, size_t size, uint8_t* out, size_t outSize, size_t& produced);
+
+/** @brief zlib `adler32()`와 같은 의미(초기값 1). */
+uint32_t GvAdler32(uint32_t adler, const uint8_t* data, size_t size);
+/** @brief `adler32(A||B)`를 `adler32(A)`, `adler32(B)`, `len(B)`로 계산한다. */
+uint32_t GvAdler32Combine(uint32_t adler1, uint32_t adler2, uint64_t size2);
+/** @brief zlib `crc32()`와 같은 의미(초기값 0, 이어서 계산 가능). */
+uint32_t GvCrc32(uint32_t crc, const uint8_t* data, size_t size);
+
+}  // namespace detail
+}  // namespace gv
@@ -0,0 +1,423 @@
+#include "GvDeviceDiscovery.h"
+
+#include "GvTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace gv {
+
+namespace {
+
+// 장치 식별: serial number, 없으면 port.
+std::string deviceKey(const GvDeviceInfo& info) {
+    const std::string sn(info.sn, strnlen(info.sn, sizeof(info.sn)));
+    return sn.empty() ? "port:" + std::string(info.port, strnlen(info.port, sizeof(info.port))) : sn;
+}
+
+bool sameField(const char* a, const char* b, size_t capacity) {
+    return std::strncmp(a, b, capacity) == 0;
+}
+
+bool sameDevice(const GvDeviceInfo& a, const GvDeviceInfo& b) {
+    return sameField(a.name, b.name, sizeof(a.name)) && sameField(a.port, b.port, sizeof(a.port)) &&
+           sameField(a.firmware_version, b.firmware_version, sizeof(a.firmware_version)) && a.type == b.type &&
+           a.cameraid == b.cameraid;
+}
+
+std::chrono::steady_clock::time_point deadlineFrom(int timeout_ms) {
+    return std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+}
+
+}  // namespace
+
+const char* GvDeviceEventType::ToString(GvDeviceEventType::Enum e) {
+    switch (e) {
+        case Arrived: return "Arrived";
+        case Removed: return "Removed";
+        case Changed: return "Changed";
+    }
+    return "Unknown";
+}
+
+GvDeviceDiscovery::~GvDeviceDiscovery() {
+    Stop();
+}
+
+int GvDeviceDiscovery::AddSource(const char* name, GvDeviceDiscoverySource source) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running || !source) {
+        detail::GvSetLastHelperError(m_running ? "GvDeviceDiscovery::AddSource: discovery is running"
+                                               : "GvDeviceDiscovery::AddSource: invalid source");
+        return -1;
+    }
+    Source s;
+    s.name = name != nullptr ? name : "";
+    s.scan = std::move(source);
+    m_sources.push_back(std::move(s));
+    return static_cast<int>(m_sources.size()) - 1;
+}
+
+bool GvDeviceDiscovery::Start(const GvDeviceDiscoveryOptions& options) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running || m_sources.empty() || options.poll_interval_ms < 0 || options.missing_scans_before_removal < 1) {
+        detail::GvSetLastHelperError(m_running ? "GvDeviceDiscovery::Start: already running"
+                                               : "GvDeviceDiscovery::Start: no source or invalid options");
+        return false;
+    }
+    m_options = options;
+    m_stopping = false;
+    m_running = true;
+    for (size_t i = 0; i < m_sources.size(); ++i) {
+        m_threads.emplace_back(&GvDeviceDiscovery::SourceLoop, this, i);
+    }
+    return true;
+}
+
+void GvDeviceDiscovery::Stop() {
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_stopping = true;
+        threads.swap(m_threads);
+    }
+    m_wakeCv.notify_all();
+    m_tableCv.notify_all();
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+    m_stopping = false;
+    // 다음 Start()의 Refresh()/WaitForFirstScan()이 이전 실행의 완료 기록을 보지 않게 한다.
+    for (Source& s : m_sources) {
+        s.scanned = false;
+        s.completed_request = m_refreshRequest;
+    }
+}
+
+bool GvDeviceDiscovery::IsRunning() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+bool GvDeviceDiscovery::Refresh(int timeout_ms) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_running) {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::Refresh: discovery is not running");
+        return false;
+    }
+    // 콜백을 실행 중인 검색 스레드는 이 요청을 처리할 수 없다.
+    if (OnSourceThread()) {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::Refresh: called from a device event callback");
+        return false;
+    }
+    const uint64_t request = ++m_refreshRequest;
+    m_wakeCv.notify_all();
+    const auto done = [&] {
+        return m_stopping || m_pauseCount > 0 ||
+               std::all_of(m_sources.begin(), m_sources.end(),
+                           [&](const Source& s) { return s.completed_request >= request; });
+    };
+    bool ok = true;
+    if (timeout_ms > 0) {
+        ok = m_tableCv.wait_until(lock, deadlineFrom(timeout_ms), done);
+    } else {
+        m_tableCv.wait(lock, done);
+    }
+    if (m_pauseCount > 0) {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::Refresh: scans are paused");
+        return false;
+    }
+    if (!ok || m_stopping) {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::Refresh: timed out");
+        return false;
+    }
+    return true;
+}
+
+std::vector<GvDiscoveredDevice> GvDeviceDiscovery::GetDevices() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<GvDiscoveredDevice> devices;
+    devices.reserve(m_devices.size());
+    for (const Entry& e : m_devices) {
+        devices.push_back(e.device);
+    }
+    return devices;
+}
+
+bool GvDeviceDiscovery::FindDevice(const char* sn, GvDiscoveredDevice& device) const {
+    if (sn == nullptr || sn[0] == '\0') {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::FindDevice: invalid serial number");
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const Entry& e : m_devices) {
+        if (sameField(e.device.info.sn, sn, sizeof(e.device.info.sn))) {
+            device = e.device;
+            return true;
+        }
+    }
+    detail::GvSetLastHelperError(std::string("GvDeviceDiscovery::FindDevice: device not found: ") + sn);
+    return false;
+}
+
+bool GvDeviceDiscovery::WaitForDevice(const char* sn, GvDiscoveredDevice& device, int timeout_ms) const {
+    if (sn == nullptr || sn[0] == '\0') {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::WaitForDevice: invalid serial number");
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const Entry* found = nullptr;
+    const auto ready = [&] {
+        for (const Entry& e : m_devices) {
+            if (sameField(e.device.info.sn, sn, sizeof(e.device.info.sn))) {
+                found = &e;
+                return true;
+            }
+        }
+        return !m_running || m_stopping;
+    };
+    // 콜백 안에서는 표에 이미 있는 장치만 돌려준다(기다리면 검색 스레드가 멈춘다).
+    if (OnSourceThread()) {
+        ready();
+        if (found == nullptr) {
+            detail::GvSetLastHelperError(std::string("GvDeviceDiscovery::WaitForDevice: device not found: ") + sn +
+                                         " (called from a device event callback)");
+            return false;
+        }
+    } else if (timeout_ms > 0) {
+        m_tableCv.wait_until(lock, deadlineFrom(timeout_ms), ready);
+    } else {
+        m_tableCv.wait(lock, ready);
+    }
+    if (found == nullptr) {
+        detail::GvSetLastHelperError(std::string("GvDeviceDiscovery::WaitForDevice: device not found: ") + sn +
+                                     (m_running && !m_stopping ? " (timed out)" : " (discovery is not running)"));
+        return false;
+    }
+    device = found->device;
+    return true;
+}
+
+bool GvDeviceDiscovery::WaitForFirstScan(int timeout_ms) const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (OnSourceThread()) {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::WaitForFirstScan: called from a device event callback");
+        return false;
+    }
+    const auto done = [&] {
+        return !m_running || m_stopping ||
+               std::all_of(m_sources.begin(), m_sources.end(), [](const Source& s) { return s.scanned; });
+    };
+    bool ok = true;
+    if (timeout_ms > 0) {
+        ok = m_tableCv.wait_until(lock, deadlineFrom(timeout_ms), done);
+    } else {
+        m_tableCv.wait(lock, done);
+    }
+    if (!ok || !m_running || m_stopping) {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::WaitForFirstScan: timed out or not running");
+        return false;
+    }
+    return true;
+}
+
+bool GvDeviceDiscovery::PauseScans() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // 콜백 잠금을 쥔 검색 스레드가 진행 중인 다른 검색의 전달을 막으므로 기다릴 수 없다.
+    if (OnSourceThread()) {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::PauseScans: called from a device event callback");
+        return false;
+    }
+    ++m_pauseCount;
+    // 멈춘 동안 끝나지 않을 Refresh() 대기를 깨운다.
+    m_tableCv.notify_all();
+    m_tableCv.wait(lock, [&] { return m_scanning == 0; });
+    return true;
+}
+
+void GvDeviceDiscovery::ResumeScans() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pauseCount > 0) {
+            --m_pauseCount;
+        }
+    }
+    m_wakeCv.notify_all();
+}
+
+uint64_t GvDeviceDiscovery::AddCallback(GvDeviceEventCallback callback, bool notify_existing) {
+    if (!callback) {
+        detail::GvSetLastHelperError("GvDeviceDiscovery::AddCallback: invalid callback");
+        return 0;
+    }
+    // 콜백 잠금을 먼저 잡아 기존 장치 전달과 검색 스레드의 이벤트가 섞이지 않게 한다.
+    std::lock_guard<std::mutex> callbackLock(m_callbackMutex);
+    if (notify_existing) {
+        for (const GvDiscoveredDevice& device : GetDevices()) {
+            callback(GvDeviceEventType::Arrived, device);
+        }
+    }
+    const uint64_t id = m_nextCallbackId++;
+    m_callbacks.emplace_back(id, std::move(callback));
+    return id;
+}
+
+void GvDeviceDiscovery::RemoveCallback(uint64_t id) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    const auto matches = [id](const std::pair<uint64_t, GvDeviceEventCallback>& c) { return c.first == id; };
+    m_callbacks.erase(std::remove_if(m_callbacks.begin(), m_callbacks.end(), matches), m_callbacks.end());
+}
+
+GvDeviceDiscoveryStats GvDeviceDiscovery::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+bool GvDeviceDiscovery::OnSourceThread() const {
+    const std::thread::id self = std::this_thread::get_id();
+    return std::any_of(m_threads.begin(), m_threads.end(), [self](const std::thread& t) { return t.get_id() == self; });
+}
+
+void GvDeviceDiscovery::SourceLoop(size_t sourceIndex) {
+    std::vector<GvDeviceInfo> found;
+    std::vector<Event> events;
+    GvDeviceDiscoverySource scan;
+    uint64_t request = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        scan = m_sources[sourceIndex].scan;
+        request = m_refreshRequest;
+    }
+    for (;;) {
+        // [1] 멈춤이 풀리면 잠금 없이 검색(소스끼리 병렬)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCv.wait(lock, [&] { return m_stopping || m_pauseCount == 0; });
+            if (m_stopping) {
+                return;
+            }
+            ++m_scanning;
+        }
+        found.clear();
+        const uint64_t start = GvNowNs();
+        bool ok = false;
+        {
+            GvTraceScope trace("GvDeviceDiscovery::Scan", "device", 0, sourceIndex);
+            ok = scan(found);
+        }
+        const uint64_t elapsed = GvNowNs() - start;
+        {
+            // 검색 함수가 끝났음을 콜백 잠금보다 먼저 알린다(PauseScans()가 이벤트 전달을 기다리지 않게).
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_scanning;
+        }
+        m_tableCv.notify_all();
+
+        // [2] 장치 표 갱신 후 이벤트 전달. 콜백 잠금을 먼저 잡아 AddCallback()의 기존 장치 전달과 순서를 맞춘다.
+        events.clear();
+        std::unique_lock<std::mutex> callbackLock(m_callbackMutex);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.scans;
+            m_sources[sourceIndex].last_scan_ns = elapsed;
+            m_stats.last_scan_ns = 0;
+            for (const Source& s : m_sources) {
+                m_stats.last_scan_ns = std::max(m_stats.last_scan_ns, s.last_scan_ns);
+            }
+            m_stats.max_scan_ns = std::max(m_stats.max_scan_ns, elapsed);
+            if (ok) {
+                Merge(sourceIndex, found, events);
+            } else {
+                ++m_stats.failed_scans;
+            }
+            Source& source = m_sources[sourceIndex];
+            source.scanned = source.scanned || ok;
+            source.completed_request = std::max(source.completed_request, request);
+        }
+        m_tableCv.notify_all();
+        Dispatch(events);
+        callbackLock.unlock();
+
+        // [3] 다음 주기 또는 Refresh()/Stop()까지 대기
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeCv.wait_for(lock, std::chrono::milliseconds(m_options.poll_interval_ms),
+                          [&] { return m_stopping || m_refreshRequest != request; });
+        if (m_stopping) {
+            return;
+        }
+        request = m_refreshRequest;
+    }
+}
+
+void GvDeviceDiscovery::Merge(size_t sourceIndex, const std::vector<GvDeviceInfo>& found, std::vector<Event>& events) {
+    const int source = static_cast<int>(sourceIndex);
+    const uint64_t now = GvNowNs();
+    std::vector<bool> seen(m_devices.size(), false);
+    for (size_t i = 0; i < found.size(); ++i) {
+        const GvDeviceInfo& info = found[i];
+        const std::string key = deviceKey(info);
+        size_t match = m_devices.size();
+        for (size_t d = 0; d < m_devices.size(); ++d) {
+            if (m_devices[d].device.source == source && deviceKey(m_devices[d].device.info) == key) {
+                match = d;
+                break;
+            }
+        }
+        if (match == m_devices.size()) {
+            Entry entry;
+            entry.device.info = info;
+            entry.device.source = source;
+            entry.device.device_index = static_cast<int>(i);
+            entry.device.first_seen_ns = entry.device.last_seen_ns = now;
+            m_devices.push_back(entry);
+            seen.push_back(true);
+            ++m_stats.arrivals;
+            events.push_back(Event{GvDeviceEventType::Arrived, entry.device});
+            continue;
+        }
+        Entry& entry = m_devices[match];
+        seen[match] = true;
+        entry.missing = 0;
+        entry.device.last_seen_ns = now;
+        const bool changed = !sameDevice(entry.device.info, info) || entry.device.device_index != static_cast<int>(i);
+        entry.device.info = info;
+        entry.device.device_index = static_cast<int>(i);
+        if (changed) {
+            events.push_back(Event{GvDeviceEventType::Changed, entry.device});
+        }
+    }
+
+    // 이번 검색에서 빠진 장치는 연속 누락 횟수가 기준에 닿으면 제거한다.
+    size_t out = 0;
+    for (size_t d = 0; d < m_devices.size(); ++d) {
+        Entry& entry = m_devices[d];
+        if (entry.device.source == source && !seen[d] && ++entry.missing >= m_options.missing_scans_before_removal) {
+            ++m_stats.removals;
+            events.push_back(Event{GvDeviceEventType::Removed, entry.device});
+            continue;
+        }
+        if (out != d) {
+            m_devices[out] = std::move(entry);
+        }
+        ++out;
+    }
+    m_devices.resize(out);
+}
+
+void GvDeviceDiscovery::Dispatch(const std::vector<Event>& events) {
+    for (const Event& e : events) {
+        for (const std::pair<uint64_t, GvDeviceEventCallback>& c : m_callbacks) {
+            c.second(e.type, e.device);
+        }
+    }
+}
+
+}  // namespace gv
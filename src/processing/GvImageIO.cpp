@@ -0,0 +1,1137 @@
+#include "GvImageIO.h"
+
+#include "GvDeflate.h"
+#include "GvParallel.h"
+#include "GvTrace.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace gv {
+
+namespace {
+
+constexpr size_t kDefaultStripBytes = 256u * 1024u;
+constexpr uint64_t kMaxPngChunkBytes = 0x7FFFFFFFu;
+constexpr uint64_t kMaxTiffBytes = 0xFFFFFFFFu;
+
+/** @brief 인코딩 결과 조각. 원본 픽셀을 그대로 쓸 수 있으면 복사하지 않고 가리킨다. */
+struct Segment {
+    std::vector<uint8_t> owned;
+    const uint8_t* external = nullptr;
+    size_t external_size = 0;
+
+    const uint8_t* Data() const { return external != nullptr ? external : owned.data(); }
+    size_t Size() const { return external != nullptr ? external_size : owned.size(); }
+};
+
+struct ImageView {
+    const uint8_t* pixels;
+    GvImageType::Enum type;
+    size_t width;
+    size_t height;
+    size_t channels;
+    size_t row_bytes;
+};
+
+void appendBE32(std::vector<uint8_t>& out, uint32_t v) {
+    const uint8_t bytes[4] = {static_cast<uint8_t>(v >> 24), static_cast<uint8_t>(v >> 16),
+                              static_cast<uint8_t>(v >> 8), static_cast<uint8_t>(v)};
+    out.insert(out.end(), bytes, bytes + 4);
+}
+
+void putBE32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v >> 24);
+    p[1] = static_cast<uint8_t>(v >> 16);
+    p[2] = static_cast<uint8_t>(v >> 8);
+    p[3] = static_cast<uint8_t>(v);
+}
+
+template <typename T>
+void appendLE(std::vector<uint8_t>& out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (i * 8)));
+    }
+}
+
+size_t stripRows(const GvImageWriteOptions& options, const ImageView& image) {
+    const size_t rows = options.rows_per_strip > 0 ? static_cast<size_t>(options.rows_per_strip)
+                                                    : std::max<size_t>(kDefaultStripBytes / image.row_bytes, 1);
+    return std::min(rows, image.height);
+}
+
+/** @brief 행 `r`을 RGB 순서로 돌려준다. BGR8만 `scratch`에 변환하고 나머지는 원본을 가리킨다. */
+const uint8_t* rgbRow(const ImageView& image, size_t r, uint8_t* scratch) {
+    const uint8_t* src = image.pixels + r * image.row_bytes;
+    if (image.type != GvImageType::BGR8) {
+        return src;
+    }
+    for (size_t x = 0; x < image.width; ++x) {
+        scratch[x * 3] = src[x * 3 + 2];
+        scratch[x * 3 + 1] = src[x * 3 + 1];
+        scratch[x * 3 + 2] = src[x * 3];
+    }
+    return scratch;
+}
+
+/** @brief BGR8이면 RGB로 변환한 사본을 병렬로 만들고, 아니면 원본을 가리키는 조각을 만든다. */
+Segment rgbPixels(const ImageView& image, int threads) {
+    Segment segment;
+    if (image.type != GvImageType::BGR8) {
+        segment.external = image.pixels;
+        segment.external_size = image.row_bytes * image.height;
+        return segment;
+    }
+    segment.owned.resize(image.row_bytes * image.height);
+    GvParallelFor(ThreadSubsystem_IO, 0, image.height, threads, [&](size_t r0, size_t r1, int) {
+        for (size_t r = r0; r < r1; ++r) {
+            rgbRow(image, r, segment.owned.data() + r * image.row_bytes);
+        }
+    });
+    return segment;
+}
+
+// -----------------------------------------------------------------------------
+// PNG
+// -----------------------------------------------------------------------------
+
+inline uint8_t paeth(int a, int b, int c) {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return static_cast<uint8_t>(a);
+    }
+    return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+/** @brief `prev`가 nullptr이면 첫 행(위쪽이 0)으로 본다. */
+void filterRow(int filter, const uint8_t* cur, const uint8_t* prev, size_t n, size_t bpp, uint8_t* out) {
+    switch (filter) {
+        case 1:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = static_cast<uint8_t>(cur[i] - (i >= bpp ? cur[i - bpp] : 0));
+            }
+            break;
+        case 2:
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = static_cast<uint8_t>(cur[i] - (prev != nullptr ? prev[i] : 0));
+            }
+            break;
+        case 3:
+            for (size_t i = 0; i < n; ++i) {
+                const int left = i >= bpp ? cur[i - bpp] : 0;
+                const int up = prev != nullptr ? prev[i] : 0;
+                out[i] = static_cast<uint8_t>(cur[i] - ((left + up) >> 1));
+            }
+            break;
+        case 4:
+            for (size_t i = 0; i < n; ++i) {
+                const int left = i >= bpp ? cur[i - bpp] : 0;
+                const int up = prev != nullptr ? prev[i] : 0;
+                const int upLeft = i >= bpp && prev != nullptr ? prev[i - bpp] : 0;
+                out[i] = static_cast<uint8_t>(cur[i] - paeth(left, up, upLeft));
+            }
+            break;
+        default:
+            std::memcpy(out, cur, n);
+            break;
+    }
+}
+
+uint64_t filterCost(const uint8_t* row, size_t n) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += static_cast<uint64_t>(std::abs(static_cast<int>(static_cast<int8_t>(row[i]))));
+    }
+    return sum;
+}
+
+void appendPngChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size) {
+    appendBE32(out, static_cast<uint32_t>(size));
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    appendBE32(out, detail::GvCrc32(0, out.data() + start, out.size() - start));
+}
+
+bool encodePng(const ImageView& image, const GvImageWriteOptions& options, std::vector<Segment>& segments) {
+    const size_t rowsPerStrip = stripRows(options, image);
+    const size_t stripCount = (image.height + rowsPerStrip - 1) / rowsPerStrip;
+    const detail::GvDeflateLevel::Enum level =
+        options.png_profile == GvPngProfile::Best
+            ? detail::GvDeflateLevel::Best
+            : (options.png_profile == GvPngProfile::Store ? detail::GvDeflateLevel::Store
+                                                          : detail::GvDeflateLevel::Fast);
+    const int fixedFilter = options.png_profile == GvPngProfile::Fast ? 2 : 0;
+    const bool adaptive = options.png_profile == GvPngProfile::Best;
+
+    // [1] 시그니처 + IHDR
+    Segment head;
+    static const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    head.owned.assign(kSignature, kSignature + 8);
+    std::vector<uint8_t> ihdr;
+    appendBE32(ihdr, static_cast<uint32_t>(image.width));
+    appendBE32(ihdr, static_cast<uint32_t>(image.height));
+    const uint8_t ihdrTail[5] = {8, static_cast<uint8_t>(image.channels == 1 ? 0 : 2), 0, 0, 0};
+    ihdr.insert(ihdr.end(), ihdrTail, ihdrTail + 5);
+    appendPngChunk(head.owned, "IHDR", ihdr.data(), ihdr.size());
+    segments.push_back(std::move(head));
+
+    // [2] strip별 필터링 + deflate(병렬). strip마다 IDAT chunk 하나.
+    //     첫 strip은 zlib 헤더로 시작하고, 마지막 strip만 BFINAL로 끝난다.
+    std::vector<Segment> strips(stripCount);
+    std::vector<uint32_t> stripAdler(stripCount, 1);
+    std::vector<uint64_t> stripRaw(stripCount, 0);
+    const int threads = GvResolveThreadCount(options.threads, stripCount, ThreadSubsystem_IO);
+    GvParallelFor(ThreadSubsystem_IO, 0, stripCount, threads, [&](size_t s0, size_t s1, int) {
+        const size_t n = image.row_bytes;
+        std::vector<uint8_t> scratch(image.type == GvImageType::BGR8 ? n * 2 : 0);
+        std::vector<uint8_t> candidate(adaptive ? n : 0);
+        std::vector<uint8_t> filtered;
+        for (size_t s = s0; s < s1; ++s) {
+            const size_t r0 = s * rowsPerStrip;
+            const size_t r1 = std::min(r0 + rowsPerStrip, image.height);
+            filtered.resize((r1 - r0) * (n + 1));
+            const uint8_t* prev = r0 > 0 ? rgbRow(image, r0 - 1, scratch.data() + n) : nullptr;
+            for (size_t r = r0; r < r1; ++r) {
+                const uint8_t* cur = rgbRow(image, r, scratch.data() + ((r - r0) & 1) * n);
+                uint8_t* out = filtered.data() + (r - r0) * (n + 1);
+                if (adaptive) {
+                    uint64_t bestCost = UINT64_MAX;
+                    for (int f = 0; f < 5; ++f) {
+                        filterRow(f, cur, prev, n, image.channels, candidate.data());
+                        const uint64_t cost = filterCost(candidate.data(), n);
+                        if (cost < bestCost) {
+                            bestCost = cost;
+                            out[0] = static_cast<uint8_t>(f);
+                            std::memcpy(out + 1, candidate.data(), n);
+                        }
+                    }
+                } else {
+                    out[0] = static_cast<uint8_t>(fixedFilter);
+                    filterRow(fixedFilter, cur, prev, n, image.channels, out + 1);
+                }
+                prev = cur;
+            }
+            stripAdler[s] = detail::GvAdler32(1, filtered.data(), filtered.size());
+            stripRaw[s] = filtered.size();
+
+            std::vector<uint8_t>& chunk = strips[s].owned;
+            chunk.assign(8, 0);
+            std::memcpy(chunk.data() + 4, "IDAT", 4);
+            if (s == 0) {
+                chunk.push_back(0x78);
+                chunk.push_back(level == detail::GvDeflateLevel::Best ? 0xDA : 0x01);
+            }
+            const bool last = s + 1 == stripCount;
+            detail::GvDeflateRaw(filtered.data(), filtered.size(), level, last, chunk);
+            // 마지막 strip은 전체 Adler-32를 붙인 뒤 호출 스레드에서 CRC를 계산한다.
+            if (!last) {
+                putBE32(chunk.data(), static_cast<uint32_t>(chunk.size() - 8));
+                appendBE32(chunk, detail::GvCrc32(0, chunk.data() + 4, chunk.size() - 4));
+            }
+        }
+    });
+
+    // [3] Adler-32 결합 + 마지막 IDAT 마무리
+    uint32_t adler = stripAdler[0];
+    for (size_t s = 1; s < stripCount; ++s) {
+        adler = detail::GvAdler32Combine(adler, stripAdler[s], stripRaw[s]);
+    }
+    std::vector<uint8_t>& last = strips.back().owned;
+    appendBE32(last, adler);
+    putBE32(last.data(), static_cast<uint32_t>(last.size() - 8));
+    appendBE32(last, detail::GvCrc32(0, last.data() + 4, last.size() - 4));
+    for (Segment& strip : strips) {
+        if (strip.owned.size() - 12 > kMaxPngChunkBytes) {
+            detail::GvSetLastHelperError("GvEncodeImage: PNG strip exceeds the chunk size limit; reduce rows_per_strip");
+            return false;
+        }
+        segments.push_back(std::move(strip));
+    }
+
+    Segment tail;
+    appendPngChunk(tail.owned, "IEND", nullptr, 0);
+    segments.push_back(std::move(tail));
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// TIFF (little-endian baseline, 단일 IFD)
+// -----------------------------------------------------------------------------
+
+void packBitsRow(const uint8_t* src, size_t n, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < n) {
+        size_t run = 1;
+        while (i + run < n && run < 128 && src[i + run] == src[i]) {
+            ++run;
+        }
+        if (run >= 3) {
+            out.push_back(static_cast<uint8_t>(257 - run));
+            out.push_back(src[i]);
+            i += run;
+            continue;
+        }
+        // 3바이트 이상 반복이 시작되기 전까지 literal로 묶는다.
+        size_t j = i;
+        while (j < n && j - i < 128) {
+            if (j + 2 < n && src[j] == src[j + 1] && src[j] == src[j + 2]) {
+                break;
+            }
+            ++j;
+        }
+        out.push_back(static_cast<uint8_t>(j - i - 1));
+        out.insert(out.end(), src + i, src + j);
+        i = j;
+    }
+}
+
+struct TiffEntry {
+    uint16_t tag;
+    uint16_t type;
+    uint32_t count;
+    uint32_t value;
+};
+
+constexpr uint16_t kTiffShort = 3;
+constexpr uint16_t kTiffLong = 4;
+constexpr uint16_t kTiffRational = 5;
+
+bool encodeTiff(const ImageView& image, const GvImageWriteOptions& options, std::vector<Segment>& segments) {
+    const bool packBits = options.tiff_compression == GvTiffCompression::PackBits;
+    const size_t rowsPerStrip = stripRows(options, image);
+    const size_t stripCount = (image.height + rowsPerStrip - 1) / rowsPerStrip;
+    const int threads = GvResolveThreadCount(options.threads, stripCount, ThreadSubsystem_IO);
+
+    // [1] 픽셀 데이터. 비압축 Mono8/RGB8은 원본을 그대로 쓴다.
+    std::vector<Segment> data;
+    std::vector<uint32_t> stripBytes(stripCount);
+    if (packBits) {
+        data.resize(stripCount);
+        GvParallelFor(ThreadSubsystem_IO, 0, stripCount, threads, [&](size_t s0, size_t s1, int) {
+            std::vector<uint8_t> scratch(image.row_bytes);
+            for (size_t s = s0; s < s1; ++s) {
+                const size_t r0 = s * rowsPerStrip;
+                const size_t r1 = std::min(r0 + rowsPerStrip, image.height);
+                std::vector<uint8_t>& out = data[s].owned;
+                out.reserve((r1 - r0) * (image.row_bytes + image.row_bytes / 128 + 1));
+                for (size_t r = r0; r < r1; ++r) {
+                    packBitsRow(rgbRow(image, r, scratch.data()), image.row_bytes, out);
+                }
+            }
+        });
+        for (size_t s = 0; s < stripCount; ++s) {
+            stripBytes[s] = static_cast<uint32_t>(data[s].owned.size());
+        }
+    } else {
+        data.push_back(rgbPixels(image, options.threads));
+        for (size_t s = 0; s < stripCount; ++s) {
+            const size_t rows = std::min(rowsPerStrip, image.height - s * rowsPerStrip);
+            stripBytes[s] = static_cast<uint32_t>(rows * image.row_bytes);
+        }
+    }
+
+    // [2] 헤더 + IFD + 배열 값. 픽셀 데이터는 그 뒤에 이어서 둔다.
+    constexpr uint32_t kEntryCount = 13;
+    const uint32_t ifdBytes = 2 + kEntryCount * 12 + 4;
+    uint32_t cursor = 8 + ifdBytes;
+    const uint32_t bitsOffset = image.channels == 3 ? cursor : 0;
+    cursor += image.channels == 3 ? 6 : 0;
+    const uint32_t xResOffset = cursor;
+    const uint32_t yResOffset = cursor + 8;
+    cursor += 16;
+    const uint32_t offsetsOffset = cursor;
+    const uint32_t countsOffset = stripCount > 1 ? cursor + static_cast<uint32_t>(stripCount) * 4 : 0;
+    cursor += stripCount > 1 ? static_cast<uint32_t>(stripCount) * 8 : 0;
+    uint64_t total = cursor;
+    for (uint32_t bytes : stripBytes) {
+        total += bytes;
+    }
+    if (total > kMaxTiffBytes) {
+        detail::GvSetLastHelperError("GvEncodeImage: TIFF larger than 4GB is not supported");
+        return false;
+    }
+    std::vector<uint32_t> stripOffsets(stripCount);
+    uint32_t dataOffset = cursor;
+    for (size_t s = 0; s < stripCount; ++s) {
+        stripOffsets[s] = dataOffset;
+        dataOffset += stripBytes[s];
+    }
+
+    const uint32_t photometric = image.channels == 3 ? 2 : 1;
+    const TiffEntry entries[kEntryCount] = {
+        {256, kTiffLong, 1, static_cast<uint32_t>(image.width)},
+        {257, kTiffLong, 1, static_cast<uint32_t>(image.height)},
+        {258, kTiffShort, static_cast<uint32_t>(image.channels), image.channels == 3 ? bitsOffset : 8},
+        {259, kTiffShort, 1, static_cast<uint32_t>(options.tiff_compression)},
+        {262, kTiffShort, 1, photometric},
+        {273, kTiffLong, static_cast<uint32_t>(stripCount), stripCount > 1 ? offsetsOffset : stripOffsets[0]},
+        {277, kTiffShort, 1, static_cast<uint32_t>(image.channels)},
+        {278, kTiffLong, 1, static_cast<uint32_t>(rowsPerStrip)},
+        {279, kTiffLong, static_cast<uint32_t>(stripCount), stripCount > 1 ? countsOffset : stripBytes[0]},
+        {282, kTiffRational, 1, xResOffset},
+        {283, kTiffRational, 1, yResOffset},
+        {284, kTiffShort, 1, 1},
+        {296, kTiffShort, 1, 2},
+    };
+
+    Segment head;
+    std::vector<uint8_t>& out = head.owned;
+    out.reserve(cursor);
+    out.push_back('I');
+    out.push_back('I');
+    appendLE<uint16_t>(out, 42);
+    appendLE<uint32_t>(out, 8);
+    appendLE<uint16_t>(out, static_cast<uint16_t>(kEntryCount));
+    for (const TiffEntry& e : entries) {
+        appendLE<uint16_t>(out, e.tag);
+        appendLE<uint16_t>(out, e.type);
+        appendLE<uint32_t>(out, e.count);
+        // 4바이트에 들어가는 SHORT 값은 앞쪽 2바이트에 둔다.
+        if (e.type == kTiffShort && e.count == 1) {
+            appendLE<uint16_t>(out, static_cast<uint16_t>(e.value));
+            appendLE<uint16_t>(out, 0);
+        } else {
+            appendLE<uint32_t>(out, e.value);
+        }
+    }
+    appendLE<uint32_t>(out, 0);
+    if (image.channels == 3) {
+        for (int i = 0; i < 3; ++i) {
+            appendLE<uint16_t>(out, 8);
+        }
+    }
+    for (int i = 0; i < 2; ++i) {
+        appendLE<uint32_t>(out, 72);
+        appendLE<uint32_t>(out, 1);
+    }
+    if (stripCount > 1) {
+        for (uint32_t offset : stripOffsets) {
+            appendLE<uint32_t>(out, offset);
+        }
+        for (uint32_t bytes : stripBytes) {
+            appendLE<uint32_t>(out, bytes);
+        }
+    }
+    segments.push_back(std::move(head));
+    for (Segment& segment : data) {
+        segments.push_back(std::move(segment));
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// PGM / PPM
+// -----------------------------------------------------------------------------
+
+void encodePnm(const ImageView& image, const GvImageWriteOptions& options, std::vector<Segment>& segments) {
+    Segment head;
+    const std::string header = std::string(image.channels == 1 ? "P5\n" : "P6\n") + std::to_string(image.width) +
+                               " " + std::to_string(image.height) + "\n255\n";
+    head.owned.assign(header.begin(), header.end());
+    segments.push_back(std::move(head));
+    segments.push_back(rgbPixels(image, options.threads));
+}
+
+// -----------------------------------------------------------------------------
+
+bool makeView(const char* func, const unsigned char* pixels, GvImageType::Enum type, const GvSize& size,
+              ImageView& image) {
+    const size_t channels = GvImageBufferPixelSize(type);
+    if (pixels == nullptr || size.width <= 0 || size.height <= 0) {
+        detail::GvSetLastHelperError(std::string(func) + ": invalid arguments");
+        return false;
+    }
+    if (channels == 0) {
+        detail::GvSetLastHelperError(std::string(func) + ": image must be Mono8, RGB8 or BGR8");
+        return false;
+    }
+    image.pixels = pixels;
+    image.type = type;
+    image.width = static_cast<size_t>(size.width);
+    image.height = static_cast<size_t>(size.height);
+    image.channels = channels;
+    image.row_bytes = image.width * channels;
+    return true;
+}
+
+bool encodeSegments(const char* func, const unsigned char* pixels, GvImageType::Enum type, const GvSize& size,
+                    const GvImageWriteOptions& options, std::vector<Segment>& segments) {
+    ImageView image;
+    if (!makeView(func, pixels, type, size, image)) {
+        return false;
+    }
+    switch (options.format) {
+        case GvImageFileFormat::Png:
+            return encodePng(image, options, segments);
+        case GvImageFileFormat::Tiff:
+            return encodeTiff(image, options, segments);
+        case GvImageFileFormat::Pnm:
+            encodePnm(image, options, segments);
+            return true;
+        default:
+            detail::GvSetLastHelperError(std::string(func) + ": image file format is not specified");
+            return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// 읽기
+// -----------------------------------------------------------------------------
+
+constexpr uint16_t kTiffCompressionDeflate = 8;
+constexpr uint16_t kTiffCompressionAdobeDeflate = 32946;
+
+/** @brief 헤더 해석 결과. 형식별 디코딩 정보를 함께 담는다. */
+struct ParsedImage {
+    GvImageFileInfo info;
+    // TIFF
+    uint32_t compression = 1;
+    size_t rows_per_strip = 0;
+    std::vector<uint64_t> strip_offsets;
+    std::vector<uint64_t> strip_counts;
+    // PNG
+    int color_type = 0;
+    size_t source_channels = 0;
+    std::vector<uint8_t> palette;
+    std::vector<std::pair<size_t, size_t>> idat;
+};
+
+bool fail(const char* func, const std::string& message) {
+    detail::GvSetLastHelperError(std::string(func) + ": " + message);
+    return false;
+}
+
+inline uint32_t readBE32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+inline uint32_t readTiff(const uint8_t* p, size_t bytes, bool little) {
+    uint32_t v = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        const uint32_t b = p[little ? i : bytes - 1 - i];
+        v |= b << (8 * i);
+    }
+    return v;
+}
+
+bool parsePnm(const char* func, const uint8_t* d, size_t n, ParsedImage& parsed) {
+    size_t pos = 2;
+    uint64_t values[3] = {};
+    for (uint64_t& value : values) {
+        // 공백과 주석('#' ~ 줄 끝)을 건너뛴다.
+        while (pos < n && (std::isspace(d[pos]) || d[pos] == '#')) {
+            if (d[pos] == '#') {
+                while (pos < n && d[pos] != '\n') {
+                    ++pos;
+                }
+            } else {
+                ++pos;
+            }
+        }
+        if (pos >= n || !std::isdigit(d[pos])) {
+            return fail(func, "malformed PGM/PPM header");
+        }
+        while (pos < n && std::isdigit(d[pos]) && value < 0x7FFFFFFF) {
+            value = value * 10 + static_cast<uint64_t>(d[pos++] - '0');
+        }
+    }
+    if (pos >= n || !std::isspace(d[pos])) {
+        return fail(func, "malformed PGM/PPM header");
+    }
+    ++pos;
+    if (values[2] != 255) {
+        return fail(func, "only 8-bit (maxval 255) PGM/PPM is supported");
+    }
+    if (values[0] == 0 || values[1] == 0 || values[0] > 0x7FFFFFFF || values[1] > 0x7FFFFFFF) {
+        return fail(func, "invalid PGM/PPM size");
+    }
+    GvImageFileInfo& info = parsed.info;
+    info.format = GvImageFileFormat::Pnm;
+    info.type = d[1] == '5' ? GvImageType::Mono8 : GvImageType::RGB8;
+    info.size = GvSize{static_cast<int>(values[0]), static_cast<int>(values[1])};
+    info.data_offset = pos;
+    info.mappable = true;
+    const uint64_t bytes = values[0] * values[1] * GvImageBufferPixelSize(info.type);
+    if (n - pos < bytes) {
+        return fail(func, "truncated PGM/PPM data");
+    }
+    return true;
+}
+
+bool parseTiff(const char* func, const uint8_t* d, size_t n, ParsedImage& parsed) {
+    const bool little = d[0] == 'I';
+    if (n < 8 || readTiff(d + 2, 2, little) != 42) {
+        return fail(func, "malformed TIFF header");
+    }
+    const uint64_t ifd = readTiff(d + 4, 4, little);
+    if (ifd + 2 > n) {
+        return fail(func, "malformed TIFF header");
+    }
+    const size_t entryCount = readTiff(d + ifd, 2, little);
+    if (ifd + 2 + entryCount * 12 > n) {
+        return fail(func, "truncated TIFF directory");
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t photometric = UINT32_MAX;
+    uint32_t samples = 1;
+    uint32_t planar = 1;
+    uint32_t predictor = 1;
+    uint64_t rowsPerStrip = 0;
+    std::vector<uint64_t> bits(1, 1);
+    for (size_t e = 0; e < entryCount; ++e) {
+        const uint8_t* entry = d + ifd + 2 + e * 12;
+        const uint32_t tag = readTiff(entry, 2, little);
+        const uint32_t type = readTiff(entry + 2, 2, little);
+        const uint64_t count = readTiff(entry + 4, 4, little);
+        const size_t valueBytes = type == kTiffShort ? 2 : (type == kTiffLong ? 4 : 0);
+        if (valueBytes == 0 || count == 0) {
+            continue;
+        }
+        const uint8_t* p = entry + 8;
+        if (count * valueBytes > 4) {
+            const uint64_t offset = readTiff(entry + 8, 4, little);
+            if (offset + count * valueBytes > n) {
+                return fail(func, "truncated TIFF tag " + std::to_string(tag));
+            }
+            p = d + offset;
+        }
+        std::vector<uint64_t> values(static_cast<size_t>(count));
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = readTiff(p + i * valueBytes, valueBytes, little);
+        }
+        switch (tag) {
+            case 256: width = static_cast<uint32_t>(values[0]); break;
+            case 257: height = static_cast<uint32_t>(values[0]); break;
+            case 258: bits = values; break;
+            case 259: parsed.compression = static_cast<uint32_t>(values[0]); break;
+            case 262: photometric = static_cast<uint32_t>(values[0]); break;
+            case 273: parsed.strip_offsets = values; break;
+            case 277: samples = static_cast<uint32_t>(values[0]); break;
+            case 278: rowsPerStrip = values[0]; break;
+            case 279: parsed.strip_counts = values; break;
+            case 284: planar = static_cast<uint32_t>(values[0]); break;
+            case 317: predictor = static_cast<uint32_t>(values[0]); break;
+            default: break;
+        }
+    }
+
+    GvImageFileInfo& info = parsed.info;
+    info.format = GvImageFileFormat::Tiff;
+    if (width == 0 || height == 0 || width > 0x7FFFFFFF || height > 0x7FFFFFFF) {
+        return fail(func, "invalid TIFF size");
+    }
+    if (samples == 1 && photometric == 1) {
+        info.type = GvImageType::Mono8;
+    } else if (samples == 3 && photometric == 2) {
+        info.type = GvImageType::RGB8;
+    } else {
+        return fail(func, "only 8-bit BlackIsZero gray or RGB TIFF is supported");
+    }
+    if (std::any_of(bits.begin(), bits.end(), [](uint64_t b) { return b != 8; }) || planar != 1 || predictor != 1) {
+        return fail(func, "only 8-bit, chunky, non-predicted TIFF is supported");
+    }
+    if (parsed.compression != GvTiffCompression::None && parsed.compression != GvTiffCompression::PackBits &&
+        parsed.compression != kTiffCompressionDeflate && parsed.compression != kTiffCompressionAdobeDeflate) {
+        return fail(func, "unsupported TIFF compression " + std::to_string(parsed.compression));
+    }
+    info.size = GvSize{static_cast<int>(width), static_cast<int>(height)};
+    parsed.rows_per_strip = rowsPerStrip == 0 || rowsPerStrip > height ? height : static_cast<size_t>(rowsPerStrip);
+    const size_t stripCount = (height + parsed.rows_per_strip - 1) / parsed.rows_per_strip;
+    if (parsed.strip_offsets.size() != stripCount || parsed.strip_counts.size() != stripCount) {
+        return fail(func, "TIFF strip tables do not match the image size");
+    }
+    const uint64_t rowBytes = static_cast<uint64_t>(width) * samples;
+    for (size_t s = 0; s < stripCount; ++s) {
+        if (parsed.strip_offsets[s] + parsed.strip_counts[s] > n) {
+            return fail(func, "truncated TIFF strip " + std::to_string(s));
+        }
+    }
+
+    // 비압축이고 strip이 파일 안에 이어져 있으면 매핑해 그대로 쓸 수 있다.
+    bool contiguous = parsed.compression == GvTiffCompression::None;
+    for (size_t s = 0; contiguous && s < stripCount; ++s) {
+        const uint64_t rows = std::min<uint64_t>(parsed.rows_per_strip, height - s * parsed.rows_per_strip);
+        contiguous = parsed.strip_counts[s] >= rows * rowBytes &&
+                     parsed.strip_offsets[s] == parsed.strip_offsets[0] + s * parsed.rows_per_strip * rowBytes;
+    }
+    info.mappable = contiguous;
+    info.data_offset = contiguous ? parsed.strip_offsets[0] : 0;
+    return true;
+}
+
+bool parsePng(const char* func, const uint8_t* d, size_t n, ParsedImage& parsed) {
+    GvImageFileInfo& info = parsed.info;
+    info.format = GvImageFileFormat::Png;
+    size_t pos = 8;
+    bool header = false;
+    bool end = false;
+    while (!end && pos + 12 <= n) {
+        const size_t length = readBE32(d + pos);
+        const uint8_t* type = d + pos + 4;
+        const size_t body = pos + 8;
+        if (length > n - body - 4) {
+            return fail(func, "truncated PNG chunk");
+        }
+        if (std::memcmp(type, "IHDR", 4) == 0 && length >= 13) {
+            const uint32_t width = readBE32(d + body);
+            const uint32_t height = readBE32(d + body + 4);
+            const uint8_t depth = d[body + 8];
+            parsed.color_type = d[body + 9];
+            if (width == 0 || height == 0 || width > 0x7FFFFFFF || height > 0x7FFFFFFF) {
+                return fail(func, "invalid PNG size");
+            }
+            if (depth != 8 || d[body + 10] != 0 || d[body + 11] != 0) {
+                return fail(func, "only 8-bit PNG is supported");
+            }
+            if (d[body + 12] != 0) {
+                return fail(func, "interlaced PNG is not supported");
+            }
+            static const size_t kChannels[7] = {1, 0, 3, 1, 2, 0, 4};
+            if (parsed.color_type > 6 || kChannels[parsed.color_type] == 0) {
+                return fail(func, "invalid PNG color type");
+            }
+            parsed.source_channels = kChannels[parsed.color_type];
+            info.type = parsed.color_type == 0 || parsed.color_type == 4 ? GvImageType::Mono8 : GvImageType::RGB8;
+            info.size = GvSize{static_cast<int>(width), static_cast<int>(height)};
+            header = true;
+        } else if (std::memcmp(type, "PLTE", 4) == 0) {
+            parsed.palette.assign(d + body, d + body + length);
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            parsed.idat.push_back(std::make_pair(body, length));
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            end = true;
+        }
+        pos = body + length + 4;
+    }
+    if (!header || parsed.idat.empty()) {
+        return fail(func, "PNG has no image data");
+    }
+    if (parsed.color_type == 3 && parsed.palette.size() < 3) {
+        return fail(func, "palette PNG without PLTE chunk");
+    }
+    return true;
+}
+
+bool parseImage(const char* func, const uint8_t* d, size_t n, ParsedImage& parsed) {
+    static const uint8_t kPngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (n >= 8 && std::memcmp(d, kPngSignature, 8) == 0) {
+        return parsePng(func, d, n, parsed);
+    }
+    if (n >= 4 && ((d[0] == 'I' && d[1] == 'I') || (d[0] == 'M' && d[1] == 'M'))) {
+        return parseTiff(func, d, n, parsed);
+    }
+    if (n >= 2 && d[0] == 'P' && (d[1] == '5' || d[1] == '6')) {
+        return parsePnm(func, d, n, parsed);
+    }
+    return fail(func, "unsupported image file format");
+}
+
+bool inflateZlib(const uint8_t* src, size_t size, uint8_t* dst, size_t expected) {
+    if (size < 2 || (src[0] & 0x0F) != 8 || ((src[0] << 8) | src[1]) % 31 != 0 || (src[1] & 0x20) != 0) {
+        return false;
+    }
+    size_t produced = 0;
+    return detail::GvInflateRaw(src + 2, size - 2, dst, expected, produced) && produced == expected;
+}
+
+bool unpackBits(const uint8_t* src, size_t size, uint8_t* dst, size_t expected) {
+    size_t i = 0;
+    size_t o = 0;
+    while (o < expected) {
+        if (i >= size) {
+            return false;
+        }
+        const int c = static_cast<int8_t>(src[i++]);
+        if (c >= 0) {
+            const size_t len = static_cast<size_t>(c) + 1;
+            if (len > size - i || len > expected - o) {
+                return false;
+            }
+            std::memcpy(dst + o, src + i, len);
+            i += len;
+            o += len;
+        } else if (c != -128) {
+            const size_t len = static_cast<size_t>(1 - c);
+            if (i >= size || len > expected - o) {
+                return false;
+            }
+            std::memset(dst + o, src[i++], len);
+            o += len;
+        }
+    }
+    return true;
+}
+
+bool decodeTiff(const char* func, const uint8_t* d, const ParsedImage& parsed, uint8_t* out) {
+    const GvImageFileInfo& info = parsed.info;
+    const size_t rowBytes = static_cast<size_t>(info.size.width) * GvImageBufferPixelSize(info.type);
+    const size_t height = static_cast<size_t>(info.size.height);
+    for (size_t s = 0; s < parsed.strip_offsets.size(); ++s) {
+        const size_t r0 = s * parsed.rows_per_strip;
+        const size_t expected = std::min(parsed.rows_per_strip, height - r0) * rowBytes;
+        const uint8_t* src = d + parsed.strip_offsets[s];
+        const size_t size = static_cast<size_t>(parsed.strip_counts[s]);
+        uint8_t* dst = out + r0 * rowBytes;
+        bool ok = false;
+        if (parsed.compression == GvTiffCompression::None) {
+            ok = size >= expected;
+            if (ok) {
+                std::memcpy(dst, src, expected);
+            }
+        } else if (parsed.compression == GvTiffCompression::PackBits) {
+            ok = unpackBits(src, size, dst, expected);
+        } else {
+            ok = inflateZlib(src, size, dst, expected);
+        }
+        if (!ok) {
+            return fail(func, "corrupt TIFF strip " + std::to_string(s));
+        }
+    }
+    return true;
+}
+
+void unfilterRow(int filter, uint8_t* cur, const uint8_t* prev, size_t n, size_t bpp) {
+    switch (filter) {
+        case 1:
+            for (size_t i = bpp; i < n; ++i) {
+                cur[i] = static_cast<uint8_t>(cur[i] + cur[i - bpp]);
+            }
+            break;
+        case 2:
+            for (size_t i = 0; prev != nullptr && i < n; ++i) {
+                cur[i] = static_cast<uint8_t>(cur[i] + prev[i]);
+            }
+            break;
+        case 3:
+            for (size_t i = 0; i < n; ++i) {
+                const int left = i >= bpp ? cur[i - bpp] : 0;
+                const int up = prev != nullptr ? prev[i] : 0;
+                cur[i] = static_cast<uint8_t>(cur[i] + ((left + up) >> 1));
+            }
+            break;
+        case 4:
+            for (size_t i = 0; i < n; ++i) {
+                const int left = i >= bpp ? cur[i - bpp] : 0;
+                const int up = prev != nullptr ? prev[i] : 0;
+                const int upLeft = i >= bpp && prev != nullptr ? prev[i - bpp] : 0;
+                cur[i] = static_cast<uint8_t>(cur[i] + paeth(left, up, upLeft));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool decodePng(const char* func, const uint8_t* d, const ParsedImage& parsed, uint8_t* out) {
+    const GvImageFileInfo& info = parsed.info;
+    const size_t width = static_cast<size_t>(info.size.width);
+    const size_t height = static_cast<size_t>(info.size.height);
+    const size_t channels = parsed.source_channels;
+    const size_t stride = width * channels;
+
+    // [1] IDAT 연결 + zlib 해제
+    std::vector<uint8_t> stream;
+    if (parsed.idat.size() > 1) {
+        size_t total = 0;
+        for (const std::pair<size_t, size_t>& chunk : parsed.idat) {
+            total += chunk.second;
+        }
+        stream.reserve(total);
+        for (const std::pair<size_t, size_t>& chunk : parsed.idat) {
+            stream.insert(stream.end(), d + chunk.first, d + chunk.first + chunk.second);
+        }
+    }
+    const uint8_t* src = stream.empty() ? d + parsed.idat[0].first : stream.data();
+    const size_t srcSize = stream.empty() ? parsed.idat[0].second : stream.size();
+    std::vector<uint8_t> raw(height * (stride + 1));
+    if (!inflateZlib(src, srcSize, raw.data(), raw.size())) {
+        return fail(func, "corrupt PNG image data");
+    }
+
+    // [2] 행 필터 복원 + 출력 형식 변환
+    const size_t outChannels = GvImageBufferPixelSize(info.type);
+    const uint8_t* palette = parsed.palette.data();
+    const size_t paletteEntries = parsed.palette.size() / 3;
+    for (size_t r = 0; r < height; ++r) {
+        uint8_t* row = raw.data() + r * (stride + 1);
+        if (row[0] > 4) {
+            return fail(func, "invalid PNG filter type");
+        }
+        uint8_t* cur = row + 1;
+        unfilterRow(row[0], cur, r > 0 ? cur - (stride + 1) : nullptr, stride, channels);
+        uint8_t* dst = out + r * width * outChannels;
+        switch (parsed.color_type) {
+            case 0:
+            case 2:
+                std::memcpy(dst, cur, stride);
+                break;
+            case 3:
+                for (size_t x = 0; x < width; ++x) {
+                    if (cur[x] >= paletteEntries) {
+                        return fail(func, "PNG palette index out of range");
+                    }
+                    std::memcpy(dst + x * 3, palette + cur[x] * 3, 3);
+                }
+                break;
+            case 4:
+                for (size_t x = 0; x < width; ++x) {
+                    dst[x] = cur[x * 2];
+                }
+                break;
+            default:
+                for (size_t x = 0; x < width; ++x) {
+                    std::memcpy(dst + x * 3, cur + x * 4, 3);
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+bool decodeImage(const char* func, const uint8_t* d, const ParsedImage& parsed, uint8_t* out) {
+    switch (parsed.info.format) {
+        case GvImageFileFormat::Png:
+            return decodePng(func, d, parsed, out);
+        case GvImageFileFormat::Tiff:
+            return decodeTiff(func, d, parsed, out);
+        default:
+            std::memcpy(out, d + parsed.info.data_offset,
+                        static_cast<size_t>(parsed.info.size.width) * static_cast<size_t>(parsed.info.size.height) *
+                            GvImageBufferPixelSize(parsed.info.type));
+            return true;
+    }
+}
+
+GvImageFileFormat::Enum formatFromExtension(const char* fileName) {
+    const char* dot = std::strrchr(fileName, '.');
+    if (dot == nullptr) {
+        return GvImageFileFormat::Auto;
+    }
+    std::string ext(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (ext == "png") {
+        return GvImageFileFormat::Png;
+    }
+    if (ext == "tif" || ext == "tiff") {
+        return GvImageFileFormat::Tiff;
+    }
+    if (ext == "pgm" || ext == "ppm" || ext == "pnm") {
+        return GvImageFileFormat::Pnm;
+    }
+    return GvImageFileFormat::Auto;
+}
+
+}  // namespace
+
+const char* GvImageFileFormat::ToString(GvImageFileFormat::Enum e) {
+    switch (e) {
+        case Png: return "Png";
+        case Tiff: return "Tiff";
+        case Pnm: return "Pnm";
+        default: return "Auto";
+    }
+}
+
+const char* GvPngProfile::ToString(GvPngProfile::Enum e) {
+    switch (e) {
+        case Store: return "Store";
+        case Best: return "Best";
+        default: return "Fast";
+    }
+}
+
+const char* GvTiffCompression::ToString(GvTiffCompression::Enum e) {
+    switch (e) {
+        case PackBits: return "PackBits";
+        default: return "None";
+    }
+}
+
+bool GvSaveImageFile(const char* fileName, const unsigned char* pixels, GvImageType::Enum type, const GvSize& size,
+                     const GvImageWriteOptions& options) {
+    GV_TRACE_SCOPE("GvSaveImageFile", "io");
+    if (fileName == nullptr) {
+        detail::GvSetLastHelperError("GvSaveImageFile: invalid arguments");
+        return false;
+    }
+    GvImageWriteOptions resolved = options;
+    if (resolved.format == GvImageFileFormat::Auto) {
+        resolved.format = formatFromExtension(fileName);
+        if (resolved.format == GvImageFileFormat::Auto) {
+            detail::GvSetLastHelperError(std::string("GvSaveImageFile: unknown image file extension: ") + fileName);
+            return false;
+        }
+    }
+    std::vector<Segment> segments;
+    if (!encodeSegments("GvSaveImageFile", pixels, type, size, resolved, segments)) {
+        return false;
+    }
+
+    FILE* fp = std::fopen(fileName, "wb");
+    if (fp == nullptr) {
+        detail::GvSetLastHelperError(std::string("GvSaveImageFile: cannot open ") + fileName);
+        return false;
+    }
+    // 조각이 이미 큰 버퍼이므로 stdio 버퍼링은 끈다.
+    std::setvbuf(fp, nullptr, _IONBF, 0);
+    bool ok = true;
+    for (const Segment& segment : segments) {
+        if (segment.Size() != 0 && std::fwrite(segment.Data(), 1, segment.Size(), fp) != segment.Size()) {
+            ok = false;
+            break;
+        }
+    }
+    ok = std::fclose(fp) == 0 && ok;
+    if (!ok) {
+        detail::GvSetLastHelperError(std::string("GvSaveImageFile: write failed: ") + fileName);
+    }
+    return ok;
+}
+
+bool GvSaveImageFile(const char* fileName, const GvImageBuffer& image, const GvImageWriteOptions& options) {
+    if (!image.IsValid()) {
+        detail::GvSetLastHelperError("GvSaveImageFile: invalid image");
+        return false;
+    }
+    return GvSaveImageFile(fileName, image.GetDataConstPtr(), image.GetType(), image.GetSize(), options);
+}
+
+bool GvEncodeImage(const unsigned char* pixels, GvImageType::Enum type, const GvSize& size,
+                   const GvImageWriteOptions& options, std::vector<uint8_t>& out) {
+    std::vector<Segment> segments;
+    if (!encodeSegments("GvEncodeImage", pixels, type, size, options, segments)) {
+        return false;
+    }
+    size_t total = 0;
+    for (const Segment& segment : segments) {
+        total += segment.Size();
+    }
+    out.clear();
+    out.reserve(total);
+    for (const Segment& segment : segments) {
+        out.insert(out.end(), segment.Data(), segment.Data() + segment.Size());
+    }
+    return true;
+}
+
+bool GvReadImageFileInfo(const char* fileName, GvImageFileInfo& info) {
+    if (fileName == nullptr) {
+        return fail("GvReadImageFileInfo", "invalid arguments");
+    }
+    GvMappedFile file;
+    if (!file.Open(fileName)) {
+        return false;
+    }
+    ParsedImage parsed;
+    if (!parseImage("GvReadImageFileInfo", file.GetData(), static_cast<size_t>(file.GetSize()), parsed)) {
+        return false;
+    }
+    info = parsed.info;
+    return true;
+}
+
+bool GvMappedImage::Open(const char* fileName) {
+    Close();
+    if (fileName == nullptr) {
+        return fail("GvMappedImage::Open", "invalid arguments");
+    }
+    GvMappedFile file;
+    if (!file.Open(fileName, GvMappedFileMode::CopyOnWrite)) {
+        return false;
+    }
+    ParsedImage parsed;
+    if (!parseImage("GvMappedImage::Open", file.GetData(), static_cast<size_t>(file.GetSize()), parsed)) {
+        return false;
+    }
+    if (!parsed.info.mappable) {
+        return fail("GvMappedImage::Open", std::string("pixel data is compressed or not contiguous: ") + fileName);
+    }
+    m_file = file;
+    m_type = parsed.info.type;
+    m_size = parsed.info.size;
+    m_offset = parsed.info.data_offset;
+    return true;
+}
+
+void GvMappedImage::Close() {
+    m_file.Close();
+    m_type = GvImageType::None;
+    m_size = GvSize();
+    m_offset = 0;
+}
+
+size_t GvMappedImage::GetBytes() const {
+    return static_cast<size_t>(m_size.width) * static_cast<size_t>(m_size.height) * GvImageBufferPixelSize(m_type);
+}
+
+const unsigned char* GvMappedImage::GetDataConstPtr() const {
+    return IsValid() ? m_file.GetData() + m_offset : nullptr;
+}
+
+unsigned char* GvMappedImage::GetDataPtr() const {
+    return IsValid() ? m_file.GetMutableData() + m_offset : nullptr;
+}
+
+bool GvLoadImageFile(const char* fileName, GvImageBuffer& image) {
+    if (fileName == nullptr) {
+        return fail("GvLoadImageFile", "invalid arguments");
+    }
+    GvMappedFile file;
+    if (!file.Open(fileName)) {
+        return false;
+    }
+    file.Advise(GvMappedFileAccess::Sequential);
+    ParsedImage parsed;
+    if (!parseImage("GvLoadImageFile", file.GetData(), static_cast<size_t>(file.GetSize()), parsed)) {
+        return false;
+    }
+    if (!image.IsValid() || image.GetType() != parsed.info.type || image.GetSize() != parsed.info.size) {
+        image = GvImageBuffer::Create(parsed.info.type, parsed.info.size);
+        if (!image.IsValid()) {
+            return fail("GvLoadImageFile", "cannot allocate image buffer");
+        }
+    }
+    return decodeImage("GvLoadImageFile", file.GetData(), parsed, image.GetDataPtr());
+}
+
+bool GvImageBatchLoader::Load(const std::vector<std::string>& fileNames, const GvImageBatchLoadOptions& options) {
+    m_count = fileNames.size();
+    if (m_images.size() < m_count) {
+        m_images.resize(m_count);
+    }
+    std::vector<std::string> errors(m_count);
+    GvParallelFor(ThreadSubsystem_IO, 0, m_count, options.threads, [&](size_t i0, size_t i1, int) {
+        for (size_t i = i0; i < i1; ++i) {
+            if (!GvLoadImageFile(fileNames[i].c_str(), m_images[i])) {
+                errors[i] = GvGetLastHelperErrorMessage();
+            }
+        }
+    });
+    for (size_t i = 0; i < m_count; ++i) {
+        if (!errors[i].empty()) {
+            detail::GvSetLastHelperError("GvImageBatchLoader::Load: " + fileNames[i] + ": " + errors[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+void GvImageBatchLoader::Release() {
+    std::vector<GvImageBuffer>().swap(m_images);
+    m_count = 0;
+}
+
+}  // namespace gv
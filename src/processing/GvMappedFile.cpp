@@ -0,0 +1,168 @@
+#include "GvMappedFile.h"
+
+#include "GvPageSize.h"
+
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gv {
+
+namespace detail {
+
+struct GvMappedRegion {
+    GvMappedRegion() = default;
+    GvMappedRegion(const GvMappedRegion&) = delete;
+    GvMappedRegion& operator=(const GvMappedRegion&) = delete;
+
+    ~GvMappedRegion() {
+#if defined(_WIN32)
+        if (data != nullptr) {
+            ::UnmapViewOfFile(data);
+        }
+#else
+        if (data != nullptr) {
+            ::munmap(data, static_cast<size_t>(size));
+        }
+#endif
+    }
+
+    unsigned char* data = nullptr;
+    uint64_t size = 0;
+    GvMappedFileMode::Enum mode = GvMappedFileMode::ReadOnly;
+};
+
+}  // namespace detail
+
+bool GvMappedFile::Open(const char* fileName, GvMappedFileMode::Enum mode) {
+    Close();
+    if (fileName == nullptr) {
+        detail::GvSetLastHelperError("GvMappedFile::Open: invalid arguments");
+        return false;
+    }
+    const auto fail = [&](const char* reason) {
+        detail::GvSetLastHelperError(std::string("GvMappedFile::Open: ") + reason + ": " + fileName);
+        return false;
+    };
+    std::shared_ptr<detail::GvMappedRegion> region = std::make_shared<detail::GvMappedRegion>();
+    region->mode = mode;
+
+#if defined(_WIN32)
+    HANDLE file = ::CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return fail("cannot open");
+    }
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(file, &fileSize)) {
+        ::CloseHandle(file);
+        return fail("cannot get file size");
+    }
+    region->size = static_cast<uint64_t>(fileSize.QuadPart);
+    if (region->size > 0) {
+        HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            const DWORD access = mode == GvMappedFileMode::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ;
+            region->data = static_cast<unsigned char*>(::MapViewOfFile(mapping, access, 0, 0, 0));
+            // 뷰가 매핑 객체 참조를 유지하므로 핸들은 바로 닫는다.
+            ::CloseHandle(mapping);
+        }
+    }
+    ::CloseHandle(file);
+#else
+    const int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0) {
+        return fail("cannot open");
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return fail("cannot get file size");
+    }
+    region->size = static_cast<uint64_t>(st.st_size);
+    if (region->size > 0) {
+        const int prot = mode == GvMappedFileMode::CopyOnWrite ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* data = ::mmap(nullptr, static_cast<size_t>(region->size), prot, MAP_PRIVATE, fd, 0);
+        region->data = data == MAP_FAILED ? nullptr : static_cast<unsigned char*>(data);
+    }
+    ::close(fd);
+#endif
+    if (region->size > 0 && region->data == nullptr) {
+        return fail("cannot map file");
+    }
+    m_region = std::move(region);
+    return true;
+}
+
+void GvMappedFile::Close() {
+    m_region.reset();
+}
+
+GvMappedFileMode::Enum GvMappedFile::GetMode() const {
+    return m_region ? m_region->mode : GvMappedFileMode::ReadOnly;
+}
+
+const unsigned char* GvMappedFile::GetData() const {
+    return m_region ? m_region->data : nullptr;
+}
+
+unsigned char* GvMappedFile::GetMutableData() const {
+    return m_region && m_region->mode == GvMappedFileMode::CopyOnWrite ? m_region->data : nullptr;
+}
+
+uint64_t GvMappedFile::GetSize() const {
+    return m_region ? m_region->size : 0;
+}
+
+void GvMappedFile::Advise(GvMappedFileAccess::Enum access) const {
+#if defined(_WIN32)
+    (void)access;
+#else
+    if (!m_region || m_region->data == nullptr) {
+        return;
+    }
+    int advice = MADV_NORMAL;
+    if (access == GvMappedFileAccess::Sequential) {
+        advice = MADV_SEQUENTIAL;
+    } else if (access == GvMappedFileAccess::Random) {
+        advice = MADV_RANDOM;
+    }
+    ::madvise(m_region->data, static_cast<size_t>(m_region->size), advice);
+#endif
+}
+
+void GvMappedFile::Prefetch(uint64_t offset, uint64_t bytes) const {
+    if (!m_region || m_region->data == nullptr || offset >= m_region->size) {
+        return;
+    }
+    if (bytes > m_region->size - offset) {
+        bytes = m_region->size - offset;
+    }
+#if defined(_WIN32)
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = m_region->data + offset;
+    range.NumberOfBytes = static_cast<SIZE_T>(bytes);
+    ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+#endif
+#else
+    // madvise 시작 주소는 페이지 경계여야 한다.
+    const uint64_t begin = offset - offset % detail::GvPageSize();
+    ::madvise(m_region->data + begin, static_cast<size_t>(offset + bytes - begin), MADV_WILLNEED);
+#endif
+}
+
+}  // namespace gv
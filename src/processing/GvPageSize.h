@@ -0,0 +1,14 @@
+#pragma once
+
+// Processing 라이브러리 내부용 페이지 크기 조회. 공개 헤더가 아니다.
+
+#include <cstddef>
+
+namespace gv {
+namespace detail {
+
+/** @brief 시스템 페이지 크기(bytes). 처음 호출할 때 한 번 조회한다. */
+size_t GvPageSize();
+
+}  // namespace detail
+}  // namespace gv
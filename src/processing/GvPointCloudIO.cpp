@@ -0,0 +1,240 @@
+#include "GvPointCloudIO.h"
+
+#include "GvParallel.h"
+#include "GvPlatform.h"
+#include "GvTrace.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace gv {
+
+namespace {
+
+constexpr size_t kDefaultChunkPoints = 256u * 1024u;
+
+struct RecordLayout {
+    GvPointCloudFormat::Enum format;
+    size_t scalarBytes;
+    size_t colorBytes;
+    size_t stride;
+};
+
+RecordLayout makeLayout(const GvPointCloudWriteOptions& options, bool withColor) {
+    RecordLayout layout;
+    layout.format = options.format;
+    layout.scalarBytes = options.scalar == GvPointCloudScalar::Float64 ? sizeof(double) : sizeof(float);
+    layout.colorBytes = withColor ? (options.format == GvPointCloudFormat::Pcd ? 4 : 3) : 0;
+    layout.stride = layout.scalarBytes * 3 + layout.colorBytes;
+    return layout;
+}
+
+inline void textureColor(const unsigned char* texture, GvImageType::Enum type, size_t index, unsigned char* rgb) {
+    switch (type) {
+        case GvImageType::Mono8:
+            rgb[0] = rgb[1] = rgb[2] = texture[index];
+            break;
+        case GvImageType::RGB8:
+            std::memcpy(rgb, texture + index * 3, 3);
+            break;
+        case GvImageType::BGR8:
+            rgb[0] = texture[index * 3 + 2];
+            rgb[1] = texture[index * 3 + 1];
+            rgb[2] = texture[index * 3];
+            break;
+        default:
+            rgb[0] = rgb[1] = rgb[2] = 0;
+            break;
+    }
+}
+
+template <typename Scalar>
+unsigned char* formatRange(unsigned char* out, const double* points, size_t begin, size_t end, double scale,
+                           bool skipInvalid, const unsigned char* texture, GvImageType::Enum textureType,
+                           const RecordLayout& layout) {
+    for (size_t i = begin; i < end; ++i) {
+        const double* p = points + i * 3;
+        if (skipInvalid && p[2] != p[2]) {
+            continue;
+        }
+        const Scalar xyz[3] = {static_cast<Scalar>(p[0] * scale), static_cast<Scalar>(p[1] * scale),
+                               static_cast<Scalar>(p[2] * scale)};
+        std::memcpy(out, xyz, sizeof(xyz));
+        out += sizeof(xyz);
+        if (layout.colorBytes != 0) {
+            unsigned char rgb[3];
+            textureColor(texture, textureType, i, rgb);
+            if (layout.format == GvPointCloudFormat::Pcd) {
+                const uint32_t packed = (static_cast<uint32_t>(rgb[0]) << 16) | (static_cast<uint32_t>(rgb[1]) << 8) |
+                                        static_cast<uint32_t>(rgb[2]);
+                std::memcpy(out, &packed, sizeof(packed));
+            } else {
+                std::memcpy(out, rgb, 3);
+            }
+            out += layout.colorBytes;
+        }
+    }
+    return out;
+}
+
+std::string makeHeader(const GvPointCloudWriteOptions& options, const RecordLayout& layout, const GvSize& size,
+                       size_t pointCount) {
+    const bool f64 = layout.scalarBytes == sizeof(double);
+    std::string header;
+    if (options.format == GvPointCloudFormat::Pcd) {
+        const std::string s = std::to_string(layout.scalarBytes);
+        const bool organized = !options.skip_invalid;
+        header = "# .PCD v0.7 - Point Cloud Data file format\nVERSION 0.7\n";
+        header += layout.colorBytes ? "FIELDS x y z rgb\n" : "FIELDS x y z\n";
+        header += "SIZE " + s + " " + s + " " + s + (layout.colorBytes ? " 4\n" : "\n");
+        header += layout.colorBytes ? "TYPE F F F U\nCOUNT 1 1 1 1\n" : "TYPE F F F\nCOUNT 1 1 1\n";
+        header += "WIDTH " + std::to_string(organized ? static_cast<size_t>(size.width) : pointCount) + "\n";
+        header += "HEIGHT " + std::to_string(organized ? size.height : 1) + "\n";
+        header += "VIEWPOINT 0 0 0 1 0 0 0\nPOINTS " + std::to_string(pointCount) + "\nDATA binary\n";
+    } else {
+        const char* type = f64 ? "double" : "float";
+        header = "ply\nformat binary_little_endian 1.0\nelement vertex " + std::to_string(pointCount) + "\n";
+        header += std::string("property ") + type + " x\nproperty " + type + " y\nproperty " + type + " z\n";
+        if (layout.colorBytes) {
+            header += "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+        }
+        header += "end_header\n";
+    }
+    return header;
+}
+
+bool writeAll(FILE* fp, const unsigned char* data, size_t bytes) {
+    return bytes == 0 || std::fwrite(data, 1, bytes, fp) == bytes;
+}
+
+}  // namespace
+
+bool GvSavePointCloud(const char* fileName, const double* points, const GvSize& size, const unsigned char* texture,
+                      GvImageType::Enum textureType, const GvPointCloudWriteOptions& options) {
+    GV_TRACE_SCOPE("GvSavePointCloud", "io");
+    if (fileName == nullptr || points == nullptr || size.width <= 0 || size.height <= 0) {
+        detail::GvSetLastHelperError("GvSavePointCloud: invalid arguments");
+        return false;
+    }
+    const bool withColor = texture != nullptr;
+    if (withColor && GvImageBufferPixelSize(textureType) == 0) {
+        detail::GvSetLastHelperError("GvSavePointCloud: texture must be Mono8, RGB8 or BGR8");
+        return false;
+    }
+    const RecordLayout layout = makeLayout(options, withColor);
+    const double scale = options.unit == GvPointMapUnit::Millimeter ? 1000.0 : 1.0;
+    const size_t count = static_cast<size_t>(size.width) * static_cast<size_t>(size.height);
+    const size_t chunkPoints = options.chunk_points > 0 ? options.chunk_points : kDefaultChunkPoints;
+    const size_t chunkCount = (count + chunkPoints - 1) / chunkPoints;
+    const int threads = GvResolveThreadCount(options.threads, chunkCount, ThreadSubsystem_IO);
+
+    // [1] 구간별 저장 포인트 수(헤더의 포인트 수와 구간 출력 위치 계산용)
+    std::vector<size_t> chunkValid(chunkCount, 0);
+    GvParallelFor(ThreadSubsystem_IO, 0, chunkCount, threads, [&](size_t c0, size_t c1, int) {
+        for (size_t c = c0; c < c1; ++c) {
+            const size_t begin = c * chunkPoints;
+            const size_t end = std::min(begin + chunkPoints, count);
+            size_t valid = end - begin;
+            if (options.skip_invalid) {
+                valid = 0;
+                for (size_t i = begin; i < end; ++i) {
+                    valid += points[i * 3 + 2] == points[i * 3 + 2] ? 1 : 0;
+                }
+            }
+            chunkValid[c] = valid;
+        }
+    });
+    size_t total = 0;
+    for (size_t valid : chunkValid) {
+        total += valid;
+    }
+
+    FILE* fp = std::fopen(fileName, "wb");
+    if (fp == nullptr) {
+        detail::GvSetLastHelperError(std::string("GvSavePointCloud: cannot open ") + fileName);
+        return false;
+    }
+    // 구간 버퍼를 직접 크게 쓰므로 stdio 버퍼링은 끈다.
+    std::setvbuf(fp, nullptr, _IONBF, 0);
+    const std::string header = makeHeader(options, layout, size, total);
+    bool ok = writeAll(fp, reinterpret_cast<const unsigned char*>(header.data()), header.size());
+
+    // [2] 구간 묶음(batch) 단위 직렬화 + 이전 묶음 쓰기를 겹쳐 실행
+    const size_t batchChunks = static_cast<size_t>(threads) * 2;
+    std::vector<unsigned char> buffers[2];
+    std::vector<size_t> offsets(batchChunks + 1, 0);
+    std::future<bool> pendingWrite;
+    int slot = 0;
+    for (size_t batchBegin = 0; ok && batchBegin < chunkCount; batchBegin += batchChunks) {
+        const size_t batchEnd = std::min(batchBegin + batchChunks, chunkCount);
+        offsets[0] = 0;
+        for (size_t c = batchBegin; c < batchEnd; ++c) {
+            offsets[c - batchBegin + 1] = offsets[c - batchBegin] + chunkValid[c] * layout.stride;
+        }
+        std::vector<unsigned char>& buffer = buffers[slot];
+        buffer.resize(offsets[batchEnd - batchBegin]);
+
+        GvParallelFor(ThreadSubsystem_IO, batchBegin, batchEnd, threads, [&](size_t c0, size_t c1, int) {
+            for (size_t c = c0; c < c1; ++c) {
+                const size_t begin = c * chunkPoints;
+                const size_t end = std::min(begin + chunkPoints, count);
+                unsigned char* out = buffer.data() + offsets[c - batchBegin];
+                if (layout.scalarBytes == sizeof(double)) {
+                    formatRange<double>(out, points, begin, end, scale, options.skip_invalid, texture, textureType,
+                                        layout);
+                } else {
+                    formatRange<float>(out, points, begin, end, scale, options.skip_invalid, texture, textureType,
+                                       layout);
+                }
+            }
+        });
+
+        if (pendingWrite.valid()) {
+            ok = pendingWrite.get();
+        }
+        if (ok) {
+            pendingWrite = std::async(std::launch::async, [fp, &buffer]() {
+                return writeAll(fp, buffer.data(), buffer.size());
+            });
+        }
+        slot ^= 1;
+    }
+    if (pendingWrite.valid()) {
+        ok = pendingWrite.get() && ok;
+    }
+    ok = std::fclose(fp) == 0 && ok;
+    if (!ok) {
+        detail::GvSetLastHelperError(std::string("GvSavePointCloud: write failed: ") + fileName);
+    }
+    return ok;
+}
+
+bool GvSavePointCloud(const char* fileName, const GvPointMapBuffer& points, const GvImageBuffer* texture,
+                      const GvPointCloudWriteOptions& options) {
+    if (!points.IsValid()) {
+        detail::GvSetLastHelperError("GvSavePointCloud: invalid point map");
+        return false;
+    }
+    const bool withColor = texture != nullptr && texture->IsValid();
+    if (withColor && texture->GetSize() != points.GetSize()) {
+        detail::GvSetLastHelperError("GvSavePointCloud: texture size does not match the point map");
+        return false;
+    }
+    return GvSavePointCloud(fileName, points.GetPointDataConstPtr(), points.GetSize(),
+                            withColor ? texture->GetDataConstPtr() : nullptr,
+                            withColor ? texture->GetType() : GvImageType::None, options);
+}
+
+bool GvSavePointMapPly(const char* fileName, const GvPointMapBuffer& points, const GvImageBuffer* texture,
+                       GvPointMapUnit::Enum unit) {
+    GvPointCloudWriteOptions options;
+    options.unit = unit;
+    return GvSavePointCloud(fileName, points, texture, options);
+}
+
+}  // namespace gv
@@ -0,0 +1,276 @@
+#include "GvRealtimeDispatch.h"
+
+#include "GvPageSize.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace gv {
+
+namespace {
+
+// 첫 프레임 전에 미리 접근할 스택 크기. 콜백이 이보다 깊은 스택을 쓰면 그 부분은 처음 접근할 때 폴트가 난다.
+constexpr size_t kStackPrefaultBytes = 64 * 1024;
+constexpr int kHighNice = -10;
+
+void prefaultStack() {
+    unsigned char stack[kStackPrefaultBytes];
+    volatile unsigned char* touch = stack;
+    const size_t page = detail::GvPageSize();
+    for (size_t i = 0; i < kStackPrefaultBytes; i += page) {
+        touch[i] = 0;
+    }
+}
+
+#if !defined(_WIN32)
+std::string errnoMessage(const char* what, int error) {
+    return std::string(what) + " failed: " + std::strerror(error);
+}
+
+pid_t currentTid() {
+    return static_cast<pid_t>(::syscall(SYS_gettid));
+}
+#endif
+
+}  // namespace
+
+const char* GvThreadPriority::ToString(GvThreadPriority::Enum priority) {
+    switch (priority) {
+        case Normal: return "Normal";
+        case High: return "High";
+        case Realtime: return "Realtime";
+        default: return "Unknown";
+    }
+}
+
+bool GvSetCurrentThreadPriority(GvThreadPriority::Enum priority, int realtime_priority) {
+#if defined(_WIN32)
+    int value = THREAD_PRIORITY_NORMAL;
+    if (priority == GvThreadPriority::High) {
+        value = THREAD_PRIORITY_HIGHEST;
+    } else if (priority == GvThreadPriority::Realtime) {
+        value = THREAD_PRIORITY_TIME_CRITICAL;
+    }
+    if (!::SetThreadPriority(::GetCurrentThread(), value)) {
+        detail::GvSetLastHelperError("SetThreadPriority failed: " + std::to_string(::GetLastError()));
+        return false;
+    }
+    return true;
+#else
+    sched_param param{};
+    if (priority == GvThreadPriority::Realtime) {
+        const int low = ::sched_get_priority_min(SCHED_FIFO);
+        const int high = ::sched_get_priority_max(SCHED_FIFO);
+        param.sched_priority = realtime_priority > 0 ? std::min(std::max(realtime_priority, low), high)
+                                                     : (low + high) / 2;
+        const int rc = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param);
+        if (rc != 0) {
+            detail::GvSetLastHelperError(errnoMessage("pthread_setschedparam(SCHED_FIFO)", rc) +
+                                         " (requires CAP_SYS_NICE or RLIMIT_RTPRIO)");
+            return false;
+        }
+        return true;
+    }
+    // Normal/High: 일반 스케줄러로 돌아가 nice 값으로 구분한다(Linux에서 nice는 스레드 단위).
+    const int rc = ::pthread_setschedparam(::pthread_self(), SCHED_OTHER, &param);
+    if (rc != 0) {
+        detail::GvSetLastHelperError(errnoMessage("pthread_setschedparam(SCHED_OTHER)", rc));
+        return false;
+    }
+    const int nice = priority == GvThreadPriority::High ? kHighNice : 0;
+    if (::setpriority(PRIO_PROCESS, static_cast<id_t>(currentTid()), nice) != 0) {
+        detail::GvSetLastHelperError(errnoMessage("setpriority", errno) + " (requires CAP_SYS_NICE or RLIMIT_NICE)");
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool GvGetCurrentThreadPriority(GvThreadPriorityState& state) {
+    state = GvThreadPriorityState();
+#if defined(_WIN32)
+    const int value = ::GetThreadPriority(::GetCurrentThread());
+    if (value == THREAD_PRIORITY_ERROR_RETURN) {
+        detail::GvSetLastHelperError("GetThreadPriority failed: " + std::to_string(::GetLastError()));
+        return false;
+    }
+    state.priority = value;
+#else
+    sched_param param{};
+    const int rc = ::pthread_getschedparam(::pthread_self(), &state.policy, &param);
+    if (rc != 0) {
+        detail::GvSetLastHelperError(errnoMessage("pthread_getschedparam", rc));
+        return false;
+    }
+    state.priority = param.sched_priority;
+    errno = 0;
+    state.nice = ::getpriority(PRIO_PROCESS, static_cast<id_t>(currentTid()));
+    if (errno != 0) {
+        detail::GvSetLastHelperError(errnoMessage("getpriority", errno));
+        return false;
+    }
+#endif
+    state.valid = true;
+    return true;
+}
+
+bool GvRestoreCurrentThreadPriority(const GvThreadPriorityState& state) {
+    if (!state.valid) {
+        detail::GvSetLastHelperError("GvRestoreCurrentThreadPriority: invalid state");
+        return false;
+    }
+#if defined(_WIN32)
+    if (!::SetThreadPriority(::GetCurrentThread(), state.priority)) {
+        detail::GvSetLastHelperError("SetThreadPriority failed: " + std::to_string(::GetLastError()));
+        return false;
+    }
+#else
+    sched_param param{};
+    param.sched_priority = state.priority;
+    const int rc = ::pthread_setschedparam(::pthread_self(), state.policy, &param);
+    if (rc != 0) {
+        detail::GvSetLastHelperError(errnoMessage("pthread_setschedparam", rc));
+        return false;
+    }
+    if (::setpriority(PRIO_PROCESS, static_cast<id_t>(currentTid()), state.nice) != 0) {
+        detail::GvSetLastHelperError(errnoMessage("setpriority", errno));
+        return false;
+    }
+#endif
+    return true;
+}
+
+bool GvPrepareRealtimeThread(GvThreadPriority::Enum priority, int realtime_priority) {
+    prefaultStack();
+    return GvSetCurrentThreadPriority(priority, realtime_priority);
+}
+
+bool GvLockProcessMemory() {
+#if defined(_WIN32)
+    detail::GvSetLastHelperError("GvLockProcessMemory: not supported on Windows (use GvLockedBuffer)");
+    return false;
+#else
+    if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        detail::GvSetLastHelperError(errnoMessage("mlockall", errno) + " (check RLIMIT_MEMLOCK)");
+        return false;
+    }
+    return true;
+#endif
+}
+
+void GvUnlockProcessMemory() {
+#if !defined(_WIN32)
+    ::munlockall();
+#endif
+}
+
+GvLockedBuffer::~GvLockedBuffer() {
+    Release();
+}
+
+GvLockedBuffer::GvLockedBuffer(GvLockedBuffer&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_bytes(std::exchange(other.m_bytes, 0)),
+      m_mapped(std::exchange(other.m_mapped, 0)),
+      m_locked(std::exchange(other.m_locked, false)) {}
+
+GvLockedBuffer& GvLockedBuffer::operator=(GvLockedBuffer&& other) noexcept {
+    if (this != &other) {
+        Release();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_bytes = std::exchange(other.m_bytes, 0);
+        m_mapped = std::exchange(other.m_mapped, 0);
+        m_locked = std::exchange(other.m_locked, false);
+    }
+    return *this;
+}
+
+bool GvLockedBuffer::Allocate(size_t bytes) {
+    Release();
+    if (bytes == 0) {
+        detail::GvSetLastHelperError("GvLockedBuffer::Allocate: empty buffer");
+        return false;
+    }
+    // [1] 페이지 단위로 할당(운영체제가 0으로 채운 페이지)
+    const size_t page = detail::GvPageSize();
+    const size_t mapped = (bytes + page - 1) / page * page;
+#if defined(_WIN32)
+    void* data = ::VirtualAlloc(nullptr, mapped, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (data == nullptr) {
+        detail::GvSetLastHelperError("VirtualAlloc failed: " + std::to_string(::GetLastError()));
+        return false;
+    }
+#else
+    void* data = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
+        detail::GvSetLastHelperError(errnoMessage("mmap", errno));
+        return false;
+    }
+#endif
+    m_data = static_cast<unsigned char*>(data);
+    m_bytes = bytes;
+    m_mapped = mapped;
+
+    // [2] 페이지마다 기록해 실제 메모리를 할당받는다(pre-fault).
+    for (size_t i = 0; i < mapped; i += page) {
+        static_cast<volatile unsigned char*>(data)[i] = 0;
+    }
+
+    // [3] 고정. 실패해도 버퍼는 유지한다.
+#if defined(_WIN32)
+    m_locked = ::VirtualLock(data, mapped) != 0;
+    if (!m_locked) {
+        detail::GvSetLastHelperError("VirtualLock failed: " + std::to_string(::GetLastError()) +
+                                     " (working set too small?)");
+    }
+#else
+    m_locked = ::mlock(data, mapped) == 0;
+    if (!m_locked) {
+        detail::GvSetLastHelperError(errnoMessage("mlock", errno) + " (check RLIMIT_MEMLOCK)");
+    }
+#endif
+    return true;
+}
+
+void GvLockedBuffer::Release() {
+    if (m_data == nullptr) {
+        return;
+    }
+#if defined(_WIN32)
+    if (m_locked) {
+        ::VirtualUnlock(m_data, m_mapped);
+    }
+    ::VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+    if (m_locked) {
+        ::munlock(m_data, m_mapped);
+    }
+    ::munmap(m_data, m_mapped);
+#endif
+    m_data = nullptr;
+    m_bytes = 0;
+    m_mapped = 0;
+    m_locked = false;
+}
+
+}  // namespace gv
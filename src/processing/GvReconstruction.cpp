@@ -0,0 +1,183 @@
+#include "GvReconstruction.h"
+
+#include "GvParallel.h"
+#include "GvPlatform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gv {
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+
+bool checkModel(const GvStructuredLightModel& model) {
+    return model.camera_resolution.width > 0 && model.camera_resolution.height > 0 && model.camera_fx > 0.0 &&
+           model.camera_fy > 0.0 && model.projector_width > 1 && model.projector_fx > 0.0 && model.baseline > 0.0 &&
+           model.phase_period >= 2 && model.phase_steps >= 3 && model.gray_bits > 0 && model.gray_bits < 31;
+}
+
+}  // namespace
+
+int GvStructuredLightPhaseSteps(GvCaptureMode mode) {
+    switch (mode) {
+        case CaptureMode_Fast: return 3;
+        case CaptureMode_Ultra: return 6;
+        case CaptureMode_Normal:
+        case CaptureMode_AntiInterReflection: return 4;
+        default: return 0;
+    }
+}
+
+int GvStructuredLightGrayBits(int projector_width, int phase_period) {
+    const int halfPeriod = std::max(phase_period / 2, 1);
+    const int codes = (std::max(projector_width, 1) + halfPeriod - 1) / halfPeriod;
+    int bits = 1;
+    while ((1 << bits) < codes) {
+        ++bits;
+    }
+    return bits;
+}
+
+int GvStructuredLightPatternCount(const GvStructuredLightModel& model) {
+    if (model.gray_bits <= 0 || model.phase_steps < 3) {
+        return 0;
+    }
+    return 2 + model.gray_bits + model.phase_steps;
+}
+
+void GvStructuredLightEncodeColumn(const GvStructuredLightModel& model, double column, double* pattern) {
+    const int count = GvStructuredLightPatternCount(model);
+    std::fill(pattern, pattern + count, 0.0);
+    if (count == 0 || column < 0.0 || column > model.projector_width - 1) {
+        return;
+    }
+    const double period = model.phase_period;
+    const double halfPeriod = std::max(period / 2.0, 1.0);
+    const uint32_t h = static_cast<uint32_t>(column / halfPeriod);
+    const uint32_t gray = h ^ (h >> 1);
+    pattern[0] = 1.0;
+    for (int b = 0; b < model.gray_bits; ++b) {
+        pattern[2 + b] = static_cast<double>((gray >> (model.gray_bits - 1 - b)) & 1u);
+    }
+    for (int n = 0; n < model.phase_steps; ++n) {
+        pattern[2 + model.gray_bits + n] =
+            0.5 + 0.5 * std::cos(kTwoPi * column / period - kTwoPi * n / model.phase_steps);
+    }
+}
+
+bool GvDecodeStructuredLight(const GvImageBuffer* patterns, size_t count, const GvStructuredLightModel& model,
+                             const GvStructuredLightDecodeOptions& options, GvPointMapBuffer& points,
+                             GvConfidenceMapBuffer& confidence) {
+    if (!checkModel(model)) {
+        detail::GvSetLastHelperError("GvDecodeStructuredLight: invalid structured-light model");
+        return false;
+    }
+    const GvSize size = model.camera_resolution;
+    if (patterns == nullptr || count != static_cast<size_t>(GvStructuredLightPatternCount(model))) {
+        detail::GvSetLastHelperError("GvDecodeStructuredLight: expected " +
+                                     std::to_string(GvStructuredLightPatternCount(model)) + " patterns, got " +
+                                     std::to_string(count));
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (!patterns[i].IsValid() || patterns[i].GetType() != GvImageType::Mono8 || patterns[i].GetSize() != size) {
+            detail::GvSetLastHelperError("GvDecodeStructuredLight: pattern " + std::to_string(i) +
+                                         " is not a Mono8 image of the camera resolution");
+            return false;
+        }
+    }
+    if (!points.IsValid() || points.GetSize() != size) {
+        points = GvPointMapBuffer::Create(size);
+    }
+    if (!confidence.IsValid() || confidence.GetSize() != size) {
+        confidence = GvConfidenceMapBuffer::Create(size);
+    }
+
+    const int bits = model.gray_bits;
+    const int steps = model.phase_steps;
+    const double period = model.phase_period;
+    std::vector<double> sinTable(static_cast<size_t>(steps));
+    std::vector<double> cosTable(static_cast<size_t>(steps));
+    for (int n = 0; n < steps; ++n) {
+        sinTable[static_cast<size_t>(n)] = std::sin(kTwoPi * n / steps);
+        cosTable[static_cast<size_t>(n)] = std::cos(kTwoPi * n / steps);
+    }
+    std::vector<const unsigned char*> planes(count);
+    for (size_t i = 0; i < count; ++i) {
+        planes[i] = patterns[i].GetDataConstPtr();
+    }
+    double* pts = points.GetPointDataPtr();
+    double* conf = confidence.GetDataPtr();
+
+    GvParallelFor(ThreadSubsystem_Decode, 0, static_cast<size_t>(size.height), options.threads,
+                  [&](size_t r0, size_t r1, int) {
+        for (size_t v = r0; v < r1; ++v) {
+            const double ry = (static_cast<double>(v) - model.camera_cy) / model.camera_fy;
+            for (int u = 0; u < size.width; ++u) {
+                const size_t i = v * static_cast<size_t>(size.width) + static_cast<size_t>(u);
+                const double white = planes[0][i];
+                const double black = planes[1][i];
+                const double contrast = white - black;
+                if (contrast < options.contrast_threshold || white >= 255.0) {
+                    continue;
+                }
+                const double threshold = 0.5 * (white + black);
+                uint32_t gray = 0;
+                for (int k = 0; k < bits; ++k) {
+                    gray = (gray << 1) | (planes[static_cast<size_t>(2 + k)][i] > threshold ? 1u : 0u);
+                }
+                uint32_t half = gray;
+                for (uint32_t shift = gray >> 1; shift != 0; shift >>= 1) {
+                    half ^= shift;
+                }
+                double s = 0.0;
+                double c = 0.0;
+                for (int n = 0; n < steps; ++n) {
+                    const double value = planes[static_cast<size_t>(2 + bits + n)][i];
+                    s += value * sinTable[static_cast<size_t>(n)];
+                    c += value * cosTable[static_cast<size_t>(n)];
+                }
+                const double amplitude = 2.0 / steps * std::sqrt(s * s + c * c);
+                const double quality = std::min(amplitude / (0.5 * contrast), 1.0) * std::min(contrast / 64.0, 1.0);
+                if (quality <= conf[i]) {
+                    continue;
+                }
+                double frac = std::atan2(s, c) / kTwoPi;
+                frac -= std::floor(frac);
+                // 반주기 Gray code로 위상 경계의 주기 번호 오차를 보정한다.
+                int64_t periodIndex = static_cast<int64_t>(half / 2);
+                if ((half & 1u) != 0 && frac < 0.25) {
+                    periodIndex = static_cast<int64_t>((half + 1) / 2);
+                } else if ((half & 1u) == 0 && frac > 0.75) {
+                    periodIndex = static_cast<int64_t>(half / 2) - 1;
+                }
+                const double column = (static_cast<double>(periodIndex) + frac) * period;
+                if (column < 0.0 || column > model.projector_width - 1) {
+                    continue;
+                }
+                // 카메라 광선과 프로젝터 column 평면의 교점
+                const double rx = (u - model.camera_cx) / model.camera_fx;
+                const double denom = rx - (column - model.projector_cx) / model.projector_fx;
+                if (std::fabs(denom) < 1e-12) {
+                    continue;
+                }
+                const double z = model.baseline / denom;
+                if (z <= 0.0) {
+                    continue;
+                }
+                pts[i * 3] = rx * z;
+                pts[i * 3 + 1] = ry * z;
+                pts[i * 3 + 2] = z;
+                conf[i] = quality;
+            }
+        }
+    });
+    return true;
+}
+
+}  // namespace gv
@@ -0,0 +1,540 @@
+#include "GvSequence.h"
+
+#include "GvPlatform.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace gv {
+
+namespace {
+
+constexpr uint32_t kFileMagic = 0x51535647u;    // "GVSQ"
+constexpr uint32_t kRecordMagic = 0x52465647u;  // "GVFR"
+constexpr uint32_t kFooterMagic = 0x45535647u;  // "GVSE"
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint64_t kFileHeaderBytes = 16;
+constexpr uint64_t kFooterBytes = 16;
+constexpr uint64_t kIndexEntryBytes = 16;
+constexpr uint32_t kMinAlignment = 64;
+
+// 프레임 레코드 고정부:
+// magic u32, header_bytes u32, record_bytes u64, frame_id u64, timestamp_ns u64, sn[64],
+// payload_count u32, options_bytes u32
+constexpr uint64_t kRecordFixedBytes = 104;
+// 데이터 기술자: type u32, image_type u32, width i32, height i32, offset u64(레코드 시작 기준), bytes u64
+constexpr uint64_t kDescriptorBytes = 32;
+
+static_assert(std::is_trivially_copyable<GvSingle::GvCaptureOptions>::value,
+              "capture options are stored as raw bytes");
+
+template <typename T>
+void append(std::vector<uint8_t>& out, T value) {
+    const size_t pos = out.size();
+    out.resize(pos + sizeof(T));
+    std::memcpy(out.data() + pos, &value, sizeof(T));
+}
+
+template <typename T>
+T load(const unsigned char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+bool writeBytes(FILE* fp, const void* data, size_t bytes) {
+    return bytes == 0 || std::fwrite(data, 1, bytes, fp) == bytes;
+}
+
+inline uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+inline bool isValidAlignment(uint32_t alignment) {
+    return alignment >= kMinAlignment && (alignment & (alignment - 1)) == 0;
+}
+
+uint64_t payloadBytes(GvSequencePayloadType::Enum type, GvImageType::Enum imageType, const GvSize& size) {
+    if (size.width <= 0 || size.height <= 0) {
+        return 0;
+    }
+    const uint64_t pixels = static_cast<uint64_t>(size.width) * static_cast<uint64_t>(size.height);
+    switch (type) {
+        case GvSequencePayloadType::PointMap: return pixels * 3 * sizeof(double);
+        case GvSequencePayloadType::DepthMap:
+        case GvSequencePayloadType::ConfidenceMap: return pixels * sizeof(double);
+        case GvSequencePayloadType::Image: return pixels * GvImageBufferPixelSize(imageType);
+        case GvSequencePayloadType::Blob: return pixels;
+        default: return 0;
+    }
+}
+
+GvSequencePayload makePayload(GvSequencePayloadType::Enum type, GvImageType::Enum imageType, const void* data,
+                              const GvSize& size) {
+    GvSequencePayload payload;
+    payload.type = type;
+    payload.image_type = imageType;
+    payload.size = size;
+    payload.data = data;
+    payload.bytes = payloadBytes(type, imageType, size);
+    return payload;
+}
+
+/**
+ * @brief 매핑된 파일에서 프레임 색인을 읽는다. footer가 없으면 프레임 레코드를 따라가며 복구한다.
+ * @param dataEnd 마지막 프레임 레코드의 끝(색인 시작 위치).
+ */
+bool loadIndex(const GvMappedFile& file, std::vector<detail::GvSequenceIndexEntry>& index, uint32_t& alignment,
+               uint64_t& dataEnd, bool& recovered, std::string& reason) {
+    const unsigned char* data = file.GetData();
+    const uint64_t size = file.GetSize();
+    index.clear();
+    recovered = false;
+    if (size < kFileHeaderBytes || load<uint32_t>(data) != kFileMagic) {
+        reason = "not a GvSequence file";
+        return false;
+    }
+    if (load<uint32_t>(data + 4) != kFormatVersion) {
+        reason = "unsupported format version";
+        return false;
+    }
+    alignment = load<uint32_t>(data + 8);
+    if (!isValidAlignment(alignment)) {
+        reason = "corrupt file header";
+        return false;
+    }
+
+    // [1] footer 색인
+    if (size >= alignment + kFooterBytes) {
+        const unsigned char* footer = data + size - kFooterBytes;
+        const uint64_t indexOffset = load<uint64_t>(footer);
+        const uint32_t count = load<uint32_t>(footer + 8);
+        if (load<uint32_t>(footer + 12) == kFooterMagic && indexOffset >= alignment &&
+            indexOffset % alignment == 0 &&
+            indexOffset + static_cast<uint64_t>(count) * kIndexEntryBytes + kFooterBytes == size) {
+            index.resize(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                const unsigned char* entry = data + indexOffset + i * kIndexEntryBytes;
+                index[i].offset = load<uint64_t>(entry);
+                index[i].timestamp_ns = load<uint64_t>(entry + 8);
+                if (index[i].offset < alignment || index[i].offset + kRecordFixedBytes > indexOffset ||
+                    (i > 0 && index[i].offset <= index[i - 1].offset)) {
+                    index.clear();
+                    reason = "corrupt index";
+                    return false;
+                }
+            }
+            dataEnd = indexOffset;
+            return true;
+        }
+    }
+
+    // [2] 색인 없음(기록 중단): 완전한 프레임 레코드까지만 복구
+    recovered = true;
+    uint64_t offset = alignment;
+    while (offset + kRecordFixedBytes <= size) {
+        const unsigned char* record = data + offset;
+        const uint64_t headerBytes = load<uint32_t>(record + 4);
+        const uint64_t recordBytes = load<uint64_t>(record + 8);
+        if (load<uint32_t>(record) != kRecordMagic || headerBytes < kRecordFixedBytes || recordBytes < headerBytes ||
+            recordBytes % alignment != 0 || recordBytes > size - offset) {
+            break;
+        }
+        index.push_back({offset, load<uint64_t>(record + 24)});
+        offset += recordBytes;
+    }
+    dataEnd = offset;
+    return true;
+}
+
+}  // namespace
+
+uint64_t detail::GvSequencePayloadBytes(GvSequencePayloadType::Enum type, GvImageType::Enum imageType,
+                                        const GvSize& size) {
+    return payloadBytes(type, imageType, size);
+}
+
+const char* GvSequencePayloadType::ToString(GvSequencePayloadType::Enum e) {
+    switch (e) {
+        case PointMap: return "PointMap";
+        case DepthMap: return "DepthMap";
+        case ConfidenceMap: return "ConfidenceMap";
+        case Image: return "Image";
+        case Blob: return "Blob";
+        default: return "None";
+    }
+}
+
+GvSequencePayload GvSequencePayload::FromPointMap(const double* points, const GvSize& size) {
+    return makePayload(GvSequencePayloadType::PointMap, GvImageType::None, points, size);
+}
+
+GvSequencePayload GvSequencePayload::FromPointMap(const GvPointMapBuffer& points) {
+    return FromPointMap(points.GetPointDataConstPtr(), points.GetSize());
+}
+
+GvSequencePayload GvSequencePayload::FromDepthMap(const double* depth, const GvSize& size) {
+    return makePayload(GvSequencePayloadType::DepthMap, GvImageType::None, depth, size);
+}
+
+GvSequencePayload GvSequencePayload::FromDepthMap(const GvDepthMapBuffer& depth) {
+    return FromDepthMap(depth.GetDataConstPtr(), depth.GetSize());
+}
+
+GvSequencePayload GvSequencePayload::FromConfidenceMap(const double* confidence, const GvSize& size) {
+    return makePayload(GvSequencePayloadType::ConfidenceMap, GvImageType::None, confidence, size);
+}
+
+GvSequencePayload GvSequencePayload::FromConfidenceMap(const GvConfidenceMapBuffer& confidence) {
+    return FromConfidenceMap(confidence.GetDataConstPtr(), confidence.GetSize());
+}
+
+GvSequencePayload GvSequencePayload::FromImage(const unsigned char* pixels, GvImageType::Enum type,
+                                               const GvSize& size) {
+    return makePayload(GvSequencePayloadType::Image, type, pixels, size);
+}
+
+GvSequencePayload GvSequencePayload::FromImage(const GvImageBuffer& image) {
+    return FromImage(image.GetDataConstPtr(), image.GetType(), image.GetSize());
+}
+
+GvSequencePayload GvSequencePayload::FromBlob(const void* data, uint64_t bytes) {
+    // 크기가 범위를 벗어나면 size가 0이 되어 AppendFrame()에서 거부된다.
+    const int width = bytes <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max()) ? static_cast<int>(bytes) : 0;
+    return makePayload(GvSequencePayloadType::Blob, GvImageType::None, data, GvSize(width, 1));
+}
+
+// -----------------------------------------------------------------------------
+// GvSequenceWriter
+// -----------------------------------------------------------------------------
+
+GvSequenceWriter::~GvSequenceWriter() {
+    Close();
+}
+
+bool GvSequenceWriter::Open(const char* fileName, const GvSequenceWriteOptions& options) {
+    Close();
+    if (fileName == nullptr || !isValidAlignment(options.alignment)) {
+        detail::GvSetLastHelperError("GvSequenceWriter::Open: invalid arguments");
+        return false;
+    }
+    const auto fail = [&](const std::string& reason) {
+        detail::GvSetLastHelperError("GvSequenceWriter::Open: " + reason + ": " + fileName);
+        if (m_fp != nullptr) {
+            std::fclose(m_fp);
+            m_fp = nullptr;
+        }
+        m_index.clear();
+        return false;
+    };
+
+    // [1] 이어 쓰기: 기존 색인을 읽고 색인/footer(또는 끊긴 레코드)를 잘라낸 위치부터 기록
+    m_index.clear();
+    if (options.append) {
+        FILE* probe = std::fopen(fileName, "rb");
+        if (probe != nullptr) {
+            std::fclose(probe);
+            uint64_t dataEnd = 0;
+            bool recovered = false;
+            std::string reason;
+            {
+                GvMappedFile existing;
+                if (!existing.Open(fileName)) {
+                    return fail("cannot map existing file");
+                }
+                if (!loadIndex(existing, m_index, m_alignment, dataEnd, recovered, reason)) {
+                    return fail(reason);
+                }
+            }
+            m_fp = std::fopen(fileName, "r+b");
+            if (m_fp == nullptr) {
+                return fail("cannot open");
+            }
+            if (!detail::GvFileTruncate(m_fp, dataEnd) || !detail::GvFileSeek(m_fp, dataEnd)) {
+                return fail("cannot truncate index");
+            }
+            m_position = dataEnd;
+            m_zeros.assign(m_alignment, 0);
+            return true;
+        }
+    }
+
+    // [2] 새 파일: 파일 헤더를 정렬 단위까지 채워 첫 프레임 레코드를 정렬 경계에 둔다.
+    m_fp = std::fopen(fileName, "wb");
+    if (m_fp == nullptr) {
+        return fail("cannot open");
+    }
+    m_alignment = options.alignment;
+    m_zeros.assign(m_alignment, 0);
+    std::vector<uint8_t> header;
+    append(header, kFileMagic);
+    append(header, kFormatVersion);
+    append(header, m_alignment);
+    append(header, static_cast<uint32_t>(0));
+    header.resize(m_alignment, 0);
+    if (!writeBytes(m_fp, header.data(), header.size())) {
+        return fail("write failed");
+    }
+    m_position = m_alignment;
+    return true;
+}
+
+bool GvSequenceWriter::AppendFrame(const GvSequenceFrameInfo& info, const GvSequencePayload* payloads, int count) {
+    if (m_fp == nullptr) {
+        detail::GvSetLastHelperError("GvSequenceWriter: sequence is not open");
+        return false;
+    }
+    if (count < 0 || (count > 0 && payloads == nullptr)) {
+        detail::GvSetLastHelperError("GvSequenceWriter::AppendFrame: invalid arguments");
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        const GvSequencePayload& p = payloads[i];
+        const uint64_t expected = payloadBytes(p.type, p.image_type, p.size);
+        if (p.data == nullptr || expected == 0 || (p.bytes != 0 && p.bytes != expected)) {
+            detail::GvSetLastHelperError("GvSequenceWriter::AppendFrame: invalid payload " + std::to_string(i));
+            return false;
+        }
+    }
+
+    // [1] 레코드 배치: 고정부 + 기술자 + 옵션, 이후 데이터마다 정렬 경계
+    const uint32_t optionsBytes = info.has_options ? static_cast<uint32_t>(sizeof(info.options)) : 0;
+    const uint64_t headerBytes = kRecordFixedBytes + kDescriptorBytes * static_cast<uint64_t>(count) + optionsBytes;
+    std::vector<uint64_t> offsets(static_cast<size_t>(count));
+    uint64_t recordBytes = alignUp(headerBytes, m_alignment);
+    for (int i = 0; i < count; ++i) {
+        offsets[static_cast<size_t>(i)] = recordBytes;
+        recordBytes = alignUp(recordBytes + payloadBytes(payloads[i].type, payloads[i].image_type, payloads[i].size),
+                              m_alignment);
+    }
+    const uint64_t timestamp = info.timestamp_ns != 0 ? info.timestamp_ns : GvNowNs();
+
+    std::vector<uint8_t> header;
+    header.reserve(static_cast<size_t>(alignUp(headerBytes, m_alignment)));
+    append(header, kRecordMagic);
+    append(header, static_cast<uint32_t>(headerBytes));
+    append(header, recordBytes);
+    append(header, info.frame_id);
+    append(header, timestamp);
+    char sn[sizeof(info.sn)] = {};
+    std::memcpy(sn, info.sn, sizeof(sn) - 1);
+    header.insert(header.end(), sn, sn + sizeof(sn));
+    append(header, static_cast<uint32_t>(count));
+    append(header, optionsBytes);
+    for (int i = 0; i < count; ++i) {
+        const GvSequencePayload& p = payloads[i];
+        append(header, static_cast<uint32_t>(p.type));
+        append(header, static_cast<uint32_t>(p.image_type));
+        append(header, static_cast<int32_t>(p.size.width));
+        append(header, static_cast<int32_t>(p.size.height));
+        append(header, offsets[static_cast<size_t>(i)]);
+        append(header, payloadBytes(p.type, p.image_type, p.size));
+    }
+    if (optionsBytes != 0) {
+        const uint8_t* raw = reinterpret_cast<const uint8_t*>(&info.options);
+        header.insert(header.end(), raw, raw + optionsBytes);
+    }
+    header.resize(static_cast<size_t>(alignUp(headerBytes, m_alignment)), 0);
+
+    // [2] 순차 기록. 실패하면 레코드 시작 위치로 되돌리고 그 뒤를 잘라 끊긴 레코드를 남기지 않는다.
+    bool ok = writeBytes(m_fp, header.data(), header.size());
+    uint64_t written = header.size();
+    for (int i = 0; ok && i < count; ++i) {
+        const GvSequencePayload& p = payloads[i];
+        const uint64_t bytes = payloadBytes(p.type, p.image_type, p.size);
+        const uint64_t padding = alignUp(written + bytes, m_alignment) - written - bytes;
+        ok = writeBytes(m_fp, p.data, static_cast<size_t>(bytes)) &&
+             writeBytes(m_fp, m_zeros.data(), static_cast<size_t>(padding));
+        written += bytes + padding;
+    }
+    if (!ok) {
+        std::fflush(m_fp);
+        if (!detail::GvFileSeek(m_fp, m_position) || !detail::GvFileTruncate(m_fp, m_position)) {
+            detail::GvSetLastHelperError("GvSequenceWriter::AppendFrame: write failed, cannot truncate partial record");
+            return false;
+        }
+        detail::GvSetLastHelperError("GvSequenceWriter::AppendFrame: write failed");
+        return false;
+    }
+    m_index.push_back({m_position, timestamp});
+    m_position += recordBytes;
+    return true;
+}
+
+bool GvSequenceWriter::Flush() {
+    if (m_fp == nullptr) {
+        detail::GvSetLastHelperError("GvSequenceWriter: sequence is not open");
+        return false;
+    }
+    if (std::fflush(m_fp) != 0) {
+        detail::GvSetLastHelperError("GvSequenceWriter::Flush: write failed");
+        return false;
+    }
+    return true;
+}
+
+bool GvSequenceWriter::Close() {
+    if (m_fp == nullptr) {
+        return true;
+    }
+    std::vector<uint8_t> tail;
+    tail.reserve(m_index.size() * kIndexEntryBytes + kFooterBytes);
+    for (const detail::GvSequenceIndexEntry& entry : m_index) {
+        append(tail, entry.offset);
+        append(tail, entry.timestamp_ns);
+    }
+    append(tail, m_position);
+    append(tail, static_cast<uint32_t>(m_index.size()));
+    append(tail, kFooterMagic);
+    bool ok = writeBytes(m_fp, tail.data(), tail.size());
+    ok = std::fclose(m_fp) == 0 && ok;
+    m_fp = nullptr;
+    m_index.clear();
+    if (!ok) {
+        detail::GvSetLastHelperError("GvSequenceWriter::Close: write failed");
+    }
+    return ok;
+}
+
+// -----------------------------------------------------------------------------
+// GvSequenceReader
+// -----------------------------------------------------------------------------
+
+bool GvSequenceReader::Open(const char* fileName) {
+    Close();
+    if (fileName == nullptr) {
+        detail::GvSetLastHelperError("GvSequenceReader::Open: invalid arguments");
+        return false;
+    }
+    if (!m_file.Open(fileName, GvMappedFileMode::CopyOnWrite)) {
+        return false;
+    }
+    uint32_t alignment = 0;
+    std::string reason;
+    if (!loadIndex(m_file, m_index, alignment, m_dataEnd, m_recovered, reason)) {
+        detail::GvSetLastHelperError("GvSequenceReader::Open: " + reason + ": " + fileName);
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void GvSequenceReader::Close() {
+    m_file.Close();
+    m_index.clear();
+    m_dataEnd = 0;
+    m_recovered = false;
+}
+
+const unsigned char* GvSequenceReader::Record(int frame, const char* caller) const {
+    if (frame < 0 || frame >= GetFrameCount()) {
+        detail::GvSetLastHelperError(std::string(caller) + ": frame out of range");
+        return nullptr;
+    }
+    const uint64_t offset = m_index[static_cast<size_t>(frame)].offset;
+    const unsigned char* record = m_file.GetData() + offset;
+    const uint64_t headerBytes = load<uint32_t>(record + 4);
+    const uint64_t recordBytes = load<uint64_t>(record + 8);
+    const uint64_t payloadCount = load<uint32_t>(record + 96);
+    const uint64_t optionsBytes = load<uint32_t>(record + 100);
+    if (load<uint32_t>(record) != kRecordMagic || recordBytes > m_dataEnd - offset ||
+        headerBytes != kRecordFixedBytes + payloadCount * kDescriptorBytes + optionsBytes || headerBytes > recordBytes) {
+        detail::GvSetLastHelperError(std::string(caller) + ": corrupt frame record " + std::to_string(frame));
+        return nullptr;
+    }
+    return record;
+}
+
+bool GvSequenceReader::GetFrameInfo(int frame, GvSequenceFrameInfo& info) const {
+    const unsigned char* record = Record(frame, "GvSequenceReader::GetFrameInfo");
+    if (record == nullptr) {
+        return false;
+    }
+    GvSequenceFrameInfo result;
+    result.frame_id = load<uint64_t>(record + 16);
+    result.timestamp_ns = load<uint64_t>(record + 24);
+    std::memcpy(result.sn, record + 32, sizeof(result.sn));
+    result.sn[sizeof(result.sn) - 1] = '\0';
+    const uint32_t payloadCount = load<uint32_t>(record + 96);
+    const uint32_t optionsBytes = load<uint32_t>(record + 100);
+    result.payload_count = static_cast<int>(payloadCount);
+    if (optionsBytes == sizeof(result.options)) {
+        std::memcpy(&result.options, record + kRecordFixedBytes + payloadCount * kDescriptorBytes, optionsBytes);
+        result.has_options = true;
+    }
+    info = result;
+    return true;
+}
+
+uint64_t GvSequenceReader::GetTimestamp(int frame) const {
+    return frame >= 0 && frame < GetFrameCount() ? m_index[static_cast<size_t>(frame)].timestamp_ns : 0;
+}
+
+int GvSequenceReader::FindFrame(uint64_t timestamp_ns) const {
+    const auto it = std::lower_bound(m_index.begin(), m_index.end(), timestamp_ns,
+                                     [](const detail::GvSequenceIndexEntry& entry, uint64_t ts) {
+                                         return entry.timestamp_ns < ts;
+                                     });
+    return it == m_index.end() ? -1 : static_cast<int>(it - m_index.begin());
+}
+
+bool GvSequenceReader::GetPayload(int frame, int index, GvSequencePayload& payload) const {
+    const unsigned char* record = Record(frame, "GvSequenceReader::GetPayload");
+    if (record == nullptr) {
+        return false;
+    }
+    const uint32_t payloadCount = load<uint32_t>(record + 96);
+    if (index < 0 || static_cast<uint32_t>(index) >= payloadCount) {
+        detail::GvSetLastHelperError("GvSequenceReader::GetPayload: payload index out of range");
+        return false;
+    }
+    const unsigned char* desc = record + kRecordFixedBytes + static_cast<uint64_t>(index) * kDescriptorBytes;
+    GvSequencePayload result;
+    result.type = static_cast<GvSequencePayloadType::Enum>(load<uint32_t>(desc));
+    result.image_type = static_cast<GvImageType::Enum>(load<uint32_t>(desc + 4));
+    result.size = GvSize(load<int32_t>(desc + 8), load<int32_t>(desc + 12));
+    const uint64_t offset = load<uint64_t>(desc + 16);
+    result.bytes = load<uint64_t>(desc + 24);
+    const uint64_t recordBytes = load<uint64_t>(record + 8);
+    if (result.bytes == 0 || result.bytes != payloadBytes(result.type, result.image_type, result.size) ||
+        offset > recordBytes || result.bytes > recordBytes - offset) {
+        detail::GvSetLastHelperError("GvSequenceReader::GetPayload: corrupt payload descriptor in frame " +
+                                     std::to_string(frame));
+        return false;
+    }
+    result.data = record + offset;
+    payload = result;
+    return true;
+}
+
+bool GvSequenceReader::FindPayload(int frame, GvSequencePayloadType::Enum type, GvSequencePayload& payload,
+                                   int nth) const {
+    const unsigned char* record = Record(frame, "GvSequenceReader::FindPayload");
+    if (record == nullptr) {
+        return false;
+    }
+    const int payloadCount = static_cast<int>(load<uint32_t>(record + 96));
+    for (int i = 0; i < payloadCount; ++i) {
+        const uint32_t t = load<uint32_t>(record + kRecordFixedBytes + static_cast<uint64_t>(i) * kDescriptorBytes);
+        if (t == static_cast<uint32_t>(type) && nth-- == 0) {
+            return GetPayload(frame, i, payload);
+        }
+    }
+    detail::GvSetLastHelperError(std::string("GvSequenceReader::FindPayload: no ") +
+                                 GvSequencePayloadType::ToString(type) + " in frame " + std::to_string(frame));
+    return false;
+}
+
+void GvSequenceReader::Prefetch(int frame) const {
+    if (frame < 0 || frame >= GetFrameCount()) {
+        return;
+    }
+    const size_t f = static_cast<size_t>(frame);
+    const uint64_t end = f + 1 < m_index.size() ? m_index[f + 1].offset : m_dataEnd;
+    m_file.Prefetch(m_index[f].offset, end - m_index[f].offset);
+}
+
+}  // namespace gv
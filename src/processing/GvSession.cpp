@@ -0,0 +1,714 @@
+#include "GvSession.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace gv {
+
+namespace {
+
+// 이벤트 기술자(프레임의 첫 데이터, Blob 32 bytes, little-endian):
+// magic u32, version u32, type u32, camera_id u32, raw_count u32, flags u32, info_bytes u32, reserved u32
+constexpr uint32_t kEventMagic = 0x45535647;  // "GVSE"
+constexpr uint32_t kEventVersion = 1;
+constexpr size_t kEventBytes = 32;
+constexpr uint32_t kFlagHasImage = 1u << 0;
+constexpr uint32_t kFlagColor = 1u << 1;
+
+static_assert(std::is_trivially_copyable<GvSessionInfo>::value, "session info is stored as raw bytes");
+
+struct EventDescriptor {
+    GvSessionEventType::Enum type = GvSessionEventType::None;
+    GvCameraID camera_id = CameraID_Left;
+    uint32_t raw_count = 0;
+    uint32_t flags = 0;
+    uint32_t info_bytes = 0;
+};
+
+void encodeDescriptor(const EventDescriptor& desc, unsigned char* out) {
+    const uint32_t fields[8] = {kEventMagic,
+                                kEventVersion,
+                                static_cast<uint32_t>(desc.type),
+                                static_cast<uint32_t>(desc.camera_id),
+                                desc.raw_count,
+                                desc.flags,
+                                desc.info_bytes,
+                                0};
+    std::memcpy(out, fields, sizeof(fields));
+}
+
+bool readDescriptor(const GvSequenceReader& reader, int frame, EventDescriptor& desc, const char* caller) {
+    GvSequencePayload payload;
+    if (!reader.GetPayload(frame, 0, payload)) {
+        return false;
+    }
+    uint32_t fields[8];
+    if (payload.type != GvSequencePayloadType::Blob || payload.bytes != kEventBytes) {
+        detail::GvSetLastHelperError(std::string(caller) + ": frame " + std::to_string(frame) +
+                                     " is not a session event");
+        return false;
+    }
+    std::memcpy(fields, payload.data, sizeof(fields));
+    if (fields[0] != kEventMagic || fields[1] != kEventVersion) {
+        detail::GvSetLastHelperError(std::string(caller) + ": unsupported session event in frame " +
+                                     std::to_string(frame));
+        return false;
+    }
+    desc.type = static_cast<GvSessionEventType::Enum>(fields[2]);
+    desc.camera_id = static_cast<GvCameraID>(fields[3]);
+    desc.raw_count = fields[4];
+    desc.flags = fields[5];
+    desc.info_bytes = fields[6];
+    return true;
+}
+
+/** @brief 매핑된 이미지를 버퍼로 복사한다. 형식/크기가 같으면 버퍼 메모리를 재사용한다. */
+void copyToBuffer(const GvSequencePayload& payload, GvImageBuffer& image) {
+    if (!image.IsValid() || image.GetType() != payload.image_type || image.GetSize() != payload.size) {
+        image = GvImageBuffer::Create(payload.image_type, payload.size);
+    }
+    std::memcpy(image.GetDataPtr(), payload.data, image.GetBytes());
+}
+
+/** @brief 재생 중인 이벤트의 이미지를 가상 장치 버퍼에 넣는다(`RawImageSource`). */
+bool loadEventImages(const GvSessionPlayer& player, int index, bool capture3d, std::vector<GvImageBuffer>& stack,
+                     GvImageBuffer& texture) {
+    GvSessionEvent event;
+    if (index < 0 || !player.GetEvent(index, event)) {
+        return false;
+    }
+    const GvSessionEventType::Enum expected =
+        capture3d ? GvSessionEventType::Capture3D : GvSessionEventType::Capture2D;
+    if (event.type != expected) {
+        detail::GvSetLastHelperError(std::string("GvReplaySession: event ") + std::to_string(index) + " is " +
+                                     GvSessionEventType::ToString(event.type) + ", expected " +
+                                     GvSessionEventType::ToString(expected));
+        return false;
+    }
+    GvSequencePayload payload;
+    if (capture3d) {
+        stack.resize(static_cast<size_t>(event.raw_image_count));
+        for (int i = 0; i < event.raw_image_count; ++i) {
+            if (!player.GetRawImage(index, i, payload)) {
+                return false;
+            }
+            copyToBuffer(payload, stack[static_cast<size_t>(i)]);
+        }
+    }
+    if (!event.has_image) {
+        texture = GvImageBuffer();
+        return true;
+    }
+    if (!player.GetImage(index, payload)) {
+        return false;
+    }
+    copyToBuffer(payload, texture);
+    return true;
+}
+
+}  // namespace
+
+const char* GvSessionEventType::ToString(GvSessionEventType::Enum e) {
+    switch (e) {
+        case SessionInfo: return "SessionInfo";
+        case Capture3D: return "Capture3D";
+        case Capture2D: return "Capture2D";
+        case RealtimeFrame: return "RealtimeFrame";
+        default: return "None";
+    }
+}
+
+const char* GvSessionReplaySpeed::ToString(GvSessionReplaySpeed::Enum e) {
+    switch (e) {
+        case Original: return "Original";
+        case Maximum: return "Maximum";
+        default: return "Unknown";
+    }
+}
+
+GvSessionRecorder::~GvSessionRecorder() {
+    Close();
+}
+
+bool GvSessionRecorder::Open(const char* fileName, const GvSessionInfo& info, const GvSessionRecordOptions& options) {
+    if (IsOpen()) {
+        detail::GvSetLastHelperError("GvSessionRecorder::Open: recorder is already open");
+        return false;
+    }
+    if (fileName == nullptr) {
+        detail::GvSetLastHelperError("GvSessionRecorder::Open: invalid arguments");
+        return false;
+    }
+    GvSequenceWriteOptions sequenceOptions = options.sequence;
+    sequenceOptions.append = false;
+    if (!m_sequence.Open(fileName, sequenceOptions)) {
+        return false;
+    }
+
+    // [1] 첫 프레임: 세션 정보
+    GvSessionInfo header = info;
+    header.start_ns = GvNowNs();
+    EventDescriptor desc;
+    desc.type = GvSessionEventType::SessionInfo;
+    desc.info_bytes = static_cast<uint32_t>(sizeof(GvSessionInfo));
+    unsigned char descBytes[kEventBytes];
+    encodeDescriptor(desc, descBytes);
+    const GvSequencePayload payloads[2] = {GvSequencePayload::FromBlob(descBytes, kEventBytes),
+                                           GvSequencePayload::FromBlob(&header, sizeof(header))};
+    GvSequenceFrameInfo frame;
+    frame.timestamp_ns = header.start_ns;
+    std::memcpy(frame.sn, header.device.sn, std::min(sizeof(frame.sn), sizeof(header.device.sn)));
+    frame.sn[sizeof(frame.sn) - 1] = '\0';
+    if (!m_sequence.AppendFrame(frame, payloads, 2)) {
+        m_sequence.Close();
+        return false;
+    }
+
+    // [2] 기록 스레드 시작
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_options = options;
+    m_stats = GvSessionRecordStats();
+    m_firstError.clear();
+    m_sn = frame.sn;
+    m_nextCaptureId = 1;
+    m_open = true;
+    m_stopping = false;
+    m_writer = std::thread([this]() { WriterLoop(); });
+    return true;
+}
+
+bool GvSessionRecorder::IsOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_open && !m_stopping;
+}
+
+bool GvSessionRecorder::RecordCapture3D(const GvSingle::GvCaptureOptions& options,
+                                        std::vector<GvImageBuffer> rawImages, GvImageBuffer texture,
+                                        uint64_t frame_id, uint64_t timestamp_ns) {
+    // Open()이 m_mutex 아래에서 옵션을 바꾸므로 잠금 상태에서 복사해 쓴다.
+    GvSessionRecordOptions recordOptions;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        recordOptions = m_options;
+    }
+    Event event;
+    event.type = GvSessionEventType::Capture3D;
+    event.info.frame_id = frame_id;
+    event.info.timestamp_ns = timestamp_ns;
+    event.info.has_options = true;
+    event.info.options = options;
+    if (recordOptions.record_raw_images) {
+        for (GvImageBuffer& raw : rawImages) {
+            if (!raw.IsValid()) {
+                detail::GvSetLastHelperError("GvSessionRecorder::RecordCapture3D: invalid raw image");
+                return false;
+            }
+        }
+        event.images = std::move(rawImages);
+    }
+    event.raw_count = static_cast<uint32_t>(event.images.size());
+    if (texture.IsValid()) {
+        event.images.push_back(std::move(texture));
+    }
+    return Push(std::move(event), true);
+}
+
+bool GvSessionRecorder::RecordCapture2D(const GvSingle::GvCaptureOptions& options, GvImageBuffer image,
+                                        uint64_t frame_id, uint64_t timestamp_ns) {
+    if (!image.IsValid()) {
+        detail::GvSetLastHelperError("GvSessionRecorder::RecordCapture2D: invalid image");
+        return false;
+    }
+    Event event;
+    event.type = GvSessionEventType::Capture2D;
+    event.info.frame_id = frame_id;
+    event.info.timestamp_ns = timestamp_ns;
+    event.info.has_options = true;
+    event.info.options = options;
+    event.images.push_back(std::move(image));
+    return Push(std::move(event), true);
+}
+
+bool GvSessionRecorder::RecordRealtimeFrame(const GvRealtimeImageFrame& frame, uint64_t timestamp_ns) {
+    const size_t rowBytes = static_cast<size_t>(frame.width) * static_cast<size_t>(frame.channels);
+    if (frame.data == nullptr || frame.width <= 0 || frame.height <= 0 ||
+        (frame.channels != 1 && frame.channels != 3) ||
+        (frame.stride_bytes != 0 && static_cast<size_t>(frame.stride_bytes) < rowBytes)) {
+        detail::GvSetLastHelperError("GvSessionRecorder::RecordRealtimeFrame: unsupported frame layout");
+        return false;
+    }
+    bool dropWhenFull = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        dropWhenFull = m_options.drop_realtime_when_full;
+    }
+    Event event;
+    event.type = GvSessionEventType::RealtimeFrame;
+    event.info.frame_id = frame.frame_id;
+    event.info.timestamp_ns = timestamp_ns;
+    event.camera_id = frame.camera_id;
+    event.is_color = frame.is_color;
+    GvImageBuffer image = GvImageBuffer::Create(frame.channels == 1 ? GvImageType::Mono8 : GvImageType::RGB8,
+                                                GvSize(frame.width, frame.height));
+    const size_t stride = frame.stride_bytes != 0 ? static_cast<size_t>(frame.stride_bytes) : rowBytes;
+    unsigned char* dst = image.GetDataPtr();
+    if (stride == rowBytes) {
+        std::memcpy(dst, frame.data, image.GetBytes());
+    } else {
+        for (int y = 0; y < frame.height; ++y) {
+            std::memcpy(dst + static_cast<size_t>(y) * rowBytes, frame.data + static_cast<size_t>(y) * stride,
+                        rowBytes);
+        }
+    }
+    event.images.push_back(std::move(image));
+    return Push(std::move(event), !dropWhenFull);
+}
+
+void GvSessionRecorder::RealtimeImageCallback(const GvRealtimeImageFrame* frame, UserPtr user_data) {
+    if (frame != nullptr && user_data != nullptr) {
+        static_cast<GvSessionRecorder*>(user_data)->RecordRealtimeFrame(*frame);
+    }
+}
+
+bool GvSessionRecorder::Push(Event event, bool blocking) {
+    for (const GvImageBuffer& image : event.images) {
+        event.bytes += image.GetBytes();
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_open || m_stopping) {
+        detail::GvSetLastHelperError("GvSessionRecorder: recorder is not open");
+        return false;
+    }
+
+    // [1] in-flight 예산 확인. 비어 있는 큐는 예산보다 큰 이벤트도 받는다.
+    const uint64_t limit = m_options.max_inflight_bytes;
+    const auto fits = [&]() {
+        return limit == 0 || m_stats.inflight_bytes == 0 || m_stats.inflight_bytes + event.bytes <= limit;
+    };
+    if (!fits()) {
+        if (!blocking) {
+            ++m_stats.dropped_realtime_frames;
+            detail::GvSetLastHelperError("GvSessionRecorder: in-flight byte budget exceeded, frame dropped");
+            return false;
+        }
+        const uint64_t waitStart = GvNowNs();
+        m_spaceCv.wait(lock, [&]() { return fits() || m_stopping; });
+        m_stats.blocked_ns += GvNowNs() - waitStart;
+        if (m_stopping) {
+            detail::GvSetLastHelperError("GvSessionRecorder: recorder is closing");
+            return false;
+        }
+    }
+
+    // [2] 등록. 순번/시각을 잠금 안에서 정해 파일 안 이벤트 순서와 일치시킨다.
+    if (event.type == GvSessionEventType::RealtimeFrame) {
+        ++m_stats.realtime_frames;
+    } else {
+        if (event.info.frame_id == 0) {
+            event.info.frame_id = m_nextCaptureId;
+        }
+        ++m_nextCaptureId;
+        if (event.type == GvSessionEventType::Capture3D) {
+            ++m_stats.captures_3d;
+        } else {
+            ++m_stats.captures_2d;
+        }
+    }
+    if (event.info.timestamp_ns == 0) {
+        event.info.timestamp_ns = GvNowNs();
+    }
+    m_stats.inflight_bytes += event.bytes;
+    m_stats.peak_inflight_bytes = std::max(m_stats.peak_inflight_bytes, m_stats.inflight_bytes);
+    ++m_stats.pending;
+    m_events.push_back(std::move(event));
+    lock.unlock();
+    m_workCv.notify_one();
+    return true;
+}
+
+bool GvSessionRecorder::Write(const Event& event) {
+    EventDescriptor desc;
+    desc.type = event.type;
+    desc.camera_id = event.camera_id;
+    if (event.type == GvSessionEventType::Capture3D) {
+        desc.raw_count = event.raw_count;
+        if (event.images.size() > event.raw_count) {
+            desc.flags |= kFlagHasImage;
+        }
+    } else {
+        desc.flags |= kFlagHasImage;
+    }
+    if (event.is_color) {
+        desc.flags |= kFlagColor;
+    }
+    unsigned char descBytes[kEventBytes];
+    encodeDescriptor(desc, descBytes);
+
+    std::vector<GvSequencePayload> payloads;
+    payloads.reserve(event.images.size() + 1);
+    payloads.push_back(GvSequencePayload::FromBlob(descBytes, kEventBytes));
+    for (const GvImageBuffer& image : event.images) {
+        payloads.push_back(GvSequencePayload::FromImage(image));
+    }
+    GvSequenceFrameInfo info = event.info;
+    std::memcpy(info.sn, m_sn.c_str(), std::min(sizeof(info.sn) - 1, m_sn.size() + 1));
+    return m_sequence.AppendFrame(info, payloads);
+}
+
+void GvSessionRecorder::WriterLoop() {
+    for (;;) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workCv.wait(lock, [&]() { return m_stopping || !m_events.empty(); });
+        if (m_events.empty()) {
+            return;
+        }
+        Event event = std::move(m_events.front());
+        m_events.pop_front();
+        m_writing = true;
+        lock.unlock();
+
+        const bool ok = Write(event);
+        const std::string error = ok ? std::string() : GvGetLastHelperErrorMessage();
+        event.images.clear();
+
+        lock.lock();
+        m_writing = false;
+        --m_stats.pending;
+        m_stats.inflight_bytes -= event.bytes;
+        if (ok) {
+            m_stats.written_bytes += event.bytes;
+        } else {
+            ++m_stats.failed;
+            if (m_firstError.empty()) {
+                m_firstError = error.empty() ? "write failed" : error;
+            }
+        }
+        m_spaceCv.notify_all();
+        if (m_events.empty()) {
+            m_idleCv.notify_all();
+        }
+    }
+}
+
+bool GvSessionRecorder::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_open) {
+        detail::GvSetLastHelperError("GvSessionRecorder: recorder is not open");
+        return false;
+    }
+    m_idleCv.wait(lock, [&]() { return m_events.empty() && !m_writing; });
+    // 잠금을 쥐고 있는 동안 기록 스레드는 다음 이벤트를 꺼내지 못하므로 파일을 함께 쓰지 않는다.
+    return m_sequence.Flush();
+}
+
+bool GvSessionRecorder::Close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_open) {
+            return true;
+        }
+        m_stopping = true;
+    }
+    m_workCv.notify_all();
+    m_spaceCv.notify_all();
+    // 기록 스레드는 남은 이벤트를 모두 기록한 뒤 종료한다.
+    m_writer.join();
+    bool ok = m_sequence.Close();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_open = false;
+    m_stopping = false;
+    if (m_stats.failed > 0) {
+        detail::GvSetLastHelperError("GvSessionRecorder: " + std::to_string(m_stats.failed) +
+                                     " event(s) failed to write: " + m_firstError);
+        ok = false;
+    }
+    return ok;
+}
+
+GvSessionRecordStats GvSessionRecorder::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+bool GvSessionPlayer::Open(const char* fileName) {
+    Close();
+    if (!m_reader.Open(fileName)) {
+        return false;
+    }
+    EventDescriptor desc;
+    GvSequencePayload payload;
+    if (m_reader.GetFrameCount() < 1 || !readDescriptor(m_reader, 0, desc, "GvSessionPlayer::Open") ||
+        desc.type != GvSessionEventType::SessionInfo || desc.info_bytes != sizeof(GvSessionInfo) ||
+        !m_reader.GetPayload(0, 1, payload) || payload.bytes != sizeof(GvSessionInfo)) {
+        detail::GvSetLastHelperError("GvSessionPlayer::Open: missing or incompatible session info (different SDK "
+                                     "version?)");
+        m_reader.Close();
+        return false;
+    }
+    std::memcpy(&m_info, payload.data, sizeof(GvSessionInfo));
+    return true;
+}
+
+void GvSessionPlayer::Close() {
+    m_reader.Close();
+    m_info = GvSessionInfo();
+}
+
+bool GvSessionPlayer::GetEvent(int index, GvSessionEvent& event) const {
+    if (index < 0 || index >= GetEventCount()) {
+        detail::GvSetLastHelperError("GvSessionPlayer::GetEvent: event index out of range");
+        return false;
+    }
+    const int frame = index + 1;
+    EventDescriptor desc;
+    GvSequenceFrameInfo info;
+    if (!readDescriptor(m_reader, frame, desc, "GvSessionPlayer::GetEvent") || !m_reader.GetFrameInfo(frame, info)) {
+        return false;
+    }
+    const bool hasImage = (desc.flags & kFlagHasImage) != 0;
+    if (static_cast<uint64_t>(info.payload_count) != 1ull + desc.raw_count + (hasImage ? 1 : 0)) {
+        detail::GvSetLastHelperError("GvSessionPlayer::GetEvent: corrupt event " + std::to_string(index));
+        return false;
+    }
+    GvSessionEvent result;
+    result.type = desc.type;
+    result.timestamp_ns = info.timestamp_ns;
+    result.frame_id = info.frame_id;
+    result.camera_id = desc.camera_id;
+    result.has_options = info.has_options;
+    result.options = info.options;
+    result.raw_image_count = static_cast<int>(desc.raw_count);
+    result.has_image = hasImage;
+    result.is_color = (desc.flags & kFlagColor) != 0;
+    event = result;
+    return true;
+}
+
+bool GvSessionPlayer::GetRawImage(int index, int nth, GvSequencePayload& image) const {
+    GvSessionEvent event;
+    if (!GetEvent(index, event)) {
+        return false;
+    }
+    if (nth < 0 || nth >= event.raw_image_count) {
+        detail::GvSetLastHelperError("GvSessionPlayer::GetRawImage: raw image index out of range");
+        return false;
+    }
+    if (!m_reader.GetPayload(index + 1, 1 + nth, image)) {
+        return false;
+    }
+    if (image.type != GvSequencePayloadType::Image) {
+        detail::GvSetLastHelperError("GvSessionPlayer::GetRawImage: corrupt event " + std::to_string(index));
+        return false;
+    }
+    return true;
+}
+
+bool GvSessionPlayer::GetImage(int index, GvSequencePayload& image) const {
+    GvSessionEvent event;
+    if (!GetEvent(index, event)) {
+        return false;
+    }
+    if (!event.has_image) {
+        detail::GvSetLastHelperError("GvSessionPlayer::GetImage: event " + std::to_string(index) + " has no image");
+        return false;
+    }
+    if (!m_reader.GetPayload(index + 1, 1 + event.raw_image_count, image)) {
+        return false;
+    }
+    if (image.type != GvSequencePayloadType::Image) {
+        detail::GvSetLastHelperError("GvSessionPlayer::GetImage: corrupt event " + std::to_string(index));
+        return false;
+    }
+    return true;
+}
+
+bool GvSessionPlayer::GetRealtimeFrame(int index, GvRealtimeImageFrame& frame) const {
+    GvSessionEvent event;
+    GvSequencePayload image;
+    if (!GetEvent(index, event)) {
+        return false;
+    }
+    if (event.type != GvSessionEventType::RealtimeFrame) {
+        detail::GvSetLastHelperError("GvSessionPlayer::GetRealtimeFrame: event " + std::to_string(index) +
+                                     " is not a realtime frame");
+        return false;
+    }
+    if (!GetImage(index, image)) {
+        return false;
+    }
+    const int channels = static_cast<int>(GvImageBufferPixelSize(image.image_type));
+    frame = GvRealtimeImageFrame();
+    frame.camera_id = event.camera_id;
+    frame.data = static_cast<const unsigned char*>(image.data);
+    frame.width = image.size.width;
+    frame.height = image.size.height;
+    frame.stride_bytes = image.size.width * channels;
+    frame.channels = channels;
+    frame.frame_id = event.frame_id;
+    frame.is_color = event.is_color;
+    return true;
+}
+
+bool GvReplaySession(const GvSessionPlayer& player, GvVirtualSingle& camera, const GvSessionReplayOptions& options,
+                     GvSessionReplayStats* stats) {
+    if (!player.IsOpen() || !camera.IsOpen()) {
+        detail::GvSetLastHelperError("GvReplaySession: player and camera must be open");
+        return false;
+    }
+    const int total = player.GetEventCount();
+    const int first = std::max(0, options.first_event);
+    const int last = options.event_count < 0 ? total : std::min(total, first + options.event_count);
+    const double scale = options.time_scale > 0.0 ? options.time_scale : 1.0;
+
+    GvSessionReplayStats result;
+    std::string firstError;
+    int current = -1;
+    camera.SetRawImageSource([&player, &current](const GvSingle::GvCaptureOptions&, bool capture3d,
+                                                 std::vector<GvImageBuffer>& stack, GvImageBuffer& texture) {
+        return loadEventImages(player, current, capture3d, stack, texture);
+    });
+
+    const uint64_t start = GvNowNs();
+    uint64_t baseTimestamp = 0;
+    bool haveBase = false;
+    for (int i = first; i < last; ++i) {
+        // [1] 이벤트 조회 + 다음 이벤트 미리 읽기
+        GvSessionEvent event;
+        bool ok = player.GetEvent(i, event);
+        if (i + 1 < last) {
+            player.Prefetch(i + 1);
+        }
+        // 기준 시각은 처음으로 읽은 이벤트(읽기에 실패한 이벤트의 시각은 쓰지 않는다)
+        if (ok && !haveBase) {
+            baseTimestamp = event.timestamp_ns;
+            haveBase = true;
+        }
+
+        // [2] 원래 속도: 기록 간격만큼 기다린 뒤 늦은 시간을 기록한다.
+        if (ok && options.speed == GvSessionReplaySpeed::Original) {
+            const uint64_t offset = event.timestamp_ns > baseTimestamp ? event.timestamp_ns - baseTimestamp : 0;
+            const uint64_t due = start + static_cast<uint64_t>(static_cast<double>(offset) * scale);
+            uint64_t now = GvNowNs();
+            if (now < due) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(due - now));
+                now = GvNowNs();
+            }
+            const uint64_t lateness = now > due ? now - due : 0;
+            result.total_lateness_ns += lateness;
+            result.max_lateness_ns = std::max(result.max_lateness_ns, lateness);
+        }
+
+        // [3] 실행
+        const uint64_t t0 = GvNowNs();
+        current = i;
+        if (ok) {
+            switch (event.type) {
+                case GvSessionEventType::Capture3D:
+                    ++result.captures_3d;
+                    ok = event.has_options && camera.Capture(event.options);
+                    break;
+                case GvSessionEventType::Capture2D:
+                    ++result.captures_2d;
+                    ok = event.has_options && camera.Capture2D(event.options);
+                    break;
+                case GvSessionEventType::RealtimeFrame: {
+                    ++result.realtime_frames;
+                    GvRealtimeImageFrame frame;
+                    ok = player.GetRealtimeFrame(i, frame);
+                    if (ok && options.realtime_callback != nullptr) {
+                        options.realtime_callback(&frame, options.realtime_user_data);
+                    }
+                    break;
+                }
+                default: break;
+            }
+        }
+        const uint64_t elapsed = GvNowNs() - t0;
+        ++result.events;
+        result.total_process_ns += elapsed;
+        result.max_process_ns = std::max(result.max_process_ns, elapsed);
+        if (!ok) {
+            ++result.failed;
+            if (firstError.empty()) {
+                firstError = GvGetLastHelperErrorMessage();
+                firstError = "event " + std::to_string(i) + ": " + (firstError.empty() ? "failed" : firstError);
+            }
+        }
+    }
+    result.wall_ns = GvNowNs() - start;
+    camera.SetRawImageSource(GvVirtualSingle::RawImageSource());
+
+    if (stats != nullptr) {
+        *stats = result;
+    }
+    if (result.failed > 0) {
+        detail::GvSetLastHelperError("GvReplaySession: " + std::to_string(result.failed) +
+                                     " event(s) failed, first " + firstError);
+        return false;
+    }
+    return true;
+}
+
+GvVirtualDeviceConfig GvSessionMakeVirtualConfig(const GvSessionInfo& info) {
+    GvVirtualDeviceConfig config;
+    config.name = info.device.name;
+    config.sn = info.device.sn;
+    config.firmware_version = info.device.firmware_version;
+    if (info.resolution.width > 0 && info.resolution.height > 0) {
+        config.resolution = info.resolution;
+    }
+    if (info.device.support_capture_mode != 0) {
+        config.support_capture_mode = info.device.support_capture_mode;
+    }
+    if (info.device.workingdist_far_mm > 0) {
+        config.workingdist_near_mm = info.device.workingdist_near_mm;
+        config.workingdist_far_mm = info.device.workingdist_far_mm;
+    }
+    if (info.is_virtual) {
+        config.focal_scale = info.focal_scale;
+        config.projector_width = info.projector_width;
+        config.projector_focal_scale = info.projector_focal_scale;
+        config.baseline = info.baseline;
+        config.phase_period = info.phase_period;
+        config.color = info.color;
+    } else if (info.has_calibration && info.intrinsic[0] > 0.0f && config.resolution.width > 0) {
+        config.focal_scale = info.intrinsic[0] / config.resolution.width;
+    }
+    return config;
+}
+
+GvSessionInfo GvSessionInfoFromVirtual(const GvVirtualSingle& camera) {
+    const GvVirtualDeviceConfig& config = camera.GetConfig();
+    GvSessionInfo info;
+    detail::GvVirtualFillDeviceInfo(config, "virtual", &info.device);
+    info.resolution = config.resolution;
+    info.has_calibration = camera.GetIntrinsicParameters(info.intrinsic, info.distortion);
+    info.extrinsic[0] = info.extrinsic[5] = info.extrinsic[10] = info.extrinsic[15] = 1.0f;
+    info.is_virtual = true;
+    info.focal_scale = config.focal_scale;
+    info.projector_width = config.projector_width;
+    info.projector_focal_scale = config.projector_focal_scale;
+    info.baseline = config.baseline;
+    info.phase_period = config.phase_period;
+    info.color = config.color;
+    return info;
+}
+
+bool GvSessionRecordLastCapture(GvSessionRecorder& recorder, const GvVirtualSingle& camera,
+                                const GvSingle::GvCaptureOptions& options, bool capture3d, uint64_t frame_id) {
+    if (!capture3d) {
+        return recorder.RecordCapture2D(options, camera.GetImage(), frame_id);
+    }
+    std::vector<GvImageBuffer> rawImages(static_cast<size_t>(camera.GetRawImageCount()));
+    for (size_t i = 0; i < rawImages.size(); ++i) {
+        camera.GetRawImage(rawImages[i], static_cast<uint16_t>(i));
+    }
+    return recorder.RecordCapture3D(options, std::move(rawImages), camera.GetImage(), frame_id);
+}
+
+}  // namespace gv
@@ -0,0 +1,516 @@
+#include "GvSharedRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gv {
+
+namespace detail {
+
+struct GvSharedMemory {
+    GvSharedMemory() = default;
+    GvSharedMemory(const GvSharedMemory&) = delete;
+    GvSharedMemory& operator=(const GvSharedMemory&) = delete;
+
+    ~GvSharedMemory() {
+#if defined(_WIN32)
+        if (data != nullptr) {
+            ::UnmapViewOfFile(data);
+        }
+        if (mapping != nullptr) {
+            ::CloseHandle(mapping);
+        }
+#else
+        if (data != nullptr) {
+            ::munmap(data, static_cast<size_t>(size));
+        }
+        if (owner) {
+            ::shm_unlink(name.c_str());
+        }
+#endif
+    }
+
+    std::string name;
+    unsigned char* data = nullptr;
+    uint64_t size = 0;
+    bool owner = false;
+#if defined(_WIN32)
+    HANDLE mapping = nullptr;
+#endif
+};
+
+}  // namespace detail
+
+namespace {
+
+// 메모리 배치: 링 헤더(1 page) -> 슬롯 N개. 슬롯 = 슬롯 헤더(1 page) + 데이터(slot_capacity, page 단위 올림).
+// sequence s(1부터)는 슬롯 (s - 1) % N에 들어가며, 슬롯 state는 쓰는 중 2s - 1, 완료 후 2s이다.
+constexpr uint32_t kRingMagic = 0x47525647;  // "GVRG"
+constexpr uint32_t kRingVersion = 1;
+constexpr uint64_t kPageBytes = 4096;
+constexpr uint64_t kItemAlignment = 64;
+
+using AtomicU64 = std::atomic<uint64_t>;
+static_assert(AtomicU64::is_always_lock_free, "shared ring requires lock-free 64-bit atomics");
+
+struct RingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t max_items;
+    uint64_t slot_stride;
+    uint64_t slot_capacity;
+    uint64_t created_ns;
+    uint64_t publisher_pid;
+    alignas(64) AtomicU64 published;
+};
+
+struct ItemDesc {
+    uint32_t type;
+    uint32_t image_type;
+    int32_t width;
+    int32_t height;
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+// state 외 필드는 state 확인 전후로 복사해 일관성을 검사한다(seqlock).
+struct SlotMeta {
+    uint64_t frame_id;
+    uint64_t timestamp_ns;
+    uint64_t publish_ns;
+    uint32_t item_count;
+    uint32_t reserved;
+    ItemDesc items[kGvSharedRingMaxItems];
+};
+
+struct SlotHeader {
+    AtomicU64 state;
+    SlotMeta meta;
+};
+
+static_assert(std::is_standard_layout<RingHeader>::value && sizeof(RingHeader) <= kPageBytes, "ring header layout");
+static_assert(std::is_standard_layout<SlotHeader>::value && sizeof(SlotHeader) <= kPageBytes, "slot header layout");
+
+inline uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool isValidName(const char* name) {
+    if (name == nullptr || name[0] == '\0' || std::strlen(name) > 200) {
+        return false;
+    }
+    for (const char* p = name; *p != '\0'; ++p) {
+        const char c = *p;
+        const bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' ||
+                        c == '-';
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string systemName(const char* name) {
+#if defined(_WIN32)
+    return std::string("Local\\gv_ring_") + name;
+#else
+    return std::string("/gv_ring_") + name;
+#endif
+}
+
+RingHeader* ringHeader(const detail::GvSharedMemory& memory) {
+    return reinterpret_cast<RingHeader*>(memory.data);
+}
+
+SlotHeader* slotHeader(const detail::GvSharedMemory& memory, uint64_t sequence) {
+    const RingHeader* ring = ringHeader(memory);
+    const uint64_t slot = (sequence - 1) % ring->slot_count;
+    return reinterpret_cast<SlotHeader*>(memory.data + kPageBytes + slot * ring->slot_stride);
+}
+
+unsigned char* slotData(const detail::GvSharedMemory& memory, uint64_t sequence) {
+    return reinterpret_cast<unsigned char*>(slotHeader(memory, sequence)) + kPageBytes;
+}
+
+bool createMemory(const char* name, uint64_t size, detail::GvSharedMemory& memory, std::string& reason) {
+    memory.name = systemName(name);
+    memory.size = size;
+#if defined(_WIN32)
+    const DWORD high = static_cast<DWORD>(size >> 32);
+    const DWORD low = static_cast<DWORD>(size & 0xFFFFFFFFull);
+    memory.mapping = ::CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, high, low, memory.name.c_str());
+    if (memory.mapping == nullptr) {
+        reason = "CreateFileMapping failed";
+        return false;
+    }
+    if (::GetLastError() == ERROR_ALREADY_EXISTS) {
+        // Win32 이름 있는 매핑은 제거할 수 없으므로 이전 링을 쥔 프로세스가 모두 닫아야 새로 만들 수 있다.
+        reason = "ring is still open in another process";
+        return false;
+    }
+    memory.data = static_cast<unsigned char*>(::MapViewOfFile(memory.mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+#else
+    // 이전 발행자가 남긴 이름은 지운다(이미 매핑한 구독자는 이전 메모리를 계속 본다).
+    ::shm_unlink(memory.name.c_str());
+    const int fd = ::shm_open(memory.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+    if (fd < 0) {
+        reason = "shm_open failed";
+        return false;
+    }
+    memory.owner = true;
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        reason = "cannot resize shared memory";
+        return false;
+    }
+    void* data = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    memory.data = data == MAP_FAILED ? nullptr : static_cast<unsigned char*>(data);
+#endif
+    if (memory.data == nullptr) {
+        reason = "cannot map shared memory";
+        return false;
+    }
+    return true;
+}
+
+bool openMemory(const char* name, detail::GvSharedMemory& memory, std::string& reason) {
+    memory.name = systemName(name);
+#if defined(_WIN32)
+    memory.mapping = ::OpenFileMappingA(FILE_MAP_READ, FALSE, memory.name.c_str());
+    if (memory.mapping == nullptr) {
+        reason = "ring does not exist";
+        return false;
+    }
+    memory.data = static_cast<unsigned char*>(::MapViewOfFile(memory.mapping, FILE_MAP_READ, 0, 0, 0));
+    MEMORY_BASIC_INFORMATION info;
+    if (memory.data != nullptr && ::VirtualQuery(memory.data, &info, sizeof(info)) == sizeof(info)) {
+        memory.size = static_cast<uint64_t>(info.RegionSize);
+    }
+#else
+    const int fd = ::shm_open(memory.name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        reason = "ring does not exist";
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        reason = "ring is not initialized";
+        return false;
+    }
+    memory.size = static_cast<uint64_t>(st.st_size);
+    void* data = ::mmap(nullptr, static_cast<size_t>(memory.size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    memory.data = data == MAP_FAILED ? nullptr : static_cast<unsigned char*>(data);
+#endif
+    if (memory.data == nullptr) {
+        reason = "cannot map shared memory";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+uint64_t GvSharedRingCaptureBytes(const GvSize& resolution, GvImageType::Enum textureType, bool withDepth,
+                                  bool withConfidence) {
+    uint64_t bytes = alignUp(
+        detail::GvSequencePayloadBytes(GvSequencePayloadType::PointMap, GvImageType::None, resolution), kItemAlignment);
+    bytes += alignUp(detail::GvSequencePayloadBytes(GvSequencePayloadType::Image, textureType, resolution),
+                     kItemAlignment);
+    if (withDepth) {
+        bytes += alignUp(detail::GvSequencePayloadBytes(GvSequencePayloadType::DepthMap, GvImageType::None, resolution),
+                         kItemAlignment);
+    }
+    if (withConfidence) {
+        bytes += alignUp(
+            detail::GvSequencePayloadBytes(GvSequencePayloadType::ConfidenceMap, GvImageType::None, resolution),
+            kItemAlignment);
+    }
+    return bytes;
+}
+
+GvSharedRingPublisher::GvSharedRingPublisher() = default;
+
+GvSharedRingPublisher::~GvSharedRingPublisher() {
+    Close();
+}
+
+bool GvSharedRingPublisher::Create(const char* name, const GvSharedRingOptions& options) {
+    Close();
+    if (!isValidName(name) || options.slot_count < 2 || options.slot_capacity == 0) {
+        detail::GvSetLastHelperError("GvSharedRingPublisher::Create: invalid arguments");
+        return false;
+    }
+    const uint64_t slotStride = kPageBytes + alignUp(options.slot_capacity, kPageBytes);
+    const uint64_t size = kPageBytes + slotStride * static_cast<uint64_t>(options.slot_count);
+    std::unique_ptr<detail::GvSharedMemory> memory(new detail::GvSharedMemory());
+    std::string reason;
+    if (!createMemory(name, size, *memory, reason)) {
+        detail::GvSetLastHelperError("GvSharedRingPublisher::Create: " + reason + ": " + name);
+        return false;
+    }
+
+    // 슬롯 state를 먼저 0으로 두고, 마지막에 magic을 써서 구독자가 완성된 헤더만 보게 한다.
+    for (int i = 0; i < options.slot_count; ++i) {
+        new (memory->data + kPageBytes + static_cast<uint64_t>(i) * slotStride) SlotHeader();
+    }
+    RingHeader* ring = new (memory->data) RingHeader();
+    ring->version = kRingVersion;
+    ring->slot_count = static_cast<uint32_t>(options.slot_count);
+    ring->max_items = kGvSharedRingMaxItems;
+    ring->slot_stride = slotStride;
+    ring->slot_capacity = options.slot_capacity;
+    ring->created_ns = GvNowNs();
+    ring->publisher_pid = GvCurrentProcessId();
+    ring->published.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    ring->magic = kRingMagic;
+
+    m_memory = std::move(memory);
+    m_sequence = 0;
+    return true;
+}
+
+void GvSharedRingPublisher::Close() {
+    m_memory.reset();
+    m_sequence = 0;
+}
+
+uint64_t GvSharedRingPublisher::GetSlotCapacity() const {
+    return m_memory ? ringHeader(*m_memory)->slot_capacity : 0;
+}
+
+uint64_t GvSharedRingPublisher::Publish(uint64_t frame_id, uint64_t timestamp_ns, const GvSequencePayload* items,
+                                        int count) {
+    if (!m_memory) {
+        detail::GvSetLastHelperError("GvSharedRingPublisher::Publish: ring is not open");
+        return 0;
+    }
+    if (count < 0 || count > kGvSharedRingMaxItems || (count > 0 && items == nullptr)) {
+        detail::GvSetLastHelperError("GvSharedRingPublisher::Publish: invalid arguments");
+        return 0;
+    }
+
+    // [1] 배치 계산(데이터마다 64 bytes 정렬)
+    RingHeader* ring = ringHeader(*m_memory);
+    SlotMeta meta = {};
+    uint64_t used = 0;
+    for (int i = 0; i < count; ++i) {
+        const GvSequencePayload& p = items[i];
+        const uint64_t bytes = detail::GvSequencePayloadBytes(p.type, p.image_type, p.size);
+        if (p.data == nullptr || bytes == 0 || (p.bytes != 0 && p.bytes != bytes)) {
+            detail::GvSetLastHelperError("GvSharedRingPublisher::Publish: invalid item " + std::to_string(i));
+            return 0;
+        }
+        ItemDesc& desc = meta.items[i];
+        desc.type = static_cast<uint32_t>(p.type);
+        desc.image_type = static_cast<uint32_t>(p.image_type);
+        desc.width = p.size.width;
+        desc.height = p.size.height;
+        desc.offset = used;
+        desc.bytes = bytes;
+        used = alignUp(used + bytes, kItemAlignment);
+    }
+    if (used > ring->slot_capacity) {
+        detail::GvSetLastHelperError("GvSharedRingPublisher::Publish: frame needs " + std::to_string(used) +
+                                     " bytes, slot capacity is " + std::to_string(ring->slot_capacity));
+        return 0;
+    }
+
+    // [2] seqlock 쓰기: state 홀수 -> 데이터/메타데이터 -> state 짝수 -> published
+    const uint64_t sequence = m_sequence + 1;
+    SlotHeader* slot = slotHeader(*m_memory, sequence);
+    unsigned char* data = slotData(*m_memory, sequence);
+    slot->state.store(sequence * 2 - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < count; ++i) {
+        std::memcpy(data + meta.items[i].offset, items[i].data, static_cast<size_t>(meta.items[i].bytes));
+    }
+    meta.frame_id = frame_id != 0 ? frame_id : sequence;
+    meta.timestamp_ns = timestamp_ns != 0 ? timestamp_ns : GvNowNs();
+    meta.item_count = static_cast<uint32_t>(count);
+    meta.publish_ns = GvNowNs();
+    std::memcpy(&slot->meta, &meta, sizeof(meta));
+    slot->state.store(sequence * 2, std::memory_order_release);
+    ring->published.store(sequence, std::memory_order_release);
+    m_sequence = sequence;
+    return sequence;
+}
+
+const GvSequencePayload* GvSharedRingFrame::Find(GvSequencePayloadType::Enum type, int nth) const {
+    for (int i = 0; i < item_count; ++i) {
+        if (items[i].type == type && nth-- == 0) {
+            return &items[i];
+        }
+    }
+    return nullptr;
+}
+
+GvSharedRingReader::GvSharedRingReader() = default;
+
+GvSharedRingReader::~GvSharedRingReader() {
+    Close();
+}
+
+bool GvSharedRingReader::Open(const char* name) {
+    Close();
+    if (!isValidName(name)) {
+        detail::GvSetLastHelperError("GvSharedRingReader::Open: invalid ring name");
+        return false;
+    }
+    std::unique_ptr<detail::GvSharedMemory> memory(new detail::GvSharedMemory());
+    std::string reason;
+    if (!openMemory(name, *memory, reason)) {
+        detail::GvSetLastHelperError("GvSharedRingReader::Open: " + reason + ": " + name);
+        return false;
+    }
+    const RingHeader* ring = ringHeader(*memory);
+    const bool ready = memory->size >= kPageBytes && ring->magic == kRingMagic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!ready || ring->version != kRingVersion || ring->max_items != kGvSharedRingMaxItems ||
+        ring->slot_count < 2 || ring->slot_stride < kPageBytes + ring->slot_capacity ||
+        kPageBytes + ring->slot_stride * ring->slot_count > memory->size) {
+        detail::GvSetLastHelperError(std::string("GvSharedRingReader::Open: incompatible or uninitialized ring: ") +
+                                     name);
+        return false;
+    }
+    m_memory = std::move(memory);
+    return true;
+}
+
+void GvSharedRingReader::Close() {
+    m_memory.reset();
+}
+
+int GvSharedRingReader::GetSlotCount() const {
+    return m_memory ? static_cast<int>(ringHeader(*m_memory)->slot_count) : 0;
+}
+
+uint64_t GvSharedRingReader::GetLatestSequence() const {
+    return m_memory ? ringHeader(*m_memory)->published.load(std::memory_order_acquire) : 0;
+}
+
+uint64_t GvSharedRingReader::GetCreatedNs() const {
+    return m_memory ? ringHeader(*m_memory)->created_ns : 0;
+}
+
+bool GvSharedRingReader::AcquireLatest(GvSharedRingFrame& frame) const {
+    const uint64_t latest = GetLatestSequence();
+    if (latest == 0) {
+        detail::GvSetLastHelperError("GvSharedRingReader::AcquireLatest: no frame has been published");
+        return false;
+    }
+    return Acquire(latest, frame);
+}
+
+bool GvSharedRingReader::Acquire(uint64_t sequence, GvSharedRingFrame& frame) const {
+    if (!m_memory) {
+        detail::GvSetLastHelperError("GvSharedRingReader: ring is not open");
+        return false;
+    }
+    const RingHeader* ring = ringHeader(*m_memory);
+    if (sequence == 0 || sequence > ring->published.load(std::memory_order_acquire)) {
+        detail::GvSetLastHelperError("GvSharedRingReader::Acquire: frame " + std::to_string(sequence) +
+                                     " is not published yet");
+        return false;
+    }
+
+    // [1] seqlock 읽기: state 확인 -> 메타데이터 복사 -> state 재확인
+    const SlotHeader* slot = slotHeader(*m_memory, sequence);
+    const uint64_t state = slot->state.load(std::memory_order_acquire);
+    SlotMeta meta;
+    std::memcpy(&meta, &slot->meta, sizeof(meta));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (state != sequence * 2 || slot->state.load(std::memory_order_relaxed) != state) {
+        detail::GvSetLastHelperError("GvSharedRingReader::Acquire: frame " + std::to_string(sequence) +
+                                     " has been overwritten");
+        return false;
+    }
+
+    // [2] 기술자 검증 후 포인터 구성
+    if (meta.item_count > static_cast<uint32_t>(kGvSharedRingMaxItems)) {
+        detail::GvSetLastHelperError("GvSharedRingReader::Acquire: corrupt slot");
+        return false;
+    }
+    const unsigned char* data = slotData(*m_memory, sequence);
+    GvSharedRingFrame result;
+    result.sequence = sequence;
+    result.frame_id = meta.frame_id;
+    result.timestamp_ns = meta.timestamp_ns;
+    result.publish_ns = meta.publish_ns;
+    result.item_count = static_cast<int>(meta.item_count);
+    for (int i = 0; i < result.item_count; ++i) {
+        const ItemDesc& desc = meta.items[i];
+        GvSequencePayload& item = result.items[i];
+        item.type = static_cast<GvSequencePayloadType::Enum>(desc.type);
+        item.image_type = static_cast<GvImageType::Enum>(desc.image_type);
+        item.size = GvSize(desc.width, desc.height);
+        item.bytes = desc.bytes;
+        if (desc.bytes != detail::GvSequencePayloadBytes(item.type, item.image_type, item.size) ||
+            desc.offset > ring->slot_capacity || desc.bytes > ring->slot_capacity - desc.offset) {
+            detail::GvSetLastHelperError("GvSharedRingReader::Acquire: corrupt slot");
+            return false;
+        }
+        item.data = data + desc.offset;
+    }
+    frame = result;
+    return true;
+}
+
+bool GvSharedRingReader::WaitForNext(uint64_t after, GvSharedRingFrame& frame, int timeout_ms) const {
+    if (!m_memory) {
+        detail::GvSetLastHelperError("GvSharedRingReader: ring is not open");
+        return false;
+    }
+    const uint64_t deadline = timeout_ms > 0 ? GvNowNs() + static_cast<uint64_t>(timeout_ms) * 1000000ull : 0;
+    for (uint32_t spin = 0;; ++spin) {
+        const uint64_t latest = GetLatestSequence();
+        // 가장 최근 프레임을 읽는 사이에 덮어써지면(발행이 매우 빠른 경우) 다음 최신 프레임을 다시 본다.
+        if (latest > after && Acquire(latest, frame)) {
+            return true;
+        }
+        if (deadline != 0 && GvNowNs() >= deadline) {
+            detail::GvSetLastHelperError("GvSharedRingReader::WaitForNext: timed out");
+            return false;
+        }
+        if (spin < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+bool GvSharedRingReader::IsValid(const GvSharedRingFrame& frame) const {
+    if (!m_memory || frame.sequence == 0) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slotHeader(*m_memory, frame.sequence)->state.load(std::memory_order_relaxed) == frame.sequence * 2;
+}
+
+}  // namespace gv
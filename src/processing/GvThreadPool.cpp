@@ -0,0 +1,433 @@
+#include "GvThreadPool.h"
+
+#include "GvPageSize.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace gv {
+
+namespace detail {
+
+size_t GvPageSize() {
+    static const size_t page = []() -> size_t {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        ::GetSystemInfo(&info);
+        return static_cast<size_t>(info.dwPageSize);
+#else
+        const long value = ::sysconf(_SC_PAGESIZE);
+        return value > 0 ? static_cast<size_t>(value) : 4096;
+#endif
+    }();
+    return page;
+}
+
+}  // namespace detail
+
+struct GvThreadPool::Job {
+    void (*task)(void* ctx, size_t index) = nullptr;
+    void* ctx = nullptr;
+    size_t tasks = 0;
+    std::atomic<size_t> next{0};
+    // 이 작업을 실행 중인 작업 스레드 수(m_mutex로 보호).
+    int active = 0;
+};
+
+namespace {
+
+#if defined(_WIN32)
+bool setThreadAffinity(HANDLE thread, const std::vector<int>& cpus) {
+    DWORD_PTR mask = 0;
+    for (const int cpu : cpus) {
+        if (cpu < 0 || cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            detail::GvSetLastHelperError("GvSetCurrentThreadAffinity: cpu out of range: " + std::to_string(cpu));
+            return false;
+        }
+        mask |= static_cast<DWORD_PTR>(1) << cpu;
+    }
+    if (::SetThreadAffinityMask(thread, mask) == 0) {
+        detail::GvSetLastHelperError("SetThreadAffinityMask failed: " + std::to_string(::GetLastError()));
+        return false;
+    }
+    return true;
+}
+#else
+bool setThreadAffinity(pthread_t thread, const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            detail::GvSetLastHelperError("GvSetCurrentThreadAffinity: cpu out of range: " + std::to_string(cpu));
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    const int rc = ::pthread_setaffinity_np(thread, sizeof(set), &set);
+    if (rc != 0) {
+        detail::GvSetLastHelperError(std::string("pthread_setaffinity_np failed: ") + std::strerror(rc));
+        return false;
+    }
+    return true;
+}
+
+// sysfs cpulist 형식("0-3,8-11")을 읽는다.
+bool parseCpuList(const char* text, std::vector<int>& cpus) {
+    const char* p = text;
+    while (*p != '\0' && *p != '\n') {
+        char* end = nullptr;
+        const long first = std::strtol(p, &end, 10);
+        if (end == p || first < 0) {
+            return false;
+        }
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            ++p;
+            last = std::strtol(p, &end, 10);
+            if (end == p || last < first) {
+                return false;
+            }
+            p = end;
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        if (*p == ',') {
+            ++p;
+        }
+    }
+    return true;
+}
+#endif
+
+std::mutex& globalPoolMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+GvThreadPool& globalPool() {
+    static GvThreadPool pool;
+    return pool;
+}
+
+}  // namespace
+
+GvThreadPool::~GvThreadPool() {
+    Stop();
+}
+
+bool GvThreadPool::Start(const GvSystemConfig& config) {
+    Stop();
+
+    // [1] 작업 스레드를 고정할 CPU 목록
+    std::vector<int> cpus = config.worker_cpus;
+    if (cpus.empty() && config.numa_node >= 0 && !GvGetNumaNodeCpus(config.numa_node, cpus)) {
+        return false;
+    }
+
+    // [2] 스레드 수: 호출 스레드가 작업에 참여하므로 작업 스레드는 하나 적게 만든다.
+    int workers = config.worker_threads;
+    if (workers <= 0) {
+        const int available = !cpus.empty() ? static_cast<int>(cpus.size())
+                                            : static_cast<int>(std::thread::hardware_concurrency());
+        workers = std::max(available - 1, 1);
+    }
+    const int defaults = workers + 1;
+    m_threadCounts[ThreadSubsystem_Default] = defaults;
+    m_threadCounts[ThreadSubsystem_Decode] = config.decode_threads > 0 ? config.decode_threads : defaults;
+    m_threadCounts[ThreadSubsystem_Filter] = config.filter_threads > 0 ? config.filter_threads : defaults;
+    m_threadCounts[ThreadSubsystem_IO] = config.io_threads > 0 ? config.io_threads : defaults;
+
+    // [3] 작업 스레드 생성. 고정은 각 스레드가 시작하면서 직접 한다.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cpus = cpus;
+        m_stop = false;
+        m_running = true;
+    }
+    try {
+        m_workers.reserve(static_cast<size_t>(workers));
+        for (int i = 0; i < workers; ++i) {
+            m_workers.emplace_back(&GvThreadPool::WorkerMain, this, i);
+        }
+    } catch (const std::exception& e) {
+        detail::GvSetLastHelperError(std::string("GvThreadPool::Start: failed to create worker thread: ") + e.what());
+        Stop();
+        return false;
+    }
+    return true;
+}
+
+void GvThreadPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running && m_workers.empty()) {
+            return;
+        }
+        m_stop = true;
+        m_running = false;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cpus.clear();
+    m_stop = false;
+}
+
+bool GvThreadPool::IsRunning() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+int GvThreadPool::GetWorkerCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running ? static_cast<int>(m_workers.size()) : 0;
+}
+
+std::vector<int> GvThreadPool::GetWorkerCpus() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cpus;
+}
+
+int GvThreadPool::GetThreadCount(GvThreadSubsystem subsystem) const {
+    const int index = subsystem >= 0 && subsystem < ThreadSubsystem_Count ? subsystem : ThreadSubsystem_Default;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::max(m_threadCounts[index], 1);
+}
+
+bool GvThreadPool::RunOne(Job& job) {
+    const size_t index = job.next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= job.tasks) {
+        return false;
+    }
+    job.task(job.ctx, index);
+    return true;
+}
+
+bool GvThreadPool::Run(GvThreadSubsystem, size_t tasks, void (*task)(void* ctx, size_t index), void* ctx) {
+    if (tasks == 0) {
+        return true;
+    }
+    Job job;
+    job.task = task;
+    job.ctx = ctx;
+    job.tasks = tasks;
+
+    // [1] 작업 스레드 몫을 큐에 넣는다(호출 스레드 몫 1개 제외).
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return false;
+        }
+        const size_t helpers = std::min(tasks - 1, m_workers.size());
+        for (size_t i = 0; i < helpers; ++i) {
+            m_queue.push_back(&job);
+        }
+    }
+    m_wake.notify_all();
+
+    // [2] 호출 스레드도 작업을 가져가 실행한다.
+    while (RunOne(job)) {
+    }
+
+    // [3] 아직 가져가지 않은 큐 항목을 지우고, 실행 중인 작업 스레드가 끝나기를 기다린다.
+    //     작업 스레드가 모두 바쁘면(중첩 호출) 호출 스레드가 모든 작업을 처리하고 여기서 바로 끝난다.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_queue.erase(std::remove(m_queue.begin(), m_queue.end(), &job), m_queue.end());
+    m_done.wait(lock, [&job]() { return job.active == 0; });
+    return true;
+}
+
+void GvThreadPool::WorkerMain(int index) {
+    std::vector<int> cpus;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_cpus.empty()) {
+            cpus.push_back(m_cpus[static_cast<size_t>(index) % m_cpus.size()]);
+        }
+    }
+    // 고정 실패(허용되지 않은 CPU 등)는 치명적이지 않으므로 고정 없이 계속한다.
+    GvSetCurrentThreadAffinity(cpus);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            return;
+        }
+        Job* job = m_queue.front();
+        m_queue.pop_front();
+        ++job->active;
+        lock.unlock();
+        while (RunOne(*job)) {
+        }
+        lock.lock();
+        if (--job->active == 0) {
+            m_done.notify_all();
+        }
+    }
+}
+
+void GvThreadPool::TouchPages(void* data, size_t bytes) {
+    if (data == nullptr || bytes == 0) {
+        return;
+    }
+    struct Range {
+        unsigned char* data;
+        size_t bytes;
+        size_t step;
+    } range{static_cast<unsigned char*>(data), bytes, 0};
+    const size_t page = detail::GvPageSize();
+    const size_t pages = (bytes + page - 1) / page;
+    const size_t threads = static_cast<size_t>(GetWorkerCount()) + 1;
+    range.step = ((pages + threads - 1) / threads) * page;
+    const size_t tasks = (bytes + range.step - 1) / range.step;
+    auto touch = [](void* ctx, size_t index) {
+        const Range& r = *static_cast<const Range*>(ctx);
+        const size_t begin = index * r.step;
+        std::memset(r.data + begin, 0, std::min(r.step, r.bytes - begin));
+    };
+    if (!Run(ThreadSubsystem_Default, tasks, touch, &range)) {
+        std::memset(data, 0, bytes);
+    }
+}
+
+bool GvConfigureProcessingThreads(const GvSystemConfig& config) {
+    std::lock_guard<std::mutex> lock(globalPoolMutex());
+    GvSetParallelExecutor(nullptr);
+    if (!globalPool().Start(config)) {
+        return false;
+    }
+    GvSetParallelExecutor(&globalPool());
+    return true;
+}
+
+void GvReleaseProcessingThreads() {
+    std::lock_guard<std::mutex> lock(globalPoolMutex());
+    GvSetParallelExecutor(nullptr);
+    globalPool().Stop();
+}
+
+GvThreadPool* GvGetProcessingThreadPool() {
+    std::lock_guard<std::mutex> lock(globalPoolMutex());
+    return globalPool().IsRunning() ? &globalPool() : nullptr;
+}
+
+void GvTouchProcessingMemory(void* data, size_t bytes) {
+    if (GvThreadPool* pool = GvGetProcessingThreadPool()) {
+        pool->TouchPages(data, bytes);
+    } else if (data != nullptr && bytes > 0) {
+        std::memset(data, 0, bytes);
+    }
+}
+
+bool GvSetCurrentThreadAffinity(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return true;
+    }
+#if defined(_WIN32)
+    return setThreadAffinity(::GetCurrentThread(), cpus);
+#else
+    return setThreadAffinity(::pthread_self(), cpus);
+#endif
+}
+
+bool GvGetCurrentThreadAffinity(std::vector<int>& cpus) {
+    cpus.clear();
+#if defined(_WIN32)
+    // 스레드 마스크를 직접 읽는 API가 없으므로 프로세스 마스크로 바꿨다가 이전 값으로 되돌린다.
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (!::GetProcessAffinityMask(::GetCurrentProcess(), &processMask, &systemMask)) {
+        detail::GvSetLastHelperError("GetProcessAffinityMask failed: " + std::to_string(::GetLastError()));
+        return false;
+    }
+    const DWORD_PTR mask = ::SetThreadAffinityMask(::GetCurrentThread(), processMask);
+    if (mask == 0) {
+        detail::GvSetLastHelperError("SetThreadAffinityMask failed: " + std::to_string(::GetLastError()));
+        return false;
+    }
+    ::SetThreadAffinityMask(::GetCurrentThread(), mask);
+    for (int cpu = 0; cpu < static_cast<int>(sizeof(DWORD_PTR) * 8); ++cpu) {
+        if ((mask >> cpu) & 1) {
+            cpus.push_back(cpu);
+        }
+    }
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    const int rc = ::pthread_getaffinity_np(::pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        detail::GvSetLastHelperError(std::string("pthread_getaffinity_np failed: ") + std::strerror(rc));
+        return false;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus.push_back(cpu);
+        }
+    }
+#endif
+    return true;
+}
+
+bool GvGetNumaNodeCpus(int node, std::vector<int>& cpus) {
+    cpus.clear();
+    if (node < 0) {
+        detail::GvSetLastHelperError("GvGetNumaNodeCpus: invalid node");
+        return false;
+    }
+#if defined(_WIN32)
+    ULONGLONG mask = 0;
+    if (node > 0xff || !::GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask) || mask == 0) {
+        detail::GvSetLastHelperError("GvGetNumaNodeCpus: no processors on node " + std::to_string(node));
+        return false;
+    }
+    for (int cpu = 0; cpu < 64; ++cpu) {
+        if ((mask >> cpu) & 1) {
+            cpus.push_back(cpu);
+        }
+    }
+    return true;
+#else
+    const std::string path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+    FILE* fp = std::fopen(path.c_str(), "r");
+    if (fp == nullptr) {
+        detail::GvSetLastHelperError("GvGetNumaNodeCpus: no such node: " + std::to_string(node));
+        return false;
+    }
+    char text[4096] = {};
+    const bool read = std::fgets(text, sizeof(text), fp) != nullptr;
+    std::fclose(fp);
+    if (!read || !parseCpuList(text, cpus) || cpus.empty()) {
+        cpus.clear();
+        detail::GvSetLastHelperError("GvGetNumaNodeCpus: cannot read " + path);
+        return false;
+    }
+    return true;
+#endif
+}
+
+}  // namespace gv
@@ -0,0 +1,341 @@
+#include "GvUndistort.h"
+
+#include "GvParallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gv {
+
+namespace {
+
+constexpr int kFracBits = 8;
+constexpr int kFracOne = 1 << kFracBits;
+
+// 3x3 행 우선 행렬 연산.
+void matMul(const double* a, const double* b, double* out) {
+    double r[9];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            r[i * 3 + j] = a[i * 3] * b[j] + a[i * 3 + 1] * b[3 + j] + a[i * 3 + 2] * b[6 + j];
+        }
+    }
+    std::memcpy(out, r, sizeof(r));
+}
+
+void matTranspose(const double* a, double* out) {
+    double r[9];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            r[i * 3 + j] = a[j * 3 + i];
+        }
+    }
+    std::memcpy(out, r, sizeof(r));
+}
+
+void matVec(const double* a, const double* v, double* out) {
+    const double r[3] = {a[0] * v[0] + a[1] * v[1] + a[2] * v[2], a[3] * v[0] + a[4] * v[1] + a[5] * v[2],
+                         a[6] * v[0] + a[7] * v[1] + a[8] * v[2]};
+    std::memcpy(out, r, sizeof(r));
+}
+
+// 회전 벡터 <-> 회전 행렬(Rodrigues).
+void rodrigues(const double* w, double* R) {
+    const double theta = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+    const double identity[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    if (theta < 1e-12) {
+        std::memcpy(R, identity, sizeof(identity));
+        return;
+    }
+    const double k[3] = {w[0] / theta, w[1] / theta, w[2] / theta};
+    const double c = std::cos(theta);
+    const double s = std::sin(theta);
+    const double K[9] = {0, -k[2], k[1], k[2], 0, -k[0], -k[1], k[0], 0};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            R[i * 3 + j] = identity[i * 3 + j] * c + (1.0 - c) * k[i] * k[j] + s * K[i * 3 + j];
+        }
+    }
+}
+
+void rotationVector(const double* R, double* w) {
+    const double cosTheta = std::max(-1.0, std::min(1.0, (R[0] + R[4] + R[8] - 1.0) * 0.5));
+    const double theta = std::acos(cosTheta);
+    const double v[3] = {R[7] - R[5], R[2] - R[6], R[3] - R[1]};
+    const double s = std::sin(theta);
+    if (s < 1e-9) {
+        // 0 또는 180도 근처. 스테레오 헤드에서는 0 근처만 의미가 있다.
+        w[0] = v[0] * 0.5;
+        w[1] = v[1] * 0.5;
+        w[2] = v[2] * 0.5;
+        return;
+    }
+    const double scale = theta / (2.0 * s);
+    w[0] = v[0] * scale;
+    w[1] = v[1] * scale;
+    w[2] = v[2] * scale;
+}
+
+void toDouble(const float* in, double* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<double>(in[i]);
+    }
+}
+
+GvROI resolveRoi(const GvROI& roi, const GvSize& resolution) {
+    return roi.width > 0 && roi.height > 0 ? roi : GvROI(0, 0, resolution.width, resolution.height);
+}
+
+template <int Channels>
+void remapRows(const unsigned char* src, int srcStride, unsigned char* dst, int dstStride, int width,
+               const detail::GvRemapEntry* table, size_t r0, size_t r1) {
+    for (size_t v = r0; v < r1; ++v) {
+        const detail::GvRemapEntry* e = table + v * static_cast<size_t>(width);
+        unsigned char* out = dst + v * static_cast<size_t>(dstStride);
+        for (int u = 0; u < width; ++u, ++e, out += Channels) {
+            if (e->x < 0) {
+                for (int c = 0; c < Channels; ++c) {
+                    out[c] = 0;
+                }
+                continue;
+            }
+            const unsigned char* p0 = src + static_cast<ptrdiff_t>(e->y) * srcStride + e->x * Channels;
+            const unsigned char* p1 = p0 + srcStride;
+            const uint32_t fx = e->fx;
+            const uint32_t fy = e->fy;
+            for (int c = 0; c < Channels; ++c) {
+                const uint32_t top = p0[c] * (kFracOne - fx) + p0[c + Channels] * fx;
+                const uint32_t bottom = p1[c] * (kFracOne - fx) + p1[c + Channels] * fx;
+                out[c] = static_cast<unsigned char>(
+                    (top * (kFracOne - fy) + bottom * fy + (1u << (2 * kFracBits - 1))) >> (2 * kFracBits));
+            }
+        }
+    }
+}
+
+}  // namespace
+
+bool GvBuildRemapTable(const GvCameraCalibration& camera, const GvRemapProjection& projection,
+                       const GvSize& resolution, GvRemapTable& table, const GvRemapOptions& options) {
+    const GvROI out = resolveRoi(options.output_roi, resolution);
+    const GvROI srcRoi = resolveRoi(options.source_roi, resolution);
+    if (resolution.width <= 0 || resolution.height <= 0 || out.width <= 0 || out.height <= 0 || srcRoi.width < 2 ||
+        srcRoi.height < 2 || srcRoi.x + srcRoi.width > 32767 || srcRoi.y + srcRoi.height > 32767 ||
+        camera.intrinsic[0] == 0.0f || camera.intrinsic[4] == 0.0f) {
+        detail::GvSetLastHelperError("GvBuildRemapTable: invalid arguments");
+        return false;
+    }
+    const double* Kn = projection.camera_matrix;
+    if (Kn[0] == 0.0 || Kn[4] == 0.0) {
+        detail::GvSetLastHelperError("GvBuildRemapTable: invalid projection camera matrix");
+        return false;
+    }
+    double K[9];
+    double dist[5];
+    toDouble(camera.intrinsic, K, 9);
+    toDouble(camera.distortion, dist, 5);
+    double Rinv[9];
+    matTranspose(projection.rotation, Rinv);
+
+    table.m_sourceSize = GvSize(srcRoi.width, srcRoi.height);
+    table.m_outputSize = GvSize(out.width, out.height);
+    // 0으로 채우지 않고 크기만 잡는다. 아래 병렬 루프가 모든 항목을 기록하므로 페이지는 작업 스레드 노드에 놓인다.
+    table.m_entries.clear();
+    table.m_entries.shrink_to_fit();
+    table.m_entries.resize(static_cast<size_t>(out.width) * static_cast<size_t>(out.height));
+    detail::GvRemapEntry* entries = table.m_entries.data();
+
+    // 출력 픽셀 -> 출력 정규 좌표 -> 원본 카메라 좌표(R^T) -> 왜곡 -> 원본 픽셀(입력 ROI 기준)
+    GvParallelFor(ThreadSubsystem_Filter, 0, static_cast<size_t>(out.height), options.threads,
+                  [&](size_t r0, size_t r1, int) {
+        for (size_t row = r0; row < r1; ++row) {
+            const double v = static_cast<double>(out.y) + static_cast<double>(row);
+            detail::GvRemapEntry* e = entries + row * static_cast<size_t>(out.width);
+            for (int col = 0; col < out.width; ++col, ++e) {
+                const double u = static_cast<double>(out.x + col);
+                const double yn = (v - Kn[5]) / Kn[4];
+                const double xn = (u - Kn[2] - Kn[1] * yn) / Kn[0];
+                const double ray[3] = {xn, yn, 1.0};
+                double p[3];
+                matVec(Rinv, ray, p);
+                if (p[2] <= 0.0) {
+                    e->x = -1;
+                    continue;
+                }
+                const double x = p[0] / p[2];
+                const double y = p[1] / p[2];
+                const double r2 = x * x + y * y;
+                const double radial = 1.0 + r2 * (dist[0] + r2 * (dist[1] + r2 * dist[4]));
+                const double xd = x * radial + 2.0 * dist[2] * x * y + dist[3] * (r2 + 2.0 * x * x);
+                const double yd = y * radial + dist[2] * (r2 + 2.0 * y * y) + 2.0 * dist[3] * x * y;
+                const double su = K[0] * xd + K[1] * yd + K[2] - srcRoi.x;
+                const double sv = K[4] * yd + K[5] - srcRoi.y;
+                // 픽셀 중심 기준 [0, w - 1]x[0, h - 1] 밖은 무효.
+                if (!(su >= 0.0 && sv >= 0.0 && su <= srcRoi.width - 1 && sv <= srcRoi.height - 1)) {
+                    e->x = -1;
+                    continue;
+                }
+                const int fixedU = static_cast<int>(std::lround(su * kFracOne));
+                const int fixedV = static_cast<int>(std::lround(sv * kFracOne));
+                int ix = fixedU >> kFracBits;
+                int iy = fixedV >> kFracBits;
+                int fx = fixedU & (kFracOne - 1);
+                int fy = fixedV & (kFracOne - 1);
+                if (ix >= srcRoi.width - 1) {
+                    ix = srcRoi.width - 2;
+                    fx = kFracOne;
+                }
+                if (iy >= srcRoi.height - 1) {
+                    iy = srcRoi.height - 2;
+                    fy = kFracOne;
+                }
+                e->x = static_cast<int16_t>(ix);
+                e->y = static_cast<int16_t>(iy);
+                e->fx = static_cast<uint16_t>(fx);
+                e->fy = static_cast<uint16_t>(fy);
+            }
+        }
+    });
+    return true;
+}
+
+bool GvBuildUndistortTable(const GvCameraCalibration& camera, const GvSize& resolution, GvRemapTable& table,
+                           const GvRemapOptions& options) {
+    GvRemapProjection projection;
+    toDouble(camera.intrinsic, projection.camera_matrix, 9);
+    return GvBuildRemapTable(camera, projection, resolution, table, options);
+}
+
+bool GvComputeStereoRectification(const GvCameraCalibration& left, const GvCameraCalibration& right,
+                                  GvStereoRectification& rectification) {
+    if (!left.has_extrinsic || !right.has_extrinsic) {
+        detail::GvSetLastHelperError("GvComputeStereoRectification: extrinsic parameters are required");
+        return false;
+    }
+    // [1] 좌 -> 우 상대 자세: X_r = R X_l + T
+    double Rl[9], Rr[9], tl[3], tr[3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            Rl[i * 3 + j] = left.extrinsic[i * 4 + j];
+            Rr[i * 3 + j] = right.extrinsic[i * 4 + j];
+        }
+        tl[i] = left.extrinsic[i * 4 + 3];
+        tr[i] = right.extrinsic[i * 4 + 3];
+    }
+    double RlT[9], R[9], Rtl[3];
+    matTranspose(Rl, RlT);
+    matMul(Rr, RlT, R);
+    matVec(R, tl, Rtl);
+    const double T[3] = {tr[0] - Rtl[0], tr[1] - Rtl[1], tr[2] - Rtl[2]};
+    const double nt = std::sqrt(T[0] * T[0] + T[1] * T[1] + T[2] * T[2]);
+    if (!(nt > 0.0)) {
+        detail::GvSetLastHelperError("GvComputeStereoRectification: cameras share the same center");
+        return false;
+    }
+
+    // [2] 반 회전으로 두 카메라 방향을 맞춘 뒤 기준선을 x(또는 y)축에 정렬
+    double om[3], halfR[9];
+    rotationVector(R, om);
+    const double halfOm[3] = {-0.5 * om[0], -0.5 * om[1], -0.5 * om[2]};
+    rodrigues(halfOm, halfR);
+    double t[3];
+    matVec(halfR, T, t);
+    const int idx = std::fabs(t[0]) > std::fabs(t[1]) ? 0 : 1;
+    const double c = t[idx];
+    double uu[3] = {0, 0, 0};
+    uu[idx] = c > 0 ? 1.0 : -1.0;
+    double ww[3] = {t[1] * uu[2] - t[2] * uu[1], t[2] * uu[0] - t[0] * uu[2], t[0] * uu[1] - t[1] * uu[0]};
+    const double nw = std::sqrt(ww[0] * ww[0] + ww[1] * ww[1] + ww[2] * ww[2]);
+    if (nw > 0.0) {
+        const double scale = std::acos(std::fabs(c) / nt) / nw;
+        for (double& w : ww) {
+            w *= scale;
+        }
+    }
+    double wR[9], halfRT[9];
+    rodrigues(ww, wR);
+    matTranspose(halfR, halfRT);
+    matMul(wR, halfRT, rectification.left.rotation);
+    matMul(wR, halfR, rectification.right.rotation);
+
+    // [3] 공통 카메라 행렬: 평행 방향과 수직인 축의 초점거리 중 작은 값, 주점은 평균
+    const double f = idx == 0 ? std::min(left.intrinsic[4], right.intrinsic[4])
+                              : std::min(left.intrinsic[0], right.intrinsic[0]);
+    const double cx = 0.5 * (left.intrinsic[2] + right.intrinsic[2]);
+    const double cy = 0.5 * (left.intrinsic[5] + right.intrinsic[5]);
+    const double Kn[9] = {f, 0, cx, 0, f, cy, 0, 0, 1};
+    std::memcpy(rectification.left.camera_matrix, Kn, sizeof(Kn));
+    std::memcpy(rectification.right.camera_matrix, Kn, sizeof(Kn));
+    rectification.baseline = nt;
+    rectification.vertical = idx == 1;
+    return true;
+}
+
+bool GvBuildRectifyTables(const GvDeviceCalibration& calibration, GvRemapTable& left, GvRemapTable& right,
+                          const GvRemapOptions& options, GvStereoRectification* rectification) {
+    if (calibration.camera_count != 2) {
+        detail::GvSetLastHelperError("GvBuildRectifyTables: stereo calibration is required");
+        return false;
+    }
+    GvStereoRectification rect;
+    if (!GvComputeStereoRectification(calibration.cameras[0], calibration.cameras[1], rect) ||
+        !GvBuildRemapTable(calibration.cameras[0], rect.left, calibration.resolution, left, options) ||
+        !GvBuildRemapTable(calibration.cameras[1], rect.right, calibration.resolution, right, options)) {
+        return false;
+    }
+    if (rectification != nullptr) {
+        *rectification = rect;
+    }
+    return true;
+}
+
+bool GvRemapTable::Apply(const unsigned char* src, int srcStride, int channels, unsigned char* dst, int dstStride,
+                         int threads) const {
+    if (!IsValid() || src == nullptr || dst == nullptr || (channels != 1 && channels != 3) ||
+        srcStride < m_sourceSize.width * channels || dstStride < m_outputSize.width * channels) {
+        detail::GvSetLastHelperError("GvRemapTable::Apply: invalid arguments");
+        return false;
+    }
+    const int width = m_outputSize.width;
+    const detail::GvRemapEntry* entries = m_entries.data();
+    GvParallelFor(ThreadSubsystem_Filter, 0, static_cast<size_t>(m_outputSize.height), threads,
+                  [&](size_t r0, size_t r1, int) {
+        if (channels == 1) {
+            remapRows<1>(src, srcStride, dst, dstStride, width, entries, r0, r1);
+        } else {
+            remapRows<3>(src, srcStride, dst, dstStride, width, entries, r0, r1);
+        }
+    });
+    return true;
+}
+
+bool GvRemapTable::Apply(const GvImageBuffer& src, GvImageBuffer& dst, int threads) const {
+    if (!src.IsValid() || src.GetSize() != m_sourceSize) {
+        detail::GvSetLastHelperError("GvRemapTable::Apply: image does not match table");
+        return false;
+    }
+    if (dst.GetType() != src.GetType() || dst.GetSize() != m_outputSize) {
+        dst = GvImageBuffer::Create(src.GetType(), m_outputSize);
+    }
+    return Apply(src.GetDataConstPtr(), static_cast<int>(src.GetStrideBytes()),
+                 static_cast<int>(GvImageBufferPixelSize(src.GetType())), dst.GetDataPtr(),
+                 static_cast<int>(dst.GetStrideBytes()), threads);
+}
+
+bool GvRemapTable::Apply(const GvRealtimeImageFrame& frame, GvImageBuffer& dst, int threads) const {
+    if (frame.data == nullptr || GvSize(frame.width, frame.height) != m_sourceSize ||
+        (frame.channels != 1 && frame.channels != 3)) {
+        detail::GvSetLastHelperError("GvRemapTable::Apply: frame does not match table");
+        return false;
+    }
+    const GvImageType::Enum type = frame.channels == 1 ? GvImageType::Mono8 : GvImageType::RGB8;
+    if (dst.GetType() != type || dst.GetSize() != m_outputSize) {
+        dst = GvImageBuffer::Create(type, m_outputSize);
+    }
+    const int stride = frame.stride_bytes > 0 ? frame.stride_bytes : frame.width * frame.channels;
+    return Apply(frame.data, stride, frame.channels, dst.GetDataPtr(), static_cast<int>(dst.GetStrideBytes()),
+                 threads);
+}
+
+}  // namespace gv
@@ -0,0 +1,228 @@
+#include "GvWhiteBalance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace gv {
+
+namespace {
+
+GvWhiteBalanceOptions sanitize(GvWhiteBalanceOptions options) {
+    options.sample_step = std::max(options.sample_step, 1);
+    options.frame_interval = std::max(options.frame_interval, 1);
+    options.saturation_level = std::min(std::max(options.saturation_level, 1), 256);
+    options.dark_level = std::min(std::max(options.dark_level, -1), options.saturation_level - 1);
+    options.min_valid_fraction = std::min(std::max(options.min_valid_fraction, 0.0), 1.0);
+    options.smoothing = std::min(std::max(options.smoothing, 0.01), 1.0);
+    options.min_change = std::max(options.min_change, 0.0);
+    options.settle_frames = std::max(options.settle_frames, 0);
+    options.min_ratio = std::max(options.min_ratio, 0.001f);
+    options.max_ratio = std::max(options.max_ratio, options.min_ratio);
+    return options;
+}
+
+// 표본 한 행의 채널 합. 제외할 픽셀은 0/1 마스크를 곱해 분기 없이 뺀다.
+void accumulateRow(const unsigned char* p, int count, int pixelStride, int saturation, int dark, uint64_t* sum,
+                   uint64_t& valid) {
+    uint32_t s0 = 0;
+    uint32_t s1 = 0;
+    uint32_t s2 = 0;
+    uint32_t n = 0;
+    for (int i = 0; i < count; ++i, p += pixelStride) {
+        const uint32_t c0 = p[0];
+        const uint32_t c1 = p[1];
+        const uint32_t c2 = p[2];
+        const int hi = static_cast<int>(std::max(c0, std::max(c1, c2)));
+        const uint32_t use = static_cast<uint32_t>(hi < saturation) & static_cast<uint32_t>(hi > dark);
+        s0 += c0 * use;
+        s1 += c1 * use;
+        s2 += c2 * use;
+        n += use;
+    }
+    sum[0] += s0;
+    sum[1] += s1;
+    sum[2] += s2;
+    valid += n;
+}
+
+float clampRatio(double ratio, const GvWhiteBalanceOptions& options) {
+    return static_cast<float>(std::min(std::max(ratio, static_cast<double>(options.min_ratio)),
+                                       static_cast<double>(options.max_ratio)));
+}
+
+}  // namespace
+
+bool GvComputeChannelSums(const GvRealtimeImageFrame& frame, const GvROI& roi, int sample_step, bool bgr_order,
+                          int saturation_level, int dark_level, GvChannelSums& sums) {
+    sums = GvChannelSums();
+    if (frame.data == nullptr || frame.width <= 0 || frame.height <= 0 ||
+        (frame.channels != 3 && frame.channels != 4) || frame.stride_bytes < frame.width * frame.channels) {
+        detail::GvSetLastHelperError("GvComputeChannelSums: color frame (3 or 4 channels) required");
+        return false;
+    }
+    // [1] ROI를 프레임 안으로 자른다(크기 0이면 전체).
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = frame.width;
+    int y1 = frame.height;
+    if (roi.width > 0 && roi.height > 0) {
+        x0 = std::max(roi.x, 0);
+        y0 = std::max(roi.y, 0);
+        x1 = std::min(roi.x + roi.width, frame.width);
+        y1 = std::min(roi.y + roi.height, frame.height);
+    }
+    if (x0 >= x1 || y0 >= y1) {
+        detail::GvSetLastHelperError("GvComputeChannelSums: ROI outside frame");
+        return false;
+    }
+    const int step = std::max(sample_step, 1);
+    const int count = (x1 - x0 + step - 1) / step;
+
+    // [2] 표본 행마다 누적(행 합은 32비트, 행 폭 x 255가 넘치지 않는다)
+    for (int y = y0; y < y1; y += step) {
+        const unsigned char* row = frame.data + static_cast<size_t>(y) * static_cast<size_t>(frame.stride_bytes) +
+                                   static_cast<size_t>(x0) * static_cast<size_t>(frame.channels);
+        accumulateRow(row, count, step * frame.channels, saturation_level, dark_level, sums.sum, sums.valid);
+        sums.total += static_cast<uint64_t>(count);
+    }
+    if (bgr_order) {
+        std::swap(sums.sum[0], sums.sum[2]);
+    }
+    return true;
+}
+
+GvWhiteBalance::GvWhiteBalance(const GvWhiteBalanceOptions& options) : m_options(sanitize(options)) {}
+
+void GvWhiteBalance::SetOptions(const GvWhiteBalanceOptions& options) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_options = sanitize(options);
+    refreshPending();
+}
+
+GvWhiteBalanceOptions GvWhiteBalance::GetOptions() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_options;
+}
+
+void GvWhiteBalance::SetCurrentRatios(const float ratio[3]) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (int c = 0; c < 3; ++c) {
+        const float value = ratio[c] > 0.0f ? ratio[c] : 1.0f;
+        m_estimate.current[c] = value;
+        m_estimate.ratio[c] = value;
+        m_logRatio[c] = std::log(static_cast<double>(value));
+    }
+    m_estimate.valid = false;
+    m_estimate.pending = false;
+}
+
+bool GvWhiteBalance::Update(const GvRealtimeImageFrame& frame) {
+    // [1] 설정 복사, 측면/안정화 대기/프레임 간격 확인
+    GvWhiteBalanceOptions options;
+    float current[3];
+    uint64_t settleUntil = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        options = m_options;
+        std::copy(m_estimate.current, m_estimate.current + 3, current);
+        settleUntil = m_settleUntil;
+    }
+    if (options.camera_id != CameraID_Both && frame.camera_id != options.camera_id) {
+        return false;
+    }
+    const uint64_t sequence = m_frameCounter.fetch_add(1, std::memory_order_relaxed);
+    if (sequence < settleUntil || sequence % static_cast<uint64_t>(options.frame_interval) != 0) {
+        return false;
+    }
+    if (!frame.is_color) {
+        detail::GvSetLastHelperError("GvWhiteBalance::Update: color frame required");
+        return false;
+    }
+
+    // [2] 채널 합(잠금 밖)
+    const uint64_t start = GvNowNs();
+    GvChannelSums sums;
+    if (!GvComputeChannelSums(frame, options.roi, options.sample_step, options.bgr_order, options.saturation_level,
+                              options.dark_level, sums)) {
+        return false;
+    }
+    const double validFraction = static_cast<double>(sums.valid) / static_cast<double>(sums.total);
+    if (sums.valid == 0 || validFraction < options.min_valid_fraction) {
+        return false;
+    }
+    double mean[3];
+    for (int c = 0; c < 3; ++c) {
+        mean[c] = static_cast<double>(sums.sum[c]) / static_cast<double>(sums.valid);
+    }
+
+    // [3] gray-world: G를 기준으로 R/B 비율을 고친다(프레임은 current 비율로 찍혔다고 본다).
+    double target[3];
+    for (int c = 0; c < 3; ++c) {
+        target[c] = c == 1 ? current[1] : clampRatio(current[c] * mean[1] / std::max(mean[c], 0.5), options);
+    }
+    const uint64_t measureNs = GvNowNs() - start;
+
+    // [4] 로그 영역 평활 후 반영
+    std::lock_guard<std::mutex> lock(m_mutex);
+    GvWhiteBalanceEstimate& e = m_estimate;
+    for (int c = 0; c < 3; ++c) {
+        const double logTarget = std::log(target[c]);
+        m_logRatio[c] = e.valid ? m_logRatio[c] + options.smoothing * (logTarget - m_logRatio[c]) : logTarget;
+        e.ratio[c] = c == 1 ? e.current[1] : clampRatio(std::exp(m_logRatio[c]), options);
+        e.channel_mean[c] = mean[c];
+    }
+    e.valid = true;
+    e.valid_fraction = validFraction;
+    e.frame_id = frame.frame_id;
+    ++e.measured_frames;
+    e.updated_ns = GvNowNs();
+    e.measure_ns = measureNs;
+    refreshPending();
+    return true;
+}
+
+GvWhiteBalanceEstimate GvWhiteBalance::GetEstimate() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_estimate;
+}
+
+void GvWhiteBalance::MarkApplied(const float ratio[3]) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::copy(ratio, ratio + 3, m_estimate.current);
+    ++m_estimate.applied_count;
+    m_settleUntil = m_frameCounter.load(std::memory_order_relaxed) + static_cast<uint64_t>(m_options.settle_frames);
+    refreshPending();
+}
+
+void GvWhiteBalance::Reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    GvWhiteBalanceEstimate cleared;
+    std::copy(m_estimate.current, m_estimate.current + 3, cleared.current);
+    std::copy(m_estimate.current, m_estimate.current + 3, cleared.ratio);
+    for (int c = 0; c < 3; ++c) {
+        m_logRatio[c] = std::log(static_cast<double>(cleared.current[c]));
+    }
+    m_estimate = cleared;
+    m_settleUntil = 0;
+    m_frameCounter.store(0, std::memory_order_relaxed);
+}
+
+void GvWhiteBalance::RealtimeCallback(const GvRealtimeImageFrame* frame, UserPtr user_data) {
+    if (frame != nullptr && user_data != nullptr) {
+        static_cast<GvWhiteBalance*>(user_data)->Update(*frame);
+    }
+}
+
+// m_mutex를 잡은 상태에서 호출한다.
+void GvWhiteBalance::refreshPending() {
+    const double threshold = std::log1p(m_options.min_change);
+    bool pending = false;
+    for (int c = 0; c < 3; ++c) {
+        const double change = std::log(static_cast<double>(m_estimate.ratio[c]) / m_estimate.current[c]);
+        pending = pending || std::fabs(change) > threshold;
+    }
+    m_estimate.pending = m_estimate.valid && pending;
+}
+
+}  // namespace gv